@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Check server edit latency benchmark.
+//
+// Generates a script of functions with the given number of lines (default
+// 10000) and opens it as a check file, then times edits in the middle of it
+// against parsing the whole edited file again, which is what checking it
+// without units costs. Edits are changing a line of a function body,
+// inserting a line, and removing the `শেষ` of a function and putting it back,
+// after which the function runs on to the end of the file.
+//
+// Usage : pankti_checkbench [lines]
+
+#include "../../src/check.h"
+#include "../../src/external/stb/stb_ds.h"
+#include "../../src/printer.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECKBENCH_EDITS 1000
+
+static const char *codeLines[] = {
+    "// সারির যোগফল গণনা, returns the total of the first count items",
+    "কাজ হিসাব(তালিকা, count)",
+    "    ধরি total = 0",
+    "    ধরি index = 0",
+    "    যতক্ষণ index < count করো",
+    "        // দ্বিগুণ করে যোগ",
+    "        total = total + তালিকা[index] * 2",
+    "        index = index + 1",
+    "    শেষ",
+    "    দেখাও(\"মোট যোগফল: \", total)",
+    "    ফেরাও total",
+    "শেষ",
+};
+
+#define CODE_LINES (sizeof(codeLines) / sizeof(codeLines[0]))
+
+static void appendStr(char **buf, const char *str) {
+    for (const char *c = str; *c != '\0'; c++) {
+        arrput(*buf, *c);
+    }
+}
+
+// Script of functions of at least `lines` lines
+static char *genCode(u64 lines) {
+    char *buf = NULL;
+    for (u64 line = 0; line < lines || line % CODE_LINES != 0; line++) {
+        appendStr(&buf, codeLines[line % CODE_LINES]);
+        arrput(buf, '\n');
+    }
+    arrput(buf, '\0');
+    return buf;
+}
+
+static double now(void) { return (double)clock() / CLOCKS_PER_SEC; }
+
+static PCheckFile *openFile(const char *text) {
+    PCheckFile *file = NewCheckFile(text, strlen(text));
+    if (file == NULL) {
+        PanPrint("Failed to open check file\n");
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+// Time of parsing the whole text of `file` again
+static double fullParse(const PCheckFile *file) {
+    u64 len = 0;
+    char *text = CheckFileText(file, &len);
+    double start = now();
+    PCheckFile *fresh = NewCheckFile(text, len);
+    double secs = now() - start;
+    FreeCheckFile(fresh);
+    free(text);
+    return secs;
+}
+
+static void report(const char *name, double edit, double full, u64 diags) {
+    PanPrint(
+        "%-16s %10.1f us %10.1f us %8.0fx %6llu diagnostics\n", name,
+        edit * 1e6, full * 1e6, edit > 0 ? full / edit : 0.0,
+        (unsigned long long)diags
+    );
+}
+
+static u64 diagCount(const PCheckFile *file) {
+    PCheckDiag *diags = CheckFileDiags(file);
+    u64 count = (u64)arrlen(diags);
+    arrfree(diags);
+    return count;
+}
+
+static void edit(PCheckFile *file, u32 start, u32 end, const char *text) {
+    if (!CheckFileEdit(file, start, end, text, strlen(text))) {
+        PanPrint("Edit of lines %u to %u failed\n", start, end);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char **argv) {
+    u64 lines = 10000;
+    if (argc > 1) {
+        lines = (u64)strtoull(argv[1], NULL, 10);
+    }
+
+    char *code = genCode(lines);
+    double start = now();
+    PCheckFile *file = openFile(code);
+    double openTime = now() - start;
+    PanPrint(
+        "%llu lines, %u units, open %.1f ms\n", (unsigned long long)lines,
+        (unsigned)arrlen(file->units), openTime * 1000.0
+    );
+    PanPrint(
+        "%-16s %13s %13s %9s\n", "edit", "incremental", "full parse",
+        "speedup"
+    );
+
+    // Line `index = index + 1` of the function in the middle
+    u32 mid = (u32)(lines / 2 / CODE_LINES * CODE_LINES);
+    u32 bodyLine = mid + 8;
+    u32 endLine = mid + 12;
+
+    start = now();
+    for (int i = 0; i < CHECKBENCH_EDITS; i++) {
+        edit(
+            file, bodyLine, bodyLine + 1,
+            i % 2 == 0 ? "        index = index + 2\n"
+                       : "        index = index + 1\n"
+        );
+    }
+    report(
+        "change line", (now() - start) / CHECKBENCH_EDITS, fullParse(file),
+        diagCount(file)
+    );
+
+    start = now();
+    for (int i = 0; i < CHECKBENCH_EDITS; i++) {
+        if (i % 2 == 0) {
+            edit(file, bodyLine, bodyLine, "        total = total - 1\n");
+        } else {
+            edit(file, bodyLine, bodyLine + 1, "");
+        }
+    }
+    report(
+        "insert line", (now() - start) / CHECKBENCH_EDITS, fullParse(file),
+        diagCount(file)
+    );
+
+    start = now();
+    edit(file, endLine, endLine + 1, "\n");
+    double removeTime = now() - start;
+    report("remove end", removeTime, fullParse(file), diagCount(file));
+
+    start = now();
+    edit(file, endLine, endLine + 1, "শেষ\n");
+    double restoreTime = now() - start;
+    report("restore end", restoreTime, fullParse(file), diagCount(file));
+
+    FreeCheckFile(file);
+    arrfree(code);
+    return 0;
+}
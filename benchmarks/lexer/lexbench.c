@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Lexer throughput benchmark.
+//
+// Generates a script of data tables of the given size in MB (default 4) and
+// lexes it a few times, printing the best time and MB/s. Tables are written
+// both as short lines, one row per line, and as long lines of 64 KB, like
+// generated or minified scripts. A script of functions, with indentation and
+// comments, and one of long string literals are lexed too.
+//
+// Usage : pankti_lexbench [size in MB]
+
+#include "../../src/alloc.h"
+#include "../../src/arena.h"
+#include "../../src/external/stb/stb_ds.h"
+#include "../../src/lexer.h"
+#include "../../src/printer.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LEXBENCH_RUNS      5
+#define LEXBENCH_LONG_LINE (64 * 1024)
+
+static const char *rowItems[] = {
+    "১২৩৪৫", "\"নাম\"", "৪৫.৬৭", "সত্যি", "\"ascii text\"",
+    "99.5",  "মিথ্যা",  "নিল",    "-৮",    "x_value",
+};
+
+static const char *codeLines[] = {
+    "// সারির যোগফল গণনা, returns the total of the first count items",
+    "কাজ হিসাব(তালিকা, count)",
+    "    ধরি total = 0",
+    "    ধরি index = 0",
+    "    যতক্ষণ index < count করো",
+    "        // দ্বিগুণ করে যোগ",
+    "        total = total + তালিকা[index] * 2",
+    "        index = index + 1",
+    "    শেষ",
+    "    দেখাও(\"মোট যোগফল: \", total)",
+    "    ফেরাও total",
+    "শেষ",
+    "",
+};
+
+static void appendStr(char **buf, const char *str) {
+    for (const char *c = str; *c != '\0'; c++) {
+        arrput(*buf, *c);
+    }
+}
+
+// Script of about `size` bytes, a table row is ended with a newline once a
+// line has `lineLen` bytes
+static char *genScript(u64 size, u64 lineLen) {
+    char *buf = NULL;
+    u64 lineStart = 0;
+    u64 row = 0;
+    while ((u64)arrlen(buf) < size) {
+        appendStr(&buf, "ধরি সারি = [");
+        for (u64 i = 0; i < 10; i++) {
+            appendStr(&buf, rowItems[(row + i) % 10]);
+            appendStr(&buf, i < 9 ? ", " : "]");
+        }
+        row++;
+        if ((u64)arrlen(buf) - lineStart >= lineLen) {
+            arrput(buf, '\n');
+            lineStart = (u64)arrlen(buf);
+        } else {
+            arrput(buf, ' ');
+        }
+    }
+    arrput(buf, '\0');
+    return buf;
+}
+
+// Script of about `size` bytes of functions
+static char *genCode(u64 size) {
+    char *buf = NULL;
+    u64 lineCount = sizeof(codeLines) / sizeof(codeLines[0]);
+    u64 line = 0;
+    while ((u64)arrlen(buf) < size) {
+        appendStr(&buf, codeLines[line % lineCount]);
+        arrput(buf, '\n');
+        line++;
+    }
+    arrput(buf, '\0');
+    return buf;
+}
+
+// Script of about `size` bytes of 256 byte long string literals
+static char *genStrings(u64 size) {
+    char *buf = NULL;
+    u64 row = 0;
+    while ((u64)arrlen(buf) < size) {
+        appendStr(&buf, "ধরি লেখা = \"");
+        for (u64 i = 0; i < 256; i++) {
+            arrput(buf, (char)('a' + (row + i) % 26));
+        }
+        appendStr(&buf, "\"\n");
+        row++;
+    }
+    arrput(buf, '\0');
+    return buf;
+}
+
+static void runBench(const char *name, char *src) {
+    u64 bytes = (u64)strlen(src);
+    double best = -1;
+    u64 tokens = 0;
+    for (int i = 0; i < LEXBENCH_RUNS; i++) {
+        PArena *arena = NewArena();
+        Lexer *lx = NewLexer(src, arena);
+        if (lx == NULL) {
+            PanPrint("Failed to create lexer\n");
+            exit(EXIT_FAILURE);
+        }
+        MakeLexerRaw(lx, true);
+        clock_t start = clock();
+        ScanTokens(lx);
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+        tokens = (u64)arrlen(lx->tokens);
+        FreeLexer(lx);
+        FreeArena(arena);
+        if (best < 0 || secs < best) {
+            best = secs;
+        }
+    }
+    double mb = (double)bytes / (1024.0 * 1024.0);
+    PanPrint(
+        "%-12s %8.2f MB %10llu tokens %9.1f ms %8.1f MB/s\n", name, mb,
+        (unsigned long long)tokens, best * 1000.0,
+        best > 0 ? mb / best : 0.0
+    );
+}
+
+int main(int argc, char **argv) {
+    u64 size = 4;
+    if (argc > 1) {
+        size = (u64)strtoull(argv[1], NULL, 10);
+    }
+    size *= 1024 * 1024;
+
+    char *shortLines = genScript(size, 1);
+    runBench("short lines", shortLines);
+    arrfree(shortLines);
+
+    char *longLines = genScript(size, LEXBENCH_LONG_LINE);
+    runBench("long lines", longLines);
+    arrfree(longLines);
+
+    char *code = genCode(size);
+    runBench("code", code);
+    arrfree(code);
+
+    char *strings = genStrings(size);
+    runBench("long strings", strings);
+    arrfree(strings);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// REPL snippet latency benchmark.
+//
+// Times short snippets run one after another in a session core, against
+// running each in a core of its own, created and freed around it, which is
+// what running a snippet as a script costs apart from starting the process.
+// Snippets define and call functions, use an imported module and update
+// globals of the snippets before them.
+//
+// Usage : pankti_replbench [snippets]
+
+#include "../../src/core.h"
+#include "../../src/printer.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Run before the timed snippets, which need what they define
+static const char *setupCode =
+    "import m \"গণিত\"\n"
+    "dhori x = 10\n"
+    "dhori total = 0\n";
+
+static const char *snippets[] = {
+    "kaj sq(n)\n  ferao n * n\nsesh\n",
+    "x = sq(x) % 97 + 1\n",
+    "total = total + m.বর্গমূল(x * x)\n",
+    "dhori i = 0\njotokhon i < 10 koro\n  total = total + i\n"
+    "  i = i + 1\nsesh\n",
+    "jodi total > 1000000 tahole\n  total = 0\nsesh\n",
+};
+
+#define SNIPPET_COUNT (sizeof(snippets) / sizeof(snippets[0]))
+
+static double now(void) { return (double)clock() / CLOCKS_PER_SEC; }
+
+static PanktiCore *newSession(void) {
+    PanktiCore *core = NewSessionCore();
+    if (core == NULL) {
+        PanPrint("Failed to create session core\n");
+        exit(EXIT_FAILURE);
+    }
+    return core;
+}
+
+static void runChunk(PanktiCore *core, const char *src) {
+    if (RunCoreChunk(core, src, strlen(src)) != PCERR_OK) {
+        PanPrint("Snippet failed :\n%s", src);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char **argv) {
+    u64 count = 10000;
+    if (argc > 1) {
+        count = (u64)strtoull(argv[1], NULL, 10);
+    }
+
+    PanktiCore *core = newSession();
+    runChunk(core, setupCode);
+    double start = now();
+    for (u64 i = 0; i < count; i++) {
+        runChunk(core, snippets[i % SNIPPET_COUNT]);
+    }
+    double session = (now() - start) / (double)count;
+    FreeCore(core);
+
+    // Each snippet in a core of its own needs the setup again
+    start = now();
+    for (u64 i = 0; i < count; i++) {
+        core = newSession();
+        runChunk(core, setupCode);
+        runChunk(core, snippets[0]);
+        runChunk(core, snippets[i % SNIPPET_COUNT]);
+        FreeCore(core);
+    }
+    double fresh = (now() - start) / (double)count;
+
+    PanPrint(
+        "%llu snippets\n%-16s %10.1f us\n%-16s %10.1f us\n%-16s %10.0fx\n",
+        (unsigned long long)count, "session", session * 1e6, "fresh core",
+        fresh * 1e6, "speedup", session > 0 ? fresh / session : 0.0
+    );
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Interpreter startup and stdlib import benchmark.
+//
+// Times creating and freeing a core, which registers the builtins, importing
+// each stdlib module for the first time in a new core, and importing it again
+// in a core which has it already.
+//
+// Usage : pankti_startupbench [runs]
+
+#include "../../src/core.h"
+#include "../../src/printer.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *modules[] = {"গণিত", "কথা", "তালিকা", "ছক", "পরিবেশ", "নথি"};
+
+#define MODULE_COUNT (sizeof(modules) / sizeof(modules[0]))
+
+static double now(void) { return (double)clock() / CLOCKS_PER_SEC; }
+
+static PanktiCore *newSession(void) {
+    PanktiCore *core = NewSessionCore();
+    if (core == NULL) {
+        PanPrint("Failed to create session core\n");
+        exit(EXIT_FAILURE);
+    }
+    return core;
+}
+
+static void runChunk(PanktiCore *core, const char *src) {
+    if (RunCoreChunk(core, src, strlen(src)) != PCERR_OK) {
+        PanPrint("Chunk failed :\n%s", src);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void printRow(const char *name, double seconds, u64 runs) {
+    PanPrint("%-20s %10.2f us\n", name, seconds * 1e6 / (double)runs);
+}
+
+int main(int argc, char **argv) {
+    u64 runs = 20000;
+    if (argc > 1) {
+        runs = (u64)strtoull(argv[1], NULL, 10);
+    }
+
+    char imports[MODULE_COUNT][64];
+    for (u64 m = 0; m < MODULE_COUNT; m++) {
+        snprintf(
+            imports[m], sizeof(imports[m]), "import m \"%s\"\n", modules[m]
+        );
+    }
+
+    PanPrint("%llu runs\n", (unsigned long long)runs);
+
+    double start = now();
+    for (u64 i = 0; i < runs; i++) {
+        FreeCore(newSession());
+    }
+    printRow("core", now() - start, runs);
+
+    // Running a chunk costs the same with or without an import
+    start = now();
+    for (u64 i = 0; i < runs; i++) {
+        PanktiCore *core = newSession();
+        runChunk(core, "dhori m = 0\n");
+        FreeCore(core);
+    }
+    double base = now() - start;
+    printRow("core + chunk", base, runs);
+
+    for (u64 m = 0; m < MODULE_COUNT; m++) {
+        start = now();
+        for (u64 i = 0; i < runs; i++) {
+            PanktiCore *core = newSession();
+            runChunk(core, imports[m]);
+            FreeCore(core);
+        }
+        printRow(modules[m], now() - start - base, runs);
+    }
+
+    PanktiCore *core = newSession();
+    for (u64 m = 0; m < MODULE_COUNT; m++) {
+        runChunk(core, imports[m]);
+    }
+    start = now();
+    for (u64 i = 0; i < runs; i++) {
+        runChunk(core, "dhori m = 0\n");
+    }
+    base = now() - start;
+    start = now();
+    for (u64 i = 0; i < runs; i++) {
+        runChunk(core, imports[i % MODULE_COUNT]);
+    }
+    printRow("import again", now() - start - base, runs);
+    FreeCore(core);
+    return 0;
+}
@@ -60,9 +60,235 @@
 
     '("\\.pn\\'" "\\.pank\\'")
 
-    nil
+    '(pankti-check-setup)
 
     "Syntax Highlighting for Pankti Programming Language"
 )
 
+;;; Diagnostics with `pankti --check-server' and Flymake.
+;;; One server checks every buffer. A buffer is opened with its whole text,
+;;; then only the lines touched by each edit are sent.
+
+(require 'cl-lib)
+(require 'flymake)
+
+(defvar pankti-executable "pankti"
+  "Pankti interpreter whose check server checks the buffers.")
+
+(defvar pankti--check-process nil
+  "Running check server.")
+(defvar pankti--check-output ""
+  "Server output which is not a whole reply yet.")
+(defvar pankti--check-waiting nil
+  "Handlers of the replies the server owes, oldest first.")
+(defvar pankti--check-count 0
+  "Buffers given a name at the server so far.")
+
+(defvar-local pankti--check-name nil
+  "Name of the buffer at the server.")
+(defvar-local pankti--check-open nil
+  "Non-nil while the server has the text of the buffer.")
+(defvar-local pankti--check-old nil
+  "Region of the change being made, (BEG END START-LINE END-LINE).")
+(defvar-local pankti--check-edits nil
+  "Edits not sent yet, newest first, each (START END TEXT).")
+(defvar-local pankti--check-diags nil
+  "Last diagnostics of the server for the buffer.")
+
+(defun pankti-check-setup ()
+  "Check the buffer with Flymake and the Pankti check server."
+  (when (executable-find pankti-executable)
+    (setq pankti--check-name
+          (format "buffer-%d" (setq pankti--check-count
+                                    (1+ pankti--check-count))))
+    (add-hook 'before-change-functions #'pankti--check-before-change nil t)
+    (add-hook 'after-change-functions #'pankti--check-after-change nil t)
+    (add-hook 'kill-buffer-hook #'pankti--check-close nil t)
+    (add-hook 'flymake-diagnostic-functions #'pankti-flymake nil t)
+    (flymake-mode 1)))
+
+(defun pankti--check-end-line (pos)
+  "Line after the line holding POS, the way the server counts lines.
+The empty line after a final newline is not a line for the server."
+  (save-excursion
+    (goto-char pos)
+    (if (and (eobp) (bolp))
+        (line-number-at-pos pos t)
+      (1+ (line-number-at-pos pos t)))))
+
+(defun pankti--check-lines (beg end)
+  "Text of the whole lines holding BEG to END."
+  (save-excursion
+    (let ((from (progn (goto-char beg) (line-beginning-position)))
+          (to (progn (goto-char end) (min (point-max)
+                                          (1+ (line-end-position))))))
+      (buffer-substring-no-properties from to))))
+
+(defun pankti--check-before-change (beg end)
+  (when pankti--check-open
+    (save-restriction
+      (widen)
+      (setq pankti--check-old
+            (list beg end (line-number-at-pos beg t)
+                  (pankti--check-end-line end))))))
+
+(defun pankti--check-after-change (beg end len)
+  (when pankti--check-open
+    (let ((old pankti--check-old))
+      (setq pankti--check-old nil)
+      (if (or (null old) (< beg (nth 0 old)) (> (+ beg len) (nth 1 old)))
+          ;; change is not inside the region told before it, open again
+          (setq pankti--check-open nil)
+        (save-restriction
+          (widen)
+          (push (list (nth 2 old) (nth 3 old)
+                      (pankti--check-lines
+                       (nth 0 old) (+ (nth 1 old) (- end beg len))))
+                pankti--check-edits))))))
+
+(defun pankti--check-server ()
+  "Check server, started if it is not running."
+  (unless (process-live-p pankti--check-process)
+    (setq pankti--check-output "")
+    (setq pankti--check-waiting nil)
+    (setq pankti--check-process
+          (make-process
+           :name "pankti-check"
+           :command (list pankti-executable "--check-server")
+           :coding 'utf-8-unix
+           :connection-type 'pipe
+           :noquery t
+           :filter #'pankti--check-filter
+           :sentinel #'pankti--check-sentinel)))
+  pankti--check-process)
+
+(defun pankti--check-sentinel (_proc _event)
+  ;; a new server has none of the buffers
+  (setq pankti--check-waiting nil)
+  (dolist (buffer (buffer-list))
+    (with-current-buffer buffer
+      (when pankti--check-name
+        (setq pankti--check-open nil)))))
+
+(defun pankti--check-send (header text handler)
+  "Send command HEADER with TEXT, HANDLER gets its reply."
+  (let ((proc (pankti--check-server)))
+    (setq pankti--check-waiting (append pankti--check-waiting (list handler)))
+    (process-send-string
+     proc
+     (format "%s %d\n%s" header
+             (length (encode-coding-string text 'utf-8-unix)) text))))
+
+(defun pankti--check-reply ()
+  "Take the first whole reply out of the server output.
+It is (error MESSAGE) or (diagnostics LINES), nil if there is none yet."
+  (let ((lines (split-string pankti--check-output "\n")))
+    (when (cdr lines)
+      (let ((head (car lines)))
+        (cond
+         ((string-prefix-p "error " head)
+          (setq pankti--check-output
+                (substring pankti--check-output (1+ (length head))))
+          (list 'error (substring head 6)))
+         ((string-match "\\`diagnostics [^ ]+ \\([0-9]+\\)\\'" head)
+          (let ((count (string-to-number (match-string 1 head))))
+            ;; last item is the line not ended yet
+            (when (> (length lines) (1+ count))
+              (let ((diags (cl-subseq lines 1 (1+ count))))
+                (setq pankti--check-output
+                      (mapconcat #'identity (nthcdr (1+ count) lines) "\n"))
+                (list 'diagnostics diags)))))
+         (t
+          (setq pankti--check-output
+                (substring pankti--check-output (1+ (length head))))
+          (list 'error head)))))))
+
+(defun pankti--check-filter (_proc output)
+  (setq pankti--check-output (concat pankti--check-output output))
+  (let (reply)
+    (while (setq reply (pankti--check-reply))
+      (let ((handler (pop pankti--check-waiting)))
+        (when handler
+          (funcall handler reply))))))
+
+(defun pankti--check-diagnostic (line)
+  "Flymake diagnostic of server diagnostic LINE in the current buffer."
+  (when (string-match
+         "\\`\\([0-9]+\\) \\([0-9]+\\) \\([0-9]+\\) [^ ]+ \\(.*\\)\\'" line)
+    (let ((row (string-to-number (match-string 1 line)))
+          (col (string-to-number (match-string 2 line)))
+          (len (string-to-number (match-string 3 line)))
+          (msg (match-string 4 line)))
+      (save-excursion
+        (save-restriction
+          (widen)
+          (goto-char (point-min))
+          (forward-line (1- row))
+          ;; columns and lengths are in bytes
+          (let* ((bol (position-bytes (point)))
+                 (beg (or (byte-to-position (+ bol col -1)) (point-max)))
+                 (end (or (byte-to-position (+ bol col len -1)) (point-max))))
+            (when (<= end beg)
+              (setq beg (max (point-min) (min beg (1- (point-max)))))
+              (setq end (min (point-max) (1+ beg))))
+            (flymake-make-diagnostic (current-buffer) beg end :error msg)))))))
+
+(defun pankti--check-handler (buffer report-fn &optional opening)
+  "Handler of a reply for BUFFER, REPORT-FN is given the diagnostics.
+OPENING is non-nil for the reply of opening the buffer."
+  (lambda (reply)
+    (when (buffer-live-p buffer)
+      (with-current-buffer buffer
+        (if (eq (car reply) 'error)
+            (setq pankti--check-open nil)
+          (setq pankti--check-diags (cadr reply)))
+        (cond
+         ((null report-fn))
+         (pankti--check-open
+          (funcall report-fn
+                   (delq nil (mapcar #'pankti--check-diagnostic
+                                     pankti--check-diags))))
+         ((and opening (eq (car reply) 'error))
+          (funcall report-fn :panic :explanation (cadr reply)))
+         (t
+          ;; an edit failed, the server has other text than the buffer
+          (pankti--check-send-open report-fn)))))))
+
+(defun pankti--check-send-open (report-fn)
+  (save-restriction
+    (widen)
+    (setq pankti--check-open t)
+    (setq pankti--check-edits nil)
+    (pankti--check-send
+     (format "open %s" pankti--check-name)
+     (buffer-substring-no-properties (point-min) (point-max))
+     (pankti--check-handler (current-buffer) report-fn t))))
+
+(defun pankti-flymake (report-fn &rest _args)
+  "Flymake backend checking the buffer with the Pankti check server."
+  (cond
+   ((not pankti--check-open)
+    (pankti--check-send-open report-fn))
+   ((null pankti--check-edits)
+    (funcall report-fn (delq nil (mapcar #'pankti--check-diagnostic
+                                         pankti--check-diags))))
+   (t
+    (let ((edits (reverse pankti--check-edits)))
+      (setq pankti--check-edits nil)
+      (while edits
+        (let ((edit (pop edits)))
+          (pankti--check-send
+           (format "change %s %d %d"
+                   pankti--check-name (nth 0 edit) (nth 1 edit))
+           (nth 2 edit)
+           (pankti--check-handler (current-buffer)
+                                  (and (null edits) report-fn)))))))))
+
+(defun pankti--check-close ()
+  (when (and pankti--check-open (process-live-p pankti--check-process))
+    (setq pankti--check-open nil)
+    ;; answered only if the server doesn't have the file
+    (process-send-string pankti--check-process
+                         (format "close %s\n" pankti--check-name))))
+
 (provide 'pankti-emacs-mode)
@@ -18,6 +18,7 @@ echo "==== Begin Running Pankti Benchmarks ===="
 
 hyperfine --warmup 3 \
 	"$PANKTI_BIN $SAMPLES_DIR/array.pn" \
+	"$PANKTI_BIN $SAMPLES_DIR/array_num.pn" \
 	"$PANKTI_BIN $SAMPLES_DIR/fib.pn" \
 	"$PANKTI_BIN $SAMPLES_DIR/loop.pn" \
 	"$PANKTI_BIN $SAMPLES_DIR/nestcall.pn" \
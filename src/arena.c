@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "arena.h"
+#include "alloc.h"
+#include <stddef.h>
+#include <string.h>
+
+static PArenaChunk *newChunk(u64 cap) {
+    PArenaChunk *chunk = PMalloc(sizeof(PArenaChunk) + cap);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->used = 0;
+    chunk->cap = cap;
+    return chunk;
+}
+
+PArena *NewArena(void) {
+    PArena *arena = PCreate(PArena);
+    if (arena == NULL) {
+        return NULL;
+    }
+    arena->chunks = NULL;
+    arena->size = 0;
+    return arena;
+}
+
+void FreeArena(PArena *arena) {
+    if (arena == NULL) {
+        return;
+    }
+    PArenaChunk *chunk = arena->chunks;
+    while (chunk != NULL) {
+        PArenaChunk *next = chunk->next;
+        PFree(chunk);
+        chunk = next;
+    }
+    PFree(arena);
+}
+
+void *ArenaAlloc(PArena *arena, u64 size) {
+    size = (size + ARENA_ALIGN - 1) & ~(u64)(ARENA_ALIGN - 1);
+    PArenaChunk *chunk = arena->chunks;
+    if (chunk == NULL || chunk->cap - chunk->used < size) {
+        if (size > ARENA_CHUNK_SIZE / 4) {
+            // Large allocations get a chunk of their own, which goes after
+            // the current one so the space left in it is still used
+            PArenaChunk *big = newChunk(size);
+            if (big == NULL) {
+                return NULL;
+            }
+            big->used = size;
+            if (chunk == NULL) {
+                arena->chunks = big;
+            } else {
+                big->next = chunk->next;
+                chunk->next = big;
+            }
+            arena->size += size;
+            return big->data;
+        }
+
+        chunk = newChunk(ARENA_CHUNK_SIZE);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    void *ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->size += size;
+    return ptr;
+}
+
+void *ArenaCopy(PArena *arena, const void *src, u64 size) {
+    void *ptr = ArenaAlloc(arena, size);
+    if (ptr == NULL) {
+        return NULL;
+    }
+    if (size > 0) {
+        memcpy(ptr, src, (size_t)size);
+    }
+    return ptr;
+}
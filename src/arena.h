@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_ARENA_H
+#define PANKTI_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ptypes.h"
+
+#ifndef ARENA_CHUNK_SIZE
+// Default size of a chunk in bytes
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#endif
+
+// Alignment of every allocation, enough for any of the AST and token structs
+#define ARENA_ALIGN 16
+
+// A chunk of arena memory
+typedef struct PArenaChunk {
+    struct PArenaChunk *next;
+    // Bytes used of `data`
+    u64 used;
+    // Size of `data`
+    u64 cap;
+    // Padding so `data` is aligned
+    u64 pad;
+    u8 data[];
+} PArenaChunk;
+
+// Bump Pointer Arena
+// Memory is taken from the current chunk by moving a pointer forward and is
+// never freed one by one, all of it is released with `FreeArena`. Tokens, AST
+// nodes and their child arrays live until the program is compiled, so they are
+// allocated from the arena owned by Pankti Core
+typedef struct PArena {
+    // Linked list of chunks, first one is where allocations go
+    PArenaChunk *chunks;
+    // Total bytes allocated
+    u64 size;
+} PArena;
+
+// Create new empty Arena
+PArena *NewArena(void);
+// Free the Arena and everything allocated from it
+void FreeArena(PArena *arena);
+// Allocate `size` bytes from the arena. Returns NULL on failure
+void *ArenaAlloc(PArena *arena, u64 size);
+// Copy `size` bytes of `src` to the arena. Returns NULL on failure
+void *ArenaCopy(PArena *arena, const void *src, u64 size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,7 +20,12 @@
  * + english-num: Instead of printing bengali numbers when printing values, it
  * will print english/arabic numbers.
  *
- * In release mode, only help and version flags are enabled.
+ * In release mode, only help, version, engine, check-server and repl flags
+ * are enabled.
+ * + engine: select the execution engine, `stack` (default) or `register`.
+ * + check-server: serve diagnostics to an editor instead of running a script.
+ * + repl: read and run chunks of code from stdin, keeping globals between
+ * them.
  * Though flags can be set using environment variables, but those are not
  * handled here.
  *
@@ -32,6 +37,7 @@
 #include "version.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #define OPTPARSE_IMPLEMENTATION
 #define OPTPARSE_API static
@@ -39,14 +45,17 @@
 
 #if defined(PANKTI_BUILD_DEBUG)
 #include "flags.h"
-#define PANKTI_SHORT_ARGS "hvLPBTGSE"
+#define PANKTI_SHORT_ARGS "hve:ciLPBTGSE"
 #else
-#define PANKTI_SHORT_ARGS "hv"
+#define PANKTI_SHORT_ARGS "hve:ci"
 #endif
 
 static const struct optparse_long PANKTI_LONG_OPTS[] = {
     {"help", 'h', OPTPARSE_NONE},
     {"version", 'v', OPTPARSE_NONE},
+    {"engine", 'e', OPTPARSE_REQUIRED},
+    {"check-server", 'c', OPTPARSE_NONE},
+    {"repl", 'i', OPTPARSE_NONE},
 
 #if defined(PANKTI_BUILD_DEBUG)
     {"debug-lexer", 'L', OPTPARSE_NONE},
@@ -72,6 +81,9 @@ PanArgsResult ParsePanArgs(int argc, char **argv, PanktiArgs *out) {
     out->scriptPath = NULL;
     out->scriptArgs = NULL;
     out->scriptArgCount = 0;
+    out->regEngine = false;
+    out->checkServer = false;
+    out->repl = false;
 
     const struct optparse_long *longopts = PANKTI_LONG_OPTS;
 
@@ -92,6 +104,29 @@ PanArgsResult ParsePanArgs(int argc, char **argv, PanktiArgs *out) {
                 return PARGS_EXIT_OK;
             }
 
+            case 'e': {
+                if (strcmp(opts.optarg, "register") == 0) {
+                    out->regEngine = true;
+                } else if (strcmp(opts.optarg, "stack") == 0) {
+                    out->regEngine = false;
+                } else {
+                    PanFPrint(stderr, "Unknown engine : '%s'\n", opts.optarg);
+                    PrintPanktiHelp();
+                    return PARGS_EXIT_ERR;
+                }
+                break;
+            }
+
+            case 'c': {
+                out->checkServer = true;
+                break;
+            }
+
+            case 'i': {
+                out->repl = true;
+                break;
+            }
+
 #if defined(PANKTI_BUILD_DEBUG)
 
             case 'L': {
@@ -148,7 +183,7 @@ PanArgsResult ParsePanArgs(int argc, char **argv, PanktiArgs *out) {
         }
     }
 
-    if (out->scriptPath == NULL) {
+    if (out->scriptPath == NULL && !out->checkServer && !out->repl) {
         PrintPanktiHelp();
         return PARGS_EXIT_OK;
     }
@@ -166,10 +201,18 @@ static const char *HelpInfo =
     "   pankti [options] [script.pn] [-- script-args]\n\n"
     "Options:\n"
     "   -h, --help              Show this help message\n"
-    "   -v, --version           Show version information\n\n"
+    "   -v, --version           Show version information\n"
+    "   -e, --engine <name>     Execution engine, `stack` (default) or\n"
+    "                           `register`\n"
+    "   -c, --check-server      Report diagnostics of files sent by an\n"
+    "                           editor on stdin, see `src/check.h`\n"
+    "   -i, --repl              Read and run code from stdin, chunk by\n"
+    "                           chunk, in one session\n\n"
     "Examples:\n"
     "   pankti script.pn\n"
     "   pankti --version\n"
+    "   pankti --engine register script.pn\n"
+    "   pankti --repl\n"
 #if defined(PANKTI_BUILD_DEBUG)
     "\n"
     "Debug Options (debug builds only):\n"
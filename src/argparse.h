@@ -9,6 +9,8 @@
 #ifndef PANKTI_ARGPARSE_H
 #define PANKTI_ARGPARSE_H
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -24,6 +26,12 @@ typedef struct PanktiArgs {
     const char *evalCode;
     char **scriptArgs;
     int scriptArgCount;
+    // Run with register engine instead of stack engine
+    bool regEngine;
+    // Serve editor check commands instead of running a script
+    bool checkServer;
+    // Read and run chunks of code from stdin in one session, see `repl.h`
+    bool repl;
 } PanktiArgs;
 
 PanArgsResult ParsePanArgs(int argc, char **argv, PanktiArgs *out);
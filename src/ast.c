@@ -18,6 +18,7 @@
 #include "terminal.h"
 #include "token.h"
 #include <stddef.h>
+#include <string.h>
 #include <stdio.h>
 
 static char *LiteralTypeToStr(ExpLitType type) {
@@ -43,8 +44,9 @@ void AstPrintLiteral(PExpr *expr) {
     struct ELiteral *lit = &expr->exp.ELiteral;
 
     PanFPrint(
-        stdout, "%s%s(%s%s%s)%s", TermYellow(), LiteralTypeToStr(lit->type),
-        TermReset(), lit->op->lexeme, TermYellow(), TermReset()
+        stdout, "%s%s(%s%.*s%s)%s", TermYellow(), LiteralTypeToStr(lit->type),
+        TermReset(), (int)lit->op->len, lit->op->lexeme, TermYellow(),
+        TermReset()
     );
     PanPrint("\n");
 }
@@ -103,10 +105,10 @@ void AstPrint(PExpr *expr, int indent) {
         case EXPR_VARIABLE: {
             PanPrint(
                 "%sVar(%s"
-                "%s"
+                "%.*s"
                 "%s)%s\n",
-                TermRed(), TermGreen(), expr->exp.EVariable.name->lexeme,
-                TermRed(), TermReset()
+                TermRed(), TermGreen(), (int)expr->exp.EVariable.name->len,
+                expr->exp.EVariable.name->lexeme, TermRed(), TermReset()
             );
 
             break;
@@ -223,15 +225,16 @@ void AstPrint(PExpr *expr, int indent) {
             printIndent(indent + 1);
             PanPrint("}\n");
             printIndent(indent + 1);
-            char *childName = NULL;
-            if (mg->child != NULL) {
+            const char *childName = "<error>";
+            int childLen = (int)strlen(childName);
+            if (mg->child != NULL && mg->child->lexeme != NULL) {
                 childName = mg->child->lexeme;
+                childLen = (int)mg->child->len;
             }
             PanPrint(
                 "Child("
-                "%s%s%s)\n",
-                TermGreen(), childName != NULL ? childName : "<error>",
-                TermReset()
+                "%s%.*s%s)\n",
+                TermGreen(), childLen, childName, TermReset()
             );
             printIndent(indent);
             PanPrint("}\n");
@@ -264,9 +267,10 @@ void AstStmtPrint(PStmt *stmt, int indent) {
         case STMT_LET: {
             PanPrint(
                 "Let ("
-                "%s%s%s"
+                "%s%.*s%s"
                 ") [\n",
-                TermGreen(), stmt->stmt.SLet.name->lexeme, TermReset()
+                TermGreen(), (int)stmt->stmt.SLet.name->len,
+                stmt->stmt.SLet.name->lexeme, TermReset()
             );
 
             AstPrint(stmt->stmt.SLet.expr, indent + 1);
@@ -276,7 +280,7 @@ void AstStmtPrint(PStmt *stmt, int indent) {
         }
         case STMT_BLOCK: {
             PanPrint("Block [\n");
-            for (long i = 0; i < arrlen(stmt->stmt.SBlock.stmts); i++) {
+            for (u64 i = 0; i < stmt->stmt.SBlock.count; i++) {
                 AstStmtPrint(stmt->stmt.SBlock.stmts[i], indent + 1);
             }
             printIndent(indent);
@@ -345,13 +349,15 @@ void AstStmtPrint(PStmt *stmt, int indent) {
 
             PanPrint(
                 "Func("
-                "%s%s%s"
+                "%s%.*s%s"
                 ") <",
-                TermGreen(), fn->name->lexeme, TermReset()
+                TermGreen(), (int)fn->name->len, fn->name->lexeme, TermReset()
             );
             PanPrint(TermGreen());
             for (u64 i = 0; i < fn->paramCount; i++) {
-                PanPrint("%s", fn->params[i]->lexeme);
+                PanPrint(
+                    "%.*s", (int)fn->params[i]->len, fn->params[i]->lexeme
+                );
                 if (i != fn->paramCount - 1) {
                     PanPrint("%s, %s", TermReset(), TermGreen());
                 }
@@ -366,9 +372,10 @@ void AstStmtPrint(PStmt *stmt, int indent) {
             struct SImport *import = &stmt->stmt.SImport;
             PanPrint(
                 "Import("
-                "%s%s%s"
+                "%s%.*s%s"
                 ") ",
-                TermGreen(), import->name->lexeme, TermReset()
+                TermGreen(), (int)import->name->len, import->name->lexeme,
+                TermReset()
             );
             PanPrint("{\n");
             AstPrint(import->path, indent + 2);
@@ -230,7 +230,6 @@ typedef struct PStmt {
     PStmtType type;
     // Common operator
     Token *op;
-    struct PStmt *next;
     union stmt {
         // `Temporary` Print Statement (for Debugging only)
         // Type: `STMT_DEBUG`
@@ -265,6 +264,8 @@ typedef struct PStmt {
             Token *op;
             // Statement array
             struct PStmt **stmts;
+            // Number of statements
+            u64 count;
         } SBlock;
 
         // If Statement : Conditional if statement
@@ -80,7 +80,7 @@ static PValue builtinType(PVm *vm, PValue *args, u64 argc) {
         VmError(vm, RT_IME_BUILTIN_TYPE_STRDUP);
         return MakeNil();
     }
-    PObj *typeStrObj = NewStrObject(vm->gc, NULL, typeNameMlcd, true);
+    PObj *typeStrObj = NewStrObject(vm->gc, typeNameMlcd, true);
     if (typeStrObj == NULL) {
         VmError(vm, RT_IME_BUILTIN_TYPE_STRRETURN);
         return MakeNil();
@@ -100,7 +100,7 @@ static PValue builtinLen(PVm *vm, PValue *args, u64 argc) {
         VmError(vm, RT_BUILTIN_LEN_INVALID_TYPE, ValueTypeToStr(target));
         return MakeNil();
     }
-    return MakeNumber(GetObjectLength(targetObj));
+    return MakeIntOrNumber(GetObjectLength(targetObj));
 }
 
 static PValue builtinAppend(PVm *vm, PValue *args, u64 argc) {
@@ -120,7 +120,7 @@ static PValue builtinAppend(PVm *vm, PValue *args, u64 argc) {
         }
     }
 
-    return MakeNumber((double)obj->v.OArray.count);
+    return MakeIntOrNumber((double)obj->v.OArray.count);
 }
 
 static PValue builtinError(PVm *vm, PValue *args, u64 argc) {
@@ -155,7 +155,7 @@ static PValue builtinGetArgs(PVm *vm, PValue *args, u64 argc) {
 
     PValue *items = NULL;
     for (int i = 0; i < sargCount; i++) {
-        PObj *strObj = NewStrObject(vm->gc, NULL, sargs[i], false);
+        PObj *strObj = NewStrObject(vm->gc, sargs[i], false);
         if (strObj == NULL) {
             arrfree(items); // GC will handle orphaned objects, just free array
             VmError(vm, RT_IME_BUILTIN_ARGS_ARRAY_ITEM_CREATE_FAILED);
@@ -190,7 +190,7 @@ static PValue builtinReadline(PVm *vm, PValue *args, u64 argc) {
         return MakeNil();
     }
 
-    PObj *resStrObj = NewStrObject(vm->gc, NULL, result, true);
+    PObj *resStrObj = NewStrObject(vm->gc, result, true);
 
     if (resStrObj == NULL) {
         VmError(vm, RT_IME_BUILTIN_READLINE_RESULT);
@@ -201,6 +201,22 @@ static PValue builtinReadline(PVm *vm, PValue *args, u64 argc) {
     return MakeObject(resStrObj);
 }
 
+bool BuiltinIntrinsic(const char *name, u64 argc, PanOpCode *op) {
+    if (argc == 1 && (StrEqual(name, NAME_LEN_EN) ||
+                      StrEqual(name, NAME_LEN_BN) ||
+                      StrEqual(name, NAME_LEN_PN))) {
+        *op = OP_LEN;
+        return true;
+    }
+    if (argc == 2 && (StrEqual(name, NAME_APPEND_EN) ||
+                      StrEqual(name, NAME_APPEND_BN) ||
+                      StrEqual(name, NAME_APPEND_PN))) {
+        *op = OP_APPEND;
+        return true;
+    }
+    return false;
+}
+
 void RegisterBuiltins(PVm *vm) {
     if (vm == NULL) {
         return;
@@ -210,35 +226,39 @@ void RegisterBuiltins(PVm *vm) {
         return;
     }
 
-    StdlibEntry builtinEntries[] = {
-        MakeStdlibEntry(NAME_CLOCK_EN, builtinClock, 0),
-        MakeStdlibEntry(NAME_CLOCK_BN, builtinClock, 0),
-        MakeStdlibEntry(NAME_CLOCK_PN, builtinClock, 0),
-        MakeStdlibEntry(NAME_SHOW_EN, builtinShow, -1),
-        MakeStdlibEntry(NAME_SHOW_BN, builtinShow, -1),
-        MakeStdlibEntry(NAME_SHOW_PN, builtinShow, -1),
-        MakeStdlibEntry(NAME_TYPE_EN, builtinType, 1),
-        MakeStdlibEntry(NAME_TYPE_BN, builtinType, 1),
-        MakeStdlibEntry(NAME_TYPE_PN, builtinType, 1),
-        MakeStdlibEntry(NAME_LEN_EN, builtinLen, 1),
-        MakeStdlibEntry(NAME_LEN_BN, builtinLen, 1),
-        MakeStdlibEntry(NAME_LEN_PN, builtinLen, 1),
-        MakeStdlibEntry(NAME_APPEND_EN, builtinAppend, 2),
-        MakeStdlibEntry(NAME_APPEND_BN, builtinAppend, 2),
-        MakeStdlibEntry(NAME_APPEND_PN, builtinAppend, 2),
-        MakeStdlibEntry(NAME_ERROR_EN, builtinError, 1),
-        MakeStdlibEntry(NAME_ERROR_BN, builtinError, 1),
-        MakeStdlibEntry(NAME_ERROR_PN, builtinError, 1),
-        MakeStdlibEntry(NAME_ARGS_EN, builtinGetArgs, 0),
-        MakeStdlibEntry(NAME_ARGS_BN, builtinGetArgs, 0),
-        MakeStdlibEntry(NAME_ARGS_PN, builtinGetArgs, 0),
-        MakeStdlibEntry(NAME_READLINE_EN, builtinReadline, 1),
-        MakeStdlibEntry(NAME_READLINE_BN, builtinReadline, 1),
-        MakeStdlibEntry(NAME_READLINE_PN, builtinReadline, 1),
+    static StdlibEntry builtinEntries[] = {
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_CLOCK_EN, builtinClock, 0),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_CLOCK_BN, builtinClock, 0),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_CLOCK_PN, builtinClock, 0),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_SHOW_EN, builtinShow, -1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_SHOW_BN, builtinShow, -1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_SHOW_PN, builtinShow, -1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_TYPE_EN, builtinType, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_TYPE_BN, builtinType, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_TYPE_PN, builtinType, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_LEN_EN, builtinLen, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_LEN_BN, builtinLen, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_LEN_PN, builtinLen, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_APPEND_EN, builtinAppend, 2),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_APPEND_BN, builtinAppend, 2),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_APPEND_PN, builtinAppend, 2),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ERROR_EN, builtinError, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ERROR_BN, builtinError, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ERROR_PN, builtinError, 1),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ARGS_EN, builtinGetArgs, 0),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ARGS_BN, builtinGetArgs, 0),
+        MakeStdlibEntry(BUILTIN_MODULE_NAME, NAME_ARGS_PN, builtinGetArgs, 0),
+        MakeStdlibEntry(
+            BUILTIN_MODULE_NAME, NAME_READLINE_EN, builtinReadline, 1
+        ),
+        MakeStdlibEntry(
+            BUILTIN_MODULE_NAME, NAME_READLINE_BN, builtinReadline, 1
+        ),
+        MakeStdlibEntry(
+            BUILTIN_MODULE_NAME, NAME_READLINE_PN, builtinReadline, 1
+        ),
     };
 
     u64 count = ArrCount(builtinEntries);
-    PushStdlibEntries(
-        vm, vm->globals, BUILTIN_MODULE_NAME, builtinEntries, count
-    );
+    PushStdlibEntries(vm, vm->globals, builtinEntries, count);
 }
@@ -9,11 +9,17 @@
 #ifndef PANKTI_BUILTINS_H
 #define PANKTI_BUILTINS_H
 
+#include "opcode.h"
+#include "ptypes.h"
+#include <stdbool.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
 typedef struct PVm PVm;
 void RegisterBuiltins(PVm *vm);
+// Intrinsic opcode the compiler can emit for a call of builtin `name` with
+// `argc` arguments. Returns false if there is none
+bool BuiltinIntrinsic(const char *name, u64 argc, PanOpCode *op);
 #ifdef __cplusplus
 }
 #endif
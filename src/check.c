@@ -0,0 +1,910 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "check.h"
+#include "alloc.h"
+#include "diagonctx.h"
+#include "lexer.h"
+#include "parser.h"
+#include "printer.h"
+#include "utils.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "external/stb/stb_ds.h"
+
+// Line of diagnostics reported without a token
+#define CHECK_NO_LINE UINT32_MAX
+// Longest command line of the check server
+#define CHECK_CMD_SIZE 4096
+// Longest number of a command line, with the NUL
+#define CHECK_NUM_SIZE 32
+
+// Number of lines in `text`, the last one may not end with a newline
+static u32 countLines(const char *text, u64 len) {
+    u32 count = 0;
+    const char *c = text;
+    const char *end = text + len;
+    while (c < end && (c = memchr(c, '\n', (size_t)(end - c))) != NULL) {
+        count++;
+        c++;
+    }
+
+    if (len > 0 && text[len - 1] != '\n') {
+        count++;
+    }
+
+    return count;
+}
+
+// Offset of the start of `line` (0 based) in `text`, `len` if there are fewer
+// lines
+static u64 lineOffset(const char *text, u64 len, u64 line) {
+    const char *c = text;
+    const char *end = text + len;
+    for (u64 i = 0; i < line; i++) {
+        c = memchr(c, '\n', (size_t)(end - c));
+        if (c == NULL) {
+            return len;
+        }
+        c++;
+    }
+
+    return (u64)(c - text);
+}
+
+// Line the token ends on, strings can span lines
+static u32 tokenEndLine(const Token *tok) {
+    u32 line = tok->line;
+    if (tok->type != T_STR || tok->lexeme == NULL) {
+        return line;
+    }
+
+    const char *c = tok->lexeme;
+    const char *end = tok->lexeme + tok->len;
+    while (c < end && (c = memchr(c, '\n', (size_t)(end - c))) != NULL) {
+        line++;
+        c++;
+    }
+
+    return line;
+}
+
+// Is `tok` a string without its closing quote before the end of `text`
+static bool openString(const Token *tok, const char *text, u64 len) {
+    if (tok->type != T_STR || tok->lexeme == NULL) {
+        return false;
+    }
+
+    const char *c = tok->lexeme;
+    const char *end = text + len;
+    while (c < end) {
+        if (*c == '"') {
+            return false;
+        }
+        // escape, the next character can't end the string
+        if (*c == '\\') {
+            c++;
+        }
+        c++;
+    }
+
+    return true;
+}
+
+// Append `len` bytes of `src` to stb_ds array `buf`
+static void appendBytes(char **buf, const char *src, u64 len) {
+    if (len == 0) {
+        return;
+    }
+    char *dst = arraddnptr(*buf, len);
+    memcpy(dst, src, len);
+}
+
+static void appendUnit(char **buf, const PCheckUnit *unit) {
+    appendBytes(buf, unit->seg->text + unit->textStart, unit->textLen);
+}
+
+// End `buf` with a newline if it has text
+static void endWithNewline(char **buf) {
+    u64 len = arrlen(*buf);
+    if (len > 0 && (*buf)[len - 1] != '\n') {
+        arrput(*buf, '\n');
+    }
+}
+
+// Copy stb_ds array `buf` to a NUL terminated string and free it
+static char *takeText(char *buf, u64 *len) {
+    *len = arrlen(buf);
+    char *text = PCalloc(*len + 1, sizeof(char));
+    if (text == NULL) {
+        arrfree(buf);
+        return NULL;
+    }
+
+    if (*len > 0) {
+        memcpy(text, buf, *len);
+    }
+    arrfree(buf);
+    return text;
+}
+
+// `text` is owned by the segment
+static PCheckSegment *newSegment(char *text) {
+    PCheckSegment *seg = PCreate(PCheckSegment);
+    if (seg == NULL) {
+        return NULL;
+    }
+
+    seg->arena = NewArena();
+    if (seg->arena == NULL) {
+        PFree(seg);
+        return NULL;
+    }
+    seg->text = text;
+    seg->refs = 0;
+    return seg;
+}
+
+static void freeSegment(PCheckSegment *seg) {
+    FreeArena(seg->arena);
+    PFree(seg->text);
+    PFree(seg);
+}
+
+static void releaseSegment(PCheckSegment *seg) {
+    seg->refs--;
+    if (seg->refs == 0) {
+        freeSegment(seg);
+    }
+}
+
+static void freeUnit(PCheckUnit *unit) {
+    for (u64 i = 0; i < arrlen(unit->diags); i++) {
+        PFree(unit->diags[i].msg);
+    }
+    arrfree(unit->diags);
+    arrfree(unit->tokens);
+    arrfree(unit->stmts);
+    releaseSegment(unit->seg);
+}
+
+// State of parsing a region of the file
+typedef struct CheckParse {
+    Parser *parser;
+    // Tokens of the region, then of the units after it up to one with tokens
+    Token **tokens;
+    // Tokens before it are of the region
+    u64 boundary;
+    // Tokens from `boundary` up to it are of the units after the region
+    u64 foreignEnd;
+    // stb_ds arrays, diagnostics and the statement each was reported in, -1
+    // for lexer
+    PCheckDiag *diags;
+    i64 *diagStmt;
+    i64 stmt;
+    // First token of the statement
+    u64 stmtStart;
+    // A diagnostic of the statement was reported at the token before it
+    bool readsPrev;
+    // 1 + furthest token position a diagnostic of the statement was reported
+    // at, 0 if none
+    u64 peek;
+} CheckParse;
+
+// Region statement
+typedef struct CheckStmt {
+    PStmt *stmt;
+    // Tokens `start` to `end - 1`
+    u64 start;
+    u64 end;
+    // Reported an error at the token after it, so it may change when the
+    // statement after it changes
+    bool readsNext;
+    // Reported an error at the token before it
+    bool readsPrev;
+} CheckStmt;
+
+static void collectDiag(void *ctx, Token *tok, PanDiagCode code, va_list args) {
+    CheckParse *cp = (CheckParse *)ctx;
+    const PanDiagInfo *info = DiagGetInfo(code);
+    char msgBuf[1024];
+
+    if (info->formatted) {
+        vsnprintf(msgBuf, sizeof(msgBuf), info->msg, args);
+    } else {
+        snprintf(msgBuf, sizeof(msgBuf), "%s", info->msg);
+    }
+
+    PCheckDiag diag = {
+        .line = CHECK_NO_LINE,
+        .col = 0,
+        .len = 0,
+        .code = code,
+        .msg = StrDuplicate(msgBuf, strlen(msgBuf)),
+    };
+
+    if (tok != NULL) {
+        diag.line = tok->line;
+        // end of file token is before the first column of its line
+        diag.col = tok->col > 0 ? tok->col : 1;
+        diag.len = tok->len > 0 ? tok->len : 1;
+
+        if (cp->parser != NULL) {
+            u64 pos = (u64)cp->parser->pos;
+            if (cp->tokens[pos] == tok && pos >= cp->peek) {
+                cp->peek = pos + 1;
+            }
+            if (cp->stmtStart > 0 && cp->tokens[cp->stmtStart - 1] == tok) {
+                cp->readsPrev = true;
+            }
+        }
+    }
+
+    arrput(cp->diags, diag);
+    arrput(cp->diagStmt, cp->stmt);
+}
+
+static int compareDiags(const void *a, const void *b) {
+    const PCheckDiag *x = (const PCheckDiag *)a;
+    const PCheckDiag *y = (const PCheckDiag *)b;
+    if (x->line != y->line) {
+        return x->line < y->line ? -1 : 1;
+    }
+    if (x->col != y->col) {
+        return x->col < y->col ? -1 : 1;
+    }
+    return 0;
+}
+
+// New unit of lines `startLine` to `endLine - 1` (1 based) of segment `seg`,
+// which has text of `len` bytes and starts at file line `firstLine`. `start`
+// is the offset of `startLine`, it is moved to the offset of `endLine`
+static PCheckUnit newUnit(
+    PCheckSegment *seg, u64 len, u64 *start, u32 firstLine, u32 startLine,
+    u32 endLine
+) {
+    u64 begin = *start;
+    u64 end = begin + lineOffset(
+                          seg->text + begin, len - begin, endLine - startLine
+                      );
+    *start = end;
+    seg->refs++;
+    return (PCheckUnit){
+        .seg = seg,
+        .textStart = begin,
+        .textLen = end - begin,
+        .firstLine = firstLine + startLine - 1,
+        .lineCount = endLine - startLine,
+        .segLine = startLine,
+        .tokens = NULL,
+        .stmts = NULL,
+        .diags = NULL,
+    };
+}
+
+// Cut the parsed region into units and put them in place of units `from` to
+// `to - 1` of `file`
+static void replaceUnits(
+    PCheckFile *file, u64 from, u64 to, PCheckSegment *seg, u64 len,
+    u32 firstLine, CheckParse *cp, CheckStmt *stmts
+) {
+    PCheckUnit *made = NULL;
+    u32 segLines = countLines(seg->text, len);
+    u64 stmtCount = arrlen(stmts);
+
+    if (segLines > 0) {
+        u32 startLine = 1;
+        u64 offset = 0;
+        u64 first = 0;
+        for (u64 k = 0; k < stmtCount; k++) {
+            bool last = k + 1 == stmtCount;
+            u32 endLine = segLines + 1;
+            if (!last) {
+                // Cut before the next statement if it starts on a line of its
+                // own and errors of neither depend on the other
+                const CheckStmt *s = &stmts[k];
+                const Token *next = cp->tokens[stmts[k + 1].start];
+                if (s->readsNext || stmts[k + 1].readsPrev ||
+                    s->end == s->start ||
+                    tokenEndLine(cp->tokens[s->end - 1]) >= next->line) {
+                    continue;
+                }
+                endLine = next->line;
+            }
+
+            PCheckUnit unit =
+                newUnit(seg, len, &offset, firstLine, startLine, endLine);
+            for (u64 i = first; i <= k; i++) {
+                arrput(unit.stmts, stmts[i].stmt);
+            }
+            for (u64 i = stmts[first].start; i < stmts[k].end; i++) {
+                arrput(unit.tokens, cp->tokens[i]);
+            }
+            arrput(made, unit);
+            startLine = endLine;
+            first = k + 1;
+        }
+
+        if (stmtCount == 0) {
+            PCheckUnit unit =
+                newUnit(seg, len, &offset, firstLine, 1, segLines + 1);
+            arrput(made, unit);
+        }
+    }
+
+    // Diagnostics go to the unit holding their line
+    for (u64 i = 0; i < arrlen(cp->diags); i++) {
+        PCheckDiag diag = cp->diags[i];
+        i64 s = cp->diagStmt[i];
+        if (diag.line == CHECK_NO_LINE && s >= 0) {
+            const Token *tok = cp->tokens[stmts[s].start];
+            diag.line = tok->line;
+            diag.col = tok->col > 0 ? tok->col : 1;
+            diag.len = tok->len > 0 ? tok->len : 1;
+        }
+
+        if (arrlen(made) == 0) {
+            PFree(diag.msg);
+            continue;
+        }
+
+        u64 u = 0;
+        u64 hi = arrlen(made);
+        while (hi - u > 1) {
+            u64 mid = u + (hi - u) / 2;
+            if (made[mid].segLine <= diag.line) {
+                u = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        diag.line = diag.line > made[u].segLine ? diag.line - made[u].segLine
+                                                : 0;
+        arrput(made[u].diags, diag);
+    }
+
+    for (u64 i = 0; i < arrlen(made); i++) {
+        if (arrlen(made[i].diags) > 1) {
+            qsort(
+                made[i].diags, arrlen(made[i].diags), sizeof(PCheckDiag),
+                compareDiags
+            );
+        }
+    }
+
+    for (u64 i = from; i < to; i++) {
+        freeUnit(&file->units[i]);
+    }
+    if (to > from) {
+        arrdeln(file->units, from, to - from);
+    }
+    if (arrlen(made) > 0) {
+        arrinsn(file->units, from, arrlen(made));
+        memcpy(&file->units[from], made, arrlen(made) * sizeof(PCheckUnit));
+    }
+
+    // Units after the region only move
+    for (u64 i = from + arrlen(made); i < arrlen(file->units); i++) {
+        file->units[i].firstLine =
+            i == 0 ? 1
+                   : file->units[i - 1].firstLine + file->units[i - 1].lineCount;
+    }
+
+    u64 unitCount = arrlen(file->units);
+    file->lineCount = 0;
+    if (unitCount > 0) {
+        const PCheckUnit *lastUnit = &file->units[unitCount - 1];
+        file->lineCount = lastUnit->firstLine + lastUnit->lineCount - 1;
+    }
+
+    arrfree(made);
+    if (seg->refs == 0) {
+        freeSegment(seg);
+    }
+}
+
+static void freeCheckParse(CheckParse *cp, bool freeMsgs) {
+    if (freeMsgs) {
+        for (u64 i = 0; i < arrlen(cp->diags); i++) {
+            PFree(cp->diags[i].msg);
+        }
+    }
+    arrfree(cp->diags);
+    arrfree(cp->diagStmt);
+    arrfree(cp->tokens);
+}
+
+// Lex and parse `text` of `len` bytes, which replaces units `from` to
+// `to - 1` of `file` and starts at file line `firstLine`. `text` is owned by
+// the new units
+static bool reparse(
+    PCheckFile *file, u64 from, u64 to, char *text, u64 len, u32 firstLine
+) {
+    u64 grow = 1;
+    while (true) {
+        PCheckSegment *seg = newSegment(text);
+        if (seg == NULL) {
+            PFree(text);
+            return false;
+        }
+
+        CheckParse cp = {0};
+        cp.stmt = -1;
+        Lexer *lx = NewLexer(seg->text, seg->arena);
+        if (lx == NULL) {
+            freeSegment(seg);
+            return false;
+        }
+        MakeLexerRaw(lx, true);
+        lx->errCtx = (PDiagonCtx){.report = collectDiag, .ctx = &cp};
+        ScanTokens(lx);
+
+        // The last statement of the region may read on into the units after
+        // it, so the parser sees their tokens up to the first unit with any
+        u64 eof = arrlen(lx->tokens) - 1;
+        cp.boundary = eof;
+        arrsetcap(cp.tokens, eof + 1);
+        for (u64 i = 0; i < eof; i++) {
+            arrput(cp.tokens, lx->tokens[i]);
+        }
+        u64 next = to;
+        while (next < arrlen(file->units)) {
+            const PCheckUnit *unit = &file->units[next];
+            for (u64 i = 0; i < arrlen(unit->tokens); i++) {
+                arrput(cp.tokens, unit->tokens[i]);
+            }
+            if (arrlen(unit->tokens) > 0) {
+                break;
+            }
+            next++;
+        }
+        cp.foreignEnd = arrlen(cp.tokens);
+        arrput(cp.tokens, lx->tokens[eof]);
+
+        Parser *parser = NewParser(seg->arena, lx);
+        if (parser == NULL) {
+            FreeLexer(lx);
+            freeCheckParse(&cp, true);
+            freeSegment(seg);
+            return false;
+        }
+        parser->tokens = cp.tokens;
+        parser->errCtx = (PDiagonCtx){.report = collectDiag, .ctx = &cp};
+        cp.parser = parser;
+
+        // A string left open runs on into the units after the region
+        bool straddles = eof > 0 && to < arrlen(file->units) &&
+                         openString(lx->tokens[eof - 1], seg->text, len);
+        if (straddles) {
+            next = to;
+        }
+
+        CheckStmt *stmts = NULL;
+        while (!straddles && !ParserAtEnd(parser) &&
+               (u64)parser->pos < cp.boundary) {
+            u64 start = (u64)parser->pos;
+            parser->hasError = false;
+            cp.stmt = (i64)arrlen(stmts);
+            cp.stmtStart = start;
+            cp.readsPrev = false;
+            cp.peek = 0;
+            PStmt *stmt = ParseStatement(parser);
+            u64 end = (u64)parser->pos;
+
+            if (end > cp.boundary ||
+                (cp.peek > cp.boundary && cp.peek <= cp.foreignEnd)) {
+                straddles = true;
+                break;
+            }
+
+            CheckStmt s = {
+                .stmt = stmt,
+                .start = start,
+                .end = end,
+                .readsNext = cp.peek > end,
+                .readsPrev = cp.readsPrev,
+            };
+            arrput(stmts, s);
+        }
+
+        FreeParser(parser);
+        FreeLexer(lx);
+
+        if (!straddles) {
+            replaceUnits(file, from, to, seg, len, firstLine, &cp, stmts);
+            arrfree(stmts);
+            freeCheckParse(&cp, false);
+            return true;
+        }
+
+        // A statement runs on into the units after the region, parse them
+        // together. Each retry takes twice the units of the one before, so a
+        // statement running on to the end of the file isn't parsed again for
+        // every unit
+        u64 newTo = to + grow > next + 1 ? to + grow : next + 1;
+        if (newTo > arrlen(file->units)) {
+            newTo = arrlen(file->units);
+        }
+        grow *= 2;
+
+        char *buf = NULL;
+        appendBytes(&buf, seg->text, len);
+        endWithNewline(&buf);
+        for (u64 i = to; i < newTo; i++) {
+            appendUnit(&buf, &file->units[i]);
+        }
+        to = newTo;
+        if (to < arrlen(file->units)) {
+            endWithNewline(&buf);
+        }
+
+        arrfree(stmts);
+        freeCheckParse(&cp, true);
+        freeSegment(seg);
+
+        text = takeText(buf, &len);
+        if (text == NULL) {
+            return false;
+        }
+    }
+}
+
+PCheckFile *NewCheckFile(const char *text, u64 len) {
+    PCheckFile *file = PCreate(PCheckFile);
+    if (file == NULL) {
+        return NULL;
+    }
+    file->units = NULL;
+    file->lineCount = 0;
+
+    char *copy = PCalloc(len + 1, sizeof(char));
+    if (copy == NULL) {
+        PFree(file);
+        return NULL;
+    }
+    if (len > 0) {
+        memcpy(copy, text, len);
+    }
+
+    if (!reparse(file, 0, 0, copy, len, 1)) {
+        FreeCheckFile(file);
+        return NULL;
+    }
+
+    return file;
+}
+
+void FreeCheckFile(PCheckFile *file) {
+    if (file == NULL) {
+        return;
+    }
+
+    for (u64 i = 0; i < arrlen(file->units); i++) {
+        freeUnit(&file->units[i]);
+    }
+    arrfree(file->units);
+    PFree(file);
+}
+
+// Index of the unit holding `line`, the last unit for lines after the file
+static u64 unitAt(const PCheckFile *file, u32 line) {
+    u64 lo = 0;
+    u64 hi = arrlen(file->units);
+    while (hi - lo > 1) {
+        u64 mid = lo + (hi - lo) / 2;
+        if (file->units[mid].firstLine <= line) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+bool CheckFileEdit(
+    PCheckFile *file, u32 start, u32 end, const char *text, u64 len
+) {
+    if (file == NULL || start < 1 || end < start ||
+        end > file->lineCount + 1) {
+        return false;
+    }
+
+    u64 count = arrlen(file->units);
+    u64 from = 0;
+    u64 to = 0;
+    if (count > 0) {
+        from = unitAt(file, start);
+        to = end > start ? unitAt(file, end - 1) + 1 : from + 1;
+        // The last statement before the edit may read on into it
+        while (from > 0) {
+            from--;
+            if (arrlen(file->units[from].tokens) > 0) {
+                break;
+            }
+        }
+    }
+
+    char *region = NULL;
+    for (u64 i = from; i < to; i++) {
+        appendUnit(&region, &file->units[i]);
+    }
+
+    u32 regionLine = count > 0 ? file->units[from].firstLine : 1;
+    u64 regionLen = arrlen(region);
+    u64 cutStart = lineOffset(region, regionLen, start - regionLine);
+    u64 cutEnd = lineOffset(region, regionLen, end - regionLine);
+
+    char *buf = NULL;
+    appendBytes(&buf, region, cutStart);
+    endWithNewline(&buf);
+    appendBytes(&buf, text, len);
+    if (cutEnd < regionLen) {
+        endWithNewline(&buf);
+    }
+    appendBytes(&buf, region + cutEnd, regionLen - cutEnd);
+    if (to < count) {
+        endWithNewline(&buf);
+    }
+    arrfree(region);
+
+    u64 newLen = 0;
+    char *newText = takeText(buf, &newLen);
+    if (newText == NULL) {
+        return false;
+    }
+
+    return reparse(file, from, to, newText, newLen, regionLine);
+}
+
+PCheckDiag *CheckFileDiags(const PCheckFile *file) {
+    PCheckDiag *diags = NULL;
+    for (u64 i = 0; i < arrlen(file->units); i++) {
+        const PCheckUnit *unit = &file->units[i];
+        for (u64 j = 0; j < arrlen(unit->diags); j++) {
+            PCheckDiag diag = unit->diags[j];
+            diag.line += unit->firstLine;
+            arrput(diags, diag);
+        }
+    }
+
+    return diags;
+}
+
+char *CheckFileText(const PCheckFile *file, u64 *len) {
+    char *buf = NULL;
+    for (u64 i = 0; i < arrlen(file->units); i++) {
+        appendUnit(&buf, &file->units[i]);
+    }
+
+    return takeText(buf, len);
+}
+
+// Open file of the check server
+typedef struct CheckOpenFile {
+    char *name;
+    PCheckFile *file;
+} CheckOpenFile;
+
+static i64 findOpenFile(const CheckOpenFile *files, const char *name) {
+    for (u64 i = 0; i < arrlen(files); i++) {
+        if (strcmp(files[i].name, name) == 0) {
+            return (i64)i;
+        }
+    }
+
+    return -1;
+}
+
+bool CheckPayloadLenValid(u64 len) { return len <= CHECK_PAYLOAD_MAX; }
+
+// Parse `word` of only decimal digits. False if it has other characters or
+// doesn't fit in a u64
+static bool parseNumber(const char *word, u64 *out) {
+    if (*word == '\0') {
+        return false;
+    }
+
+    u64 value = 0;
+    for (const char *c = word; *c != '\0'; c++) {
+        if (*c < '0' || *c > '9') {
+            return false;
+        }
+        u64 digit = (u64)(*c - '0');
+        if (value > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+
+    *out = value;
+    return true;
+}
+
+// Read `len` bytes of command payload from `in`, see `CheckPayloadLenValid`
+static char *readPayload(FILE *in, u64 len) {
+    char *text = PCalloc(len + 1, sizeof(char));
+    if (text == NULL) {
+        return NULL;
+    }
+
+    if (len > 0 && fread(text, 1, (size_t)len, in) != len) {
+        PFree(text);
+        return NULL;
+    }
+
+    return text;
+}
+
+// Read and drop `len` bytes of command payload from `in`. False if the input
+// ends before
+static bool skipPayload(FILE *in, u64 len) {
+    char buf[CHECK_CMD_SIZE];
+    while (len > 0) {
+        size_t n = len < sizeof(buf) ? (size_t)len : sizeof(buf);
+        if (fread(buf, 1, n, in) != n) {
+            return false;
+        }
+        len -= n;
+    }
+
+    return true;
+}
+
+static const char *diagKind(PanDiagCode code) {
+    switch (DiagGetInfo(code)->category) {
+        case PAN_DIAG_LEXER: return "lexer";
+        case PAN_DIAG_PARSER: return "parser";
+        case PAN_DIAG_COMPILER: return "compiler";
+        case PAN_DIAG_RUNTIME: return "runtime";
+        case PAN_DIAG_STRESCAPE: return "strescape";
+    }
+
+    return "parser";
+}
+
+static void printDiags(const char *name, const PCheckFile *file) {
+    PCheckDiag *diags = CheckFileDiags(file);
+    PanPrint(
+        "diagnostics %s %llu\n", name, (unsigned long long)arrlen(diags)
+    );
+    for (u64 i = 0; i < arrlen(diags); i++) {
+        PanPrint(
+            "%u %u %u %s %s\n", diags[i].line, diags[i].col, diags[i].len,
+            diagKind(diags[i].code), diags[i].msg
+        );
+    }
+    arrfree(diags);
+}
+
+static void serverError(const char *msg) { PanPrint("error %s\n", msg); }
+
+// Text of a command whose length is `word`, its `len` is set. NULL after
+// answering with the error if there is no text for the command. `stop` is set
+// if the commands after it can't be found, when the length is not a number or
+// the input ended
+static char *commandPayload(FILE *in, const char *word, u64 *len, bool *stop) {
+    if (!parseNumber(word, len)) {
+        serverError("bad length");
+        *stop = true;
+        return NULL;
+    }
+    if (!CheckPayloadLenValid(*len)) {
+        serverError("payload too large");
+        *stop = !skipPayload(in, *len);
+        return NULL;
+    }
+
+    char *text = readPayload(in, *len);
+    if (text == NULL) {
+        serverError("failed to read text");
+        *stop = true;
+    }
+    return text;
+}
+
+int ServeCheckCommands(FILE *in) {
+    CheckOpenFile *files = NULL;
+    char cmd[CHECK_CMD_SIZE];
+    char name[CHECK_CMD_SIZE];
+
+    while (fgets(cmd, sizeof(cmd), in) != NULL) {
+        char lenWord[CHECK_NUM_SIZE];
+        char startWord[CHECK_NUM_SIZE];
+        char endWord[CHECK_NUM_SIZE];
+        u64 len = 0;
+        u64 start = 0;
+        u64 end = 0;
+        bool stop = false;
+
+        if (strcmp(cmd, "quit\n") == 0 || strcmp(cmd, "quit") == 0) {
+            break;
+        } else if (sscanf(cmd, "open %4095s %31s", name, lenWord) == 2) {
+            char *text = commandPayload(in, lenWord, &len, &stop);
+            if (stop) {
+                break;
+            }
+            if (text == NULL) {
+                PanFlushStdout();
+                continue;
+            }
+
+            PCheckFile *file = NewCheckFile(text, len);
+            PFree(text);
+            if (file == NULL) {
+                serverError("failed to parse file");
+            } else {
+                i64 index = findOpenFile(files, name);
+                if (index >= 0) {
+                    FreeCheckFile(files[index].file);
+                    files[index].file = file;
+                } else {
+                    CheckOpenFile open = {
+                        .name = StrDuplicate(name, strlen(name)),
+                        .file = file,
+                    };
+                    arrput(files, open);
+                }
+                printDiags(name, file);
+            }
+        } else if (sscanf(
+                       cmd, "change %4095s %31s %31s %31s", name, startWord,
+                       endWord, lenWord
+                   ) == 4) {
+            char *text = commandPayload(in, lenWord, &len, &stop);
+            if (stop) {
+                break;
+            }
+            if (text == NULL) {
+                PanFlushStdout();
+                continue;
+            }
+
+            i64 index = findOpenFile(files, name);
+            if (!parseNumber(startWord, &start) || start > UINT32_MAX ||
+                !parseNumber(endWord, &end) || end > UINT32_MAX) {
+                serverError("bad line number");
+            } else if (index < 0) {
+                serverError("file is not open");
+            } else if (!CheckFileEdit(
+                           files[index].file, (u32)start, (u32)end, text, len
+                       )) {
+                serverError("lines out of range");
+            } else {
+                printDiags(name, files[index].file);
+            }
+            PFree(text);
+        } else if (sscanf(cmd, "close %4095s", name) == 1) {
+            i64 index = findOpenFile(files, name);
+            if (index < 0) {
+                serverError("file is not open");
+            } else {
+                FreeCheckFile(files[index].file);
+                PFree(files[index].name);
+                arrdel(files, index);
+            }
+        } else {
+            serverError("unknown command");
+        }
+
+        PanFlushStdout();
+    }
+
+    PanFlushStdout();
+    for (u64 i = 0; i < arrlen(files); i++) {
+        FreeCheckFile(files[i].file);
+        PFree(files[i].name);
+    }
+    arrfree(files);
+    return EXIT_SUCCESS;
+}
+
+int RunCheckServer(void) { return ServeCheckCommands(stdin); }
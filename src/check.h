@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_CHECK_H
+#define PANKTI_CHECK_H
+
+#include "arena.h"
+#include "ast.h"
+#include "gen/diagon.h"
+#include "ptypes.h"
+#include "token.h"
+#include <stdbool.h>
+#include <stdio.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Check server.
+//
+// Editors keep a check server running, send it the text of open files and
+// their edits, and get back the diagnostics of the file. A file is kept as
+// units, runs of whole lines holding top level statements, each with its
+// tokens and AST. An edit lexes and parses only the units it touches and the
+// unit before them, whose last statement could read on into the edit. If a
+// statement or a string runs on into the units after them, those are parsed
+// again too. Other units only have their first line moved.
+//
+// Each top level statement is parsed with a clean error state, so an error
+// doesn't cascade into the statements after it. Only lexer and parser
+// diagnostics are reported, the compiler needs the whole program.
+//
+// Protocol, on stdin and stdout. Names have no spaces, lines are 1 based,
+// `<text>` is the `<length>` bytes after the command line.
+//
+//   open <name> <length>\n<text>       Open file `name` with `text`
+//   change <name> <start> <end> <length>\n<text>
+//                                      Replace lines `start` to `end - 1`
+//                                      with `text`, `start == end` inserts
+//   close <name>                       Forget file
+//   quit                               Stop the server
+//
+// `open` and `change` are answered with the diagnostics of the whole file,
+//
+//   diagnostics <name> <count>
+//   <line> <col> <len> <lexer|parser> <message>    `count` lines of these
+//
+// Columns and lengths are in bytes. Bad commands get `error <message>`. The
+// text of a `<length>` over `CHECK_PAYLOAD_MAX` is skipped, and answered with
+// `error payload too large`. A `<length>` which is not a decimal number gets
+// `error bad length` and stops the server, as where its text ends is unknown.
+
+// Largest text of an `open` or `change` command
+#define CHECK_PAYLOAD_MAX ((u64)256 * 1024 * 1024)
+
+typedef struct PCheckDiag {
+    // Line of diagnostic. In `PCheckUnit.diags` it is 0 based from the first
+    // line of the unit
+    u32 line;
+    // Byte column, 1 based
+    u32 col;
+    u32 len;
+    PanDiagCode code;
+    char *msg;
+} PCheckDiag;
+
+// Text, tokens and AST of the units which were parsed together
+typedef struct PCheckSegment {
+    char *text;
+    PArena *arena;
+    // Units using it
+    u32 refs;
+} PCheckSegment;
+
+typedef struct PCheckUnit {
+    PCheckSegment *seg;
+    // Where lines of the unit are in `seg->text`
+    u64 textStart;
+    u64 textLen;
+    // First line in the file, 1 based
+    u32 firstLine;
+    u32 lineCount;
+    // Line number tokens of `seg` give the first line of the unit
+    u32 segLine;
+    // stb_ds arrays
+    Token **tokens;
+    PStmt **stmts;
+    PCheckDiag *diags;
+} PCheckUnit;
+
+typedef struct PCheckFile {
+    // stb_ds array, in line order
+    PCheckUnit *units;
+    u32 lineCount;
+} PCheckFile;
+
+// Lex and parse `text` of `len` bytes as a new file
+PCheckFile *NewCheckFile(const char *text, u64 len);
+// Free the file with its units
+void FreeCheckFile(PCheckFile *file);
+// Replace lines `start` to `end - 1` (1 based) of `file` with `text` of `len`
+// bytes, and parse them again. False if lines are out of range
+bool CheckFileEdit(
+    PCheckFile *file, u32 start, u32 end, const char *text, u64 len
+);
+// Diagnostics of `file` with their file lines, 1 based. The stb_ds array
+// must be freed with `arrfree`, messages are owned by the file
+PCheckDiag *CheckFileDiags(const PCheckFile *file);
+// Text of `file`, must be freed
+char *CheckFileText(const PCheckFile *file, u64 *len);
+
+// Can text of `len` bytes be read for a command
+bool CheckPayloadLenValid(u64 len);
+// Serve check commands from `in` until `quit` or end of input
+int ServeCheckCommands(FILE *in);
+// Serve check commands from stdin until `quit` or end of input
+int RunCheckServer(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
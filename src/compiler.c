@@ -18,6 +18,7 @@
 #include "compiler.h"
 #include "alloc.h"
 #include "ast.h"
+#include "builtins.h"
 #include "diagonctx.h"
 #include "external/stb/stb_ds.h"
 #include "flags.h"
@@ -38,14 +39,15 @@
 #include <stdio.h>
 #include <string.h>
 
-#define MAX_CONST_COUNT 65535
+// Largest function (in bytes of compiled code) which calls can be inlined
+#define INLINE_MAX_CODE 64
 
 // Compile and Emit Bytecodes for a Parser Produced Statement
 static bool compileStmt(PCompiler *comp, PStmt *stmt);
 // Compiled and Emit Bytecodes for a Parser Produced Expression
 static bool compileExpr(PCompiler *comp, PExpr *expr);
 // Add a Constant and return its index in constant list
-static u16 addConstant(PCompiler *comp, PValue value);
+static u32 addConstant(PCompiler *comp, PValue value, Token *tok);
 // Try setting up variable name.
 // If is local, we create a local
 // otherwise we create a Identifier constant from token
@@ -65,6 +67,7 @@ PCompiler *dummyCompiler(
     c->errCtx = errCtx;
     c->gc = gc;
     c->func = NULL;
+    c->name = ftype == COMP_FN_FUNCTION ? name : NULL;
     c->funcType = ftype;
     c->enclosing = enclosing;
     c->prog = NULL;
@@ -90,8 +93,22 @@ PCompiler *dummyCompiler(
         return NULL;
     }
     c->func = cmFunc;
+    // slot 0 is the function itself
+    c->stackDepth = 1;
+    cmFunc->v.OComFunction.code->maxStack = 1;
 
     c->loopCtx = NULL;
+    c->body = NULL;
+    c->isDirect = false;
+    c->directFailed = false;
+    c->inl = NULL;
+    c->inlineFns = NULL;
+    c->imports = NULL;
+    c->inner = NULL;
+    c->session = false;
+    if (enclosing != NULL) {
+        enclosing->inner = c;
+    }
 
     PLocal *local = &c->locals[c->localCount++];
     local->depth = 0;
@@ -125,12 +142,34 @@ PCompiler *NewEnclosedCompiler(
     return c;
 }
 
+// Free loop contexts of `comp`, loops are left open when compiling stops at
+// an error
+static void freeLoopCtxs(PCompiler *comp) {
+    while (comp->loopCtx != NULL) {
+        PCompLoopCtx *loopCtx = comp->loopCtx;
+        comp->loopCtx = loopCtx->enclosing;
+        arrfree(loopCtx->breakJumps);
+        PFree(loopCtx);
+    }
+}
+
 void FreeCompiler(PCompiler *comp) {
     if (comp == NULL) {
         return;
     }
-    if (comp->loopCtx != NULL) {
-        PFree(comp->loopCtx);
+    FreeCompiler(comp->inner);
+    if (comp->enclosing != NULL) {
+        comp->enclosing->inner = NULL;
+    }
+    freeLoopCtxs(comp);
+    if (comp->inlineFns != NULL) {
+        arrfree(comp->inlineFns);
+    }
+    for (i64 i = 0; i < arrlen(comp->imports); i++) {
+        PFree(comp->imports[i].name);
+    }
+    if (comp->imports != NULL) {
+        arrfree(comp->imports);
     }
     FreeToken(comp->dummyToken);
     PFree(comp);
@@ -182,33 +221,77 @@ static finline PBytecode *getbt(PCompiler *comp) {
     return comp->func->v.OComFunction.code;
 }
 
-// Add a Constant and return its index in constant list
-static u16 addConstant(PCompiler *comp, PValue value) {
-    u16 index = AddConstantToPool(getbt(comp), value);
+// Add a Constant pushed with `emitConstant` and return its index in constant
+// list. Reports an error at `tok` if the pool is full, returning 0
+static u32 addConstant(PCompiler *comp, PValue value, Token *tok) {
+    u32 index = AddConstantToPool(getbt(comp), value, true);
+    if (index == UINT32_MAX) {
+        cmpError(comp, tok, COMPILER_CONST_TOO_MANY);
+        return 0;
+    }
     return index;
 }
 
+// Add a Constant for an opcode with a u16 constant operand and return its
+// index. Reports an error at `tok` if no u16 index is left, returning 0
+static u16 addShortConstant(PCompiler *comp, PValue value, Token *tok) {
+    u32 index = AddConstantToPool(getbt(comp), value, false);
+    if (index == UINT32_MAX) {
+        cmpError(comp, tok, COMPILER_CONST_TOO_MANY);
+        return 0;
+    }
+    return (u16)index;
+}
+
+// Track stack depth of emitted code and record the maximum.
+// The depth follows the fall through path of the code, places where a jump
+// lands with a different depth adjust `stackDepth` by hand
+static void trackStack(PCompiler *comp, int effect) {
+    comp->stackDepth += effect;
+    PBytecode *bt = getbt(comp);
+    if (comp->stackDepth > (int)bt->maxStack) {
+        bt->maxStack = (u32)comp->stackDepth;
+    }
+}
+
 // Emit a single opcode
 static u64 emitBt(PCompiler *comp, Token *tok, PanOpCode op) {
+    trackStack(comp, OpStackEffect(op, 0));
     return EmitBytecode(getbt(comp), tok, op);
 }
 
 // Emit a bytecode with a u16 operand
 static u64 emitBtU16(PCompiler *comp, Token *tok, PanOpCode op, u16 a) {
+    trackStack(comp, OpStackEffect(op, a));
     return EmitBytecodeWithOneArg(getbt(comp), tok, op, a);
 }
 
+// Emit code pushing constant `index`, `OP_CONST_LONG` if it doesn't fit in a
+// u16 operand
+static void emitConstant(PCompiler *comp, Token *tok, u32 index) {
+    if (index <= UINT16_MAX) {
+        emitBtU16(comp, tok, OP_CONST, (u16)index);
+        return;
+    }
+    trackStack(comp, OpStackEffect(OP_CONST_LONG, 0));
+    PBytecode *bt = getbt(comp);
+    EmitBytecode(bt, tok, OP_CONST_LONG);
+    EmitRawU8(bt, (u8)(index >> 16));
+    EmitRawU8(bt, (u8)(index >> 8));
+    EmitRawU8(bt, (u8)index);
+}
+
 // Emit a jump type opcode with placeholder which should be patched later
 // returns the position of offset operand
-static u16 emitJump(PCompiler *comp, Token *tok, PanOpCode op) {
+static u64 emitJump(PCompiler *comp, Token *tok, PanOpCode op) {
     emitBtU16(comp, tok, op, 0xffff);
     return getbt(comp)->codeCount - 2;
 }
 
 // Patch a jump type opcode's operand
 // offset is the position of offset operand in bytecode
-static void patchJump(PCompiler *comp, int offset) {
-    int jump = getbt(comp)->codeCount - offset - 2;
+static void patchJump(PCompiler *comp, u64 offset) {
+    u64 jump = getbt(comp)->codeCount - offset - 2;
     if (jump > UINT16_MAX) {
         cmpError(comp, NULL, COMPILER_COND_JUMP_BIG);
         return;
@@ -296,7 +379,7 @@ static int addUpvalue(PCompiler *comp, u16 index, bool isLocal) {
     }
 
     if (upvalCount == UINT8_MAX) {
-        cmpError(comp, compFun->rawName, COMPILER_CLOSURE_TOO_MANY);
+        cmpError(comp, comp->name, COMPILER_CLOSURE_TOO_MANY);
         return 0;
     }
 
@@ -305,12 +388,50 @@ static int addUpvalue(PCompiler *comp, u16 index, bool isLocal) {
     return compFun->upvalCount++;
 }
 
+// Check if `name` is a local of `comp` or any of its enclosing compilers.
+// Unlike `findLocal` it doesn't report anything
+static bool isOuterLocal(PCompiler *comp, Token *name) {
+    for (PCompiler *c = comp; c != NULL; c = c->enclosing) {
+        for (int i = c->localCount - 1; i >= 0; i--) {
+            Token *localName = c->locals[i].name;
+            if (localName != NULL && isIdentTokenEqual(name, localName)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Find local of enclosing function frame for a direct function.
+// Direct functions can only reach the frame they are called from, if `name`
+// is a local of some function further outside, the direct compile fails
+static int findOuter(PCompiler *comp, Token *name) {
+    int local = findLocal(comp->enclosing, name);
+    if (local >= 0) {
+        return local;
+    }
+
+    if (isOuterLocal(comp->enclosing->enclosing, name)) {
+        comp->directFailed = true;
+    }
+    return -1;
+}
+
 // Find upvalue in local context and enclosing context
 static int findUpvalue(PCompiler *comp, Token *name) {
     if (comp->enclosing == NULL) { // no outer scope means no local or upvalue
         return -1;
     }
 
+    // Direct functions don't have upvalues, so closures inside them can
+    // only capture their locals
+    if (comp->isDirect) {
+        if (isOuterLocal(comp->enclosing, name)) {
+            comp->directFailed = true;
+        }
+        return -1;
+    }
+
     // Look for local variables defined in just outside the the scope
     // func mango()
     //     let x = 10
@@ -325,6 +446,7 @@ static int findUpvalue(PCompiler *comp, Token *name) {
     int local = findLocal(comp->enclosing, name);
     if (local >= 0) {
         comp->enclosing->locals[local].isCaptured = true;
+        comp->enclosing->func->v.OComFunction.capturesLocals = true;
         return addUpvalue(comp, (u16)local, true);
     }
 
@@ -362,6 +484,8 @@ static finline void emitReturn(PCompiler *comp) {
     // EmitRawU8(getbt(comp), OP_RETURN);
     emitBt(comp, comp->dummyToken, OP_NIL);
     emitBt(comp, comp->dummyToken, OP_RETURN);
+    // function is complete, duplicate constants are no longer looked up
+    FreeConstIndex(getbt(comp));
 }
 
 // Time has come for ending of compiler
@@ -400,9 +524,56 @@ bool CompilerCompile(PCompiler *compiler, PStmt **prog) {
     return true;
 }
 
+bool CompilerNewChunk(PCompiler *comp) {
+    PObj *func = NewComFuncObject(comp->gc, NULL);
+    if (func == NULL) {
+        return false;
+    }
+
+    // Compilers of functions the last chunk stopped in
+    FreeCompiler(comp->inner);
+    freeLoopCtxs(comp);
+    comp->func = func;
+    comp->stackDepth = 1;
+    func->v.OComFunction.code->maxStack = 1;
+    comp->localCount = 1;
+    comp->scopeDepth = 0;
+    comp->inl = NULL;
+    comp->prog = NULL;
+    comp->progCount = 0;
+    comp->session = true;
+    return true;
+}
+
+// Lexemes are slices of the source, which aren't NUL terminated. Names up to
+// this long are terminated in a buffer on the stack
+#define LEXEME_BUF_SIZE 128
+
+// Copy lexeme of `tok` to `buf` of `LEXEME_BUF_SIZE` bytes with a NUL after
+// it. False if it doesn't fit, which no builtin or module name does
+static bool lexemeStr(const Token *tok, char *buf) {
+    if (tok->lexeme == NULL || tok->len >= LEXEME_BUF_SIZE) {
+        return false;
+    }
+    memcpy(buf, tok->lexeme, tok->len);
+    buf[tok->len] = '\0';
+    return true;
+}
+
+// String object with lexeme of `tok` as is. The string is only copied to the
+// heap if it isn't in the string pool yet
+static PObj *lexemeStrObject(PCompiler *comp, const Token *tok) {
+    char buf[LEXEME_BUF_SIZE];
+    if (lexemeStr(tok, buf)) {
+        return NewStrObject(comp->gc, buf, false);
+    }
+    char *str = StrDuplicate(tok->lexeme, tok->len);
+    return str != NULL ? NewStrObject(comp->gc, str, true) : NULL;
+}
+
 static char *readStringEscapes(PCompiler *comp, Token *tok) {
     char *rawinput = tok->lexeme;
-    u64 inlen = (u64)strlen(rawinput);
+    u64 inlen = tok->len;
     u64 outlen = inlen * 4 + 1;
     char *output = PCalloc((u64)outlen, sizeof(char));
     if (output == NULL) {
@@ -461,22 +632,29 @@ static bool compileLitExpr(PCompiler *comp, PExpr *expr) {
 
     switch (lit->type) {
         case EXP_LIT_NUM: {
-            u16 constIdx = addConstant(comp, MakeNumber(lit->value.nvalue));
-            emitBtU16(comp, lit->op, OP_CONST, constIdx);
+            u32 constIdx = addConstant(
+                comp, MakeIntOrNumber(lit->value.nvalue), lit->op
+            );
+            emitConstant(comp, lit->op, constIdx);
             break;
         }
         case EXP_LIT_STR: {
             Token *opTok = expr->op;
-            char *escapedStr = readStringEscapes(comp, opTok);
-            // We hand ownership of escaped str to the string object
-            PObj *strObj = NewStrObject(comp->gc, expr->op, escapedStr, true);
+            PObj *strObj = NULL;
+            if (memchr(opTok->lexeme, '\\', opTok->len) == NULL) {
+                strObj = lexemeStrObject(comp, opTok);
+            } else {
+                char *escapedStr = readStringEscapes(comp, opTok);
+                // We hand ownership of escaped str to the string object
+                strObj = NewStrObject(comp->gc, escapedStr, true);
+            }
 
             if (strObj == NULL) {
                 cmpError(comp, expr->op, COMPILER_IME_STRING);
                 return false;
             }
-            u16 constIdx = addConstant(comp, MakeObject(strObj));
-            emitBtU16(comp, lit->op, OP_CONST, constIdx);
+            u32 constIdx = addConstant(comp, MakeObject(strObj), lit->op);
+            emitConstant(comp, lit->op, constIdx);
             break;
         }
         case EXP_LIT_BOOL: {
@@ -553,14 +731,14 @@ static bool compileLogicalExpr(PCompiler *comp, PExpr *expr) {
     }
 
     if (logic->op->type == T_AND) {
-        u16 endJump = emitJump(comp, logic->op, OP_POP_JUMP_IF_FALSE);
+        u64 endJump = emitJump(comp, logic->op, OP_POP_JUMP_IF_FALSE);
         if (!compileExpr(comp, logic->right)) {
             cmpError(comp, logic->right->op, COMPILER_RIGHT_LOGICAL);
             return false;
         }
         patchJump(comp, endJump);
     } else if (logic->op->type == T_OR) {
-        u16 endJump = emitJump(comp, logic->op, OP_POP_JUMP_IF_TRUE);
+        u64 endJump = emitJump(comp, logic->op, OP_POP_JUMP_IF_TRUE);
         if (!compileExpr(comp, logic->right)) {
             cmpError(comp, logic->right->op, COMPILER_RIGHT_LOGICAL);
             return false;
@@ -627,19 +805,172 @@ static bool compileMapExpr(PCompiler *comp, PExpr *expr) {
 // return the constant index
 static u16 addIdentConst(PCompiler *comp, Token *tok) {
 
-    PObj *strObj = NewStrObject(comp->gc, tok, tok->lexeme, false);
+    PObj *strObj = lexemeStrObject(comp, tok);
     if (strObj == NULL) {
         cmpError(comp, tok, COMPILER_IDENT_NAME);
         return 0;
     }
-    PValue strVal = MakeObject(strObj);
-    u16 constIndex = addConstant(comp, strVal);
-    return constIndex;
+    return addShortConstant(comp, MakeObject(strObj), tok);
+}
+
+// Inlining.
+//
+// Calls of small top level functions whose body is a single return statement
+// are compiled as the returned expression, inside the caller. Only functions
+// which are never redefined or assigned to anywhere in the program, and only
+// calls compiled after the function, are inlined, so the name is known to
+// always refer to the function when the call runs.
+//
+// Arguments are pushed to stack slots above the current stack top, which the
+// inlined expression reads as its parameters. The result is moved to the slot
+// below the arguments, then the arguments are popped. When the expression is
+// made of operators only and reads each parameter once in order, the
+// arguments are compiled in place of the parameters instead.
+//
+// Inlined code is recorded as a range in `PBytecode.inlines` and shown as a
+// frame of its own in stack traces. Arguments compiled in place are not part
+// of the range.
+
+// Find parameter `name` of inlined call `inl`, returns -1 if not found
+static int findInlineParam(PCompInline *inl, Token *name) {
+    for (u64 i = 0; i < inl->fn->paramCount; i++) {
+        if (isIdentTokenEqual(inl->fn->params[i], name)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Find function which can be inlined for call expression `expr`
+static const PCompInlineFn *findInlineFn(PCompiler *comp, PExpr *expr) {
+    struct ECall *call = &expr->exp.ECall;
+    if (call->callee->type != EXPR_VARIABLE) {
+        return NULL;
+    }
+    Token *name = call->callee->exp.EVariable.name;
+    // inside inlined code every name other than parameters is a global
+    if (comp->inl != NULL) {
+        if (findInlineParam(comp->inl, name) != -1) {
+            return NULL;
+        }
+    } else if (isOuterLocal(comp, name)) {
+        return NULL;
+    }
+
+    PCompiler *top = comp;
+    while (top->enclosing != NULL) {
+        top = top->enclosing;
+    }
+
+    i64 count = arrlen(top->inlineFns);
+    for (i64 i = 0; i < count; i++) {
+        struct SFunc *fn = &top->inlineFns[i].stmt->stmt.SFunc;
+        if (fn->paramCount == call->argCount &&
+            isIdentTokenEqual(fn->name, name)) {
+            return &top->inlineFns[i];
+        }
+    }
+    return NULL;
+}
+
+// Compile argument `index` of inlined call `inl` in place of its parameter.
+// The argument is code of the caller, so the inlined range is stopped around
+// it
+static bool compileInlineArg(PCompiler *comp, PCompInline *inl, int index) {
+    PBytecode *bt = getbt(comp);
+    PExpr *arg = inl->call->exp.ECall.args[index];
+    EndInlineRange(bt, inl->range);
+    comp->inl = inl->enclosing;
+    bool ok = compileExpr(comp, arg);
+    comp->inl = inl;
+    inl->range = BeginInlineRange(bt, inl->name, inl->call->exp.ECall.op);
+    if (!ok) {
+        cmpError(comp, arg->op, COMPILER_CALL_EXPR_ARG);
+    }
+    return ok;
+}
+
+// Compile variable expression `expr` of inlined code
+static bool compileInlineVariable(PCompiler *comp, PExpr *expr) {
+    PCompInline *inl = comp->inl;
+    Token *name = expr->exp.EVariable.name;
+    int param = findInlineParam(inl, name);
+    if (param == -1) {
+        u16 constIndex = addIdentConst(comp, name);
+        emitBtU16(comp, name, OP_GET_GLOBAL, constIndex);
+        return true;
+    }
+
+    if (inl->slot == -1) {
+        return compileInlineArg(comp, inl, param);
+    }
+    emitBtU16(comp, name, OP_GET_LOCAL, (u16)(inl->slot + 1 + param));
+    return true;
+}
+
+// Check if every argument of call `call` is a literal, which can be compiled
+// in place of parameters used any number of times
+static bool isLiteralArgs(struct ECall *call) {
+    for (u64 i = 0; i < call->argCount; i++) {
+        if (call->args[i]->type != EXPR_LITERAL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compile call `expr` of function `fn` inline
+static bool compileInlineCall(
+    PCompiler *comp, PExpr *expr, const PCompInlineFn *fn
+) {
+    struct ECall *call = &expr->exp.ECall;
+    struct SFunc *fnStmt = &fn->stmt->stmt.SFunc;
+    PExpr *body = fnStmt->body->stmt.SBlock.stmts[0]->stmt.SReturn.value;
+    PCompInline inl = {
+        .fn = fnStmt,
+        .call = expr,
+        .name = addIdentConst(comp, fnStmt->name),
+        .range = 0,
+        .slot = -1,
+        .enclosing = comp->inl,
+    };
+
+    if (!fn->inPlace && !isLiteralArgs(call)) {
+        inl.slot = comp->stackDepth;
+        emitBt(comp, call->op, OP_NIL);
+        for (u64 i = 0; i < call->argCount; i++) {
+            if (!compileExpr(comp, call->args[i])) {
+                cmpError(comp, call->args[i]->op, COMPILER_CALL_EXPR_ARG);
+                return false;
+            }
+        }
+    }
+
+    PBytecode *bt = getbt(comp);
+    inl.range = BeginInlineRange(bt, inl.name, call->op);
+    comp->inl = &inl;
+    bool ok = compileExpr(comp, body);
+    comp->inl = inl.enclosing;
+    EndInlineRange(bt, inl.range);
+    if (!ok) {
+        return false;
+    }
+
+    if (inl.slot != -1) {
+        emitBtU16(comp, call->op, OP_SET_LOCAL, (u16)inl.slot);
+        for (u64 i = 0; i <= call->argCount; i++) {
+            emitBt(comp, call->op, OP_POP);
+        }
+    }
+    return true;
 }
 
 // Compile a variable expression
 static bool compileVariableExpr(PCompiler *comp, PExpr *expr) {
     struct EVariable *var = &expr->exp.EVariable;
+    if (comp->inl != NULL) {
+        return compileInlineVariable(comp, expr);
+    }
 
     int localIndex = findLocal(comp, var->name);
     if (localIndex != -1 && localIndex != -2) {
@@ -647,6 +978,14 @@ static bool compileVariableExpr(PCompiler *comp, PExpr *expr) {
         return true;
     }
 
+    if (comp->isDirect) {
+        int outerIndex = findOuter(comp, var->name);
+        if (outerIndex != -1) {
+            emitBtU16(comp, var->name, OP_GET_OUTER, outerIndex);
+            return true;
+        }
+    }
+
     // look for local in enclosing scope or previosly made upvalues
     int upvalIndex = findUpvalue(comp, var->name);
     if (upvalIndex != -1) {
@@ -674,6 +1013,14 @@ static bool cmpVariableAssign(PCompiler *comp, PExpr *expr) {
 
     // same thing as finding enclosing local or previosly made upvalues
     Token *varName = assign->name->exp.EVariable.name;
+    if (comp->isDirect) {
+        int outerIndex = findOuter(comp, varName);
+        if (outerIndex != -1) {
+            emitBtU16(comp, varName, OP_SET_OUTER, outerIndex);
+            return true;
+        }
+    }
+
     int upvalIndex = findUpvalue(comp, varName);
     if (upvalIndex != -1) {
         emitBtU16(comp, varName, OP_SET_UPVAL, upvalIndex);
@@ -719,8 +1066,119 @@ static bool compileAssignExpr(PCompiler *comp, PExpr *expr) {
     return false;
 }
 
-static bool compileCallExpr(PCompiler *comp, PExpr *expr) {
+// Intrinsics.
+//
+// Calls of some builtins and standard library functions are compiled to
+// opcodes of their own, such as `OP_LEN`, which skip looking up the function
+// and the native call. A builtin is compiled so only where its name is not a
+// local, and a module member only when the module was imported by a top level
+// statement before the call, so it has been imported when the call runs.
+//
+// Globals can still be redefined at runtime. Names of globals intrinsics were
+// compiled for are marked `intrinsic`, and writing a global with a marked
+// name turns intrinsics off in the VM. They then call the function the normal
+// way.
+
+// Check if `name` is a global where it is being compiled
+static bool isGlobalName(PCompiler *comp, Token *name) {
+    // inside inlined code every name other than parameters is a global
+    if (comp->inl != NULL) {
+        return findInlineParam(comp->inl, name) == -1;
+    }
+    return !isOuterLocal(comp, name);
+}
+
+// Find module imported as `name` by a top level statement so far
+static StdlibMod findImport(PCompiler *comp, Token *name) {
+    PCompiler *top = comp;
+    while (top->enclosing != NULL) {
+        top = top->enclosing;
+    }
+    for (i64 i = arrlen(top->imports) - 1; i >= 0; i--) {
+        const PCompImport *import = &top->imports[i];
+        if (import->len == name->len &&
+            memcmp(import->name, name->lexeme, name->len) == 0) {
+            return import->mod;
+        }
+    }
+    return STDLIB_NONE;
+}
+
+// Find intrinsic opcode for call expression `expr`
+static bool findIntrinsic(PCompiler *comp, PExpr *expr, PanOpCode *op) {
+    struct ECall *call = &expr->exp.ECall;
+    PExpr *callee = call->callee;
+    char buf[LEXEME_BUF_SIZE];
+    if (callee->type == EXPR_VARIABLE) {
+        Token *name = callee->exp.EVariable.name;
+        return isGlobalName(comp, name) && lexemeStr(name, buf) &&
+               BuiltinIntrinsic(buf, call->argCount, op);
+    }
+    if (callee->type == EXPR_MODGET &&
+        callee->exp.EModget.module->type == EXPR_VARIABLE) {
+        Token *name = callee->exp.EModget.module->exp.EVariable.name;
+        if (!isGlobalName(comp, name) ||
+            !lexemeStr(callee->exp.EModget.child, buf)) {
+            return false;
+        }
+        return StdlibIntrinsic(findImport(comp, name), buf, call->argCount, op);
+    }
+    return false;
+}
+
+// Add global name `tok` to constant pool, marked as a name intrinsics depend
+// on
+static u16 addIntrinsicName(PCompiler *comp, Token *tok) {
+    u16 constIndex = addIdentConst(comp, tok);
+    PValue name = getbt(comp)->constPool[constIndex];
+    if (IsValueObjType(name, OT_STR)) {
+        ValueAsObj(name)->v.OString.intrinsic = true;
+    }
+    return constIndex;
+}
+
+// Compile call `expr` as intrinsic opcode `op`
+static bool compileIntrinsicCall(PCompiler *comp, PExpr *expr, PanOpCode op) {
     struct ECall *call = &expr->exp.ECall;
+    for (u64 i = 0; i < call->argCount; i++) {
+        if (!compileExpr(comp, call->args[i])) {
+            cmpError(comp, call->args[i]->op, COMPILER_CALL_EXPR_ARG);
+            return false;
+        }
+    }
+    // Room for the callee below the arguments, when it is called the normal
+    // way
+    trackStack(comp, 1);
+    trackStack(comp, -1);
+
+    PExpr *callee = call->callee;
+    if (callee->type == EXPR_MODGET) {
+        Token *moduleName = callee->exp.EModget.module->exp.EVariable.name;
+        u16 module = addIntrinsicName(comp, moduleName);
+        u16 member = addIdentConst(comp, callee->exp.EModget.child);
+        // at the `.`, errors of getting the member match `OP_MODGET`
+        emitBtU16(comp, callee->op, op, module);
+        EmitRawU16(getbt(comp), member);
+        return true;
+    }
+    u16 name = addIntrinsicName(comp, callee->exp.EVariable.name);
+    emitBtU16(comp, call->op, op, name);
+    return true;
+}
+
+// Compile callee and arguments of call expression followed by `callOp`,
+// which is either `OP_CALL` or `OP_TAIL_CALL`. Calls which can be inlined are
+// compiled inline, and calls of intrinsics as their opcodes instead
+static bool compileCall(PCompiler *comp, PExpr *expr, PanOpCode callOp) {
+    struct ECall *call = &expr->exp.ECall;
+    const PCompInlineFn *inlineFn = findInlineFn(comp, expr);
+    if (inlineFn != NULL) {
+        return compileInlineCall(comp, expr, inlineFn);
+    }
+    PanOpCode intrinsic = OP_CALL;
+    if (findIntrinsic(comp, expr, &intrinsic)) {
+        return compileIntrinsicCall(comp, expr, intrinsic);
+    }
     if (!compileExpr(comp, call->callee)) {
         cmpError(comp, call->callee->op, COMPILER_CALL_EXPR_CALLE);
         return false;
@@ -732,11 +1190,15 @@ static bool compileCallExpr(PCompiler *comp, PExpr *expr) {
         }
     }
 
-    emitBtU16(comp, call->op, OP_CALL, (u16)call->argCount);
+    emitBtU16(comp, call->op, callOp, (u16)call->argCount);
 
     return true;
 }
 
+static bool compileCallExpr(PCompiler *comp, PExpr *expr) {
+    return compileCall(comp, expr, OP_CALL);
+}
+
 static bool compileSubscriptExpr(PCompiler *comp, PExpr *expr) {
     struct ESubscript *subExpr = &expr->exp.ESubscript;
     if (!compileExpr(comp, subExpr->value)) {
@@ -841,7 +1303,9 @@ static void tryLocalDeclare(PCompiler *comp, Token *name) {
         return;
     }
     if (doesLocalExists(comp, name) != -1) {
-        cmpError(comp, name, COMPILER_VAR_EXISTS, name->lexeme);
+        char *str = StrDuplicate(name->lexeme, name->len);
+        cmpError(comp, name, COMPILER_VAR_EXISTS, str != NULL ? str : "");
+        PFree(str);
         return;
     }
     if (comp->localCount >= MAX_COMPILER_LOCAL_COUNT) {
@@ -893,7 +1357,7 @@ static bool compileLetStmt(PCompiler *comp, PStmt *stmt) {
 static bool compileBlockStmt(PCompiler *comp, PStmt *stmt) {
     startScope(comp);
     struct SBlock *block = &stmt->stmt.SBlock;
-    u64 stmtCount = arrlen(block->stmts);
+    u64 stmtCount = block->count;
     for (u64 i = 0; i < stmtCount; i++) {
         if (!compileStmt(comp, block->stmts[i])) {
             endScope(comp, block->op);
@@ -911,7 +1375,7 @@ static bool compileIfStmt(PCompiler *comp, PStmt *stmt) {
         cmpError(comp, ifstmt->cond->op, COMPILER_IF_COND);
         return false;
     }
-    int thenJump = emitJump(comp, ifstmt->op, OP_JUMP_IF_FALSE);
+    u64 thenJump = emitJump(comp, ifstmt->op, OP_JUMP_IF_FALSE);
     emitBt(comp, ifstmt->op, OP_POP);
 
     if (!compileStmt(comp, ifstmt->thenBranch)) {
@@ -919,8 +1383,10 @@ static bool compileIfStmt(PCompiler *comp, PStmt *stmt) {
         return false;
     }
 
-    int elseJump = emitJump(comp, ifstmt->op, OP_JUMP);
+    u64 elseJump = emitJump(comp, ifstmt->op, OP_JUMP);
     patchJump(comp, thenJump);
+    // condition is still on stack when jumped here
+    comp->stackDepth++;
     emitBt(comp, ifstmt->op, OP_POP);
 
     if (ifstmt->elseBranch != NULL) {
@@ -934,20 +1400,25 @@ static bool compileIfStmt(PCompiler *comp, PStmt *stmt) {
     return true;
 }
 
-static void emitLoop(PCompiler *comp, Token *token, u16 loopStart) {
+static void emitLoop(PCompiler *comp, Token *token, u64 loopStart) {
     emitBt(comp, token, OP_LOOP);
-    u16 offset = getbt(comp)->codeCount - loopStart + 2;
+    u64 offset = getbt(comp)->codeCount - loopStart + 2;
+    if (offset > UINT16_MAX) {
+        cmpError(comp, token, COMPILER_COND_JUMP_BIG);
+        return;
+    }
 
-    EmitRawU16(getbt(comp), offset);
+    EmitRawU16(getbt(comp), (u16)offset);
 }
 
-static PCompLoopCtx *enterLoop(PCompiler *comp, u16 loopStart) {
+static PCompLoopCtx *enterLoop(PCompiler *comp, u64 loopStart) {
     PCompLoopCtx *loopCtx = PCreate(PCompLoopCtx);
     if (loopCtx == NULL) {
         return NULL;
     }
     loopCtx->breakJumps = NULL;
     loopCtx->loopStart = loopStart;
+    loopCtx->scopeDepth = comp->scopeDepth;
     loopCtx->enclosing = comp->loopCtx;
     comp->loopCtx = loopCtx;
     return loopCtx;
@@ -976,7 +1447,7 @@ static void exitLoop(PCompiler *comp) {
 static bool compileWhileStmt(PCompiler *comp, PStmt *stmt) {
     struct SWhile *whileStmt = &stmt->stmt.SWhile;
 
-    u16 loopStart = getbt(comp)->codeCount;
+    u64 loopStart = getbt(comp)->codeCount;
 
     PCompLoopCtx *loopCtx = enterLoop(comp, loopStart);
     if (loopCtx == NULL) {
@@ -989,7 +1460,7 @@ static bool compileWhileStmt(PCompiler *comp, PStmt *stmt) {
         return false;
     }
 
-    u16 exitJump = emitJump(comp, whileStmt->op, OP_JUMP_IF_FALSE);
+    u64 exitJump = emitJump(comp, whileStmt->op, OP_JUMP_IF_FALSE);
 
     emitBt(comp, whileStmt->op, OP_POP);
 
@@ -1001,11 +1472,26 @@ static bool compileWhileStmt(PCompiler *comp, PStmt *stmt) {
     emitLoop(comp, whileStmt->op, loopStart);
 
     patchJump(comp, exitJump);
+    // condition is still on stack when jumped here
+    comp->stackDepth++;
     emitBt(comp, whileStmt->op, OP_POP);
     exitLoop(comp);
     return true;
 }
 
+// Pop locals declared inside the loop body before `break` or `continue`
+// jumps out of it. Compiler's locals are kept, code after the jump is still
+// in the same scope. Upvalues are always closed as the locals may get
+// captured later in the scope
+static void popLoopLocals(PCompiler *comp, Token *op) {
+    int depth = comp->stackDepth;
+    for (int i = comp->localCount - 1;
+         i >= 0 && comp->locals[i].depth > comp->loopCtx->scopeDepth; i--) {
+        emitBt(comp, op, OP_CLS_UPVAL);
+    }
+    comp->stackDepth = depth;
+}
+
 static bool compileBreakStmt(PCompiler *comp, PStmt *stmt) {
     struct SBreak *breakStmt = &stmt->stmt.SBreak;
 
@@ -1013,7 +1499,8 @@ static bool compileBreakStmt(PCompiler *comp, PStmt *stmt) {
         cmpError(comp, breakStmt->op, COMPILER_BREAK_STMT);
         return false;
     }
-    u16 jumpPos = emitJump(comp, breakStmt->op, OP_JUMP);
+    popLoopLocals(comp, breakStmt->op);
+    u64 jumpPos = emitJump(comp, breakStmt->op, OP_JUMP);
     arrput(comp->loopCtx->breakJumps, jumpPos);
     return true;
 }
@@ -1025,12 +1512,12 @@ static bool compileContinueStmt(PCompiler *comp, PStmt *stmt) {
         cmpError(comp, contStmt->op, COMPILER_CONTINUE_STMT);
         return false;
     }
+    popLoopLocals(comp, contStmt->op);
     emitLoop(comp, contStmt->op, comp->loopCtx->loopStart);
     return true;
 }
 
-static bool compileFuncBody(PCompiler *comp, PStmt **stmts) {
-    u64 stmtCount = arrlen(stmts);
+static bool compileFuncBody(PCompiler *comp, PStmt **stmts, u64 stmtCount) {
     for (u64 i = 0; i < stmtCount; i++) {
         if (!compileStmt(comp, stmts[i])) {
             cmpError(comp, stmts[i]->op, COMPILER_FUNC_BLOCK);
@@ -1042,55 +1529,496 @@ static bool compileFuncBody(PCompiler *comp, PStmt **stmts) {
     return true;
 }
 
-static bool compileFunc(PCompiler *comp, PStmt *stmt) {
+// Escape analysis of nested functions.
+//
+// A function declared inside another function escapes if its value can be
+// seen by anything other than the enclosing function's own call expressions.
+// The enclosing body is scanned for the function name, every use of the name
+// other than the callee of a call (`name(...)`) is an escape, e.g.
+// returning it, storing it, passing it as an argument or capturing it in a
+// nested function (including its own body, a recursive call). Shadowing the
+// name anywhere is treated as an escape too, to keep the scan name based.
+//
+// Functions which don't escape are only ever called from the enclosing
+// frame, so they are compiled as "direct" functions: no closure object is
+// made, the compiled function itself is stored in the local slot and the
+// enclosing function's locals are accessed through `OP_GET_OUTER` and
+// `OP_SET_OUTER` instead of upvalues.
+
+static bool stmtLetsEscape(PStmt *stmt, Token *name, PStmt *self, bool nested);
+
+// Check if `name` escapes in expression `expr`. When `nested` is true the
+// expression is inside a nested function, where every use is an escape
+static bool exprLetsEscape(PExpr *expr, Token *name, bool nested) {
+    if (expr == NULL) {
+        return false;
+    }
+
+    switch (expr->type) {
+        case EXPR_VARIABLE:
+            return isIdentTokenEqual(expr->exp.EVariable.name, name);
+        case EXPR_BINARY:
+            return exprLetsEscape(expr->exp.EBinary.left, name, nested) ||
+                   exprLetsEscape(expr->exp.EBinary.right, name, nested);
+        case EXPR_LOGICAL:
+            return exprLetsEscape(expr->exp.ELogical.left, name, nested) ||
+                   exprLetsEscape(expr->exp.ELogical.right, name, nested);
+        case EXPR_UNARY:
+            return exprLetsEscape(expr->exp.EUnary.right, name, nested);
+        case EXPR_GROUPING:
+            return exprLetsEscape(expr->exp.EGrouping.expr, name, nested);
+        case EXPR_ASSIGN:
+            return exprLetsEscape(expr->exp.EAssign.name, name, nested) ||
+                   exprLetsEscape(expr->exp.EAssign.value, name, nested);
+        case EXPR_SUBSCRIPT:
+            return exprLetsEscape(expr->exp.ESubscript.value, name, nested) ||
+                   exprLetsEscape(expr->exp.ESubscript.index, name, nested);
+        case EXPR_MODGET:
+            return exprLetsEscape(expr->exp.EModget.module, name, nested);
+        case EXPR_ARRAY: {
+            struct EArray *arr = &expr->exp.EArray;
+            for (u64 i = 0; i < arr->count; i++) {
+                if (exprLetsEscape(arr->items[i], name, nested)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_MAP: {
+            struct EMap *map = &expr->exp.EMap;
+            for (u64 i = 0; i < map->count; i++) {
+                if (exprLetsEscape(map->etable[i], name, nested)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_CALL: {
+            struct ECall *call = &expr->exp.ECall;
+            // calling the function directly is the only allowed use
+            bool directCallee = !nested && call->callee->type == EXPR_VARIABLE;
+            if (!directCallee && exprLetsEscape(call->callee, name, nested)) {
+                return true;
+            }
+            for (u64 i = 0; i < call->argCount; i++) {
+                if (exprLetsEscape(call->args[i], name, nested)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_LITERAL:
+            return false;
+    }
+
+    return true;
+}
+
+static bool stmtsLetEscape(
+    PStmt **stmts, u64 count, Token *name, PStmt *self, bool nested
+) {
+    for (u64 i = 0; i < count; i++) {
+        if (stmtLetsEscape(stmts[i], name, self, nested)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check if `name` escapes in statement `stmt`. `self` is the declaration
+// of the function being checked
+static bool stmtLetsEscape(PStmt *stmt, Token *name, PStmt *self, bool nested) {
+    if (stmt == NULL) {
+        return false;
+    }
+
+    switch (stmt->type) {
+        case STMT_EXPR:
+            return exprLetsEscape(stmt->stmt.SExpr.expr, name, nested);
+        case STMT_DEBUG:
+            return exprLetsEscape(stmt->stmt.SDebug.expr, name, nested);
+        case STMT_RETURN:
+            return exprLetsEscape(stmt->stmt.SReturn.value, name, nested);
+        case STMT_LET:
+            return isIdentTokenEqual(stmt->stmt.SLet.name, name) ||
+                   exprLetsEscape(stmt->stmt.SLet.expr, name, nested);
+        case STMT_IMPORT:
+            return isIdentTokenEqual(stmt->stmt.SImport.name, name);
+        case STMT_BLOCK:
+            return stmtsLetEscape(
+                stmt->stmt.SBlock.stmts, stmt->stmt.SBlock.count, name, self,
+                nested
+            );
+        case STMT_IF:
+            return exprLetsEscape(stmt->stmt.SIf.cond, name, nested) ||
+                   stmtLetsEscape(stmt->stmt.SIf.thenBranch, name, self, nested) ||
+                   stmtLetsEscape(stmt->stmt.SIf.elseBranch, name, self, nested);
+        case STMT_WHILE:
+            return exprLetsEscape(stmt->stmt.SWhile.cond, name, nested) ||
+                   stmtLetsEscape(stmt->stmt.SWhile.body, name, self, nested);
+        case STMT_FUNC: {
+            struct SFunc *fn = &stmt->stmt.SFunc;
+            if (stmt != self && isIdentTokenEqual(fn->name, name)) {
+                return true;
+            }
+            for (u64 i = 0; i < fn->paramCount; i++) {
+                if (isIdentTokenEqual(fn->params[i], name)) {
+                    return true;
+                }
+            }
+            return stmtLetsEscape(fn->body, name, self, true);
+        }
+        case STMT_BREAK:
+        case STMT_CONTINUE:
+            return false;
+    }
+
+    return true;
+}
+
+// Check if function `stmt` can be compiled as a direct function of `comp`
+static bool isNonEscapingFunc(PCompiler *comp, PStmt *stmt) {
+    if (comp->funcType != COMP_FN_FUNCTION || comp->body == NULL) {
+        return false;
+    }
+
+    Token *name = stmt->stmt.SFunc.name;
+    struct SBlock *body = &comp->body->stmt.SBlock;
+    return !stmtsLetEscape(body->stmts, body->count, name, stmt, false);
+}
+
+// Compile function `stmt` with a new enclosed compiler, which is returned
+// and holds the compiled function and its upvalue information.
+// When `direct` is true, the function is compiled as a direct function. If
+// it turns out to need something a direct function can't have, such as
+// variables of functions further outside, `directFailed` of returned compiler
+// is set and the result must be discarded.
+// Returns NULL on errors
+static PCompiler *compileFuncObj(PCompiler *comp, PStmt *stmt, bool direct) {
     struct SFunc *fnStmt = &stmt->stmt.SFunc;
     PCompiler *fComp = NewEnclosedCompiler(
         comp->gc, comp, COMP_FN_FUNCTION, fnStmt->name, comp->errCtx
     );
     if (fComp == NULL) {
         cmpError(comp, fnStmt->name, COMPILER_FUNC_STMT);
-        return false;
+        return NULL;
     }
+    fComp->isDirect = direct;
+    fComp->body = fnStmt->body;
 
     startScope(fComp);
     for (u64 i = 0; i < fnStmt->paramCount; i++) {
         u16 paramIndex = readVariableName(fComp, fnStmt->params[i]);
         defineVariable(fComp, paramIndex, fnStmt->params[i]);
     }
-    if (!compileFuncBody(fComp, fnStmt->body->stmt.SBlock.stmts)) {
+    // arguments are pushed by caller
+    trackStack(fComp, (int)fnStmt->paramCount);
+    struct SBlock *body = &fnStmt->body->stmt.SBlock;
+    if (!compileFuncBody(fComp, body->stmts, body->count)) {
         cmpError(comp, fnStmt->body->stmt.SBlock.op, COMPILER_FUNC_BLOCK);
-        return false;
+        return NULL;
     }
     PObj *fnObj = GetCompiledFunction(fComp);
     if (fnObj == NULL) {
         cmpError(comp, fnStmt->name, COMPILER_FUNC_STMT);
-        return false;
+        return NULL;
     }
     fnObj->v.OComFunction.paramCount = fnStmt->paramCount;
-    u16 constIndex = addConstant(comp, MakeObject(fnObj));
-    emitBtU16(comp, fnStmt->name, OP_CLOSURE, constIndex);
+    return fComp;
+}
+
+// Compile function `stmt` and emit code making its value. Returns the
+// compiled function, NULL on errors
+static PObj *compileFunc(PCompiler *comp, PStmt *stmt) {
+    struct SFunc *fnStmt = &stmt->stmt.SFunc;
+    PCompiler *fComp = NULL;
 
-    // emit informatin about function scope upvalues
-    for (i16 i = 0; i < fnObj->v.OComFunction.upvalCount; i++) {
-        EmitRawU16(getbt(comp), fComp->upvals[i].isLocal ? 1 : 0);
-        EmitRawU16(getbt(comp), fComp->upvals[i].index);
+    if (isNonEscapingFunc(comp, stmt)) {
+        fComp = compileFuncObj(comp, stmt, true);
+        if (fComp == NULL) {
+            return NULL;
+        }
+        if (fComp->directFailed) {
+            FreeCompiler(fComp);
+            fComp = NULL;
+        }
+    }
+
+    if (fComp == NULL) {
+        fComp = compileFuncObj(comp, stmt, false);
+        if (fComp == NULL) {
+            return NULL;
+        }
+    }
+
+    PObj *fnObj = fComp->func;
+    if (fComp->isDirect) {
+        // the compiled function itself is the value of the local
+        u32 constIndex = addConstant(comp, MakeObject(fnObj), fnStmt->name);
+        emitConstant(comp, fnStmt->name, constIndex);
+    } else {
+        u16 constIndex =
+            addShortConstant(comp, MakeObject(fnObj), fnStmt->name);
+        emitBtU16(comp, fnStmt->name, OP_CLOSURE, constIndex);
+
+        // emit informatin about function scope upvalues
+        // local slots and upvalue indexes are always below `UINT8_MAX`
+        for (i16 i = 0; i < fnObj->v.OComFunction.upvalCount; i++) {
+            EmitRawU8(
+                getbt(comp), fComp->upvals[i].isLocal ? CLOSURE_UPVAL_LOCAL : 0
+            );
+            EmitRawU8(getbt(comp), (u8)fComp->upvals[i].index);
+        }
     }
 
 #if defined(PANKTI_BUILD_DEBUG)
     if (FLAG_DEBUG_BYTECODE) {
-        PanPrint("--------- %s --------\n", stmt->op->lexeme);
+        PanPrint(
+            "--------- %.*s --------\n", (int)stmt->op->len, stmt->op->lexeme
+        );
         DebugBytecode(fnObj->v.OComFunction.code, 0);
     }
 #endif
     FreeCompiler(fComp);
+    return fnObj;
+}
+
+static bool stmtRebinds(PStmt *stmt, Token *name, PStmt *self);
+
+// Check if expression `expr` assigns to `name`
+static bool exprRebinds(PExpr *expr, Token *name) {
+    if (expr == NULL) {
+        return false;
+    }
+
+    switch (expr->type) {
+        case EXPR_ASSIGN: {
+            PExpr *target = expr->exp.EAssign.name;
+            if (target->type == EXPR_VARIABLE &&
+                isIdentTokenEqual(target->exp.EVariable.name, name)) {
+                return true;
+            }
+            return exprRebinds(target, name) ||
+                   exprRebinds(expr->exp.EAssign.value, name);
+        }
+        case EXPR_BINARY:
+            return exprRebinds(expr->exp.EBinary.left, name) ||
+                   exprRebinds(expr->exp.EBinary.right, name);
+        case EXPR_LOGICAL:
+            return exprRebinds(expr->exp.ELogical.left, name) ||
+                   exprRebinds(expr->exp.ELogical.right, name);
+        case EXPR_UNARY: return exprRebinds(expr->exp.EUnary.right, name);
+        case EXPR_GROUPING:
+            return exprRebinds(expr->exp.EGrouping.expr, name);
+        case EXPR_SUBSCRIPT:
+            return exprRebinds(expr->exp.ESubscript.value, name) ||
+                   exprRebinds(expr->exp.ESubscript.index, name);
+        case EXPR_MODGET: return exprRebinds(expr->exp.EModget.module, name);
+        case EXPR_ARRAY: {
+            struct EArray *arr = &expr->exp.EArray;
+            for (u64 i = 0; i < arr->count; i++) {
+                if (exprRebinds(arr->items[i], name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_MAP: {
+            struct EMap *map = &expr->exp.EMap;
+            for (u64 i = 0; i < map->count; i++) {
+                if (exprRebinds(map->etable[i], name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_CALL: {
+            struct ECall *call = &expr->exp.ECall;
+            if (exprRebinds(call->callee, name)) {
+                return true;
+            }
+            for (u64 i = 0; i < call->argCount; i++) {
+                if (exprRebinds(call->args[i], name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case EXPR_VARIABLE:
+        case EXPR_LITERAL: return false;
+    }
+
+    return true;
+}
+
+static bool stmtsRebind(PStmt **stmts, u64 count, Token *name, PStmt *self) {
+    for (u64 i = 0; i < count; i++) {
+        if (stmtRebinds(stmts[i], name, self)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check if statement `stmt` declares, imports or assigns `name`, other than
+// by function declaration `self`. Locals with the name are counted too
+static bool stmtRebinds(PStmt *stmt, Token *name, PStmt *self) {
+    if (stmt == NULL) {
+        return false;
+    }
+
+    switch (stmt->type) {
+        case STMT_EXPR: return exprRebinds(stmt->stmt.SExpr.expr, name);
+        case STMT_DEBUG: return exprRebinds(stmt->stmt.SDebug.expr, name);
+        case STMT_RETURN: return exprRebinds(stmt->stmt.SReturn.value, name);
+        case STMT_LET:
+            return isIdentTokenEqual(stmt->stmt.SLet.name, name) ||
+                   exprRebinds(stmt->stmt.SLet.expr, name);
+        case STMT_IMPORT:
+            return isIdentTokenEqual(stmt->stmt.SImport.name, name);
+        case STMT_BLOCK:
+            return stmtsRebind(
+                stmt->stmt.SBlock.stmts, stmt->stmt.SBlock.count, name, self
+            );
+        case STMT_IF:
+            return exprRebinds(stmt->stmt.SIf.cond, name) ||
+                   stmtRebinds(stmt->stmt.SIf.thenBranch, name, self) ||
+                   stmtRebinds(stmt->stmt.SIf.elseBranch, name, self);
+        case STMT_WHILE:
+            return exprRebinds(stmt->stmt.SWhile.cond, name) ||
+                   stmtRebinds(stmt->stmt.SWhile.body, name, self);
+        case STMT_FUNC:
+            if (stmt != self && isIdentTokenEqual(stmt->stmt.SFunc.name, name)) {
+                return true;
+            }
+            return stmtRebinds(stmt->stmt.SFunc.body, name, self);
+        case STMT_BREAK:
+        case STMT_CONTINUE: return false;
+    }
+
     return true;
 }
 
+// Check if parameters of `fn` can be replaced by arguments in returned
+// expression `expr`. `next` is the next parameter expected to be read
+static bool isInPlaceExpr(struct SFunc *fn, PExpr *expr, u64 *next) {
+    switch (expr->type) {
+        case EXPR_LITERAL: return true;
+        case EXPR_VARIABLE: {
+            Token *name = expr->exp.EVariable.name;
+            if (*next < fn->paramCount &&
+                isIdentTokenEqual(fn->params[*next], name)) {
+                (*next)++;
+                return true;
+            }
+            return false;
+        }
+        case EXPR_BINARY:
+            return isInPlaceExpr(fn, expr->exp.EBinary.left, next) &&
+                   isInPlaceExpr(fn, expr->exp.EBinary.right, next);
+        case EXPR_UNARY:
+            return isInPlaceExpr(fn, expr->exp.EUnary.right, next);
+        case EXPR_GROUPING:
+            return isInPlaceExpr(fn, expr->exp.EGrouping.expr, next);
+        default: return false;
+    }
+}
+
+// Check if expression `expr` can be inlined, it must not assign anything
+static bool isInlineExpr(PExpr *expr) {
+    if (expr == NULL) {
+        return false;
+    }
+
+    switch (expr->type) {
+        case EXPR_ASSIGN: return false;
+        case EXPR_LITERAL:
+        case EXPR_VARIABLE: return true;
+        case EXPR_BINARY:
+            return isInlineExpr(expr->exp.EBinary.left) &&
+                   isInlineExpr(expr->exp.EBinary.right);
+        case EXPR_LOGICAL:
+            return isInlineExpr(expr->exp.ELogical.left) &&
+                   isInlineExpr(expr->exp.ELogical.right);
+        case EXPR_UNARY: return isInlineExpr(expr->exp.EUnary.right);
+        case EXPR_GROUPING: return isInlineExpr(expr->exp.EGrouping.expr);
+        case EXPR_SUBSCRIPT:
+            return isInlineExpr(expr->exp.ESubscript.value) &&
+                   isInlineExpr(expr->exp.ESubscript.index);
+        case EXPR_MODGET: return isInlineExpr(expr->exp.EModget.module);
+        case EXPR_ARRAY: {
+            struct EArray *arr = &expr->exp.EArray;
+            for (u64 i = 0; i < arr->count; i++) {
+                if (!isInlineExpr(arr->items[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case EXPR_MAP: {
+            struct EMap *map = &expr->exp.EMap;
+            for (u64 i = 0; i < map->count; i++) {
+                if (!isInlineExpr(map->etable[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case EXPR_CALL: {
+            struct ECall *call = &expr->exp.ECall;
+            if (!isInlineExpr(call->callee)) {
+                return false;
+            }
+            for (u64 i = 0; i < call->argCount; i++) {
+                if (!isInlineExpr(call->args[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Remember top level function `stmt`, compiled to `fnObj`, if its calls can
+// be inlined. See `compileInlineCall`
+static void addInlineFn(PCompiler *comp, PStmt *stmt, PObj *fnObj) {
+    struct SFunc *fnStmt = &stmt->stmt.SFunc;
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    PStmt **body = fnStmt->body->stmt.SBlock.stmts;
+    if (fnStmt->body->stmt.SBlock.count != 1 || body[0]->type != STMT_RETURN ||
+        fn->upvalCount != 0 || fn->code->codeCount > INLINE_MAX_CODE) {
+        return;
+    }
+
+    PExpr *value = body[0]->stmt.SReturn.value;
+    if (!isInlineExpr(value)) {
+        return;
+    }
+
+    for (u64 i = 0; i < comp->progCount; i++) {
+        if (stmtRebinds(comp->prog[i], fnStmt->name, stmt)) {
+            return;
+        }
+    }
+
+    u64 next = 0;
+    bool inPlace =
+        isInPlaceExpr(fnStmt, value, &next) && next == fnStmt->paramCount;
+    PCompInlineFn inlineFn = {.stmt = stmt, .inPlace = inPlace};
+    arrput(comp->inlineFns, inlineFn);
+}
+
 static bool compileFuncStmt(PCompiler *comp, PStmt *stmt) {
     struct SFunc *fnStmt = &stmt->stmt.SFunc;
     u16 identIndex = readVariableName(comp, fnStmt->name);
     markLocalInit(comp);
-    compileFunc(comp, stmt);
+    PObj *fnObj = compileFunc(comp, stmt);
+    if (fnObj != NULL && comp->enclosing == NULL && comp->scopeDepth == 0 &&
+        !comp->session) {
+        addInlineFn(comp, stmt, fnObj);
+    }
     defineVariable(comp, identIndex, fnStmt->name);
     return true;
 }
@@ -1101,7 +2029,14 @@ static bool compileReturnStmt(PCompiler *comp, PStmt *stmt) {
         cmpError(comp, retStmt->op, COMPILER_RETURN_TOP_LEVEL);
         return false;
     }
-    if (retStmt->value != NULL) {
+    if (retStmt->value != NULL && retStmt->value->type == EXPR_CALL) {
+        // `return f(...)`, the called function can reuse our frame.
+        // `OP_RETURN` is still needed for callees which can't (natives etc.)
+        if (!compileCall(comp, retStmt->value, OP_TAIL_CALL)) {
+            cmpError(comp, retStmt->value->op, COMPILER_RETURN_STMT);
+            return false;
+        }
+    } else if (retStmt->value != NULL) {
         if (!compileExpr(comp, retStmt->value)) {
             cmpError(comp, retStmt->value->op, COMPILER_RETURN_STMT);
             return false;
@@ -1123,6 +2058,25 @@ static bool compileImportStmt(PCompiler *comp, PStmt *stmt) {
     }
 
     emitBtU16(comp, importStmt->op, OP_IMPORT, customNameIndex);
+
+    // Runs before any code compiled after it, see `findIntrinsic`. Module
+    // names have no escapes, so the raw path is enough to find the module
+    PExpr *path = importStmt->path;
+    if (comp->enclosing == NULL && comp->scopeDepth == 0 &&
+        comp->loopCtx == NULL && path->type == EXPR_LITERAL &&
+        path->exp.ELiteral.type == EXP_LIT_STR) {
+        char buf[LEXEME_BUF_SIZE];
+        StdlibMod mod = lexemeStr(path->exp.ELiteral.op, buf)
+                            ? GetStdlibMod(buf)
+                            : STDLIB_NONE;
+        Token *name = importStmt->name;
+        PCompImport import = {
+            .name = StrDuplicate(name->lexeme, name->len),
+            .len = name->len,
+            .mod = mod,
+        };
+        arrput(comp->imports, import);
+    }
     return true;
 }
 
@@ -13,6 +13,7 @@
 #include "diagonctx.h"
 #include "object.h"
 #include "opcode.h"
+#include "pstdlib.h"
 #include "ptypes.h"
 #include "token.h"
 #include <stdbool.h>
@@ -45,11 +46,48 @@ typedef enum PCompFuncType {
 
 // Loop Context for Break and Continue statements
 typedef struct PCompLoopCtx {
-    u16 *breakJumps;
-    u16 loopStart;
+    u64 *breakJumps;
+    u64 loopStart;
+    // Scope depth outside of the loop body
+    int scopeDepth;
     struct PCompLoopCtx *enclosing;
 } PCompLoopCtx;
 
+// Top level function whose calls can be inlined, see `compileInlineCall`
+typedef struct PCompInlineFn {
+    // The function statement
+    PStmt *stmt;
+    // Arguments can be compiled in place of the parameters, the returned
+    // expression reads each parameter once and in order
+    bool inPlace;
+} PCompInlineFn;
+
+// Inlined call being compiled
+typedef struct PCompInline {
+    struct SFunc *fn;
+    // Call expression
+    PExpr *call;
+    // Constant index of function name
+    u16 name;
+    // Current inlined code range of bytecode
+    u64 range;
+    // Stack slot of the result, arguments are in the slots after it. `-1` if
+    // arguments are compiled in place
+    int slot;
+    // Inlined call the call expression is in
+    struct PCompInline *enclosing;
+} PCompInline;
+
+// Standard library module imported by a top level statement, see
+// `compileIntrinsicCall`
+typedef struct PCompImport {
+    // Name the module is imported as, a copy so it outlives the AST. See
+    // `CompilerNewChunk`
+    char *name;
+    u32 len;
+    StdlibMod mod;
+} PCompImport;
+
 // Pankti Compiler Object
 typedef struct PCompiler {
     // Parser passed AST
@@ -67,6 +105,8 @@ typedef struct PCompiler {
     // `0` means top level script
     // the more deep we the go more scopeDepth is increased
     int scopeDepth;
+    // Current stack depth of emitted code, see `PBytecode.maxStack`
+    int stackDepth;
 
     Token *dummyToken;
 
@@ -77,12 +117,33 @@ typedef struct PCompiler {
     // Compiled function object, where the bytecodes, constants will be
     // emitted. The function will be returned after compiling finished
     PObj *func;
+    // Name of the function being compiled, NULL for top level script
+    Token *name;
     // Current compiling function type.
     // Top level script or user defined function
     PCompFuncType funcType;
     // Enclosing compiler
     struct PCompiler *enclosing;
     PCompLoopCtx *loopCtx;
+    // Body block of the function being compiled, used for escape analysis
+    // of nested functions. NULL for top level script
+    PStmt *body;
+    // Compiling a non escaping nested function, which is called directly
+    // and reaches enclosing function's locals with `OP_GET_OUTER`
+    bool isDirect;
+    // Set if direct compile is not possible. See `compileFunc`
+    bool directFailed;
+    // Inlined call being compiled, NULL if none
+    PCompInline *inl;
+    // Functions which calls can be inlined. Only used in top level compiler
+    PCompInlineFn *inlineFns;
+    // Modules imported so far. Only used in top level compiler
+    PCompImport *imports;
+    // Compiler of the function being compiled inside this one, NULL if none
+    struct PCompiler *inner;
+    // Compiling chunks of a session, see `CompilerNewChunk`. Any chunk after
+    // this one can rebind a global, so no calls are inlined
+    bool session;
 } PCompiler;
 
 // Create a new compiler object
@@ -102,6 +163,10 @@ void FreeCompiler(PCompiler *comp);
 void CompilerMarkRoots(Pgc *gc, void *ctx);
 // Compile a root AST Node
 bool CompilerCompile(PCompiler *compiler, PStmt **prog);
+// Start compiling the next chunk of a session with a new top level function.
+// Globals and modules imported by chunks before it are kept, anything left
+// by a chunk which stopped at an error is dropped
+bool CompilerNewChunk(PCompiler *comp);
 
 void DebugCompilerTree(PCompiler *comp);
 
@@ -8,6 +8,7 @@
 
 #include "core.h"
 #include "alloc.h"
+#include "arena.h"
 #include "ast.h"
 #include "compiler.h"
 #include "diagonctx.h"
@@ -23,6 +24,7 @@
 #include "ptypes.h"
 #include "terminal.h"
 #include "token.h"
+#include "unicode.h"
 #include "utils.h"
 #include "vm.h"
 
@@ -31,6 +33,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #if defined(PANKTI_BUILD_DEBUG)
@@ -55,85 +58,86 @@ static void coreParserErrorBridge(
     CoreParserError((PanktiCore *)ctx, tok, code, args);
 }
 
+// Create GC, compiler and VM of `core`. False if any of them can't be
+// created, the ones which were are freed
+static bool newCoreRuntime(PanktiCore *core) {
+    core->gc = NewGc();
+    if (core->gc == NULL) {
+        return false;
+    }
+    core->compiler = NewCompiler(
+        core->gc, (PDiagonCtx){.report = coreCompilerErrorBridge, .ctx = core}
+    );
+
+    if (core->compiler == NULL) {
+        FreeGc(core->gc);
+        return false;
+    }
+    core->vm = NewVm(
+        core->gc, (PDiagonCtx){.report = coreRuntimeErrorBridge, .ctx = core}
+    );
+
+    if (core->vm == NULL) {
+        FreeGc(core->gc);
+        FreeCompiler(core->compiler);
+        return false;
+    }
+
+    GcRegisterRootMarker(core->gc, VmMarkRoots, core->vm);
+    GcRegisterRootMarker(core->gc, CompilerMarkRoots, core->compiler);
+    return true;
+}
+
 PanktiCore *NewCore(const char *scriptPath) {
     PanktiCore *core = PCreate(PanktiCore);
     if (core == NULL) {
         return NULL;
     }
     core->scriptPath = scriptPath;
-    core->source = PanReadFile(core->scriptPath);
-
-    if (core->source == NULL) {
+    if (!PanLoadSource(core->scriptPath, &core->source)) {
         PanPrint("Failed to Read Source Code\n");
         PFree(core);
         return NULL;
     }
 
-    core->lexer = NewLexer(core->source);
+    core->lines = (PLineIndex){.source = core->source.text, .starts = NULL};
+    core->arena = NewArena();
+    if (core->arena == NULL) {
+        PanFreeSource(&core->source);
+        PFree(core);
+        return NULL;
+    }
+    core->lexer = NewLexer(core->source.text, core->arena);
 
     if (core->lexer == NULL) {
+        FreeArena(core->arena);
+        PanFreeSource(&core->source);
         PFree(core);
         return NULL;
     }
 
+    // Source is freed by core, it is dropped early. See `releaseFrontend`
+    MakeLexerRaw(core->lexer, true);
     core->lexer->core = core;
     core->parser = NULL;
 
     core->scriptArgs = NULL;
     core->scriptArgCount = 0;
+    core->regEngine = false;
+    core->recover = NULL;
+    core->sessionLines = 0;
 
     core->caughtError = false;
     core->runtimeError = false;
-    core->gc = NewGc();
-    if (core->gc == NULL) {
-        if (core->lexer != NULL) {
-            FreeLexer(core->lexer);
-        }
-
-        PFree(core);
-        return NULL;
-    }
-    core->lexer->timestamp = core->gc->timestamp;
-    core->compiler = NewCompiler(
-        core->gc, (PDiagonCtx){.report = coreCompilerErrorBridge, .ctx = core}
-    );
-
-    if (core->compiler == NULL) {
-        if (core->lexer != NULL) {
-            FreeLexer(core->lexer);
-        }
-
-        if (core->gc != NULL) {
-            FreeGc(core->gc);
-        }
-
-        PFree(core);
-        return NULL;
-    }
-    core->vm = NewVm(
-        core->gc, (PDiagonCtx){.report = coreRuntimeErrorBridge, .ctx = core}
-    );
-
-    if (core->vm == NULL) {
-        if (core->lexer != NULL) {
-            FreeLexer(core->lexer);
-        }
-
-        if (core->gc != NULL) {
-            FreeGc(core->gc);
-        }
-
-        if (core->compiler != NULL) {
-            FreeCompiler(core->compiler);
-        }
+    if (!newCoreRuntime(core)) {
+        FreeLexer(core->lexer);
+        FreeArena(core->arena);
+        PanFreeSource(&core->source);
 
         PFree(core);
         return NULL;
     }
 
-    GcRegisterRootMarker(core->gc, VmMarkRoots, core->vm);
-    GcRegisterRootMarker(core->gc, CompilerMarkRoots, core->compiler);
-
     return core;
 }
 
@@ -141,6 +145,7 @@ void FreeCore(PanktiCore *core) {
     if (core == NULL) {
         return;
     }
+    FreeLineIndex(&core->lines);
     if (core->gc != NULL) {
         FreeGc(core->gc);
     }
@@ -152,6 +157,8 @@ void FreeCore(PanktiCore *core) {
         FreeLexer(core->lexer);
     }
 
+    PanFreeSource(&core->source);
+
     if (core->compiler != NULL) {
         FreeCompiler(core->compiler);
     }
@@ -160,9 +167,41 @@ void FreeCore(PanktiCore *core) {
         FreeVm(core->vm);
     }
 
+    FreeArena(core->arena);
+
     PFree(core);
 }
 
+// Free the source, tokens and AST once the script is compiled, the bytecode
+// keeps positions it needs for errors. Source is loaded again to print a
+// runtime error, see `reloadSource`, unless it came from a pipe
+static void releaseFrontend(PanktiCore *core) {
+    FreeParser(core->parser);
+    core->parser = NULL;
+    FreeLexer(core->lexer);
+    core->lexer = NULL;
+    FreeArena(core->arena);
+    core->arena = NULL;
+    core->compiler->prog = NULL;
+    core->compiler->progCount = 0;
+
+    if (core->source.reloadable) {
+        FreeLineIndex(&core->lines);
+        PanFreeSource(&core->source);
+        core->lines.source = NULL;
+    }
+}
+
+// Read the script again after `releaseFrontend`, to print the source line of
+// an error
+static void reloadSource(PanktiCore *core) {
+    if (core->source.text != NULL) {
+        return;
+    }
+    PanLoadSource(core->scriptPath, &core->source);
+    core->lines = (PLineIndex){.source = core->source.text, .starts = NULL};
+}
+
 PCoreErrorType RunCore(PanktiCore *core) {
     if (core == NULL) {
         PanPrint("Internal Error : Failed to create Pankti Core\n");
@@ -211,7 +250,7 @@ PCoreErrorType RunCore(PanktiCore *core) {
         exit(1);
     }
 
-    core->parser = NewParser(core->gc, core->lexer);
+    core->parser = NewParser(core->arena, core->lexer);
     if (core->parser == NULL) {
         PanPrint("Internal Error : Failed to create Pankti Parser\n");
         return PCERR_CORE;
@@ -265,6 +304,7 @@ PCoreErrorType RunCore(PanktiCore *core) {
     CompilerCompile(core->compiler, prog);
 
     PObj *comFn = GetCompiledFunction(core->compiler);
+    releaseFrontend(core);
 
 #if defined(PANKTI_BUILD_DEBUG)
     if (FLAG_DEBUG_TIMES) {
@@ -279,10 +319,13 @@ PCoreErrorType RunCore(PanktiCore *core) {
         PanPrint("[DEBUG] Compiler finished in : %f sec.\n", compilerTime);
     }
 #endif
-    SetupVm(
-        core->vm, comFn, core->scriptPath, core->scriptArgCount,
-        core->scriptArgs
-    );
+    core->vm->regEngine = core->regEngine;
+    if (!SetupVm(
+            core->vm, comFn, core->scriptPath, core->scriptArgCount,
+            core->scriptArgs
+        )) {
+        return PCERR_RUNTIME;
+    }
 
 #if defined(PANKTI_BUILD_DEBUG)
     if (FLAG_DEBUG_TIMES) {
@@ -295,6 +338,10 @@ PCoreErrorType RunCore(PanktiCore *core) {
         end = clock();
         double vmTime = ((double)(end - start)) / CLOCKS_PER_SEC;
         PanPrint("[DEBUG] VM finished in : %f sec.\n", vmTime);
+        PanPrint(
+            "[DEBUG] VM executed : %llu instructions\n",
+            (unsigned long long)core->vm->insCount
+        );
     }
 #endif
     if (core->caughtError) {
@@ -309,6 +356,143 @@ PCoreErrorType RunCore(PanktiCore *core) {
     return PCERR_OK;
 }
 
+// Name of a session in stack traces
+#define CORE_SESSION_NAME "repl"
+
+PanktiCore *NewSessionCore(void) {
+    PanktiCore *core = PCreate(PanktiCore);
+    if (core == NULL) {
+        return NULL;
+    }
+    *core = (PanktiCore){0};
+    core->scriptPath = CORE_SESSION_NAME;
+
+    // Chunks are appended to the source as they come, errors can point into
+    // any of them
+    core->source.text = PCalloc(1, 1);
+    if (core->source.text == NULL) {
+        PFree(core);
+        return NULL;
+    }
+    core->lines = (PLineIndex){.source = core->source.text, .starts = NULL};
+
+    if (!newCoreRuntime(core)) {
+        PanFreeSource(&core->source);
+        PFree(core);
+        return NULL;
+    }
+
+    stbds_rand_seed((size_t)time(NULL));
+    srand(time(NULL));
+    SetupVmSession(core->vm, core->scriptPath, 0, NULL);
+    return core;
+}
+
+// Append chunk `src` of `len` bytes to the session source, ending it with a
+// newline. `start` is set to where it starts in the source
+static bool appendChunk(
+    PanktiCore *core, const char *src, u64 len, u64 *start
+) {
+    bool newline = len == 0 || src[len - 1] != '\n';
+    u64 size = core->source.len + len + (newline ? 1 : 0);
+    char *text = PRealloc(core->source.text, size + 1);
+    if (text == NULL) {
+        return false;
+    }
+
+    memcpy(text + core->source.len, src, (size_t)len);
+    if (newline) {
+        text[size - 1] = '\n';
+    }
+    text[size] = '\0';
+    *start = core->source.len;
+    core->source.text = text;
+    core->source.len = size;
+
+    FreeLineIndex(&core->lines);
+    core->lines = (PLineIndex){.source = text, .starts = NULL};
+    return true;
+}
+
+// End chunk of a session with `err`, dropping its tokens and AST, and the
+// frames it left if it stopped at an error
+static PCoreErrorType endChunk(PanktiCore *core, PCoreErrorType err) {
+    core->recover = NULL;
+    releaseFrontend(core);
+    if (core->caughtError) {
+        VmReset(core->vm);
+    }
+    core->caughtError = false;
+    core->runtimeError = false;
+    PanFlushStdout();
+    return err;
+}
+
+PCoreErrorType RunCoreChunk(PanktiCore *core, const char *src, u64 len) {
+    u64 start = 0;
+    u64 firstLine = core->sessionLines + 1;
+    if (!appendChunk(core, src, len, &start)) {
+        return PCERR_CORE;
+    }
+    for (u64 i = start; i < core->source.len; i++) {
+        if (core->source.text[i] == '\n') {
+            core->sessionLines++;
+        }
+    }
+
+    core->arena = NewArena();
+    if (core->arena == NULL) {
+        return PCERR_CORE;
+    }
+    core->lexer = NewLexer(core->source.text + start, core->arena);
+    if (core->lexer == NULL) {
+        return endChunk(core, PCERR_CORE);
+    }
+    MakeLexerRaw(core->lexer, true);
+    core->lexer->core = core;
+    core->lexer->line = firstLine;
+
+    // Compiler and runtime errors jump back here, see `CoreRuntimeError`
+    jmp_buf recover;
+    core->recover = &recover;
+    if (setjmp(recover) != 0) {
+        return endChunk(
+            core, core->runtimeError ? PCERR_RUNTIME : PCERR_COMPILER
+        );
+    }
+
+    ScanTokens(core->lexer);
+    if (core->lexer->hasError) {
+        return endChunk(core, PCERR_LEXER);
+    }
+
+    core->parser = NewParser(core->arena, core->lexer);
+    if (core->parser == NULL) {
+        return endChunk(core, PCERR_CORE);
+    }
+    core->parser->errCtx =
+        (PDiagonCtx){.report = coreParserErrorBridge, .ctx = core};
+
+    PStmt **prog = ParseParser(core->parser);
+    if (core->lexer->hasError) {
+        return endChunk(core, PCERR_LEXER);
+    }
+    if (core->parser->hasError) {
+        return endChunk(core, PCERR_PARSER);
+    }
+
+    if (!CompilerNewChunk(core->compiler)) {
+        return endChunk(core, PCERR_CORE);
+    }
+    CompilerCompile(core->compiler, prog);
+    PObj *comFn = GetCompiledFunction(core->compiler);
+    releaseFrontend(core);
+
+    core->vm->regEngine = core->regEngine;
+    VmRunChunk(core->vm, comFn);
+    return endChunk(core, PCERR_OK);
+}
+
 static inline char *coreErrorToStr(PCoreErrorType errtype) {
     switch (errtype) {
         case PCERR_LEXER:
@@ -323,11 +507,11 @@ static inline char *coreErrorToStr(PCoreErrorType errtype) {
 }
 
 static void printSourceLine(PanktiCore *core, u64 lineNum, u64 col, u64 len) {
-    if (core == NULL || core->source == NULL || lineNum == 0) {
+    if (core == NULL || core->source.text == NULL || lineNum == 0) {
         return;
     }
 
-    const char *ptr = core->source;
+    const char *ptr = core->source.text;
     u64 cur = 1; // current line number
 
     // as long we get character while current line is less than lineNum
@@ -431,6 +615,7 @@ void CoreRuntimeError(
     PanktiCore *core, Token *token, PanDiagCode code, va_list args
 ) {
     PanFlushStdout();
+    reloadSource(core);
     u64 line = 0;
     u64 col = 0;
     u64 gcol = 0;
@@ -439,7 +624,7 @@ void CoreRuntimeError(
     if (token != NULL) {
         line = token->line;
         col = token->col;
-        gcol = token->gcol;
+        gcol = LineIndexGraphemeCol(&core->lines, line, col);
         len = token->len;
     }
 
@@ -456,7 +641,12 @@ void CoreRuntimeError(
     printSourceLine(core, line, col, len);
     printHintMsg(core, code);
     PanFPrint(stderr, "\n");
-    VmPrintStackTrace(core->vm);
+    VmPrintStackTrace(core->vm, &core->lines);
+    if (core->recover != NULL) {
+        core->caughtError = true;
+        core->runtimeError = true;
+        longjmp(*core->recover, 1);
+    }
     FreeCore(core);
     exit(EXIT_FAILURE);
 }
@@ -473,7 +663,7 @@ void CoreParserError(
     if (token != NULL) {
         line = token->line;
         col = token->col;
-        gcol = token->gcol;
+        gcol = LineIndexGraphemeCol(&core->lines, line, col);
         len = token->len;
     }
     const PanDiagInfo *info = DiagGetInfo(code);
@@ -523,7 +713,7 @@ void CoreCompilerError(
     if (token != NULL) {
         line = token->line;
         col = token->col;
-        gcol = token->gcol;
+        gcol = LineIndexGraphemeCol(&core->lines, line, col);
         len = token->len;
     }
     const PanDiagInfo *info = DiagGetInfo(code);
@@ -540,6 +730,10 @@ void CoreCompilerError(
 
     printHintMsg(core, code);
 
+    if (core->recover != NULL) {
+        core->caughtError = true;
+        longjmp(*core->recover, 1);
+    }
     FreeCore(core);
     exit(EXIT_FAILURE);
 }
@@ -11,6 +11,7 @@
 
 #include "compiler.h"
 #include "vm.h"
+#include <setjmp.h>
 #include <stdbool.h>
 #include <stdio.h>
 #ifdef __cplusplus
@@ -22,6 +23,8 @@ extern "C" {
 #include "parser.h"
 #include "ptypes.h"
 #include "token.h"
+#include "unicode.h"
+#include "utils.h"
 #include <stddef.h>
 
 // Main Body for whole pankti runtime
@@ -40,13 +43,26 @@ typedef struct PanktiCore {
     PVm *vm;
 
     Pgc *gc;
+    // Tokens and AST of the script, freed at once when it is compiled
+    PArena *arena;
 
-    // Original script as is
-    char *source;
+    // Original script as is, lexemes of tokens point into it. Freed when it
+    // is compiled, loaded again if a runtime error has to print it
+    PanSource source;
+    // Line starts of `source`, for grapheme based columns of errors
+    PLineIndex lines;
     // Path to script
     const char *scriptPath;
     char **scriptArgs;
     int scriptArgCount;
+    // Run with register engine
+    bool regEngine;
+    // Set while a chunk of a session runs, errors which would quit jump here
+    // instead. See `RunCoreChunk`
+    jmp_buf *recover;
+    // Lines of the session so far, the next chunk starts on the line after
+    // them
+    u64 sessionLines;
 
     // Has error?
     bool caughtError;
@@ -71,6 +87,15 @@ PanktiCore *NewCore(const char *scriptPath);
 void FreeCore(PanktiCore *core);
 // Run the script
 PCoreErrorType RunCore(PanktiCore *core);
+// Create Pankti Core for a session, which runs chunks of code one after
+// another with `RunCoreChunk` as if they were one script. Builtins are
+// registered once, the VM, globals and imported modules stay alive between
+// chunks
+PanktiCore *NewSessionCore(void);
+// Compile and run chunk `src` of `len` bytes in session `core`. Errors are
+// printed and the rest of the chunk is dropped, but the session goes on with
+// whatever the chunk did before the error
+PCoreErrorType RunCoreChunk(PanktiCore *core, const char *src, u64 len);
 // Throw Runtime Error and Quit
 // `core` = Interpreter Core
 // `token` = Token where the runtime error occurred; can be NULL if something
@@ -47,7 +47,6 @@ Pgc *NewGc(void) {
     gc->stress = false;
 #endif
     gc->objects = NULL;
-    gc->stmts = NULL;
     gc->timestamp = (u64)time(NULL);
     gc->objCount = 0;
     gc->grayStack = NULL;
@@ -65,15 +64,6 @@ static void freeObjects(Pgc *gc) {
     }
 }
 
-static void freeStatements(Pgc *gc) {
-    PStmt *stmt = gc->stmts;
-    while (stmt != NULL) {
-        PStmt *nextStmt = stmt->next;
-        FreeStmt(gc, stmt);
-        stmt = nextStmt;
-    }
-}
-
 void FreeGc(Pgc *gc) {
 #if defined(PANKTI_BUILD_DEBUG)
     if (FLAG_DEBUG_GC) {
@@ -87,7 +77,6 @@ void FreeGc(Pgc *gc) {
         return;
     }
 
-    freeStatements(gc);
     freeObjects(gc);
     if (gc->strings != NULL) {
         FreeStringPool(gc->strings);
@@ -18,6 +18,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "arena.h"
 #include "ast.h"
 #include "object.h"
 #include "ptypes.h"
@@ -67,9 +68,6 @@ typedef struct Pgc {
     // Linked list to all the objects
     // to traverse the chain for marking, freeing
     PObj *objects;
-    // Linked list to all the statements
-    // Freed at the end
-    PStmt *stmts;
 
     // Link to roots
     PGcRootMarker markers[GC_MARKER_CAP];
@@ -96,7 +94,7 @@ typedef struct Pgc {
 
 // Create new Garbage Collector Object
 Pgc *NewGc(void);
-// Free Garbage Collector and all owned objects, statements, strings etc.
+// Free Garbage Collector and all owned objects, strings etc.
 void FreeGc(Pgc *gc);
 // Start Garbage collection process
 void CollectGarbage(Pgc *gc);
@@ -124,13 +122,13 @@ PObj *NewObject(Pgc *gc, PObjType type);
 void FreeObject(Pgc *gc, PObj *o);
 
 // Create New String Object
-// `name` = Token (optional if virtual, created in runtime)
 // `value` = String value
 // `noDup` = Don't duplicate the value, it means we are giving you already
 // mallocd string, just chanding ownership
-PObj *NewStrObject(Pgc *gc, Token *name, char *value, bool noDup);
+PObj *NewStrObject(Pgc *gc, char *value, bool noDup);
 
 // Create New Compiled Function Object
+// `name` = Function name, copied to `strName`. NULL for top level script
 PObj *NewComFuncObject(Pgc *gc, Token *name);
 
 // Create New Closure Object
@@ -148,51 +146,51 @@ PObj *NewNativeFnObject(Pgc *gc, const char *name, NativeFn fn, int arity);
 PObj *NewModuleObject(Pgc *gc, char *name, char *path);
 PObj *NewUpvalueObject(Pgc *gc, PValue *slot);
 
+// AST nodes are allocated from `arena` and only freed with it. Child arrays
+// (`args`, `items`, `params`, `stmts`) must be allocated from it as well
+
 // Create New (Empty) Expression
 // `type` = Expression Type
 // Return => New Expression with type `type` or NULL in case of failure
-PExpr *NewExpr(Pgc *gc, PExprType type, Token *op);
-
-// Free Expression
-void FreeExpr(Pgc *gc, PExpr *expr);
+PExpr *NewExpr(PArena *arena, PExprType type, Token *op);
 
 // New Binary Expression. Type : `EXPR_BINARY`
 // `op` = Raw operator token
 // `left` = Left hand side expression
 // `right` = Right hand side expression
 // Return => New Binary Expression as Expression pointer or NULL
-PExpr *NewBinaryExpr(Pgc *gc, PExpr *left, Token *op, PExpr *right);
+PExpr *NewBinaryExpr(PArena *arena, PExpr *left, Token *op, PExpr *right);
 
 // New Unary Expression. Type : `EXPR_UNARY`
 // `op` = Raw operator token
 // `right` = Right hand side [Original] expression
 // Return => New Unary Expression as Expression pointer or NULL
-PExpr *NewUnary(Pgc *gc, Token *op, PExpr *right);
+PExpr *NewUnary(PArena *arena, Token *op, PExpr *right);
 
 // New Literal Expression (ie. Bool, String, Nil etc). Type : `EXPR_LITERAL`
 // `op` = Raw token
 // `type` = Literal type
 // Return => New Literal Expression as Expression pointer or NULL
-PExpr *NewLiteral(Pgc *gc, Token *op, ExpLitType type);
+PExpr *NewLiteral(PArena *arena, Token *op, ExpLitType type);
 
 // New Grouping Expression. Type : `EXPR_GROUPING`
 // `(<expr>)`
 // Return => New Grouping Expression as Expression pointer or NULL
-PExpr *NewGrouping(Pgc *gc, Token *op, PExpr *expr);
+PExpr *NewGrouping(PArena *arena, Token *op, PExpr *expr);
 
 // New Variable Expression. Type : `EXPR_VARIABLE`
 // `name` = Variable name
 // Return => New Variable Expression as Expression pointer or NULL
-PExpr *NewVarExpr(Pgc *gc, Token *name);
+PExpr *NewVarExpr(PArena *arena, Token *name);
 
 // New Assignment Expression. Type : `EXPR_ASSIGN`
 // Set `value` to a preexisting variable with name being `name`
 // Return => New Assignment Expression as Expression pointer or NULL
-PExpr *NewAssignment(Pgc *gc, Token *op, PExpr *name, PExpr *value);
+PExpr *NewAssignment(PArena *arena, Token *op, PExpr *name, PExpr *value);
 
 // New Logical Expression (ie. And, Or). Type : `EXPR_LOGICAL`
 // Return => New Logical Expression as Expression pointer or NULL
-PExpr *NewLogical(Pgc *gc, PExpr *left, Token *op, PExpr *right);
+PExpr *NewLogical(PArena *arena, PExpr *left, Token *op, PExpr *right);
 
 // New (Function) Calling Expression. Type : `EXPR_CALL`
 // `op` = Right parentheses of the call expression
@@ -200,47 +198,47 @@ PExpr *NewLogical(Pgc *gc, PExpr *left, Token *op, PExpr *right);
 // `args` = The argument array
 // `count` = Count of arguments
 // Return => New Call Expression as Expression pointer or NULL
-PExpr *NewCallExpr(Pgc *gc, Token *op, PExpr *callee, PExpr **args, u64 count);
+PExpr *NewCallExpr(
+    PArena *arena, Token *op, PExpr *callee, PExpr **args, u64 count
+);
 
 // New Array Expression
-PExpr *NewArrayExpr(Pgc *gc, Token *op, PExpr **items, u64 count);
+PExpr *NewArrayExpr(PArena *arena, Token *op, PExpr **items, u64 count);
 
 // Create New HashMap Expression
-PExpr *NewMapExpr(Pgc *gc, Token *op, PExpr **items, u64 count);
+PExpr *NewMapExpr(PArena *arena, Token *op, PExpr **items, u64 count);
 
-PExpr *NewSubscriptExpr(Pgc *gc, Token *op, PExpr *value, PExpr *index);
-PExpr *NewModgetExpr(Pgc *gc, Token *op, PExpr *module, Token *child);
+PExpr *NewSubscriptExpr(PArena *arena, Token *op, PExpr *value, PExpr *index);
+PExpr *NewModgetExpr(PArena *arena, Token *op, PExpr *module, Token *child);
 
 // Create New (Empty) Statement
 // Return => New Expression with type `type` or NULL in case of failure
-PStmt *NewStmt(Pgc *gc, PStmtType type, Token *op);
-
-// Free Statement
-void FreeStmt(Pgc *gc, PStmt *stmt);
+PStmt *NewStmt(PArena *arena, PStmtType type, Token *op);
 
 // Debug Statement
-PStmt *NewDebugStmt(Pgc *gc, Token *op, PExpr *value);
+PStmt *NewDebugStmt(PArena *arena, Token *op, PExpr *value);
 // New (Naked) Expression Statement
 // `op` = The last token the expression.
 // The first expression is not used as single token expression without any
 // statements can cause the `op` being NULL
 // `value` = The actual expression
 // Return => New Expression Statement as Statement pointer or NULL
-PStmt *NewExprStmt(Pgc *gc, Token *op, PExpr *value);
+PStmt *NewExprStmt(PArena *arena, Token *op, PExpr *value);
 
 // New Let (Variable Declaration) Statement
 // `name` = Variable name
 // `value` = The value to set
 // Return => New Let Statement as Statement pointer or NULL
-PStmt *NewLetStmt(Pgc *gc, Token *name, PExpr *value);
+PStmt *NewLetStmt(PArena *arena, Token *name, PExpr *value);
 
 // New Block Statement
 // In case of braced closure {....} `op` is the left brace
 // When used for functions or while loops `op` is the last `END` token
 // When used for If Statement, the `op` can be either `ELSE` or `END` depending
 // on the branch.
+// `count` = Number of statements in `stmts`
 // Return => New Block Statement as Statement pointer or NULL
-PStmt *NewBlockStmt(Pgc *gc, Token *op, PStmt **stmts);
+PStmt *NewBlockStmt(PArena *arena, Token *op, PStmt **stmts, u64 count);
 
 // New If Statement
 // `op` = The `IF` token
@@ -248,32 +246,34 @@ PStmt *NewBlockStmt(Pgc *gc, Token *op, PStmt **stmts);
 // `then` = Then branch
 // `elseB` = Else branch, it is optional and can be NULL
 // Return => New If Statement as Statement pointer or NULL
-PStmt *NewIfStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *then, PStmt *elseB);
+PStmt *NewIfStmt(
+    PArena *arena, Token *op, PExpr *cond, PStmt *then, PStmt *elseB
+);
 
 // New While Statement
 // `op` = The `WHILE` token
 // `cond` = The eonditional expression
 // `body` = The loop body. Always will be a Block Statement.
 // Return => New While Statement as Statement pointer or NULL
-PStmt *NewWhileStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *body);
+PStmt *NewWhileStmt(PArena *arena, Token *op, PExpr *cond, PStmt *body);
 
 // New Return Statement
 // `op` = The `RETURN` token
 // `value` = The actual value. It is optional and can be NULL
 // Return => New Return Statement as Statement pointer or NULL
-PStmt *NewReturnStmt(Pgc *gc, Token *op, PExpr *value);
+PStmt *NewReturnStmt(PArena *arena, Token *op, PExpr *value);
 
 // New Break Statement
 // `op` = The `BREAK` token
 // Only usable in While loops
 // Return => New Break Statement as Statement pointer or NULL
-PStmt *NewBreakStmt(Pgc *gc, Token *op);
+PStmt *NewBreakStmt(PArena *arena, Token *op);
 
 // New Continue Statement
 // `op` = The `CONTINUE` token
 // Only usable in While loops
 // Return => New Continue Statement as Statement pointer or NULL
-PStmt *NewContinueStmt(Pgc *gc, Token *op);
+PStmt *NewContinueStmt(PArena *arena, Token *op);
 
 // New Function Statement
 // `name` = The name token of the function
@@ -282,7 +282,7 @@ PStmt *NewContinueStmt(Pgc *gc, Token *op);
 // `count` = Number of parameters
 // Return => New Function Statement as Statement pointer or NULL
 PStmt *NewFuncStmt(
-    Pgc *gc, Token *name, Token **params, PStmt *body, u64 count
+    PArena *arena, Token *name, Token **params, PStmt *body, u64 count
 );
 
 // New Import Statement
@@ -290,7 +290,7 @@ PStmt *NewFuncStmt(
 // `iname` = The custom name for the import
 // `ipath` = The import path; must evaluate to a string
 // Return = New Import Statement as Statement pointer or NULL
-PStmt *NewImportStmt(Pgc *gc, Token *op, Token *iname, PExpr *ipath);
+PStmt *NewImportStmt(PArena *arena, Token *op, Token *iname, PExpr *ipath);
 
 #ifdef __cplusplus
 }
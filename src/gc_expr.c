@@ -6,9 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#include "alloc.h"
+#include "arena.h"
 #include "ast.h"
-#include "external/stb/stb_ds.h"
 #include "gc.h"
 #include "token.h"
 #include <stdbool.h>
@@ -19,8 +18,8 @@
 // Creation Functions
 // ===================
 
-PExpr *NewExpr(Pgc *gc, PExprType type, Token *op) {
-    PExpr *e = PCreate(PExpr);
+PExpr *NewExpr(PArena *arena, PExprType type, Token *op) {
+    PExpr *e = ArenaAlloc(arena, sizeof(PExpr));
     if (e == NULL) {
         return NULL;
     }
@@ -29,8 +28,8 @@ PExpr *NewExpr(Pgc *gc, PExprType type, Token *op) {
     return e;
 }
 
-PExpr *NewBinaryExpr(Pgc *gc, PExpr *left, Token *op, PExpr *right) {
-    PExpr *e = NewExpr(gc, EXPR_BINARY, op);
+PExpr *NewBinaryExpr(PArena *arena, PExpr *left, Token *op, PExpr *right) {
+    PExpr *e = NewExpr(arena, EXPR_BINARY, op);
     if (e == NULL) {
         return NULL;
     }
@@ -41,8 +40,8 @@ PExpr *NewBinaryExpr(Pgc *gc, PExpr *left, Token *op, PExpr *right) {
     return e;
 }
 
-PExpr *NewUnary(Pgc *gc, Token *op, PExpr *right) {
-    PExpr *e = NewExpr(gc, EXPR_UNARY, op);
+PExpr *NewUnary(PArena *arena, Token *op, PExpr *right) {
+    PExpr *e = NewExpr(arena, EXPR_UNARY, op);
     if (e == NULL) {
         return NULL;
     }
@@ -51,8 +50,8 @@ PExpr *NewUnary(Pgc *gc, Token *op, PExpr *right) {
     return e;
 }
 
-PExpr *NewLiteral(Pgc *gc, Token *op, ExpLitType type) {
-    PExpr *e = NewExpr(gc, EXPR_LITERAL, op);
+PExpr *NewLiteral(PArena *arena, Token *op, ExpLitType type) {
+    PExpr *e = NewExpr(arena, EXPR_LITERAL, op);
     if (e == NULL) {
         return NULL;
     }
@@ -61,8 +60,8 @@ PExpr *NewLiteral(Pgc *gc, Token *op, ExpLitType type) {
     return e;
 }
 
-PExpr *NewGrouping(Pgc *gc, Token *op, PExpr *expr) {
-    PExpr *e = NewExpr(gc, EXPR_GROUPING, op);
+PExpr *NewGrouping(PArena *arena, Token *op, PExpr *expr) {
+    PExpr *e = NewExpr(arena, EXPR_GROUPING, op);
     if (e == NULL) {
         return NULL;
     }
@@ -71,8 +70,8 @@ PExpr *NewGrouping(Pgc *gc, Token *op, PExpr *expr) {
     return e;
 }
 
-PExpr *NewVarExpr(Pgc *gc, Token *name) {
-    PExpr *e = NewExpr(gc, EXPR_VARIABLE, name);
+PExpr *NewVarExpr(PArena *arena, Token *name) {
+    PExpr *e = NewExpr(arena, EXPR_VARIABLE, name);
     if (e == NULL) {
         return NULL;
     }
@@ -80,8 +79,8 @@ PExpr *NewVarExpr(Pgc *gc, Token *name) {
     return e;
 }
 
-PExpr *NewAssignment(Pgc *gc, Token *op, PExpr *name, PExpr *value) {
-    PExpr *e = NewExpr(gc, EXPR_ASSIGN, op);
+PExpr *NewAssignment(PArena *arena, Token *op, PExpr *name, PExpr *value) {
+    PExpr *e = NewExpr(arena, EXPR_ASSIGN, op);
     if (e == NULL) {
         return NULL;
     }
@@ -91,8 +90,8 @@ PExpr *NewAssignment(Pgc *gc, Token *op, PExpr *name, PExpr *value) {
     return e;
 }
 
-PExpr *NewLogical(Pgc *gc, PExpr *left, Token *op, PExpr *right) {
-    PExpr *e = NewExpr(gc, EXPR_LOGICAL, op);
+PExpr *NewLogical(PArena *arena, PExpr *left, Token *op, PExpr *right) {
+    PExpr *e = NewExpr(arena, EXPR_LOGICAL, op);
     if (e == NULL) {
         return NULL;
     }
@@ -102,8 +101,10 @@ PExpr *NewLogical(Pgc *gc, PExpr *left, Token *op, PExpr *right) {
     return e;
 }
 
-PExpr *NewCallExpr(Pgc *gc, Token *op, PExpr *callee, PExpr **args, u64 count) {
-    PExpr *e = NewExpr(gc, EXPR_CALL, op);
+PExpr *NewCallExpr(
+    PArena *arena, Token *op, PExpr *callee, PExpr **args, u64 count
+) {
+    PExpr *e = NewExpr(arena, EXPR_CALL, op);
     if (e == NULL) {
         return NULL;
     }
@@ -114,8 +115,8 @@ PExpr *NewCallExpr(Pgc *gc, Token *op, PExpr *callee, PExpr **args, u64 count) {
     return e;
 }
 
-PExpr *NewArrayExpr(Pgc *gc, Token *op, PExpr **items, u64 count) {
-    PExpr *e = NewExpr(gc, EXPR_ARRAY, op);
+PExpr *NewArrayExpr(PArena *arena, Token *op, PExpr **items, u64 count) {
+    PExpr *e = NewExpr(arena, EXPR_ARRAY, op);
     if (e == NULL) {
         return NULL;
     }
@@ -125,8 +126,8 @@ PExpr *NewArrayExpr(Pgc *gc, Token *op, PExpr **items, u64 count) {
     return e;
 }
 
-PExpr *NewMapExpr(Pgc *gc, Token *op, PExpr **items, u64 count) {
-    PExpr *e = NewExpr(gc, EXPR_MAP, op);
+PExpr *NewMapExpr(PArena *arena, Token *op, PExpr **items, u64 count) {
+    PExpr *e = NewExpr(arena, EXPR_MAP, op);
     if (e == NULL) {
         return NULL;
     }
@@ -136,8 +137,8 @@ PExpr *NewMapExpr(Pgc *gc, Token *op, PExpr **items, u64 count) {
     return e;
 }
 
-PExpr *NewSubscriptExpr(Pgc *gc, Token *op, PExpr *value, PExpr *index) {
-    PExpr *e = NewExpr(gc, EXPR_SUBSCRIPT, op);
+PExpr *NewSubscriptExpr(PArena *arena, Token *op, PExpr *value, PExpr *index) {
+    PExpr *e = NewExpr(arena, EXPR_SUBSCRIPT, op);
     if (e == NULL) {
         return NULL;
     }
@@ -148,8 +149,8 @@ PExpr *NewSubscriptExpr(Pgc *gc, Token *op, PExpr *value, PExpr *index) {
     return e;
 }
 
-PExpr *NewModgetExpr(Pgc *gc, Token *op, PExpr *module, Token *child) {
-    PExpr *e = NewExpr(gc, EXPR_MODGET, op);
+PExpr *NewModgetExpr(PArena *arena, Token *op, PExpr *module, Token *child) {
+    PExpr *e = NewExpr(arena, EXPR_MODGET, op);
     if (e == NULL) {
         return NULL;
     }
@@ -159,104 +160,3 @@ PExpr *NewModgetExpr(Pgc *gc, Token *op, PExpr *module, Token *child) {
     e->exp.EModget.child = child;
     return e;
 }
-// ===================
-// Freeing Functions
-// ===================
-
-// Free the base Expr Struct with NULL check
-static inline void freeBaseExpr(Pgc *gc, PExpr *expr) {
-    if (expr != NULL) {
-        PFree(expr);
-        expr = NULL;
-    }
-}
-
-void FreeExpr(Pgc *gc, PExpr *e) {
-    // Freeing Expressions
-    // Never Free tokens. Token are directly referenced from Lexer
-    if (e == NULL) {
-        return;
-    }
-
-    switch (e->type) {
-        case EXPR_CALL: {
-            FreeExpr(gc, e->exp.ECall.callee);
-            u64 count = e->exp.ECall.argCount;
-            for (u64 i = 0; i < count; i++) {
-                PExpr *ex = arrpop(e->exp.ECall.args);
-                FreeExpr(gc, ex);
-            }
-            arrfree(e->exp.ECall.args);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_LOGICAL: {
-            FreeExpr(gc, e->exp.ELogical.left);
-            FreeExpr(gc, e->exp.ELogical.right);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_MODGET: {
-            FreeExpr(gc, e->exp.EModget.module);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_ASSIGN: {
-            FreeExpr(gc, e->exp.EAssign.name);
-            FreeExpr(gc, e->exp.EAssign.value);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_VARIABLE: {
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_GROUPING: {
-            FreeExpr(gc, e->exp.EGrouping.expr);
-            freeBaseExpr(gc, e);
-            break;
-        }
-
-        case EXPR_LITERAL: {
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_UNARY: {
-            FreeExpr(gc, e->exp.EUnary.right);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_BINARY: {
-            FreeExpr(gc, e->exp.EBinary.left);
-            FreeExpr(gc, e->exp.EBinary.right);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_ARRAY: {
-            u64 count = e->exp.EArray.count;
-            for (u64 i = 0; i < count; i++) {
-                FreeExpr(gc, arrpop(e->exp.EArray.items));
-            }
-            arrfree(e->exp.EArray.items);
-
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_MAP: {
-            struct EMap *map = &e->exp.EMap;
-            for (u64 i = 0; i < map->count; i++) {
-                FreeExpr(gc, arrpop(map->etable));
-            }
-
-            arrfree(map->etable);
-            freeBaseExpr(gc, e);
-            break;
-        }
-        case EXPR_SUBSCRIPT: {
-            FreeExpr(gc, e->exp.ESubscript.value);
-            FreeExpr(gc, e->exp.ESubscript.index);
-            freeBaseExpr(gc, e);
-            break;
-        }
-    }
-}
@@ -52,7 +52,7 @@ PObj *NewObject(Pgc *gc, PObjType type) {
     return o;
 }
 
-PObj *NewStrObject(Pgc *gc, Token *name, char *value, bool noDup) {
+PObj *NewStrObject(Pgc *gc, char *value, bool noDup) {
 
     if (value == NULL) {
         return NULL;
@@ -94,9 +94,9 @@ PObj *NewStrObject(Pgc *gc, Token *name, char *value, bool noDup) {
         return NULL;
     }
 
-    o->v.OString.name = name;
     o->v.OString.value = strValue;
     o->v.OString.hash = hash;
+    o->v.OString.intrinsic = false;
     if (gc->strings != NULL) {
         StringPoolInsert(gc->strings, o);
     }
@@ -108,7 +108,6 @@ PObj *NewComFuncObject(Pgc *gc, Token *name) {
     if (o == NULL) {
         return NULL;
     }
-    o->v.OComFunction.rawName = name;
 
     PBytecode *btCode = NewBytecode();
     if (btCode == NULL) {
@@ -119,10 +118,14 @@ PObj *NewComFuncObject(Pgc *gc, Token *name) {
     o->v.OComFunction.code = btCode;
     o->v.OComFunction.paramCount = 0;
     o->v.OComFunction.upvalCount = 0;
+    o->v.OComFunction.capturesLocals = false;
     o->v.OComFunction.strName = NULL;
 
     if (name != NULL) {
-        PObj *strName = NewStrObject(gc, name, name->lexeme, false);
+        // Lexeme is a slice of the source, see `Token`
+        char *nameStr = StrDuplicate(name->lexeme, name->len);
+        PObj *strName =
+            nameStr != NULL ? NewStrObject(gc, nameStr, true) : NULL;
         if (strName == NULL) {
             GcPopObj(gc, o);
             return NULL;
@@ -171,6 +174,7 @@ PObj *NewArrayObject(Pgc *gc, Token *op, PValue *items, u64 count) {
     o->v.OArray.items = items;
     o->v.OArray.count = count;
     o->v.OArray.op = op;
+    o->v.OArray.kind = ArrayItemsStore(items, count);
     return o;
 }
 
@@ -6,9 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#include "alloc.h"
+#include "arena.h"
 #include "ast.h"
-#include "external/stb/stb_ds.h"
 #include "flags.h"
 #include "gc.h"
 #include "token.h"
@@ -24,15 +23,13 @@
 // Creation Functions
 // ===================
 
-PStmt *NewStmt(Pgc *gc, PStmtType type, Token *op) {
-    PStmt *s = PCreate(PStmt);
+PStmt *NewStmt(PArena *arena, PStmtType type, Token *op) {
+    PStmt *s = ArenaAlloc(arena, sizeof(PStmt));
     if (s == NULL) {
         return NULL;
     }
     s->type = type;
     s->op = op;
-    s->next = gc->stmts;
-    gc->stmts = s;
 #if defined PANKTI_BUILD_DEBUG
     if (FLAG_DEBUG_GC) {
 
@@ -45,8 +42,8 @@ PStmt *NewStmt(Pgc *gc, PStmtType type, Token *op) {
     return s;
 }
 
-PStmt *NewDebugStmt(Pgc *gc, Token *op, PExpr *value) {
-    PStmt *s = NewStmt(gc, STMT_DEBUG, op);
+PStmt *NewDebugStmt(PArena *arena, Token *op, PExpr *value) {
+    PStmt *s = NewStmt(arena, STMT_DEBUG, op);
     if (s == NULL) {
         return NULL;
     }
@@ -55,8 +52,8 @@ PStmt *NewDebugStmt(Pgc *gc, Token *op, PExpr *value) {
     return s;
 }
 
-PStmt *NewExprStmt(Pgc *gc, Token *op, PExpr *value) {
-    PStmt *s = NewStmt(gc, STMT_EXPR, op);
+PStmt *NewExprStmt(PArena *arena, Token *op, PExpr *value) {
+    PStmt *s = NewStmt(arena, STMT_EXPR, op);
     if (s == NULL) {
         return NULL;
     }
@@ -66,8 +63,8 @@ PStmt *NewExprStmt(Pgc *gc, Token *op, PExpr *value) {
     ;
 }
 
-PStmt *NewLetStmt(Pgc *gc, Token *name, PExpr *value) {
-    PStmt *s = NewStmt(gc, STMT_LET, name);
+PStmt *NewLetStmt(PArena *arena, Token *name, PExpr *value) {
+    PStmt *s = NewStmt(arena, STMT_LET, name);
     if (s == NULL) {
         return NULL;
     }
@@ -77,18 +74,21 @@ PStmt *NewLetStmt(Pgc *gc, Token *name, PExpr *value) {
     return s;
 }
 
-PStmt *NewBlockStmt(Pgc *gc, Token *op, PStmt **stmts) {
-    PStmt *s = NewStmt(gc, STMT_BLOCK, op);
+PStmt *NewBlockStmt(PArena *arena, Token *op, PStmt **stmts, u64 count) {
+    PStmt *s = NewStmt(arena, STMT_BLOCK, op);
     if (s == NULL) {
         return NULL;
     }
     s->stmt.SBlock.op = op;
     s->stmt.SBlock.stmts = stmts;
+    s->stmt.SBlock.count = count;
     return s;
 }
 
-PStmt *NewIfStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *then, PStmt *elseB) {
-    PStmt *s = NewStmt(gc, STMT_IF, op);
+PStmt *NewIfStmt(
+    PArena *arena, Token *op, PExpr *cond, PStmt *then, PStmt *elseB
+) {
+    PStmt *s = NewStmt(arena, STMT_IF, op);
     if (s == NULL) {
         return NULL;
     }
@@ -99,8 +99,8 @@ PStmt *NewIfStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *then, PStmt *elseB) {
     return s;
 }
 
-PStmt *NewWhileStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *body) {
-    PStmt *s = NewStmt(gc, STMT_WHILE, op);
+PStmt *NewWhileStmt(PArena *arena, Token *op, PExpr *cond, PStmt *body) {
+    PStmt *s = NewStmt(arena, STMT_WHILE, op);
     if (s == NULL) {
         return NULL;
     }
@@ -110,8 +110,8 @@ PStmt *NewWhileStmt(Pgc *gc, Token *op, PExpr *cond, PStmt *body) {
     return s;
 }
 
-PStmt *NewReturnStmt(Pgc *gc, Token *op, PExpr *value) {
-    PStmt *s = NewStmt(gc, STMT_RETURN, op);
+PStmt *NewReturnStmt(PArena *arena, Token *op, PExpr *value) {
+    PStmt *s = NewStmt(arena, STMT_RETURN, op);
     if (s == NULL) {
         return NULL;
     }
@@ -120,8 +120,8 @@ PStmt *NewReturnStmt(Pgc *gc, Token *op, PExpr *value) {
     return s;
 }
 
-PStmt *NewBreakStmt(Pgc *gc, Token *op) {
-    PStmt *s = NewStmt(gc, STMT_BREAK, op);
+PStmt *NewBreakStmt(PArena *arena, Token *op) {
+    PStmt *s = NewStmt(arena, STMT_BREAK, op);
     if (s == NULL) {
         return NULL;
     }
@@ -129,8 +129,8 @@ PStmt *NewBreakStmt(Pgc *gc, Token *op) {
     return s;
 }
 
-PStmt *NewContinueStmt(Pgc *gc, Token *op) {
-    PStmt *s = NewStmt(gc, STMT_CONTINUE, op);
+PStmt *NewContinueStmt(PArena *arena, Token *op) {
+    PStmt *s = NewStmt(arena, STMT_CONTINUE, op);
     if (s == NULL) {
         return NULL;
     }
@@ -139,9 +139,9 @@ PStmt *NewContinueStmt(Pgc *gc, Token *op) {
 }
 
 PStmt *NewFuncStmt(
-    Pgc *gc, Token *name, Token **params, PStmt *body, u64 count
+    PArena *arena, Token *name, Token **params, PStmt *body, u64 count
 ) {
-    PStmt *s = NewStmt(gc, STMT_FUNC, name);
+    PStmt *s = NewStmt(arena, STMT_FUNC, name);
     if (s == NULL) {
         return NULL;
     }
@@ -152,8 +152,8 @@ PStmt *NewFuncStmt(
     return s;
 }
 
-PStmt *NewImportStmt(Pgc *gc, Token *op, Token *iname, PExpr *ipath) {
-    PStmt *s = NewStmt(gc, STMT_IMPORT, op);
+PStmt *NewImportStmt(PArena *arena, Token *op, Token *iname, PExpr *ipath) {
+    PStmt *s = NewStmt(arena, STMT_IMPORT, op);
     if (s == NULL) {
         return NULL;
     }
@@ -162,88 +162,3 @@ PStmt *NewImportStmt(Pgc *gc, Token *op, Token *iname, PExpr *ipath) {
     s->stmt.SImport.path = ipath;
     return s;
 }
-
-// ===================
-// Freeing Functions
-// ===================
-
-static inline void freeBaseStmt(Pgc *gc, PStmt *stmt) {
-    if (stmt != NULL) {
-        PFree(stmt);
-    }
-}
-
-void FreeStmt(Pgc *gc, PStmt *s) {
-    if (s == NULL) {
-        return;
-    }
-#if defined PANKTI_BUILD_DEBUG
-    if (FLAG_DEBUG_GC) {
-        PanPrint(
-            "    %s[DEBUG] [GC] Freeing Statement : %s%s\n", TermGreen(),
-            StmtTypeToStr(s->type), TermReset()
-        );
-    }
-#endif
-    switch (s->type) {
-        case STMT_DEBUG: {
-            FreeExpr(gc, s->stmt.SDebug.expr);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_EXPR: {
-            FreeExpr(gc, s->stmt.SExpr.expr);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_LET: {
-            // should we do this?
-            FreeExpr(gc, s->stmt.SLet.expr);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_RETURN: {
-            FreeExpr(gc, s->stmt.SReturn.value);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_FUNC: {
-            struct SFunc *fs = &s->stmt.SFunc;
-            arrfree(fs->params);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_IMPORT: {
-            struct SImport *imp = &s->stmt.SImport;
-            FreeExpr(gc, imp->path);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_BLOCK: {
-            struct SBlock *blk = &s->stmt.SBlock;
-            arrfree(blk->stmts);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_IF: {
-            FreeExpr(gc, s->stmt.SIf.cond);
-            freeBaseStmt(gc, s);
-            break;
-        }
-        case STMT_WHILE: {
-            FreeExpr(gc, s->stmt.SWhile.cond);
-            freeBaseStmt(gc, s);
-            break;
-        }
-
-        case STMT_BREAK: {
-            freeBaseStmt(gc, s);
-            break;
-        }
-
-        case STMT_CONTINUE: {
-            freeBaseStmt(gc, s);
-            break;
-        }
-    }
-}
@@ -110,6 +110,7 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {COMPILER_VAR_EXISTS, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, true, false, "'%s' নামের চলরাশি এইখানে আগের থেকেই আছে ", ""},
     {COMPILER_LOCAL_TOO_MANY, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, false, "অনেক বেশি স্থানীয় চলরাশি পাওয়া গেছে", ""},
     {COMPILER_CLOSURE_TOO_MANY, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, false, "অনেক বেশি স্থানীয় এবং নিকটস্থ স্থানীয় চলরাশি পাওয়া গেছে", ""},
+    {COMPILER_CONST_TOO_MANY, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, false, "একটি কাজের মধ্যে অনেক বেশি ধ্রুবক পাওয়া গেছে", ""},
     {COMPILER_WHILE_BLOCK_CTX, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, false, "যতক্ষণ-করো বিবৃতি কম্পাইল করার জন্য কিছু প্রয়োজন অভ্যন্তরীণ তথ্য তৈরি বিফল হয়েছে", ""},
     {COMPILER_RETURN_TOP_LEVEL, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, true, "প্রাথমিক স্তরে ফেরাও বিবৃতি ব্যবহার করা যায় না", "ফেরাও বিবৃতি শুধুমাত্র কাজের ক্ষেত্রে প্রযোজ্য"},
     {COMPILER_IME_NOCTX, PAN_DIAG_COMPILER, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: প্রয়োজনীয় প্রস্তুতি ছাড়াই পঙক্তি চালু হয়েছে", ""},
@@ -155,6 +156,7 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_ONLY_FUNC_CLOSURE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "শুধুমাত্র কাজের ক্ষেত্রেই স্থানীয় ও প্রতিবেশী চলরাশি প্রস্তুতি নেওয়া সম্ভব কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_IME_ARRAY, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: তালিকা তৈরি বিফল হয়েছে", ""},
     {RT_IME_MAP, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: ছক তৈরি বিফল হয়েছে", ""},
+    {RT_IME_REG_TRANSLATE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, true, "অভ্যন্তরীণ গোলমাল: কাজটি নিবন্ধক যন্ত্রের জন্য অনুবাদ করা সম্ভব হয়নি", "কাজটি ছোট করে বা `--engine stack` দিয়ে চালিয়ে দেখুন"},
     {RT_ONLY_MOD_CHILD, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "শুধুমাত্র উৎস থেকেই সদস্য পাওয়া যায় কিন্তু একটি %s-জাতিয় রাশি থেকে সদস্য নেওয়ার চেষ্টা করা হয়েছে", ""},
     {RT_INVALID_MOD_CHILD, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "উৎসের থেকে অবৈধ সদস্য ব্যবহারের চেষ্টা করা হয়েছে %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_UNKNOWN_MOD, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "অজানা উৎস %s পাওয়া গেছে", "উৎস আনয়ন করা হয়েছে তো?"},
@@ -176,6 +178,22 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_STDARR_TRIM_FIRST_ARR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.কাটো(তালিকার_নাম) কাজের প্রথম প্রেরণমান একটি তালিকা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া", ""},
     {RT_STDARR_TRIM_ARR_EMPTY, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "তালিকা.কাটো(তালিকার_নাম) কাজের মধ্যে দেওয়া তালিকাতে কোনো উপাদান নেই", ""},
     {RT_IME_STDARR_TRIM_ARRAY_ITEMS_OUTSYNC, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: তালিকা.কাটো(তালিকার_নাম) কাজে প্রদত্ত তালিকার মধ্যে উপাদানগুলি খুঁজে পাওয়া গেলো না", ""},
+    {RT_STDARR_FN_FIRST_ARR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের প্রথম প্রেরণমান একটি তালিকা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDARR_NUM_NOT_NUMERIC, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের তালিকার সব উপাদান সংখ্যা হওয়া উচিত ছিল কিন্তু %llu নং সূচকে একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDARR_NUM_ARR_EMPTY, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের মধ্যে দেওয়া তালিকাতে কোনো উপাদান নেই", ""},
+    {RT_STDARR_NUM_ARG_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের প্রেরণমান '%s' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
+    {RT_STDARR_DOT_LEN_MISMATCH, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.ডট_গুণফল(ক, খ) কাজের দুটি তালিকার আয়তন সমান হওয়া উচিত ছিল কিন্তু %llu এবং %llu পাওয়া গেছে", ""},
+    {RT_STDARR_RANGE_INVALID_STEP, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "তালিকা.পরিসর(শুরু, শেষ, ধাপ) কাজের ধাপ শূন্য বা অসীম হতে পারে না", ""},
+    {RT_STDARR_RANGE_TOO_BIG, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.পরিসর(শুরু, শেষ, ধাপ) কাজে তৈরি তালিকাটি অত্যন্ত বড়, সর্বোচ্চ %llu টি উপাদান থাকতে পারে", ""},
+    {RT_IME_STDARR_NEW_ARR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "অভ্যন্তরীণ গোলমাল: তালিকা.%s কাজের ফলাফলের জন্য নতুন তালিকা তৈরি বিফল হয়েছে", ""},
+    {RT_IME_STDARR_RESERVE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "অভ্যন্তরীণ গোলমাল: তালিকা.%s কাজে %llu টি উপাদানের জায়গা তৈরি বিফল হয়েছে", ""},
+    {RT_STDARR_CALLBACK_NOT_FN, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের '%s' প্রেরণমানটি একটি কাজ হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDARR_SORT_MIXED, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "তালিকা.সাজাও(তালিকার_নাম) কাজে তালিকার হয় সব উপাদান সংখ্যা অথবা সব উপাদান কথা হওয়া উচিত ছিল কিন্তু %llu নং সূচকে একটি %s-জাতিয় রাশি পাওয়া গেছে", "অন্য ধরনের উপাদান সাজানোর জন্য তালিকা.তুলনায়_সাজাও(তালিকার_নাম, কাজ) ব্যবহার করুন"},
+    {RT_STDARR_SORTBY_MODIFIED, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "তালিকা.%s কাজে সাজানোর সময় তালিকার আয়তন %llu থেকে বদলে %llu হয়ে গেছে", "তুলনার কাজের মধ্যে তালিকাটি বদলানো যাবে না"},
+    {RT_STDARR_FN_ARG_NOT_ARR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের '%s' প্রেরণমানটি একটি তালিকা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDARR_FN_INVALID_NUMIDX, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের '%s' প্রেরণমানটি একটি ধনাত্মক পূর্ণ সংখ্যা হওয়া উচিত ছিল কিন্তু %f পাওয়া গেছে", ""},
+    {RT_STDARR_FN_INDEX_OUT_RANGE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.%s কাজের '%s' প্রেরণমানটি সীমার বাইরে, বৈধ মান হল ০ থেকে %llu", ""},
+    {RT_STDARR_SLICE_BAD_RANGE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "তালিকা.টুকরো(তালিকার_নাম, শুরু, শেষ) কাজের শুরু (%llu) শেষের (%llu) থেকে বড় হতে পারে না", ""},
     {RT_STDFILE_EXISTS_FIRST_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "নথি.বর্তমান(নথির_পথ) কাজের প্রথম প্রেরণমান অর্থাৎ নথির পথ একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া", ""},
     {RT_STDFILE_READ_FIRST_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "নথি.পড়ো(নথির_পথ) কাজের প্রথম প্রেরণমান অর্থাৎ নথির পথ কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া", ""},
     {RT_STDFILE_READ_FILE_NOT_FOUND, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "নথি.পড়ো(নথির_পথ) কাজে প্রদত্ত নথি '%s' খুঁজে পাওয়া গেলো না", ""},
@@ -214,7 +232,7 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_STDMATH_SIN_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.সাইন(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
     {RT_STDMATH_COS_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.কস(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
     {RT_STDMATH_TAN_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.ট্যান(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
-    {RT_STDMATH_TAN_RESULT_INVALID, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.ট্যান(ক) কাজে %f ডিগ্রির মান অসংজ্ঞায়িত", ""},
+    {RT_STDMATH_TAN_RESULT_INVALID, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.ট্যান(ক) কাজে %f ডিগ্রির মান অসংজ্ঞায়িত", ""},
     {RT_STDMATH_DEG_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.ডিগ্রি(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
     {RT_STDMATH_RAD_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.রেডিয়ান(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
     {RT_STDMATH_NUMBER_NOT_NUM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "গণিত.সংখ্যা(ক) কাজের প্রেরণমান 'ক' একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
@@ -241,9 +259,9 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_IME_STDSYS_USERNAME_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পরিবেশ.ব্যবহারকারী() কাজে অপারেটিং সিস্টেমের ব্যবহারকারীর নামের কথারাশি তৈরি বিফল হয়েছে", ""},
     {RT_IME_STDSYS_HOMEDIR_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পরিবেশ.ঘর() কাজে অপারেটিং সিস্টেমের ব্যবহারকারীর হোম ডাইরেক্টরি/ফোল্ডারের নামের কথারাশি তৈরি বিফল হয়েছে", ""},
     {RT_IME_STDSYS_CURDIR_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পরিবেশ.অবস্থান() কাজে বর্তমান ডাইরেক্টরি/ফোল্ডারের নামের কথারাশি তৈরি বিফল হয়েছে", ""},
-    {RT_STDSTR_INDEX_STR_NOT_STRING, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে প্রথম প্রেরণমান অর্থাৎ ক একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
-    {RT_STDSTR_INDEX_INVALID_IDX_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি সংখ্যা রাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
-    {RT_STDSTR_INDEX_INVALID_IDX_NUMTYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি ধনাত্মক পূর্ণসংখ্যা হওয়া উচিত ছিল কিন্তু %f দেওয়া হয়েছে", ""},
+    {RT_STDSTR_INDEX_STR_NOT_STRING, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে প্রথম প্রেরণমান অর্থাৎ ক একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
+    {RT_STDSTR_INDEX_INVALID_IDX_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি সংখ্যা রাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে", ""},
+    {RT_STDSTR_INDEX_INVALID_IDX_NUMTYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি ধনাত্মক পূর্ণসংখ্যা হওয়া উচিত ছিল কিন্তু %f দেওয়া হয়েছে", ""},
     {RT_STDSTR_INDEX_INDEX_OUT_RANGE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "কথা.সূচক(ক, সূচক) কাজের সূচকটি কথারাশিতে বর্তমান অক্ষরগুলির মোটসংখ্যার থেকে বড়, বৈধ সূচক হল ০ থেকে %llu", ""},
     {RT_IME_STDSTR_INDEX_GRAPHEME_MEM, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: কথা.সূচক(ক, সূচক) কাজে সূচকীয় অক্ষর খোঁজা বিফল হয়েছে", ""},
     {RT_IME_STDSTR_INDEX_RESULT_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: কথা.সূচক(ক, সূচক) কাজে ফেরত মান কথারাশি তৈরি বিফল হয়েছে", ""},
@@ -266,7 +284,7 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_STDGFX_LINE_Y1_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'খ' প্রেরণমান অর্থাৎ উলম্ব অক্ষের প্রথম অবস্থান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_LINE_X2_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'গ' প্রেরণমান অর্থাৎ অনুভূমিক অক্ষের দ্বিতীয় অবস্থান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_LINE_Y2_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'ঘ' প্রেরণমান অর্থাৎ উলম্ব অক্ষের দ্বিতীয় অবস্থান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
-    {RT_STDGFX_LINE_COLOR_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_LINE_COLOR_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_LINE_COLOR_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমানে একটি অবৈধ রঙ '%s' দেওয়া হয়েছে", "কয়েকটি বৈধ রঙ হল 'লাল', 'হলুদ', 'সবুজ', 'নীল', 'সাদা', 'কালো' প্রভৃতি, এছাড়া নতুন রঙ লেখা যাবে এইভাবে 'রঙ=<লালের পরিমাণ>,<সবুজের_পরিমাণ>,<নীলের পরিমাণ>'"},
     {RT_STDGFX_PIXEL_X_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বিন্দু(ক, খ, রঙ) কাজের 'ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_PIXEL_Y_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বিন্দু(ক, খ, রঙ) কাজের 'খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
@@ -302,30 +320,30 @@ static const PanDiagInfo diagList[PANDIAG_CODE_COUNT] = {
     {RT_STDGFX_TEXT_SIZE_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.লেখা(ক, খ, কথা, আয়তন, রঙ) কাজের 'আয়তন' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_TEXT_COLOR_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.লেখা(ক, খ, কথা, আয়তন, রঙ) কাজের 'রঙ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_TEXT_COLOR_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.লেখা(ক, খ, কথা, আয়তন, রঙ) কাজের 'রঙ' প্রেরণমানে একটি অবৈধ রঙ '%s' দেওয়া হয়েছে", "কয়েকটি বৈধ রঙ হল 'লাল', 'হলুদ', 'সবুজ', 'নীল', 'সাদা', 'কালো' প্রভৃতি, এছাড়া নতুন রঙ লেখা যাবে এইভাবে 'রঙ=<লালের পরিমাণ>,<সবুজের_পরিমাণ>,<নীলের পরিমাণ>'"},
-    {RT_STDGFX_KEYPRESS_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_KEYPRESS_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_KEYPRESS_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে", "বোতামের নামের কয়েকটি উদাহরণ হলঃ 'w', 'a', 's', 'd', 'ডান', 'বাম', 'উপরে', 'নীচে' ইত্যাদি, সম্পূর্ণ তালিকা পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_KEYDOWN_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_KEYDOWN_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_KEYDOWN_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে", "বোতামের নামের কয়েকটি উদাহরণ হলঃ 'w', 'a', 's', 'd', 'ডান', 'বাম', 'উপরে', 'নীচে' ইত্যাদি, সম্পূর্ণ তালিকা পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_KEYUP_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_KEYUP_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_KEYUP_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে", "বোতামের নামের কয়েকটি উদাহরণ হলঃ 'w', 'a', 's', 'd', 'ডান', 'বাম', 'উপরে', 'নীচে' ইত্যাদি, সম্পূর্ণ তালিকা পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_KEYRELEASED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_KEYRELEASED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_KEYRELEASED_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে", "বোতামের নামের কয়েকটি উদাহরণ হলঃ 'w', 'a', 's', 'd', 'ডান', 'বাম', 'উপরে', 'নীচে' ইত্যাদি, সম্পূর্ণ তালিকা পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_LOADIMG_PATH_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
-    {RT_STDGFX_LOADIMG_FILE_NOT_FOUND, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমানে দেওয়া ছবির পথে ('%s') কোনো নথি খুঁজে পাওয়া গেলো না", ""},
-    {RT_IME_STDGFX_LOADIMG_FAILED_FETCH_IMAGE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলা বিফল হয়েছে", ""},
-    {RT_IME_STDGFX_LOADIMG_FAILED_IMAGE_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলার জন্য ছবির জন্য বিশেষ অভ্যন্তরীণ নাম তৈরি বিফল হয়েছে", ""},
-    {RT_STDGFX_DRAWIMG_X_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
-    {RT_STDGFX_DRAWIMG_Y_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
-    {RT_STDGFX_DRAWIMG_IMG_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
-    {RT_STDGFX_DRAWIMG_IMG_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, true, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে একটি অবৈধ ছবির নাম দেওয়া হয়েছে", "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজটি ব্যবহারের আগে পট.ছবি_আনয়ন(ছবির_পথ) কাজ ব্যবহার করে ছবিটি স্ক্রিপ্টে আনতে হবে এবং সেই কাজের ফেরত দেওয়া ছবির নামই শুধুমাত্র এই কাজে ব্যবহার করা যায়"},
-    {RT_IME_STDGFX_DRAWIMG_IMG_FETCH_FAIL, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, true, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে দেওয়া ছবির নামের ছবিটি ব্যবহারের উপযোগী করা বিফল হয়েছে", "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজটি ব্যবহারের আগে পট.ছবি_আনয়ন(ছবির_পথ) কাজ ব্যবহার করে ছবিটি স্ক্রিপ্টে আনতে হবে এবং সেই কাজের ফেরত দেওয়া ছবির নামই শুধুমাত্র এই কাজে ব্যবহার করা যায়"},
-    {RT_STDGFX_MOUSEPRESSED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_LOADIMG_PATH_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_LOADIMG_FILE_NOT_FOUND, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমানে দেওয়া ছবির পথে ('%s') কোনো নথি খুঁজে পাওয়া গেলো না", ""},
+    {RT_IME_STDGFX_LOADIMG_FAILED_FETCH_IMAGE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলা বিফল হয়েছে", ""},
+    {RT_IME_STDGFX_LOADIMG_FAILED_IMAGE_STR, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, false, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলার জন্য ছবির জন্য বিশেষ অভ্যন্তরীণ নাম তৈরি বিফল হয়েছে", ""},
+    {RT_STDGFX_DRAWIMG_X_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_DRAWIMG_Y_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_DRAWIMG_IMG_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_DRAWIMG_IMG_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, true, "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে একটি অবৈধ ছবির নাম দেওয়া হয়েছে", "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজটি ব্যবহারের আগে পট.ছবি_আনয়ন(ছবির_পথ) কাজ ব্যবহার করে ছবিটি স্ক্রিপ্টে আনতে হবে এবং সেই কাজের ফেরত দেওয়া ছবির নামই শুধুমাত্র এই কাজে ব্যবহার করা যায়"},
+    {RT_IME_STDGFX_DRAWIMG_IMG_FETCH_FAIL, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, false, true, "অভ্যন্তরীণ গোলমাল: পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে দেওয়া ছবির নামের ছবিটি ব্যবহারের উপযোগী করা বিফল হয়েছে", "পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজটি ব্যবহারের আগে পট.ছবি_আনয়ন(ছবির_পথ) কাজ ব্যবহার করে ছবিটি স্ক্রিপ্টে আনতে হবে এবং সেই কাজের ফেরত দেওয়া ছবির নামই শুধুমাত্র এই কাজে ব্যবহার করা যায়"},
+    {RT_STDGFX_MOUSEPRESSED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_MOUSEPRESSED_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে", "মাউসের বোতামের নামের বৈধ মানগুলি হলঃ 'ডান', 'বাম', 'মাঝ', বিস্তারিত তথ্য পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_MOUSEDOWN_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_MOUSEDOWN_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_MOUSEDOWN_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে", "মাউসের বোতামের নামের বৈধ মানগুলি হলঃ 'ডান', 'বাম', 'মাঝ', বিস্তারিত তথ্য পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_MOUSERELEASED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_MOUSERELEASED_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_MOUSERELEASED_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে", "মাউসের বোতামের নামের বৈধ মানগুলি হলঃ 'ডান', 'বাম', 'মাঝ', বিস্তারিত তথ্য পঙক্তির নির্দেশিকায় দেওয়া আছে"},
-    {RT_STDGFX_MOUSEUP_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
+    {RT_STDGFX_MOUSEUP_KEY_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_MOUSEUP_KEY_INVALID_VALUE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, true, "পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে", "মাউসের বোতামের নামের বৈধ মানগুলি হলঃ 'ডান', 'বাম', 'মাঝ', বিস্তারিত তথ্য পঙক্তির নির্দেশিকায় দেওয়া আছে"},
     {RT_STDGFX_2RECTCOLS_R1X_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.স্পর্শ_আয়তক্ষেত্র(১ম_আয়তক্ষেত্র_ক, ১ম_আয়তক্ষেত্র_খ, ১ম_আয়তক্ষেত্র_দৈর্ঘ্য, ১ম_আয়তক্ষেত্র_প্রস্থ, ২য়_আয়তক্ষেত্র_ক, ২য়_আয়তক্ষেত্র_খ, ২য়_আয়তক্ষেত্র_দৈর্ঘ্য, ২য়_আয়তক্ষেত্র_প্রস্থ) কাজের '১ম_আয়তক্ষেত্র_ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
     {RT_STDGFX_2RECTCOLS_R1Y_INVALID_TYPE, PAN_DIAG_RUNTIME, PAN_DIAG_SEV_ERROR, true, false, "পট.স্পর্শ_আয়তক্ষেত্র(১ম_আয়তক্ষেত্র_ক, ১ম_আয়তক্ষেত্র_খ, ১ম_আয়তক্ষেত্র_দৈর্ঘ্য, ১ম_আয়তক্ষেত্র_প্রস্থ, ২য়_আয়তক্ষেত্র_ক, ২য়_আয়তক্ষেত্র_খ, ২য়_আয়তক্ষেত্র_দৈর্ঘ্য, ২য়_আয়তক্ষেত্র_প্রস্থ) কাজের '১ম_আয়তক্ষেত্র_খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে", ""},
@@ -232,6 +232,8 @@ typedef enum PanDiagCode{
     COMPILER_LOCAL_TOO_MANY,
     // অনেক বেশি স্থানীয় এবং নিকটস্থ স্থানীয় চলরাশি পাওয়া গেছে
     COMPILER_CLOSURE_TOO_MANY,
+    // একটি কাজের মধ্যে অনেক বেশি ধ্রুবক পাওয়া গেছে
+    COMPILER_CONST_TOO_MANY,
     // যতক্ষণ-করো বিবৃতি কম্পাইল করার জন্য কিছু প্রয়োজন অভ্যন্তরীণ তথ্য তৈরি বিফল হয়েছে
     COMPILER_WHILE_BLOCK_CTX,
     // প্রাথমিক স্তরে ফেরাও বিবৃতি ব্যবহার করা যায় না
@@ -322,6 +324,8 @@ typedef enum PanDiagCode{
     RT_IME_ARRAY,
     // অভ্যন্তরীণ গোলমাল: ছক তৈরি বিফল হয়েছে
     RT_IME_MAP,
+    // অভ্যন্তরীণ গোলমাল: কাজটি নিবন্ধক যন্ত্রের জন্য অনুবাদ করা সম্ভব হয়নি
+    RT_IME_REG_TRANSLATE,
     // শুধুমাত্র উৎস থেকেই সদস্য পাওয়া যায় কিন্তু একটি %s-জাতিয় রাশি থেকে সদস্য নেওয়ার চেষ্টা করা হয়েছে
     RT_ONLY_MOD_CHILD,
     // উৎসের থেকে অবৈধ সদস্য ব্যবহারের চেষ্টা করা হয়েছে %s-জাতিয় রাশি পাওয়া গেছে
@@ -364,6 +368,38 @@ typedef enum PanDiagCode{
     RT_STDARR_TRIM_ARR_EMPTY,
     // অভ্যন্তরীণ গোলমাল: তালিকা.কাটো(তালিকার_নাম) কাজে প্রদত্ত তালিকার মধ্যে উপাদানগুলি খুঁজে পাওয়া গেলো না
     RT_IME_STDARR_TRIM_ARRAY_ITEMS_OUTSYNC,
+    // তালিকা.%s কাজের প্রথম প্রেরণমান একটি তালিকা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    RT_STDARR_FN_FIRST_ARR,
+    // তালিকা.%s কাজের তালিকার সব উপাদান সংখ্যা হওয়া উচিত ছিল কিন্তু %llu নং সূচকে একটি %s-জাতিয় রাশি পাওয়া গেছে
+    RT_STDARR_NUM_NOT_NUMERIC,
+    // তালিকা.%s কাজের মধ্যে দেওয়া তালিকাতে কোনো উপাদান নেই
+    RT_STDARR_NUM_ARR_EMPTY,
+    // তালিকা.%s কাজের প্রেরণমান '%s' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
+    RT_STDARR_NUM_ARG_NOT_NUM,
+    // তালিকা.ডট_গুণফল(ক, খ) কাজের দুটি তালিকার আয়তন সমান হওয়া উচিত ছিল কিন্তু %llu এবং %llu পাওয়া গেছে
+    RT_STDARR_DOT_LEN_MISMATCH,
+    // তালিকা.পরিসর(শুরু, শেষ, ধাপ) কাজের ধাপ শূন্য বা অসীম হতে পারে না
+    RT_STDARR_RANGE_INVALID_STEP,
+    // তালিকা.পরিসর(শুরু, শেষ, ধাপ) কাজে তৈরি তালিকাটি অত্যন্ত বড়, সর্বোচ্চ %llu টি উপাদান থাকতে পারে
+    RT_STDARR_RANGE_TOO_BIG,
+    // অভ্যন্তরীণ গোলমাল: তালিকা.%s কাজের ফলাফলের জন্য নতুন তালিকা তৈরি বিফল হয়েছে
+    RT_IME_STDARR_NEW_ARR,
+    // অভ্যন্তরীণ গোলমাল: তালিকা.%s কাজে %llu টি উপাদানের জায়গা তৈরি বিফল হয়েছে
+    RT_IME_STDARR_RESERVE,
+    // তালিকা.%s কাজের '%s' প্রেরণমানটি একটি কাজ হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    RT_STDARR_CALLBACK_NOT_FN,
+    // তালিকা.সাজাও(তালিকার_নাম) কাজে তালিকার হয় সব উপাদান সংখ্যা অথবা সব উপাদান কথা হওয়া উচিত ছিল কিন্তু %llu নং সূচকে একটি %s-জাতিয় রাশি পাওয়া গেছে
+    RT_STDARR_SORT_MIXED,
+    // তালিকা.%s কাজে সাজানোর সময় তালিকার আয়তন %llu থেকে বদলে %llu হয়ে গেছে
+    RT_STDARR_SORTBY_MODIFIED,
+    // তালিকা.%s কাজের '%s' প্রেরণমানটি একটি তালিকা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    RT_STDARR_FN_ARG_NOT_ARR,
+    // তালিকা.%s কাজের '%s' প্রেরণমানটি একটি ধনাত্মক পূর্ণ সংখ্যা হওয়া উচিত ছিল কিন্তু %f পাওয়া গেছে
+    RT_STDARR_FN_INVALID_NUMIDX,
+    // তালিকা.%s কাজের '%s' প্রেরণমানটি সীমার বাইরে, বৈধ মান হল ০ থেকে %llu
+    RT_STDARR_FN_INDEX_OUT_RANGE,
+    // তালিকা.টুকরো(তালিকার_নাম, শুরু, শেষ) কাজের শুরু (%llu) শেষের (%llu) থেকে বড় হতে পারে না
+    RT_STDARR_SLICE_BAD_RANGE,
     // নথি.বর্তমান(নথির_পথ) কাজের প্রথম প্রেরণমান অর্থাৎ নথির পথ একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া
     RT_STDFILE_EXISTS_FIRST_STR,
     // নথি.পড়ো(নথির_পথ) কাজের প্রথম প্রেরণমান অর্থাৎ নথির পথ কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া
@@ -440,7 +476,7 @@ typedef enum PanDiagCode{
     RT_STDMATH_COS_NOT_NUM,
     // গণিত.ট্যান(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
     RT_STDMATH_TAN_NOT_NUM,
-    // গণিত.ট্যান(ক) কাজে %f ডিগ্রির মান অসংজ্ঞায়িত
+    // গণিত.ট্যান(ক) কাজে %f ডিগ্রির মান অসংজ্ঞায়িত
     RT_STDMATH_TAN_RESULT_INVALID,
     // গণিত.ডিগ্রি(ক) কাজের প্রেরণমান 'ক' একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
     RT_STDMATH_DEG_NOT_NUM,
@@ -494,11 +530,11 @@ typedef enum PanDiagCode{
     RT_IME_STDSYS_HOMEDIR_STR,
     // অভ্যন্তরীণ গোলমাল: পরিবেশ.অবস্থান() কাজে বর্তমান ডাইরেক্টরি/ফোল্ডারের নামের কথারাশি তৈরি বিফল হয়েছে
     RT_IME_STDSYS_CURDIR_STR,
-    // কথা.সূচক(ক, সূচক) কাজে প্রথম প্রেরণমান অর্থাৎ ক একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
+    // কথা.সূচক(ক, সূচক) কাজে প্রথম প্রেরণমান অর্থাৎ ক একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
     RT_STDSTR_INDEX_STR_NOT_STRING,
-    // কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি সংখ্যা রাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
+    // কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি সংখ্যা রাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি দেওয়া হয়েছে
     RT_STDSTR_INDEX_INVALID_IDX_TYPE,
-    // কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি ধনাত্মক পূর্ণসংখ্যা হওয়া উচিত ছিল কিন্তু %f দেওয়া হয়েছে
+    // কথা.সূচক(ক, সূচক) কাজে দ্বিতীয় প্রেরণমান অর্থাৎ সূচক একটি ধনাত্মক পূর্ণসংখ্যা হওয়া উচিত ছিল কিন্তু %f দেওয়া হয়েছে
     RT_STDSTR_INDEX_INVALID_IDX_NUMTYPE,
     // কথা.সূচক(ক, সূচক) কাজের সূচকটি কথারাশিতে বর্তমান অক্ষরগুলির মোটসংখ্যার থেকে বড়, বৈধ সূচক হল ০ থেকে %llu
     RT_STDSTR_INDEX_INDEX_OUT_RANGE,
@@ -544,7 +580,7 @@ typedef enum PanDiagCode{
     RT_STDGFX_LINE_X2_INVALID_TYPE,
     // পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'ঘ' প্রেরণমান অর্থাৎ উলম্ব অক্ষের দ্বিতীয় অবস্থান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_LINE_Y2_INVALID_TYPE,
-    // পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_LINE_COLOR_INVALID_TYPE,
     // পট.রেখা(ক, খ, গ, ঘ, রঙ) কাজের 'রঙ' প্রেরণমানে একটি অবৈধ রঙ '%s' দেওয়া হয়েছে
     RT_STDGFX_LINE_COLOR_INVALID_VALUE,
@@ -616,53 +652,53 @@ typedef enum PanDiagCode{
     RT_STDGFX_TEXT_COLOR_INVALID_TYPE,
     // পট.লেখা(ক, খ, কথা, আয়তন, রঙ) কাজের 'রঙ' প্রেরণমানে একটি অবৈধ রঙ '%s' দেওয়া হয়েছে
     RT_STDGFX_TEXT_COLOR_INVALID_VALUE,
-    // পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_KEYPRESS_KEY_INVALID_TYPE,
     // পট.বোতাম_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_KEYPRESS_KEY_INVALID_VALUE,
-    // পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_KEYDOWN_KEY_INVALID_TYPE,
     // পট.বোতাম_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_KEYDOWN_KEY_INVALID_VALUE,
-    // পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_KEYUP_KEY_INVALID_TYPE,
     // পট.বোতাম_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_KEYUP_KEY_INVALID_VALUE,
-    // পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_KEYRELEASED_KEY_INVALID_TYPE,
     // পট.বোতাম_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_KEYRELEASED_KEY_INVALID_VALUE,
-    // পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_LOADIMG_PATH_INVALID_TYPE,
-    // পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমানে দেওয়া ছবির পথে ('%s') কোনো নথি খুঁজে পাওয়া গেলো না
+    // পট.ছবি_আনয়ন(ছবির_পথ) কাজের 'ছবির_পথ' প্রেরণমানে দেওয়া ছবির পথে ('%s') কোনো নথি খুঁজে পাওয়া গেলো না
     RT_STDGFX_LOADIMG_FILE_NOT_FOUND,
-    // অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলা বিফল হয়েছে
+    // অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলা বিফল হয়েছে
     RT_IME_STDGFX_LOADIMG_FAILED_FETCH_IMAGE,
-    // অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলার জন্য ছবির জন্য বিশেষ অভ্যন্তরীণ নাম তৈরি বিফল হয়েছে
+    // অভ্যন্তরীণ গোলমাল: পট.ছবি_আনয়ন(ছবির_পথ) কাজের ছবিটি ব্যবহারের উপযোগী করে তোলার জন্য ছবির জন্য বিশেষ অভ্যন্তরীণ নাম তৈরি বিফল হয়েছে
     RT_IME_STDGFX_LOADIMG_FAILED_IMAGE_STR,
-    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ক' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_DRAWIMG_X_INVALID_TYPE,
-    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'খ' প্রেরণমান একটি সংখ্যা হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_DRAWIMG_Y_INVALID_TYPE,
-    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_DRAWIMG_IMG_INVALID_TYPE,
     // পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে একটি অবৈধ ছবির নাম দেওয়া হয়েছে
     RT_STDGFX_DRAWIMG_IMG_INVALID_VALUE,
     // অভ্যন্তরীণ গোলমাল: পট.ছবি_আঁকো(ক, খ, ছবির_নাম) কাজের 'ছবির_নাম' প্রেরণমানে দেওয়া ছবির নামের ছবিটি ব্যবহারের উপযোগী করা বিফল হয়েছে
     RT_IME_STDGFX_DRAWIMG_IMG_FETCH_FAIL,
-    // পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_MOUSEPRESSED_KEY_INVALID_TYPE,
     // পট.মাউস_চাপা(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_MOUSEPRESSED_KEY_INVALID_VALUE,
-    // পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_MOUSEDOWN_KEY_INVALID_TYPE,
     // পট.মাউস_চাপা_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_MOUSEDOWN_KEY_INVALID_VALUE,
-    // পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_MOUSERELEASED_KEY_INVALID_TYPE,
     // পট.মাউস_ছাড়া(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_MOUSERELEASED_KEY_INVALID_VALUE,
-    // পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
+    // পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমান একটি কথারাশি হওয়া উচিত ছিল কিন্তু একটি %s-জাতিয় রাশি পাওয়া গেছে
     RT_STDGFX_MOUSEUP_KEY_INVALID_TYPE,
     // পট.মাউস_ছাড়া_আছে(বোতামের_নাম) কাজের 'বোতামের_নাম' প্রেরণমানে অবৈধ মাউসের বোতামের নাম '%s' দেওয়া হয়েছে
     RT_STDGFX_MOUSEUP_KEY_INVALID_VALUE,
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// x86-64 machine code templates for register bytecode. See jit.h
+//
+// Native code of a function is one block : prologue, epilogue and then code
+// of each register instruction. While it runs
+// + rbx = vm
+// + r12 = registers of the frame
+// + r13 = `QNAN`, to check for numbers
+// + r14 = `TrueValue`, to check for truthy values
+// and it returns a `PJitStatus` to `JitRun`.
+
+#include "jit.h"
+
+#if defined(PANKTI_JIT)
+
+#include "alloc.h"
+#include "external/stb/stb_ds.h"
+#include "opcode.h"
+#include <string.h>
+#include <sys/mman.h>
+
+typedef PJitStatus (*JitEntryFn)(PVm *vm, PValue *regs, const u8 *start);
+typedef PJitStatus (*JitHelperFn)(PVm *vm, const PRegIns *ins);
+
+// Registers used by templates
+#define X_RAX 0
+#define X_RCX 1
+
+// Condition codes of `jcc`
+#define CC_B  0x2
+#define CC_E  0x4
+#define CC_NE 0x5
+#define CC_BE 0x6
+#define CC_P  0xA
+
+// Jump to the code of a register instruction, patched once every
+// instruction is emitted
+typedef struct JitFix {
+    u32 at;
+    u32 pc;
+} JitFix;
+
+typedef struct JitEmitter {
+    const PRegCode *rc;
+    const PValue *consts;
+    u8 *buf;
+    JitFix *fixes;
+    u32 *offsets;
+    u32 epilogue;
+} JitEmitter;
+
+static void emit8(JitEmitter *e, u8 byte) { arrput(e->buf, byte); }
+
+static void emitBytes(JitEmitter *e, const u8 *bytes, int count) {
+    for (int i = 0; i < count; i++) {
+        arrput(e->buf, bytes[i]);
+    }
+}
+
+static void emit32(JitEmitter *e, u32 value) {
+    for (int i = 0; i < 4; i++) {
+        arrput(e->buf, (u8)(value >> (i * 8)));
+    }
+}
+
+static void emit64(JitEmitter *e, u64 value) {
+    for (int i = 0; i < 8; i++) {
+        arrput(e->buf, (u8)(value >> (i * 8)));
+    }
+}
+
+static u32 here(const JitEmitter *e) { return (u32)arrlen(e->buf); }
+
+static void patch32(JitEmitter *e, u32 at, u32 value) {
+    for (int i = 0; i < 4; i++) {
+        e->buf[at + i] = (u8)(value >> (i * 8));
+    }
+}
+
+// Point rel32 at `at` to `target`
+static void patchRel(JitEmitter *e, u32 at, u32 target) {
+    patch32(e, at, (u32)((i64)target - (i64)(at + 4)));
+}
+
+// jcc rel32 to a label bound later. Returns where rel32 is
+static u32 jccForward(JitEmitter *e, u8 cc) {
+    emit8(e, 0x0F);
+    emit8(e, 0x80 | cc);
+    u32 at = here(e);
+    emit32(e, 0);
+    return at;
+}
+
+// jmp rel32 to a label bound later. Returns where rel32 is
+static u32 jmpForward(JitEmitter *e) {
+    emit8(e, 0xE9);
+    u32 at = here(e);
+    emit32(e, 0);
+    return at;
+}
+
+// jcc rel32 to register instruction `pc`
+static void jccToPc(JitEmitter *e, u8 cc, u32 pc) {
+    JitFix fix = {jccForward(e, cc), pc};
+    arrput(e->fixes, fix);
+}
+
+// jmp rel32 to register instruction `pc`
+static void jmpToPc(JitEmitter *e, u32 pc) {
+    JitFix fix = {jmpForward(e), pc};
+    arrput(e->fixes, fix);
+}
+
+// jcc rel32 to epilogue
+static void jccToEpilogue(JitEmitter *e, u8 cc) {
+    patchRel(e, jccForward(e, cc), e->epilogue);
+}
+
+// mov x, imm64
+static void emitLoadImm(JitEmitter *e, int x, u64 value) {
+    emit8(e, 0x48);
+    emit8(e, (u8)(0xB8 + x));
+    emit64(e, value);
+}
+
+// mov x, [r12 + reg * 8]
+static void emitLoadReg(JitEmitter *e, int x, u16 reg) {
+    const u8 bytes[] = {0x49, 0x8B, (u8)(0x84 | (x << 3)), 0x24};
+    emitBytes(e, bytes, 4);
+    emit32(e, (u32)reg * sizeof(PValue));
+}
+
+// mov [r12 + reg * 8], rax
+static void emitStoreRax(JitEmitter *e, u16 reg) {
+    const u8 bytes[] = {0x49, 0x89, 0x84, 0x24};
+    emitBytes(e, bytes, 4);
+    emit32(e, (u32)reg * sizeof(PValue));
+}
+
+static PValue rkConst(const JitEmitter *e, u16 rk) {
+    return e->consts[rk & REG_RK_MAX];
+}
+
+static bool isRKConst(u16 rk) { return (rk & REG_CONST_BIT) != 0; }
+
+static void emitLoadRK(JitEmitter *e, int x, u16 rk) {
+    if (isRKConst(rk)) {
+        emitLoadImm(e, x, rkConst(e, rk));
+    } else {
+        emitLoadReg(e, x, rk);
+    }
+}
+
+// Load RK(rk) to x for `emitCheckNum`, a number constant is loaded as the
+// bits of its `double`
+static void emitLoadNumRK(JitEmitter *e, int x, u16 rk) {
+    if (isRKConst(rk) && IsValueNum(rkConst(e, rk))) {
+        emitLoadImm(e, x, MakeNumber(ValueAsNum(rkConst(e, rk))));
+    } else {
+        emitLoadRK(e, x, rk);
+    }
+}
+
+// Can the operand be a number? Constants are known at compile time
+static bool rkMaybeNum(const JitEmitter *e, u16 rk) {
+    return !isRKConst(rk) || IsValueNum(rkConst(e, rk));
+}
+
+static void bindForward(JitEmitter *e, u32 at) {
+    if (at != 0) {
+        patchRel(e, at, here(e));
+    }
+}
+
+// Jump to a label bound later unless x is a number, an int is converted to
+// the bits of its `double`. Returns where rel32 is, or 0 if operand is a
+// number constant and nothing was emitted
+static u32 emitCheckNum(JitEmitter *e, int x, u16 rk) {
+    if (isRKConst(rk)) {
+        return 0;
+    }
+    // mov rsi, x ; and rsi, r13 ; cmp rsi, r13
+    const u8 checkNum[] = {0x48, 0x89, (u8)(0xC6 | (x << 3)), 0x4C, 0x21,
+                           0xEE, 0x4C, 0x39, 0xEE};
+    emitBytes(e, checkNum, 9);
+    u32 isDouble = jccForward(e, CC_NE);
+    // mov rsi, x ; shr rsi, 32 ; cmp esi, high bits of int tag
+    const u8 checkInt[] = {0x48, 0x89, (u8)(0xC6 | (x << 3)), 0x48,
+                           0xC1, 0xEE, 0x20, 0x81, 0xFE};
+    emitBytes(e, checkInt, 9);
+    emit32(e, (u32)((QNAN | TAG_INT) >> 32));
+    u32 slow = jccForward(e, CC_NE);
+    // cvtsi2sd xmm2, x32 ; movq x, xmm2
+    const u8 toDouble[] = {0xF2, 0x0F, 0x2A, (u8)(0xD0 | x),
+                           0x66, 0x48, 0x0F, 0x7E, (u8)(0xD0 | x)};
+    emitBytes(e, toDouble, 9);
+    bindForward(e, isDouble);
+    return slow;
+}
+
+// movq xmm0, rax ; movq xmm1, rcx
+static void emitToXmm(JitEmitter *e) {
+    const u8 bytes[] = {0x66, 0x48, 0x0F, 0x6E, 0xC0,
+                        0x66, 0x48, 0x0F, 0x6E, 0xC9};
+    emitBytes(e, bytes, 10);
+}
+
+// Call `fn(vm, ins)`, status ends up in eax
+static void emitHelper(JitEmitter *e, JitHelperFn fn, const PRegIns *ins) {
+    // mov rdi, rbx
+    const u8 movRdi[] = {0x48, 0x89, 0xDF};
+    emitBytes(e, movRdi, 3);
+    // mov rsi, ins
+    emit8(e, 0x48);
+    emit8(e, 0xBE);
+    emit64(e, (u64)(uintptr_t)ins);
+    emitLoadImm(e, X_RAX, (u64)(uintptr_t)fn);
+    // call rax
+    emit8(e, 0xFF);
+    emit8(e, 0xD0);
+}
+
+// Return `JIT_ERROR` from native code if helper failed
+static void emitCheckError(JitEmitter *e) {
+    // test eax, eax
+    emit8(e, 0x85);
+    emit8(e, 0xC0);
+    jccToEpilogue(e, CC_E);
+}
+
+// cmp eax, imm8
+static void emitCmpEax(JitEmitter *e, u8 value) {
+    emit8(e, 0x83);
+    emit8(e, 0xF8);
+    emit8(e, value);
+}
+
+// Generic instruction, run by the VM
+static void emitExec(JitEmitter *e, const PRegIns *ins) {
+    emitHelper(e, VmJitExec, ins);
+    emitCheckError(e);
+}
+
+static void emitPrologue(JitEmitter *e) {
+    const u8 bytes[] = {
+        0x55,                   // push rbp
+        0x48, 0x89, 0xE5,       // mov rbp, rsp
+        0x53,                   // push rbx
+        0x41, 0x54,             // push r12
+        0x41, 0x55,             // push r13
+        0x41, 0x56,             // push r14
+        0x41, 0x57,             // push r15
+        0x48, 0x83, 0xEC, 0x08, // sub rsp, 8 ; align stack for calls
+        0x48, 0x89, 0xFB,       // mov rbx, rdi
+        0x49, 0x89, 0xF4,       // mov r12, rsi
+    };
+    emitBytes(e, bytes, sizeof(bytes));
+    // mov r13, QNAN ; mov r14, TrueValue
+    emit8(e, 0x49);
+    emit8(e, 0xBD);
+    emit64(e, QNAN);
+    emit8(e, 0x49);
+    emit8(e, 0xBE);
+    emit64(e, TrueValue);
+    // jmp rdx
+    emit8(e, 0xFF);
+    emit8(e, 0xE2);
+}
+
+static void emitEpilogue(JitEmitter *e) {
+    const u8 bytes[] = {
+        0x48, 0x83, 0xC4, 0x08, // add rsp, 8
+        0x41, 0x5F,             // pop r15
+        0x41, 0x5E,             // pop r14
+        0x41, 0x5D,             // pop r13
+        0x41, 0x5C,             // pop r12
+        0x5B,                   // pop rbx
+        0x5D,                   // pop rbp
+        0xC3,                   // ret
+    };
+    emitBytes(e, bytes, sizeof(bytes));
+}
+
+// R(a) = RK(b) op RK(c), inline if both are numbers
+static void emitArith(JitEmitter *e, const PRegIns *ins, u8 sseOp) {
+    if (!rkMaybeNum(e, ins->b) || !rkMaybeNum(e, ins->c)) {
+        emitExec(e, ins);
+        return;
+    }
+
+    emitLoadNumRK(e, X_RAX, ins->b);
+    emitLoadNumRK(e, X_RCX, ins->c);
+    u32 slowB = emitCheckNum(e, X_RAX, ins->b);
+    u32 slowC = emitCheckNum(e, X_RCX, ins->c);
+    emitToXmm(e);
+    // addsd / subsd / mulsd xmm0, xmm1 ; movq rax, xmm0
+    const u8 bytes[] = {0xF2, 0x0F, sseOp, 0xC1, 0x66, 0x48, 0x0F, 0x7E, 0xC0};
+    emitBytes(e, bytes, 9);
+    emitStoreRax(e, ins->a);
+    u32 done = jmpForward(e);
+
+    bindForward(e, slowB);
+    bindForward(e, slowC);
+    emitExec(e, ins);
+    bindForward(e, done);
+}
+
+// Jump to `target` unless RK(b) op RK(c). Numbers are compared inline
+static void emitCompareJump(JitEmitter *e, const PRegIns *ins, u32 target) {
+    if (!rkMaybeNum(e, ins->b) || !rkMaybeNum(e, ins->c)) {
+        emitHelper(e, VmJitCompare, ins);
+        emitCheckError(e);
+        emitCmpEax(e, JIT_JUMP);
+        jccToPc(e, CC_E, target);
+        return;
+    }
+
+    emitLoadNumRK(e, X_RAX, ins->b);
+    emitLoadNumRK(e, X_RCX, ins->c);
+    u32 slowB = emitCheckNum(e, X_RAX, ins->b);
+    u32 slowC = emitCheckNum(e, X_RCX, ins->c);
+    emitToXmm(e);
+
+    // ucomisd xmm0, xmm1 compares b with c, ucomisd xmm1, xmm0 c with b.
+    // Unordered (NaN) sets ZF, PF and CF, so every comparison is false
+    const u8 ucomBC[] = {0x66, 0x0F, 0x2E, 0xC1};
+    const u8 ucomCB[] = {0x66, 0x0F, 0x2E, 0xC8};
+    u32 skip = 0;
+    switch ((PRegOp)ins->op) {
+        case RG_JMPF_LT:
+            emitBytes(e, ucomCB, 4);
+            jccToPc(e, CC_BE, target);
+            break;
+        case RG_JMPF_LE:
+            emitBytes(e, ucomCB, 4);
+            jccToPc(e, CC_B, target);
+            break;
+        case RG_JMPF_GT:
+            emitBytes(e, ucomBC, 4);
+            jccToPc(e, CC_BE, target);
+            break;
+        case RG_JMPF_GE:
+            emitBytes(e, ucomBC, 4);
+            jccToPc(e, CC_B, target);
+            break;
+        case RG_JMPF_EQ:
+            emitBytes(e, ucomBC, 4);
+            jccToPc(e, CC_NE, target);
+            jccToPc(e, CC_P, target);
+            break;
+        case RG_JMPF_NE:
+            emitBytes(e, ucomBC, 4);
+            skip = jccForward(e, CC_P);
+            jccToPc(e, CC_E, target);
+            break;
+        default: break;
+    }
+    bindForward(e, skip);
+    u32 done = jmpForward(e);
+
+    bindForward(e, slowB);
+    bindForward(e, slowC);
+    emitHelper(e, VmJitCompare, ins);
+    emitCheckError(e);
+    emitCmpEax(e, JIT_JUMP);
+    jccToPc(e, CC_E, target);
+    bindForward(e, done);
+}
+
+static void emitIns(JitEmitter *e, u32 pc) {
+    const PRegIns *ins = &e->rc->code[pc];
+    u32 target = (u32)((i64)pc + 1 + (i16)ins->a);
+
+    switch ((PRegOp)ins->op) {
+        case RG_MOVE: {
+            emitLoadReg(e, X_RAX, ins->b);
+            emitStoreRax(e, ins->a);
+            break;
+        }
+        case RG_LOADK: {
+            u32 index = ins->b | (u32)ins->c << 16;
+            emitLoadImm(e, X_RAX, e->consts[index]);
+            emitStoreRax(e, ins->a);
+            break;
+        }
+        case RG_LOADNIL:
+        case RG_LOADTRUE:
+        case RG_LOADFALSE: {
+            PValue value = ins->op == RG_LOADNIL    ? MakeNil()
+                           : ins->op == RG_LOADTRUE ? MakeBool(true)
+                                                    : MakeBool(false);
+            emitLoadImm(e, X_RAX, value);
+            emitStoreRax(e, ins->a);
+            break;
+        }
+
+        case RG_ADD: emitArith(e, ins, 0x58); break;
+        case RG_SUB: emitArith(e, ins, 0x5C); break;
+        case RG_MUL: emitArith(e, ins, 0x59); break;
+
+        case RG_JMP: jmpToPc(e, target); break;
+        case RG_JMPF:
+        case RG_JMPT: {
+            emitLoadReg(e, X_RAX, ins->b);
+            // cmp rax, r14
+            const u8 bytes[] = {0x4C, 0x39, 0xF0};
+            emitBytes(e, bytes, 3);
+            jccToPc(e, ins->op == RG_JMPF ? CC_NE : CC_E, target);
+            break;
+        }
+        case RG_JMPF_EQ:
+        case RG_JMPF_NE:
+        case RG_JMPF_GT:
+        case RG_JMPF_GE:
+        case RG_JMPF_LT:
+        case RG_JMPF_LE: emitCompareJump(e, ins, target); break;
+
+        case RG_CALL: {
+            emitHelper(e, VmJitCall, ins);
+            emitCheckError(e);
+            break;
+        }
+        case RG_TAILCALL: {
+            emitHelper(e, VmJitTailCall, ins);
+            emitCheckError(e);
+            emitCmpEax(e, JIT_TAILCALL);
+            jccToEpilogue(e, CC_E);
+            break;
+        }
+        case RG_RETURN: {
+            emitHelper(e, VmJitReturn, ins);
+            patchRel(e, jmpForward(e), e->epilogue);
+            break;
+        }
+
+        // Read by the `RG_CLOSURE` before them
+        case RG_UPVAL_DESC: break;
+
+        default: emitExec(e, ins); break;
+    }
+}
+
+PJitCode *JitCompile(const PBytecode *bt) {
+    const PRegCode *rc = bt->reg;
+    if (rc == NULL || rc->count == 0) {
+        return NULL;
+    }
+
+    JitEmitter e = {0};
+    e.rc = rc;
+    e.consts = bt->constPool;
+    e.offsets = PCreateArray(u32, rc->count);
+    if (e.offsets == NULL) {
+        return NULL;
+    }
+
+    emitPrologue(&e);
+    e.epilogue = here(&e);
+    emitEpilogue(&e);
+
+    for (u32 pc = 0; pc < rc->count; pc++) {
+        e.offsets[pc] = here(&e);
+        emitIns(&e, pc);
+    }
+
+    for (i64 i = 0; i < arrlen(e.fixes); i++) {
+        patchRel(&e, e.fixes[i].at, e.offsets[e.fixes[i].pc]);
+    }
+
+    PJitCode *jit = PCreate(PJitCode);
+    u64 size = (u64)arrlen(e.buf);
+    void *mem = MAP_FAILED;
+    if (jit != NULL) {
+        mem = mmap(
+            NULL, (size_t)size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+        );
+    }
+
+    if (mem != MAP_FAILED) {
+        memcpy(mem, e.buf, (size_t)size);
+        if (mprotect(mem, (size_t)size, PROT_READ | PROT_EXEC) != 0) {
+            munmap(mem, (size_t)size);
+            mem = MAP_FAILED;
+        }
+    }
+
+    arrfree(e.buf);
+    arrfree(e.fixes);
+    if (mem == MAP_FAILED) {
+        PFree(e.offsets);
+        PFree(jit);
+        return NULL;
+    }
+
+    jit->mem = (u8 *)mem;
+    jit->size = size;
+    jit->offsets = e.offsets;
+    return jit;
+}
+
+PJitStatus JitRun(const PJitCode *jit, PVm *vm, PValue *regs, u32 pc) {
+    // Prologue is at the start of the block
+    JitEntryFn entry = NULL;
+    const u8 *mem = jit->mem;
+    memcpy(&entry, &mem, sizeof(entry));
+    return entry(vm, regs, jit->mem + jit->offsets[pc]);
+}
+
+void FreeJitCode(PJitCode *jit) {
+    if (jit == NULL) {
+        return;
+    }
+    munmap(jit->mem, (size_t)jit->size);
+    PFree(jit->offsets);
+    PFree(jit);
+}
+
+#endif
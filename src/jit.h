@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_JIT_H
+#define PANKTI_JIT_H
+
+#include "object.h"
+#include "ptypes.h"
+#include "regcode.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Baseline JIT for x86-64.
+//
+// Built when `PANKTI_JIT` is defined, which the build only does for x86-64
+// Linux and macOS with NaN boxing (native code works on NaN boxed values
+// directly).
+//
+// Each function counts its calls and loop back edges, once it is hot its
+// register bytecode (see regcode.h) is compiled by stitching a machine code
+// template for each instruction. Moves, constants, number arithmetic and
+// comparisons and jumps are done inline, everything else calls back into the
+// VM through the `VmJit*` helpers below. A frame running native code is a
+// register frame, its registers are its stack slots, so native code can be
+// entered at a loop head from a running interpreter.
+//
+// `PANKTI_JIT` environment variable : `off` disables the JIT, `always`
+// compiles every function on its first call or loop iteration.
+
+#if defined(PANKTI_JIT)
+
+// Calls and back edges before a function is compiled
+#define JIT_HOT_THRESHOLD 1000
+// `hotCount` of functions which can't be compiled
+#define JIT_NEVER UINT32_MAX
+// Max nested native frames, deeper calls run in the register engine so C
+// stack doesn't overflow before the VM call stack does
+#define JIT_MAX_DEPTH 512
+
+// Result of native code and VM helpers
+typedef enum PJitStatus {
+    // Error was reported
+    JIT_ERROR = 0,
+    // Continue with next instruction
+    JIT_NEXT,
+    // Conditional jump is taken
+    JIT_JUMP,
+    // Frame returned, result is in its slot 0
+    JIT_DONE,
+    // Frame was replaced by a tail call, run it from the start
+    JIT_TAILCALL,
+} PJitStatus;
+
+typedef struct PJitCode {
+    u8 *mem;
+    u64 size;
+    // Offset of native code of each register instruction
+    u32 *offsets;
+} PJitCode;
+
+// Compile register bytecode of `bt` to native code. Returns NULL on failure
+PJitCode *JitCompile(const PBytecode *bt);
+// Run native code of top frame of `vm` with registers `regs` from register
+// instruction `pc`
+PJitStatus JitRun(const PJitCode *jit, PVm *vm, PValue *regs, u32 pc);
+// Free native code
+void FreeJitCode(PJitCode *jit);
+
+// VM helpers called from native code, see vm.c. They work on the top frame
+// and `ins` is the instruction being run
+
+// Run any instruction which doesn't change control flow
+PJitStatus VmJitExec(PVm *vm, const PRegIns *ins);
+// Compare of a fused compare and jump, `JIT_JUMP` if it is false
+PJitStatus VmJitCompare(PVm *vm, const PRegIns *ins);
+PJitStatus VmJitCall(PVm *vm, const PRegIns *ins);
+PJitStatus VmJitTailCall(PVm *vm, const PRegIns *ins);
+PJitStatus VmJitReturn(PVm *vm, const PRegIns *ins);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -22,36 +22,43 @@
 #include "printer.h"
 #include "ptypes.h"
 #include "token.h"
-#include "unicode.h"
 #include "ustring.h"
 #include "utils.h"
 
-Lexer *NewLexer(char *src) {
-    Lexer *lx = PMalloc(sizeof(Lexer));
-    if (lx == NULL) {
+// Runs of ASCII whitespace, identifier and string bytes are skipped 16 bytes
+// at a time with SSE2 (x86-64) or NEON (AArch64), other targets use the
+// scalar loops. Only non ASCII characters are decoded to codepoints
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PANKTI_LEXER_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define PANKTI_LEXER_NEON
+#include <arm_neon.h>
+#endif
+
+Lexer *NewLexer(char *src, PArena *arena) {
+    if (src == NULL) {
         return NULL;
     }
-
-    UIter *iter = NewUIterator(src);
-    if (iter == NULL) {
-        PFree(lx);
+    Lexer *lx = PMalloc(sizeof(Lexer));
+    if (lx == NULL) {
         return NULL;
     }
 
-    lx->iter = iter;
-
     lx->current = 0;
     lx->start = 0;
     lx->column = 1;
     lx->line = 1;
-    lx->lineStart = 0;
-    lx->tokIndex = 0;
     lx->source = src;
     lx->length = (u64)strlen(src);
     lx->tokens = NULL;
+    lx->arena = arena;
     lx->core = NULL;
+    lx->errCtx = (PDiagonCtx){0};
     lx->raw = false;
     lx->hasError = false;
+    lx->openString = false;
 
     return lx;
 }
@@ -74,64 +81,60 @@ void FreeLexer(Lexer *lexer) {
         }
     }
 
+    // Tokens themselves belong to the arena
     if (lexer->tokens != NULL) {
-        long count = arrlen(lexer->tokens);
-        for (long i = 0; i < count; i++) {
-            FreeToken(arrpop(lexer->tokens));
-        }
         arrfree(lexer->tokens);
     }
 
-    if (lexer->iter != NULL) {
-        FreeUIterator(lexer->iter);
-    }
-
     PFree(lexer);
 }
 
 void ResetLexer(Lexer *lexer) {
+    // Tokens themselves belong to the arena
     if (lexer->tokens != NULL) {
-        long count = arrlen(lexer->tokens);
-        for (long i = 0; i < count; i++) {
-            FreeToken(arrpop(lexer->tokens));
-        }
         arrfree(lexer->tokens);
     }
 
-    if (lexer->iter != NULL) {
-        FreeUIterator(lexer->iter);
-    }
-
-    UIter *iter = NewUIterator(lexer->source);
-    lexer->iter = iter;
-
     lexer->current = 0;
     lexer->start = 0;
     lexer->column = 1;
-    lexer->lineStart = 0;
     lexer->line = 1;
     lexer->length = (u64)strlen(lexer->source);
     lexer->tokens = NULL;
+    lexer->openString = false;
 }
 
-static inline void error(Lexer *lx, u64 line, u64 col, const char *msg) {
+// Report invalid character `rawChar`
+static inline void error(Lexer *lx, u64 line, u64 col, const char *rawChar) {
     lx->hasError = true;
+    u64 len = lx->current - lx->start;
+    if (len == 0) {
+        len = 1;
+    }
     if (lx->core != NULL) {
-        u64 len = lx->current - lx->start;
-        if (len == 0) {
-            len = 1;
-        }
-        CoreLexerError(lx->core, line, col, len, msg);
+        CoreLexerError(
+            lx->core, line, col, len, StrFormat(LEXER_ERR_INVALID_CHAR, rawChar)
+        );
+        return;
     }
 
-    if (lx->core == NULL) {
-        // Should never reach here
-        PanPrint(
-            LEXER_ERR_INVALID_CHAR_NOCORE, (unsigned long long)lx->line,
-            (unsigned long long)lx->column
-        );
+    if (lx->errCtx.report != NULL) {
+        Token tok = {
+            .lexeme = NULL,
+            .type = T_EOF,
+            .line = (u32)line,
+            .col = (u32)col,
+            .len = (u32)len,
+        };
+        ReportDiag(&lx->errCtx, &tok, LEXER_INVALID_CHAR, rawChar);
         return;
     }
+
+    // Should never reach here
+    PanPrint(
+        LEXER_ERR_INVALID_CHAR_NOCORE, (unsigned long long)lx->line,
+        (unsigned long long)lx->column
+    );
 }
 
 static inline bool isAnyNumber(char32_t c) {
@@ -147,33 +150,229 @@ static inline bool isAnyAlpha(char32_t c) {
     return isEnAlpha || isBnAlpha;
 }
 
-static inline bool isAnyAlphaNum(char32_t c) {
-    return isAnyAlpha(c) || isAnyNumber(c);
+#if defined(PANKTI_LEXER_SSE2)
+typedef __m128i LexVec;
+static finline LexVec vecLoad(const u8 *s) {
+    return _mm_loadu_si128((const __m128i *)(const void *)s);
+}
+static finline LexVec vecEq(LexVec v, char c) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+// Bytes from `lo` to `hi`, both ASCII. Signed compare, so non ASCII bytes
+// are negative and never in range
+static finline LexVec vecRange(LexVec v, char lo, char hi) {
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(v, _mm_set1_epi8((char)(lo - 1))),
+        _mm_cmplt_epi8(v, _mm_set1_epi8((char)(hi + 1)))
+    );
 }
+static finline LexVec vecOr(LexVec a, LexVec b) { return _mm_or_si128(a, b); }
+static finline bool vecAll(LexVec v) { return _mm_movemask_epi8(v) == 0xffff; }
+static finline bool vecNone(LexVec v) { return _mm_movemask_epi8(v) == 0; }
+#elif defined(PANKTI_LEXER_NEON)
+typedef uint8x16_t LexVec;
+static finline LexVec vecLoad(const u8 *s) { return vld1q_u8(s); }
+static finline LexVec vecEq(LexVec v, char c) {
+    return vceqq_u8(v, vdupq_n_u8((u8)c));
+}
+static finline LexVec vecRange(LexVec v, char lo, char hi) {
+    return vandq_u8(
+        vcgeq_u8(v, vdupq_n_u8((u8)lo)), vcleq_u8(v, vdupq_n_u8((u8)hi))
+    );
+}
+static finline LexVec vecOr(LexVec a, LexVec b) { return vorrq_u8(a, b); }
+static finline bool vecAll(LexVec v) { return vminvq_u8(v) == 0xff; }
+static finline bool vecNone(LexVec v) { return vmaxvq_u8(v) == 0; }
+#endif
 
-static bool atEnd(const Lexer *lexer) { return UIterIsEnd(lexer->iter); }
+#if defined(PANKTI_LEXER_SSE2) || defined(PANKTI_LEXER_NEON)
+#define PANKTI_LEXER_SIMD
+#endif
 
-static char32_t advance(Lexer *lexer) {
-    u64 pos = lexer->iter->pos;
-    char32_t cp = UIterNext(lexer->iter);
-    if (cp != 0) {
-        lexer->current += (lexer->iter->pos - pos);
-        lexer->column += lexer->iter->pos - pos;
-        return cp;
+// Most runs are shorter than a vector, which only pays off for long ones.
+// Runs are checked byte by byte until they are this long
+#define LEXER_SIMD_AFTER 16
+
+#if defined(PANKTI_LEXER_SIMD)
+// Bytes of the whole vectors at `s` which are all spaces, tabs or carriage
+// returns
+static u64 spaceVecRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    for (; i + 16 <= len; i += 16) {
+        LexVec v = vecLoad(s + i);
+        LexVec space =
+            vecOr(vecEq(v, ' '), vecOr(vecEq(v, '\t'), vecEq(v, '\r')));
+        if (!vecAll(space)) {
+            break;
+        }
     }
+    return i;
+}
 
-    return 0;
+// Bytes of the whole vectors at `s` which are all ASCII letters, digits or
+// `_`
+static u64 identVecRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    for (; i + 16 <= len; i += 16) {
+        LexVec v = vecLoad(s + i);
+        LexVec ident = vecOr(
+            vecOr(vecRange(v, 'a', 'z'), vecRange(v, 'A', 'Z')),
+            vecOr(vecRange(v, '0', '9'), vecEq(v, '_'))
+        );
+        if (!vecAll(ident)) {
+            break;
+        }
+    }
+    return i;
 }
 
-static char32_t _peek(const Lexer *lx, int n) {
-    if (atEnd(lx) || n < 0) {
+// Bytes of the whole vectors at `s` without `"`, `\` or newline
+static u64 stringVecRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    for (; i + 16 <= len; i += 16) {
+        LexVec v = vecLoad(s + i);
+        LexVec stop =
+            vecOr(vecEq(v, '"'), vecOr(vecEq(v, '\\'), vecEq(v, '\n')));
+        if (!vecNone(stop)) {
+            break;
+        }
+    }
+    return i;
+}
+#endif
+
+static finline bool isSpaceByte(u8 c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Bytes of the run of spaces, tabs and carriage returns at `s`
+static u64 spaceRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    while (i < len && isSpaceByte(s[i])) {
+        i++;
+#if defined(PANKTI_LEXER_SIMD)
+        if (i == LEXER_SIMD_AFTER) {
+            i += spaceVecRun(s + i, len - i);
+        }
+#endif
+    }
+    return i;
+}
+
+static finline bool isIdentByte(u8 c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+}
+
+// If `s` starts with a UTF-8 encoded character of the Bengali block
+// (`IsBnChar`), all of which are three bytes
+static finline bool isBnBytes(const u8 *s, u64 len) {
+    if (len < 3 || s[0] != 0xe0) {
+        return false;
+    }
+    if (s[1] == 0xa6) {
+        return (s[2] & 0xc0) == 0x80;
+    }
+    return s[1] == 0xa7 && s[2] >= 0x80 && s[2] <= 0xbe;
+}
+
+// If `s` starts with a UTF-8 encoded Bengali digit (`IsBnNumber`)
+static finline bool isBnNumberBytes(const u8 *s, u64 len) {
+    return len >= 3 && s[0] == 0xe0 && s[1] == 0xa7 && s[2] >= 0xa6 &&
+           s[2] <= 0xaf;
+}
+
+// Bytes of the run of identifier characters (`isAnyAlpha` or `isAnyNumber`)
+// at `s`
+static u64 identRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    while (i < len) {
+        if (isIdentByte(s[i])) {
+            i++;
+#if defined(PANKTI_LEXER_SIMD)
+            if (i == LEXER_SIMD_AFTER) {
+                i += identVecRun(s + i, len - i);
+            }
+#endif
+        } else if (isBnBytes(s + i, len - i)) {
+            i += 3;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+// Bytes of the run at `s` until a `"`, `\` or newline
+static u64 stringRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    while (i < len && s[i] != '"' && s[i] != '\\' && s[i] != '\n') {
+        i++;
+#if defined(PANKTI_LEXER_SIMD)
+        if (i == LEXER_SIMD_AFTER) {
+            i += stringVecRun(s + i, len - i);
+        }
+#endif
+    }
+    return i;
+}
+
+static bool atEnd(const Lexer *lexer) {
+    return lexer->current >= lexer->length;
+}
+
+// Codepoint at byte `pos` of source, setting `len` to its byte length. ASCII
+// is read as is, only other characters are decoded
+static finline char32_t codepointAt(const Lexer *lx, u64 pos, u64 *len) {
+    if (pos >= lx->length) {
+        *len = 0;
         return 0;
     }
-    return UIterPeek(lx->iter, n);
+    u8 c = (u8)lx->source[pos];
+    if (c < 0x80) {
+        *len = 1;
+        return c;
+    }
+    return UDecodeCp(lx->source + pos, lx->length - pos, len);
 }
 
-static char32_t peek(const Lexer *lx) { return _peek(lx, 0); }
-static char32_t peekPeek(const Lexer *lx) { return _peek(lx, 1); }
+static char32_t advance(Lexer *lexer) {
+    u64 len = 0;
+    char32_t cp = codepointAt(lexer, lexer->current, &len);
+    lexer->current += len;
+    lexer->column += len;
+    return cp;
+}
+
+static char32_t peek(const Lexer *lx) {
+    u64 len = 0;
+    return codepointAt(lx, lx->current, &len);
+}
+
+static char32_t peekPeek(const Lexer *lx) {
+    u64 len = 0;
+    codepointAt(lx, lx->current, &len);
+    if (len == 0) {
+        return 0;
+    }
+    return codepointAt(lx, lx->current + len, &len);
+}
+
+// Source bytes from the current position
+static finline const u8 *cursor(const Lexer *lx) {
+    return (const u8 *)lx->source + lx->current;
+}
+
+// How many source bytes are left
+static finline u64 remaining(const Lexer *lx) {
+    return lx->length - lx->current;
+}
+
+// Move `n` bytes ahead on the current line
+static finline void skipBytes(Lexer *lx, u64 n) {
+    lx->current += n;
+    lx->column += n;
+}
 
 static bool match(Lexer *lx, char32_t target) {
     if (atEnd(lx)) {
@@ -214,8 +413,13 @@ static void lexerErrorSync(Lexer * lx){
 }
 */
 
+// Lexeme of source bytes from `start`, a slice of the source which isn't NUL
+// terminated. Strings are only copied out of it when the compiler makes string
+// objects of them
+static char *lexemeAt(const Lexer *lx, u64 start) { return lx->source + start; }
+
 static bool addTokenWithLexeme(Lexer *lx, PTokenType type, char *str, u64 len) {
-    Token *tok = NewToken(type);
+    Token *tok = NewArenaToken(lx->arena, type);
     if (tok == NULL) {
         return false;
     }
@@ -224,7 +428,6 @@ static bool addTokenWithLexeme(Lexer *lx, PTokenType type, char *str, u64 len) {
     tok->line = lx->line;
     if (str != NULL) {
         tok->len = len;
-        tok->hash = StrHash(str, len, lx->timestamp);
     } else {
         if (IsDoubleTok(type)) {
             tok->len = 2;
@@ -237,18 +440,6 @@ static bool addTokenWithLexeme(Lexer *lx, PTokenType type, char *str, u64 len) {
     column -= tok->len;
 
     tok->col = column;
-
-    tok->gcol =
-        GetGraphemeCount(
-            lx->source + lx->lineStart,
-            lx->start - lx->lineStart // bytes from line start to token start
-        ) +
-        1; // 1 based column
-
-    tok->glen =
-        GetGraphemeCount(lx->source + lx->start, lx->current - lx->start);
-
-    tok->index = lx->tokIndex++;
     arrput(lx->tokens, tok);
     return true;
 }
@@ -258,7 +449,7 @@ static bool addToken(Lexer *lx, PTokenType type) {
 }
 
 static bool addStringToken(Lexer *lx, char *str, u64 line, u64 col, u64 len) {
-    Token *tok = NewToken(T_STR);
+    Token *tok = NewArenaToken(lx->arena, T_STR);
     if (tok == NULL) {
         return false;
     }
@@ -266,15 +457,9 @@ static bool addStringToken(Lexer *lx, char *str, u64 line, u64 col, u64 len) {
     tok->lexeme = str;
     tok->line = line;
     tok->col = col;
-    tok->len = len - 2;
-    tok->hash = StrHash(str, tok->len, lx->timestamp);
-    tok->gcol = GetGraphemeCount(
-                    lx->source + lx->lineStart, lx->start - lx->lineStart
-                ) +
-                1;
-    tok->glen = GetGraphemeCount(str, StrLength(str));
-
-    tok->index = lx->tokIndex++;
+    // Without quotes, a lone `"` at the end has neither
+    tok->len = len >= 2 ? len - 2 : 0;
+
     arrput(lx->tokens, tok);
     return true;
 }
@@ -282,11 +467,16 @@ static bool addStringToken(Lexer *lx, char *str, u64 line, u64 col, u64 len) {
 static void readString(Lexer *lx) {
     u64 column = lx->column - 1;
     u64 line = lx->line;
-    while (peek(lx) != '"' && !atEnd(lx)) {
+    while (true) {
+        skipBytes(lx, stringRun(cursor(lx), remaining(lx)));
+        if (atEnd(lx) || peek(lx) == '"') {
+            break;
+        }
         if (peek(lx) == '\n') {
             lx->line++;
             lx->column = 1;
-        } else if (peek(lx) == '\\') {
+        } else {
+            // escape, the next character can't end the string
             advance(lx);
         }
         advance(lx);
@@ -294,24 +484,37 @@ static void readString(Lexer *lx) {
 
     if (!atEnd(lx)) {
         advance(lx); // somehow if we get malformed unterminated string
+    } else {
+        lx->openString = true;
     }
 
-    char *lexeme = SubString(lx->source, lx->start + 1, lx->current - 1);
+    char *lexeme = lexemeAt(lx, lx->start + 1);
     addStringToken(lx, lexeme, line, column, lx->current - lx->start);
 }
 
-static void readNumber(Lexer *lx) {
-    while (isAnyNumber(peek(lx))) {
-        advance(lx);
+// Bytes of the run of digits (`isAnyNumber`) at `s`
+static u64 digitRun(const u8 *s, u64 len) {
+    u64 i = 0;
+    while (i < len) {
+        if (s[i] >= '0' && s[i] <= '9') {
+            i++;
+        } else if (isBnNumberBytes(s + i, len - i)) {
+            i += 3;
+        } else {
+            break;
+        }
     }
+    return i;
+}
+
+static void readNumber(Lexer *lx) {
+    skipBytes(lx, digitRun(cursor(lx), remaining(lx)));
 
     if (peek(lx) == '.' && isAnyNumber(peekPeek(lx))) {
         advance(lx);
-        while (isAnyNumber(peek(lx))) {
-            advance(lx);
-        }
+        skipBytes(lx, digitRun(cursor(lx), remaining(lx)));
     }
-    char *lexeme = SubString(lx->source, lx->start, lx->current);
+    char *lexeme = lexemeAt(lx, lx->start);
     addTokenWithLexeme(lx, T_NUM, lexeme, lx->current - lx->start);
 }
 
@@ -365,11 +568,9 @@ static PTokenType getIdentType(const char *str, u64 len) {
 }
 
 static void readIdent(Lexer *lx) {
-    while (isAnyAlphaNum(peek(lx))) {
-        advance(lx);
-    }
+    skipBytes(lx, identRun(cursor(lx), remaining(lx)));
 
-    char *lexeme = SubString(lx->source, lx->start, lx->current);
+    char *lexeme = lexemeAt(lx, lx->start);
     u64 lexemeLen = lx->current - lx->start;
     PTokenType identType = getIdentType(lexeme, lexemeLen);
     addTokenWithLexeme(lx, identType, lexeme, lx->current - lx->start);
@@ -391,9 +592,11 @@ static void scanToken(Lexer *lx) {
         case '-': addToken(lx, T_MINUS); break;
         case '/': {
             if (match(lx, '/')) {
-                while (peek(lx) != '\n' && !atEnd(lx)) {
-                    advance(lx);
-                }
+                // comment runs to the end of line
+                const u8 *end = memchr(cursor(lx), '\n', remaining(lx));
+                skipBytes(
+                    lx, end == NULL ? remaining(lx) : (u64)(end - cursor(lx))
+                );
             } else {
                 addToken(lx, T_SLASH);
             }
@@ -453,7 +656,6 @@ static void scanToken(Lexer *lx) {
         case '\n': {
             lx->line++;
             lx->column = 1;
-            lx->lineStart = lx->current;
             break;
         }
         default: {
@@ -464,14 +666,11 @@ static void scanToken(Lexer *lx) {
                 readIdent(lx);
                 break;
             } else {
-                u8 rawChar[4];
+                u8 rawChar[5] = {0};
                 U32ToU8(c, rawChar);
                 // backtrack current position advance
                 u64 errCol = lx->column - (lx->current - lx->start);
-                error(
-                    lx, lx->line, errCol,
-                    StrFormat(LEXER_ERR_INVALID_CHAR, rawChar)
-                );
+                error(lx, lx->line, errCol, (const char *)rawChar);
                 // lexerErrorSync(lx);
                 break;
             }
@@ -480,8 +679,25 @@ static void scanToken(Lexer *lx) {
     }
 }
 
+// Skip whitespace and newlines up to the next token
+static void skipSpace(Lexer *lx) {
+    while (!atEnd(lx)) {
+        skipBytes(lx, spaceRun(cursor(lx), remaining(lx)));
+        if (atEnd(lx) || lx->source[lx->current] != '\n') {
+            return;
+        }
+        lx->current++;
+        lx->line++;
+        lx->column = 1;
+    }
+}
+
 Token **ScanTokens(Lexer *lexer) {
-    while (!atEnd(lexer)) {
+    while (true) {
+        skipSpace(lexer);
+        if (atEnd(lexer)) {
+            break;
+        }
         lexer->start = lexer->current;
         scanToken(lexer);
     }
@@ -17,6 +17,8 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "arena.h"
+#include "diagonctx.h"
 #include "ptypes.h"
 #include "token.h"
 #include "ustring.h"
@@ -34,9 +36,9 @@ typedef struct Lexer {
     u64 length;
     // Array of tokens; Filled with ScanTokens(...) function
     Token **tokens;
-
-    // Token index
-    u64 tokIndex;
+    // Tokens are allocated from here, their lexemes point into `source`; Not
+    // owned by lexer
+    PArena *arena;
 
     // Start index of the character for token to be created
     // When creating a new token, this will be the first character index
@@ -49,25 +51,21 @@ typedef struct Lexer {
     // current column number of the start of the token
     u64 column;
 
-    // Byte offset of where current line starts
-    u64 lineStart;
-
-    // Codepoint iterator. The characters are read as UTF-32 characters
-    UIter *iter;
-
-    // Timestamp seed for hashing
-    u64 timestamp;
-
     // Lexer Error occurred
     bool hasError;
+    // Last string ran on to the end of the source without its closing quote
+    bool openString;
 
     // Reference to Pankti Core
     PanktiCore *core;
+    // Errors are reported here when there is no core, see `check.h`
+    PDiagonCtx errCtx;
 } Lexer;
 
 // Create new Lexer Object;
 // `src` = source code
-Lexer *NewLexer(char *src);
+// `arena` = Where the tokens are allocated. They are only freed with it
+Lexer *NewLexer(char *src, PArena *arena);
 
 // Turn Lexer into Raw Lexer
 // It means: Lexer is given raw compile time string to work on
@@ -7,9 +7,11 @@
  */
 
 #include "argparse.h"
+#include "check.h"
 #include "core.h"
 #include "flags.h"
 #include "printer.h"
+#include "repl.h"
 #include "terminal.h"
 #include "utils.h"
 #include <locale.h>
@@ -71,6 +73,17 @@ int main(int argc, char **argv) {
         printf("Fatal Memory Error : Failed to initialize print buffer\n");
         return EXIT_FAILURE;
     }
+    if (args.checkServer) {
+        int result = RunCheckServer();
+        DestroyPrintBuffer();
+        return result;
+    }
+    if (args.repl) {
+        int result = RunRepl(args.regEngine);
+        DestroyPrintBuffer();
+        return result;
+    }
+
     if (args.scriptPath != NULL) {
         const char *filePath = args.scriptPath;
         if (!DoesFileExists(filePath)) {
@@ -89,6 +102,7 @@ int main(int argc, char **argv) {
         }
         core->scriptArgCount = args.scriptArgCount;
         core->scriptArgs = args.scriptArgs;
+        core->regEngine = args.regEngine;
         RunCore(core);
         PanFlushStdout();
         FreeCore(core);
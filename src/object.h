@@ -41,6 +41,9 @@ typedef u64 PValue;
 #define TAG_NIL    1
 #define TAG_FALSE  2
 #define TAG_TRUE   3
+// Numbers which are whole and fit in an `i32` can also be stored as the int
+// itself in the low 32 bits, tagged with `QNAN | TAG_INT`
+#define TAG_INT    ((u64)1 << 48)
 #define NilValue   ((PValue)(u64)(QNAN | TAG_NIL))
 #define TrueValue  ((PValue)(u64)(QNAN | TAG_TRUE))
 #define FalseValue ((PValue)(u64)(QNAN | TAG_FALSE))
@@ -85,6 +88,17 @@ typedef struct MapEntry {
     PValue value;
 } MapEntry;
 
+// Storage kind of an array. Arrays whose items are all numbers are kept as
+// `ARR_KIND_NUM`; with NaN boxing their item buffer is bit-for-bit a packed
+// `double` buffer (see `ArrayItemValue`), which the bulk numeric kernels use
+// directly.
+typedef enum PArrayKind {
+    // Items can be anything
+    ARR_KIND_ANY,
+    // Every item is a number
+    ARR_KIND_NUM,
+} PArrayKind;
+
 typedef struct UpValue {
     u16 index;
     bool isLocal;
@@ -101,18 +115,22 @@ typedef struct PObj {
     union v {
         // String Object. Type : `OT_STR`
         struct OString {
-            Token *name;
             char *value;
             u64 hash;
+            // Set if calls through a global of this name were compiled to
+            // intrinsic opcodes, writing the global turns them off
+            bool intrinsic;
         } OString;
 
         // Compiled Function Object. Type : `OT_COMFNC`
         struct OComFunction {
-            Token *rawName;
             // Will be OString
             PObj *strName;
             u64 paramCount;
             i16 upvalCount;
+            // Set when closures created inside this function capture its
+            // locals, so returning from it must close the open upvalues
+            bool capturesLocals;
             PBytecode *code;
         } OComFunction;
 
@@ -126,6 +144,7 @@ typedef struct PObj {
             Token *op;
             u64 count;
             PValue *items;
+            PArrayKind kind;
         } OArray;
 
         struct OMap {
@@ -181,9 +200,100 @@ static inline PValue MakeNumber(double number) {
 #endif
 }
 
+// Check if value is a number stored as int. Every int is a number too, for
+// anything other than fast paths they are the same as their `double`
+static inline bool IsValueInt(PValue value) {
+#if defined USE_NAN_BOXING
+    return (value & (SIGN_BIT | QNAN | TAG_INT)) == (QNAN | TAG_INT);
+#else
+    (void)value;
+    return false;
+#endif
+}
+
+// Get int of a value which `IsValueInt`
+static inline i32 ValueAsInt(PValue value) {
+#if defined USE_NAN_BOXING
+    return (i32)(u32)value;
+#else
+    return (i32)value.v.num;
+#endif
+}
+
+// Make a number value stored as int
+static inline PValue MakeInt(i32 number) {
+#if defined USE_NAN_BOXING
+    return (PValue)(QNAN | TAG_INT | (u64)(u32)number);
+#else
+    return MakeNumber((double)number);
+#endif
+}
+
+// Make a number value, stored as int if it is one. `-0` stays a `double` as
+// it is printed differently
+static inline PValue MakeIntOrNumber(double number) {
+#if defined USE_NAN_BOXING
+    if (number >= INT32_MIN && number <= INT32_MAX) {
+        i32 whole = (i32)number;
+        if ((double)whole == number &&
+            (whole != 0 || MakeNumber(number) == MakeNumber(0.0))) {
+            return MakeInt(whole);
+        }
+    }
+#endif
+    return MakeNumber(number);
+}
+
+// Int fast paths of arithmetic operators. Each writes `a op b` to `out` and
+// returns true, or returns false if the result is not an int : it overflows
+// or is `-0`, and the operator must be done with `double`s
+static inline bool IntAdd(i32 a, i32 b, PValue *out) {
+    i64 result = (i64)a + b;
+    if (result < INT32_MIN || result > INT32_MAX) {
+        return false;
+    }
+    *out = MakeInt((i32)result);
+    return true;
+}
+
+static inline bool IntSub(i32 a, i32 b, PValue *out) {
+    i64 result = (i64)a - b;
+    if (result < INT32_MIN || result > INT32_MAX) {
+        return false;
+    }
+    *out = MakeInt((i32)result);
+    return true;
+}
+
+static inline bool IntMul(i32 a, i32 b, PValue *out) {
+    i64 result = (i64)a * b;
+    if (result < INT32_MIN || result > INT32_MAX ||
+        (result == 0 && (a < 0 || b < 0))) {
+        return false;
+    }
+    *out = MakeInt((i32)result);
+    return true;
+}
+
+// Same as `fmod`, the result has the sign of `a`
+static inline bool IntMod(i32 a, i32 b, PValue *out) {
+    if (b == 0 || b == -1) {
+        return false;
+    }
+    i32 result = a % b;
+    if (result == 0 && a < 0) {
+        return false;
+    }
+    *out = MakeInt(result);
+    return true;
+}
+
 // Get Numeric value of PValue `value`
 static inline double ValueAsNum(PValue value) {
 #if defined USE_NAN_BOXING
+    if (IsValueInt(value)) {
+        return (double)ValueAsInt(value);
+    }
     double number;
     memcpy(&number, &value, sizeof(PValue));
     return number;
@@ -196,7 +306,7 @@ PValueType GetValueType(PValue value);
 
 // Check if value is a number
 #if defined(USE_NAN_BOXING)
-#define IsValueNum(val) (((val) & QNAN) != QNAN)
+#define IsValueNum(val) (((val) & QNAN) != QNAN || IsValueInt(val))
 #else
 #define IsValueNum(val) (val.type == PVAL_NUM)
 #endif
@@ -317,9 +427,85 @@ PValue MapObjGetValue(PObj *map, PValue key, u64 keyHash, bool *found);
 // If the key doesn't exist, ok is set to false, and Nil value is returned
 PValue MapObjRemoveKey(PObj *map, PValue key, u64 keyHash, bool *ok);
 
-bool ArrayObjInsValue(PObj *o, int index, PValue value);
+// Most items an array can hold. Growing an array past it fails instead of
+// asking for more memory than there can be
+#define ARRAY_ITEMS_MAX ((u64)1 << 32)
+
+// Insert `value` before item at `index`, moving the following items right.
+// Return false if index is out of range or the array can't grow
+bool ArrayObjInsValue(PObj *o, u64 index, PValue value);
 // Push new item to array. Return false if failed to push value.
 bool ArrayObjPushValue(PObj *o, PValue value);
+// Remove item at `index`, moving the following items left. Removed item is
+// written to `removed` if it is not NULL. Return false if index is out of range
+bool ArrayObjRemoveAt(PObj *o, u64 index, PValue *removed);
+// Make sure array has room for `capacity` items without reallocating. Return
+// false, leaving the array as it was, if it is over `ARRAY_ITEMS_MAX`
+bool ArrayObjReserve(PObj *o, u64 capacity);
+// Make sure stb_ds array `*items`, which may be NULL, has room for `capacity`
+// items. Return false, leaving it as it was, if it is over `ARRAY_ITEMS_MAX`.
+// Every growth of array items goes through it
+bool ArrayItemsReserve(PValue **items, u64 capacity);
+// Remove all items, keeping the allocated buffer
+bool ArrayObjClear(PObj *o);
+// Append `count` items to the end of array. `items` can point to the array's
+// own buffer. Return false if the array can't grow
+bool ArrayObjAppendItems(PObj *o, const PValue *items, u64 count);
+// Replace `deleteCount` items starting at `start` with `itemCount` items from
+// `items`. `items` must not point to the array's own buffer.
+// Return false if the range is out of bounds or the array can't grow
+bool ArrayObjSplice(
+    PObj *o, u64 start, u64 deleteCount, const PValue *items, u64 itemCount
+);
+// Find the storage kind of `count` items
+PArrayKind ArrayItemsKind(const PValue *items, u64 count);
+// Convert `count` items just stored in an array with `ArrayItemValue`.
+// Returns their storage kind
+PArrayKind ArrayItemsStore(PValue *items, u64 count);
+// Check if every item of array is a number. Arrays which were deoptimized to
+// `ARR_KIND_ANY` are rescanned and promoted back if possible.
+// If `badIndex` is not NULL, index of the first non-number is written to it
+bool ArrayObjIsNumeric(PObj *o, u64 *badIndex);
+
+// Numbers are stored in arrays as `double`s, so numeric arrays are packed
+// `double` buffers. Returns `value` to store in an array
+static inline PValue ArrayItemValue(PValue value) {
+    return IsValueInt(value) ? MakeNumber((double)ValueAsInt(value)) : value;
+}
+
+// Keep the array kind in sync after `value` was stored in array
+static inline void ArrayObjTrackKind(struct OArray *arr, PValue value) {
+    if (arr->kind == ARR_KIND_NUM && !IsValueNum(value)) {
+        arr->kind = ARR_KIND_ANY;
+    }
+}
+
+// Comparison function used for sorting. Returns true if `a` must be ordered
+// before `b`. `ctx` is passed as is from the sort function
+typedef bool (*PValueLessFn)(PValue a, PValue b, void *ctx);
+// Sort `count` items in place. Sort is not stable
+void ArraySortValues(PValue *items, u64 count, PValueLessFn less, void *ctx);
+// Stable sort `count` items in place. `scratch` must have room for `count`
+// items
+void ArrayStableSortValues(
+    PValue *items, PValue *scratch, u64 count, PValueLessFn less, void *ctx
+);
+
+// Bulk numeric kernels. `items` must only contain numbers
+// Sum of all items
+double ArrayNumSum(const PValue *items, u64 count);
+// Smallest item. `count` must be greater than zero
+double ArrayNumMin(const PValue *items, u64 count);
+// Largest item. `count` must be greater than zero
+double ArrayNumMax(const PValue *items, u64 count);
+// Dot product of `a` and `b`
+double ArrayNumDot(const PValue *a, const PValue *b, u64 count);
+// dst[i] = src[i] * factor
+void ArrayNumScale(PValue *dst, const PValue *src, u64 count, double factor);
+// dst[i] = value; `value` can be any value
+void ArrayNumFill(PValue *dst, u64 count, PValue value);
+// dst[i] = start + i * step
+void ArrayNumRange(PValue *dst, u64 count, double start, double step);
 // Print Object
 void PrintObject(const PObj *o);
 // Get string from object
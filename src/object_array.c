@@ -9,9 +9,11 @@
 #include "external/stb/stb_ds.h"
 #include "object.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
-bool ArrayObjInsValue(PObj *o, int index, PValue value) {
+bool ArrayObjInsValue(PObj *o, u64 index, PValue value) {
     if (o == NULL) {
         return false;
     }
@@ -21,13 +23,23 @@ bool ArrayObjInsValue(PObj *o, int index, PValue value) {
     }
 
     struct OArray *arr = &o->v.OArray;
-    if (index < 0 || index >= arr->count) {
+    if (index >= arr->count) {
         return false;
     }
 
-    arrput(arr->items, value);
-    arrdelswap(arr->items, index);
-    arr->count = (u64)arrlen(arr->items);
+    u64 count = arr->count;
+    if (!ArrayItemsReserve(&arr->items, count + 1)) {
+        return false;
+    }
+    arrsetlen(arr->items, count + 1);
+    memmove(
+        arr->items + index + 1, arr->items + index,
+        sizeof(PValue) * (count - index)
+    );
+    value = ArrayItemValue(value);
+    arr->items[index] = value;
+    arr->count = count + 1;
+    ArrayObjTrackKind(arr, value);
 
     return true;
 }
@@ -39,13 +51,202 @@ bool ArrayObjPushValue(PObj *o, PValue value) {
 
     struct OArray *arr = &o->v.OArray;
     u64 oldCount = arr->count;
+    if (!ArrayItemsReserve(&arr->items, oldCount + 1)) {
+        return false;
+    }
+    value = ArrayItemValue(value);
     arrput(arr->items, value);
     u64 newCount = arrlen(arr->items);
 
     if (newCount == oldCount + 1) {
         arr->count = newCount;
+        ArrayObjTrackKind(arr, value);
         return true;
     } else {
         return false;
     }
 }
+
+PArrayKind ArrayItemsKind(const PValue *items, u64 count) {
+    for (u64 i = 0; i < count; i++) {
+        if (!IsValueNum(items[i])) {
+            return ARR_KIND_ANY;
+        }
+    }
+
+    return ARR_KIND_NUM;
+}
+
+PArrayKind ArrayItemsStore(PValue *items, u64 count) {
+    PArrayKind kind = ARR_KIND_NUM;
+    for (u64 i = 0; i < count; i++) {
+        items[i] = ArrayItemValue(items[i]);
+        if (!IsValueNum(items[i])) {
+            kind = ARR_KIND_ANY;
+        }
+    }
+
+    return kind;
+}
+
+bool ArrayObjIsNumeric(PObj *o, u64 *badIndex) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    struct OArray *arr = &o->v.OArray;
+    if (arr->kind == ARR_KIND_NUM) {
+        return true;
+    }
+
+    for (u64 i = 0; i < arr->count; i++) {
+        if (!IsValueNum(arr->items[i])) {
+            if (badIndex != NULL) {
+                *badIndex = i;
+            }
+            return false;
+        }
+    }
+
+    arr->kind = ARR_KIND_NUM;
+    return true;
+}
+
+bool ArrayObjRemoveAt(PObj *o, u64 index, PValue *removed) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    struct OArray *arr = &o->v.OArray;
+    if (index >= arr->count) {
+        return false;
+    }
+
+    if (removed != NULL) {
+        *removed = arr->items[index];
+    }
+
+    // removing the last item doesn't need to move anything
+    u64 tail = arr->count - index - 1;
+    if (tail > 0) {
+        memmove(
+            arr->items + index, arr->items + index + 1, sizeof(PValue) * tail
+        );
+    }
+    arr->count--;
+    arrsetlen(arr->items, arr->count);
+    return true;
+}
+
+bool ArrayItemsReserve(PValue **items, u64 capacity) {
+    if ((u64)arrcap(*items) >= capacity) {
+        return true;
+    }
+
+    // stb_ds can't report a failed allocation, so sizes which can't be
+    // allocated are refused before growing. It can grow to twice the size
+    if (capacity > ARRAY_ITEMS_MAX ||
+        capacity > SIZE_MAX / 2 / sizeof(PValue)) {
+        return false;
+    }
+    arrsetcap(*items, capacity);
+    return true;
+}
+
+bool ArrayObjReserve(PObj *o, u64 capacity) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    return ArrayItemsReserve(&o->v.OArray.items, capacity);
+}
+
+bool ArrayObjClear(PObj *o) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    struct OArray *arr = &o->v.OArray;
+    if (arr->items != NULL) {
+        arrsetlen(arr->items, 0);
+    }
+    arr->count = 0;
+    arr->kind = ARR_KIND_NUM;
+    return true;
+}
+
+bool ArrayObjAppendItems(PObj *o, const PValue *items, u64 count) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    if (count == 0) {
+        return true;
+    }
+
+    struct OArray *arr = &o->v.OArray;
+    u64 oldCount = arr->count;
+    bool sameBuffer = items == arr->items;
+    if (!ArrayItemsReserve(&arr->items, oldCount + count)) {
+        return false;
+    }
+    arrsetlen(arr->items, oldCount + count);
+    // `items` can be our own buffer (`a` extended by `a`), which might have
+    // moved while growing
+    if (sameBuffer) {
+        items = arr->items;
+    }
+    memmove(arr->items + oldCount, items, sizeof(PValue) * count);
+    arr->count = oldCount + count;
+
+    if (ArrayItemsStore(arr->items + oldCount, count) != ARR_KIND_NUM) {
+        arr->kind = ARR_KIND_ANY;
+    }
+    return true;
+}
+
+bool ArrayObjSplice(
+    PObj *o, u64 start, u64 deleteCount, const PValue *items, u64 itemCount
+) {
+    if (o == NULL || o->type != OT_ARR) {
+        return false;
+    }
+
+    struct OArray *arr = &o->v.OArray;
+    u64 count = arr->count;
+    if (start > count || deleteCount > count - start) {
+        return false;
+    }
+
+    u64 tail = count - start - deleteCount;
+    u64 newCount = count - deleteCount + itemCount;
+
+    if (itemCount > deleteCount) {
+        // grow first, then move the tail right
+        if (!ArrayItemsReserve(&arr->items, newCount)) {
+            return false;
+        }
+        arrsetlen(arr->items, newCount);
+        memmove(
+            arr->items + start + itemCount, arr->items + start + deleteCount,
+            sizeof(PValue) * tail
+        );
+    } else if (itemCount < deleteCount) {
+        // move the tail left, then shrink
+        memmove(
+            arr->items + start + itemCount, arr->items + start + deleteCount,
+            sizeof(PValue) * tail
+        );
+        arrsetlen(arr->items, newCount);
+    }
+
+    if (itemCount > 0) {
+        memcpy(arr->items + start, items, sizeof(PValue) * itemCount);
+    }
+    arr->count = newCount;
+
+    if (ArrayItemsStore(arr->items + start, itemCount) != ARR_KIND_NUM) {
+        arr->kind = ARR_KIND_ANY;
+    }
+    return true;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Bulk kernels for numeric (`ARR_KIND_NUM`) arrays.
+// With NaN boxing a number PValue is the raw bits of a `double`, so a numeric
+// array's item buffer is already a packed `double` buffer and is processed
+// two lanes at a time with SSE2 (x86-64) or NEON (AArch64). Other targets and
+// the non NaN boxing build use the plain scalar loops.
+//
+// Min and max return NaN if any item is NaN, on every path. The SIMD min and
+// max instructions don't agree on NaN, so the NaNs are looked for separately.
+
+#include "object.h"
+#include <math.h>
+#include <stdbool.h>
+
+#if defined(USE_NAN_BOXING) &&                                                 \
+    (defined(__SSE2__) || defined(_M_X64) ||                                   \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PANKTI_ARRNUM_SSE2
+#include <emmintrin.h>
+#elif defined(USE_NAN_BOXING) && defined(__aarch64__) && defined(__ARM_NEON)
+#define PANKTI_ARRNUM_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(PANKTI_ARRNUM_SSE2) || defined(PANKTI_ARRNUM_NEON)
+// Treat item buffer as packed doubles
+#define numPtr(items)      ((const double *)(const void *)(items))
+#define numMutPtr(items)   ((double *)(void *)(items))
+#endif
+
+double ArrayNumSum(const PValue *items, u64 count) {
+    u64 i = 0;
+    double result = 0.0;
+#if defined(PANKTI_ARRNUM_SSE2)
+    const double *p = numPtr(items);
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    result = lanes[0] + lanes[1];
+#elif defined(PANKTI_ARRNUM_NEON)
+    const double *p = numPtr(items);
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    for (; i + 4 <= count; i += 4) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(p + i));
+        acc1 = vaddq_f64(acc1, vld1q_f64(p + i + 2));
+    }
+    result = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+    for (; i < count; i++) {
+        result += ValueAsNum(items[i]);
+    }
+
+    return result;
+}
+
+double ArrayNumMin(const PValue *items, u64 count) {
+    double result = ValueAsNum(items[0]);
+    u64 i = 1;
+#if defined(PANKTI_ARRNUM_SSE2)
+    if (count >= 4) {
+        const double *p = numPtr(items);
+        __m128d acc = _mm_loadu_pd(p);
+        __m128d nans = _mm_cmpunord_pd(acc, acc);
+        for (i = 2; i + 2 <= count; i += 2) {
+            __m128d v = _mm_loadu_pd(p + i);
+            nans = _mm_or_pd(nans, _mm_cmpunord_pd(v, v));
+            acc = _mm_min_pd(acc, v);
+        }
+        if (_mm_movemask_pd(nans) != 0) {
+            return NAN;
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        result = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+    }
+#elif defined(PANKTI_ARRNUM_NEON)
+    if (count >= 4) {
+        const double *p = numPtr(items);
+        float64x2_t acc = vld1q_f64(p);
+        for (i = 2; i + 2 <= count; i += 2) {
+            acc = vminq_f64(acc, vld1q_f64(p + i));
+        }
+        result = vminvq_f64(acc);
+    }
+#endif
+    for (; i < count; i++) {
+        double item = ValueAsNum(items[i]);
+        if (isnan(item)) {
+            return NAN;
+        }
+        if (item < result) {
+            result = item;
+        }
+    }
+
+    // NEON propagates NaN, a NaN first item is kept by the comparisons
+    return isnan(result) ? NAN : result;
+}
+
+double ArrayNumMax(const PValue *items, u64 count) {
+    double result = ValueAsNum(items[0]);
+    u64 i = 1;
+#if defined(PANKTI_ARRNUM_SSE2)
+    if (count >= 4) {
+        const double *p = numPtr(items);
+        __m128d acc = _mm_loadu_pd(p);
+        __m128d nans = _mm_cmpunord_pd(acc, acc);
+        for (i = 2; i + 2 <= count; i += 2) {
+            __m128d v = _mm_loadu_pd(p + i);
+            nans = _mm_or_pd(nans, _mm_cmpunord_pd(v, v));
+            acc = _mm_max_pd(acc, v);
+        }
+        if (_mm_movemask_pd(nans) != 0) {
+            return NAN;
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        result = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    }
+#elif defined(PANKTI_ARRNUM_NEON)
+    if (count >= 4) {
+        const double *p = numPtr(items);
+        float64x2_t acc = vld1q_f64(p);
+        for (i = 2; i + 2 <= count; i += 2) {
+            acc = vmaxq_f64(acc, vld1q_f64(p + i));
+        }
+        result = vmaxvq_f64(acc);
+    }
+#endif
+    for (; i < count; i++) {
+        double item = ValueAsNum(items[i]);
+        if (isnan(item)) {
+            return NAN;
+        }
+        if (item > result) {
+            result = item;
+        }
+    }
+
+    // NEON propagates NaN, a NaN first item is kept by the comparisons
+    return isnan(result) ? NAN : result;
+}
+
+double ArrayNumDot(const PValue *a, const PValue *b, u64 count) {
+    u64 i = 0;
+    double result = 0.0;
+#if defined(PANKTI_ARRNUM_SSE2)
+    const double *pa = numPtr(a);
+    const double *pb = numPtr(b);
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_pd(
+            acc0, _mm_mul_pd(_mm_loadu_pd(pa + i), _mm_loadu_pd(pb + i))
+        );
+        acc1 = _mm_add_pd(
+            acc1,
+            _mm_mul_pd(_mm_loadu_pd(pa + i + 2), _mm_loadu_pd(pb + i + 2))
+        );
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    result = lanes[0] + lanes[1];
+#elif defined(PANKTI_ARRNUM_NEON)
+    const double *pa = numPtr(a);
+    const double *pb = numPtr(b);
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    for (; i + 4 <= count; i += 4) {
+        acc0 = vfmaq_f64(acc0, vld1q_f64(pa + i), vld1q_f64(pb + i));
+        acc1 = vfmaq_f64(acc1, vld1q_f64(pa + i + 2), vld1q_f64(pb + i + 2));
+    }
+    result = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+    for (; i < count; i++) {
+        result += ValueAsNum(a[i]) * ValueAsNum(b[i]);
+    }
+
+    return result;
+}
+
+void ArrayNumScale(PValue *dst, const PValue *src, u64 count, double factor) {
+    u64 i = 0;
+#if defined(PANKTI_ARRNUM_SSE2)
+    const double *ps = numPtr(src);
+    double *pd = numMutPtr(dst);
+    __m128d f = _mm_set1_pd(factor);
+    for (; i + 2 <= count; i += 2) {
+        _mm_storeu_pd(pd + i, _mm_mul_pd(_mm_loadu_pd(ps + i), f));
+    }
+#elif defined(PANKTI_ARRNUM_NEON)
+    const double *ps = numPtr(src);
+    double *pd = numMutPtr(dst);
+    for (; i + 2 <= count; i += 2) {
+        vst1q_f64(pd + i, vmulq_n_f64(vld1q_f64(ps + i), factor));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = MakeNumber(ValueAsNum(src[i]) * factor);
+    }
+}
+
+void ArrayNumFill(PValue *dst, u64 count, PValue value) {
+    for (u64 i = 0; i < count; i++) {
+        dst[i] = value;
+    }
+}
+
+void ArrayNumRange(PValue *dst, u64 count, double start, double step) {
+    // `start + i * step` instead of repeated addition, so that error doesn't
+    // accumulate for fractional steps
+    for (u64 i = 0; i < count; i++) {
+        dst[i] = MakeNumber(start + (double)i * step);
+    }
+}
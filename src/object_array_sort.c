@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Sorting of PValue buffers.
+// `ArraySortValues` is a pattern-defeating quicksort (pdqsort, Orson Peters),
+// it is unstable and is used where equal items are indistinguishable (numbers
+// and strings). `ArrayStableSortValues` is a bottom-up merge sort, used with
+// user supplied comparators.
+//
+// Every partition loop is bounds checked, so an inconsistent `less` (such as a
+// user comparator, or NaN numbers) gives an unspecified order but never reads
+// outside the buffer.
+
+#include "object.h"
+#include <stdbool.h>
+
+// Below this size insertion sort is used
+#define PDQ_INSERTION_THRESHOLD 24
+// Above this size pivot is selected with Tukey's ninther
+#define PDQ_NINTHER_THRESHOLD 128
+// Max element moves allowed in partial insertion sort before giving up
+#define PDQ_PARTIAL_INSERTION_LIMIT 8
+// Run length of initial insertion sorted runs of merge sort
+#define MERGE_RUN 16
+
+static finline void swapValues(PValue *v, u64 a, u64 b) {
+    PValue tmp = v[a];
+    v[a] = v[b];
+    v[b] = tmp;
+}
+
+// Sort v[lo, hi) with insertion sort
+static void insertionSort(
+    PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx
+) {
+    for (u64 i = lo + 1; i < hi; i++) {
+        PValue item = v[i];
+        u64 j = i;
+        while (j > lo && less(item, v[j - 1], ctx)) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = item;
+    }
+}
+
+// Insertion sort v[lo, hi) but give up after a few moves.
+// Returns true if range was sorted
+static bool partialInsertionSort(
+    PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx
+) {
+    u64 moves = 0;
+    for (u64 i = lo + 1; i < hi; i++) {
+        PValue item = v[i];
+        u64 j = i;
+        while (j > lo && less(item, v[j - 1], ctx)) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = item;
+        moves += i - j;
+        if (moves > PDQ_PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void siftDown(
+    PValue *v, u64 lo, u64 root, u64 size, PValueLessFn less, void *ctx
+) {
+    while (true) {
+        u64 child = 2 * root + 1;
+        if (child >= size) {
+            return;
+        }
+        if (child + 1 < size && less(v[lo + child], v[lo + child + 1], ctx)) {
+            child++;
+        }
+        if (!less(v[lo + root], v[lo + child], ctx)) {
+            return;
+        }
+        swapValues(v, lo + root, lo + child);
+        root = child;
+    }
+}
+
+// Sort v[lo, hi) with heap sort. Fallback for bad pivot sequences
+static void heapSort(PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx) {
+    u64 size = hi - lo;
+    for (u64 i = size / 2; i > 0; i--) {
+        siftDown(v, lo, i - 1, size, less, ctx);
+    }
+    for (u64 end = size - 1; end > 0; end--) {
+        swapValues(v, lo, lo + end);
+        siftDown(v, lo, 0, end, less, ctx);
+    }
+}
+
+// Order v[a], v[b], v[c]
+static finline void sort3(
+    PValue *v, u64 a, u64 b, u64 c, PValueLessFn less, void *ctx
+) {
+    if (less(v[b], v[a], ctx)) {
+        swapValues(v, a, b);
+    }
+    if (less(v[c], v[b], ctx)) {
+        swapValues(v, b, c);
+        if (less(v[b], v[a], ctx)) {
+            swapValues(v, a, b);
+        }
+    }
+}
+
+// Partition v[lo, hi) around pivot v[lo]. Items equal to pivot go to the
+// right. Returns final position of pivot. `partitioned` is set if no item
+// had to be swapped
+static u64 partitionRight(
+    PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx, bool *partitioned
+) {
+    PValue pivot = v[lo];
+    u64 first = lo + 1;
+    u64 last = hi;
+
+    while (first < hi && less(v[first], pivot, ctx)) {
+        first++;
+    }
+    while (last > first && !less(v[last - 1], pivot, ctx)) {
+        last--;
+    }
+
+    *partitioned = first >= last;
+
+    // invariant : v[lo+1, first) < pivot, v[last, hi) >= pivot
+    while (first < last) {
+        swapValues(v, first, last - 1);
+        first++;
+        last--;
+        while (first < last && less(v[first], pivot, ctx)) {
+            first++;
+        }
+        while (last > first && !less(v[last - 1], pivot, ctx)) {
+            last--;
+        }
+    }
+
+    u64 pivotPos = first - 1;
+    v[lo] = v[pivotPos];
+    v[pivotPos] = pivot;
+    return pivotPos;
+}
+
+// Partition v[lo, hi) around pivot v[lo] with items equal to pivot going to
+// the left. Used when there are many equal items. Returns pivot position
+static u64 partitionLeft(
+    PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx
+) {
+    PValue pivot = v[lo];
+    u64 first = lo + 1;
+    u64 last = hi;
+
+    // invariant : v[lo+1, first) <= pivot, v[last, hi) > pivot
+    while (true) {
+        while (first < last && !less(pivot, v[first], ctx)) {
+            first++;
+        }
+        while (last > first && less(pivot, v[last - 1], ctx)) {
+            last--;
+        }
+        if (first >= last) {
+            break;
+        }
+        swapValues(v, first, last - 1);
+        first++;
+        last--;
+    }
+
+    u64 pivotPos = first - 1;
+    v[lo] = v[pivotPos];
+    v[pivotPos] = pivot;
+    return pivotPos;
+}
+
+static void pdqLoop(
+    PValue *v, u64 lo, u64 hi, PValueLessFn less, void *ctx, int badAllowed,
+    bool leftmost
+) {
+    while (true) {
+        u64 size = hi - lo;
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            insertionSort(v, lo, hi, less, ctx);
+            return;
+        }
+
+        // choose pivot and move it to v[lo]
+        u64 half = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(v, lo, lo + half, hi - 1, less, ctx);
+            sort3(v, lo + 1, lo + half - 1, hi - 2, less, ctx);
+            sort3(v, lo + 2, lo + half + 1, hi - 3, less, ctx);
+            sort3(v, lo + half - 1, lo + half, lo + half + 1, less, ctx);
+            swapValues(v, lo, lo + half);
+        } else {
+            sort3(v, lo + half, lo, hi - 1, less, ctx);
+        }
+
+        // If pivot is equal to the item before this range, (which is <= every
+        // item of this range) all items equal to pivot can be put aside
+        if (!leftmost && !less(v[lo - 1], v[lo], ctx)) {
+            lo = partitionLeft(v, lo, hi, less, ctx) + 1;
+            continue;
+        }
+
+        bool partitioned = false;
+        u64 pivotPos = partitionRight(v, lo, hi, less, ctx, &partitioned);
+        u64 leftSize = pivotPos - lo;
+        u64 rightSize = hi - (pivotPos + 1);
+
+        if (leftSize < size / 8 || rightSize < size / 8) {
+            // highly unbalanced partition, too many of them and we switch to
+            // heap sort for guaranteed n*log(n)
+            if (--badAllowed == 0) {
+                heapSort(v, lo, hi, less, ctx);
+                return;
+            }
+
+            // break possible patterns by shuffling some items
+            if (leftSize >= PDQ_INSERTION_THRESHOLD) {
+                swapValues(v, lo, lo + leftSize / 4);
+                swapValues(v, pivotPos - 1, pivotPos - leftSize / 4);
+            }
+            if (rightSize >= PDQ_INSERTION_THRESHOLD) {
+                swapValues(v, pivotPos + 1, pivotPos + 1 + rightSize / 4);
+                swapValues(v, hi - 1, hi - rightSize / 4);
+            }
+        } else if (partitioned &&
+                   partialInsertionSort(v, lo, pivotPos, less, ctx) &&
+                   partialInsertionSort(v, pivotPos + 1, hi, less, ctx)) {
+            // range was (almost) already sorted
+            return;
+        }
+
+        // recurse into left part, loop on the right part
+        pdqLoop(v, lo, pivotPos, less, ctx, badAllowed, leftmost);
+        lo = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+void ArraySortValues(PValue *items, u64 count, PValueLessFn less, void *ctx) {
+    if (count < 2) {
+        return;
+    }
+
+    int badAllowed = 0;
+    for (u64 n = count; n > 0; n >>= 1) {
+        badAllowed++;
+    }
+
+    pdqLoop(items, 0, count, less, ctx, badAllowed, true);
+}
+
+// Merge sorted src[lo, mid) and src[mid, hi) into dst[lo, hi). Items from the
+// right run are only taken if they are strictly less, which keeps it stable
+static void mergeRuns(
+    const PValue *src, PValue *dst, u64 lo, u64 mid, u64 hi, PValueLessFn less,
+    void *ctx
+) {
+    u64 i = lo;
+    u64 j = mid;
+    u64 k = lo;
+    while (i < mid && j < hi) {
+        if (less(src[j], src[i], ctx)) {
+            dst[k++] = src[j++];
+        } else {
+            dst[k++] = src[i++];
+        }
+    }
+    while (i < mid) {
+        dst[k++] = src[i++];
+    }
+    while (j < hi) {
+        dst[k++] = src[j++];
+    }
+}
+
+void ArrayStableSortValues(
+    PValue *items, PValue *scratch, u64 count, PValueLessFn less, void *ctx
+) {
+    if (count < 2) {
+        return;
+    }
+
+    for (u64 lo = 0; lo < count; lo += MERGE_RUN) {
+        u64 hi = lo + MERGE_RUN < count ? lo + MERGE_RUN : count;
+        insertionSort(items, lo, hi, less, ctx);
+    }
+
+    PValue *src = items;
+    PValue *dst = scratch;
+    for (u64 width = MERGE_RUN; width < count; width *= 2) {
+        for (u64 lo = 0; lo < count; lo += 2 * width) {
+            u64 mid = lo + width < count ? lo + width : count;
+            u64 hi = lo + 2 * width < count ? lo + 2 * width : count;
+            mergeRuns(src, dst, lo, mid, hi, less, ctx);
+        }
+        PValue *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != items) {
+        memcpy(items, src, sizeof(PValue) * count);
+    }
+}
@@ -9,9 +9,11 @@
 #include "opcode.h"
 #include "alloc.h"
 #include "external/stb/stb_ds.h"
+#include "jit.h"
 #include "object.h"
 #include "printer.h"
 #include "ptypes.h"
+#include "regcode.h"
 #include "terminal.h"
 #include "token.h"
 #include <stdarg.h>
@@ -21,6 +23,7 @@
 
 static const POpDefinition opDefs[] = {
     [OP_CONST] = {"OpConst", 1, {2}},
+    [OP_CONST_LONG] = {"OpConstLong", 1, {3}},
     [OP_DEBUG] = {"OpDebug", 0, {0}},
     [OP_RETURN] = {"OpReturn", 0, {0}},
     [OP_TRUE] = {"OpTrue", 0, {0}},
@@ -56,12 +59,18 @@ static const POpDefinition opDefs[] = {
     [OP_POP_JUMP_IF_TRUE] = {"OpPopJumpIfTrue", 1, {2}},
     [OP_LOOP] = {"OpLoop", 1, {2}},
     [OP_CALL] = {"OpCall", 1, {2}},
+    [OP_TAIL_CALL] = {"OpTailCall", 1, {2}},
     [OP_CLOSURE] = {"OpClosure", 1, {2}},
     [OP_CLS_UPVAL] = {"OpClsUpval", 0, {0}},
+    [OP_GET_OUTER] = {"OpGetOuter", 1, {2}},
+    [OP_SET_OUTER] = {"OpSetOuter", 1, {2}},
     [OP_SUBSCRIPT] = {"OpSubscript", 0, {0}},
     [OP_SUBS_ASSIGN] = {"OpSubsAssign", 0, {0}},
     [OP_IMPORT] = {"OpImport", 1, {2}},
     [OP_MODGET] = {"OpModGet", 1, {2}},
+    [OP_LEN] = {"OpLen", 1, {2}},
+    [OP_APPEND] = {"OpAppend", 1, {2}},
+    [OP_SQRT] = {"OpSqrt", 2, {2, 2}},
 };
 
 const char *OpCodeToStr(PanOpCode code) { return opDefs[code].name; }
@@ -77,7 +86,20 @@ PBytecode *NewBytecode(void) {
     b->codeCount = 0;
     b->constPool = NULL;
     b->constCount = 0;
+    b->constIndex = NULL;
+    b->constIndexCap = 0;
+    b->constShortNext = UINT16_MAX + 1;
     b->posTable = NULL;
+    b->posLast = (PBtPosInfo){0};
+    b->inlines = NULL;
+    b->maxStack = 0;
+    b->modCaches = NULL;
+    b->reg = NULL;
+    b->loopHits = 0;
+#if defined(PANKTI_JIT)
+    b->jit = NULL;
+    b->hotCount = 0;
+#endif
     return b;
 }
 
@@ -95,12 +117,27 @@ void FreeBytecode(PBytecode *b) {
         arrfree(b->constPool);
         b->constCount = 0;
     }
+    FreeConstIndex(b);
 
     if (b->posTable != NULL) {
         arrfree(b->posTable);
         b->posTable = NULL;
     }
 
+    if (b->inlines != NULL) {
+        arrfree(b->inlines);
+        b->inlines = NULL;
+    }
+
+    if (b->modCaches != NULL) {
+        PFree(b->modCaches);
+        b->modCaches = NULL;
+    }
+
+    FreeRegCode(b->reg);
+#if defined(PANKTI_JIT)
+    FreeJitCode(b->jit);
+#endif
     PFree(b);
 }
 
@@ -124,6 +161,20 @@ static u64 disasmConstIns(const char *name, u64 offset, const PBytecode *b) {
     return offset + 3;
 }
 
+static u64 disasmConstLongIns(
+    const char *name, u64 offset, const PBytecode *b
+) {
+    u32 constIndex = ReadU24(b, offset + 1);
+
+    PanPrint("%s%s%s", TermGreen(), name, TermReset());
+    PanPrint(" %u : ", constIndex);
+    PanPrint(TermPurple());
+    PrintValue(b->constPool[constIndex]);
+    PanPrint(TermReset());
+    PanPrint("\n");
+    return offset + 4;
+}
+
 static u64 disasmBytesIns(const char *name, u64 offset, const PBytecode *b) {
     PanPrint("%s%s%s", TermGreen(), name, TermReset());
     u16 itemCount = ReadU16(b, offset + 1);
@@ -192,9 +243,25 @@ u64 DisasmBytecode(const PBytecode *bt, u64 offset) {
         case OP_GET_GLOBAL:
         case OP_SET_GLOBAL:
         case OP_IMPORT:
-        case OP_MODGET: {
+        case OP_MODGET:
+        case OP_LEN:
+        case OP_APPEND: {
             return disasmConstIns(def.name, offset, bt);
         }
+        case OP_CONST_LONG: {
+            return disasmConstLongIns(def.name, offset, bt);
+        }
+        case OP_SQRT: {
+            u16 member = ReadU16(bt, offset + 3);
+            PanPrint("%s%s%s", TermGreen(), def.name, TermReset());
+            PanPrint(" %d.%d : ", ReadU16(bt, offset + 1), member);
+            PanPrint(TermPurple());
+            PrintValue(bt->constPool[ReadU16(bt, offset + 1)]);
+            PanPrint(".");
+            PrintValue(bt->constPool[member]);
+            PanPrint("%s\n", TermReset());
+            return offset + 5;
+        }
 
         case OP_JUMP_IF_FALSE:
         case OP_JUMP:
@@ -211,7 +278,10 @@ u64 DisasmBytecode(const PBytecode *bt, u64 offset) {
         case OP_GET_LOCAL:
         case OP_SET_UPVAL:
         case OP_GET_UPVAL:
-        case OP_CALL: {
+        case OP_GET_OUTER:
+        case OP_SET_OUTER:
+        case OP_CALL:
+        case OP_TAIL_CALL: {
             return disasmBytesIns(def.name, offset, bt);
         }
         case OP_MAP:
@@ -232,12 +302,13 @@ u64 DisasmBytecode(const PBytecode *bt, u64 offset) {
 
             u64 cur = offset + 3;
             for (i16 i = 0; i < upvalCount; i++) {
-                u16 isLocal = ReadU16RawCode(bt->code, cur);
-                u16 index = ReadU16RawCode(bt->code, cur + 2);
+                u8 flags = bt->code[cur];
+                u8 index = bt->code[cur + 1];
                 PanPrint(
-                    "      | %s %d\n", isLocal ? "local" : "upvalue", index
+                    "      | %s %d\n",
+                    flags & CLOSURE_UPVAL_LOCAL ? "local" : "upvalue", index
                 );
-                cur += 4;
+                cur += 2;
             }
 
             return cur;
@@ -258,40 +329,122 @@ void DebugBytecode(const PBytecode *bt, u64 offset) {
 }
 
 static bool shouldRecordPos(PBytecode *b, Token *tok) {
-    u64 tableCount = (u64)arrlen(b->posTable);
-    if (tableCount == 0) {
+    if (arrlen(b->posTable) == 0) {
         return true;
-    } else {
-        PBtPosInfo *last = &b->posTable[tableCount - 1];
-        if (last->col != tok->col || last->line != tok->line ||
-            last->len != tok->len) {
-            return true;
-        }
     }
+    PBtPosInfo *last = &b->posLast;
+    return last->col != tok->col || last->line != tok->line ||
+           last->len != tok->len;
+}
 
-    return false;
+// Write `value` as LEB128 varint, 7 bits per byte, high bit set on all but
+// the last byte
+static void writeVarint(PBytecode *b, u32 value) {
+    while (value >= 0x80) {
+        arrput(b->posTable, (u8)(value | 0x80));
+        value >>= 7;
+    }
+    arrput(b->posTable, (u8)value);
 }
 
+static u32 readVarint(const u8 *table, u64 *i) {
+    u32 value = 0;
+    u32 shift = 0;
+    u8 byte;
+    do {
+        byte = table[(*i)++];
+        value |= (u32)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+// First byte of a position entry : bits 0-2 are offset delta, bits 3-4 line
+// delta and bits 5-7 length. Fields too large for them are written as varints
+// after it, then the column
+#define POS_OFFSET_BITS 0x07
+#define POS_LINE_SHIFT  3
+#define POS_LINE_VARINT 2
+#define POS_LEN_SHIFT   5
+#define POS_LEN_VARINT  0
+
 static bool recordPos(PBytecode *b, Token *tok) {
     bool shouldRecord = shouldRecordPos(b, tok);
     if (!shouldRecord) {
         return false;
     }
 
-    PBtPosInfo entry = {
-        .startOffset = b->codeCount,
+    PBtPosInfo *last = &b->posLast;
+    u32 offsetDelta = (u32)b->codeCount - last->startOffset;
+    // Lines mostly go forward by 0 or 1 but not always, zigzag keeps small
+    // negative deltas small
+    i32 lineDelta = (i32)(tok->line - last->line);
+
+    u8 head = offsetDelta < POS_OFFSET_BITS ? (u8)offsetDelta : POS_OFFSET_BITS;
+    u8 lineCode = lineDelta == 0 || lineDelta == 1 ? (u8)lineDelta
+                                                   : POS_LINE_VARINT;
+    u8 lenCode = tok->len >= 1 && tok->len <= 7 ? (u8)tok->len
+                                                : POS_LEN_VARINT;
+    head |= (u8)(lineCode << POS_LINE_SHIFT) | (u8)(lenCode << POS_LEN_SHIFT);
+    arrput(b->posTable, head);
+
+    if (offsetDelta >= POS_OFFSET_BITS) {
+        writeVarint(b, offsetDelta);
+    }
+    if (lineCode == POS_LINE_VARINT) {
+        writeVarint(b, ((u32)lineDelta << 1) ^ (u32)(lineDelta >> 31));
+    }
+    if (lenCode == POS_LEN_VARINT) {
+        writeVarint(b, tok->len);
+    }
+    writeVarint(b, tok->col);
+
+    *last = (PBtPosInfo){
+        .startOffset = (u32)b->codeCount,
         .line = tok->line,
         .col = tok->col,
         .len = tok->len,
-        .gcol = tok->gcol,
-        .glen = tok->glen,
-        .token = tok
     };
-
-    arrput(b->posTable, entry);
     return true;
 }
 
+bool BytecodeFindPos(const PBytecode *b, u64 offset, PBtPosInfo *pos) {
+    u64 size = (u64)arrlen(b->posTable);
+    PBtPosInfo cur = {0};
+    bool found = false;
+    u64 i = 0;
+    while (i < size) {
+        u8 head = b->posTable[i++];
+        u32 offsetDelta = head & POS_OFFSET_BITS;
+        if (offsetDelta == POS_OFFSET_BITS) {
+            offsetDelta = readVarint(b->posTable, &i);
+        }
+        // Code before the first entry gets its position
+        if (cur.startOffset + offsetDelta > offset && found) {
+            break;
+        }
+        cur.startOffset += offsetDelta;
+
+        u8 lineCode = (head >> POS_LINE_SHIFT) & 0x03;
+        if (lineCode == POS_LINE_VARINT) {
+            u32 zigzag = readVarint(b->posTable, &i);
+            cur.line += (zigzag >> 1) ^ (u32)-(i32)(zigzag & 1);
+        } else {
+            cur.line += lineCode;
+        }
+        cur.len = head >> POS_LEN_SHIFT;
+        if (cur.len == POS_LEN_VARINT) {
+            cur.len = readVarint(b->posTable, &i);
+        }
+        cur.col = readVarint(b->posTable, &i);
+        found = true;
+    }
+    if (found) {
+        *pos = cur;
+    }
+    return found;
+}
+
 u64 EmitBytecode(PBytecode *b, Token *tok, PanOpCode op) {
     if (tok != NULL) {
         recordPos(b, tok);
@@ -350,25 +503,122 @@ u64 EmitBytecodeWithTwoArgs(
     return pos;
 }
 
-u16 AddConstantToPool(PBytecode *b, PValue value) {
-    u16 index = b->constCount;
+u64 BeginInlineRange(PBytecode *b, u16 name, Token *call) {
+    PBtInline entry = {
+        .start = b->codeCount,
+        .end = b->codeCount,
+        .name = name,
+        .call = {
+            .startOffset = (u32)b->codeCount,
+            .line = call->line,
+            .col = call->col,
+            .len = call->len,
+        }
+    };
+    arrput(b->inlines, entry);
+    return (u64)arrlen(b->inlines) - 1;
+}
 
-    for (u16 i = 0; i < index; i++) {
-        PValue a = b->constPool[i];
-        if (IsValueEqual(a, value)) {
-            return i;
+void EndInlineRange(PBytecode *b, u64 index) {
+    b->inlines[index].end = b->codeCount;
+}
+
+// Hash of a constant for `constIndex`, equal constants have equal hashes.
+// Strings are interned, so equal strings are one object and hash by pointer
+// like the other objects, which are never equal to one another
+static u64 constHash(PValue value) {
+    if (IsValueObj(value)) {
+        u64 bits = (u64)(uintptr_t)ValueAsObj(value);
+        bits *= 0x9e3779b97f4a7c15ULL;
+        return bits ^ (bits >> 32);
+    }
+    return GetValueHash(value, 0);
+}
+
+// Put constant `index` of `b` in the hash index, which has a free slot
+static void constIndexPut(PBytecode *b, u32 index) {
+    u32 mask = b->constIndexCap - 1;
+    u32 slot = (u32)constHash(b->constPool[index]) & mask;
+    while (b->constIndex[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    b->constIndex[slot] = index + 1;
+}
+
+// Grow the hash index so it stays at most half full with one more constant,
+// building it from the pool if it was freed. Returns false if out of memory
+static bool constIndexReserve(PBytecode *b) {
+    if ((u64)(b->constCount + 1) * 2 <= b->constIndexCap) {
+        return true;
+    }
+    u32 cap = b->constIndexCap == 0 ? 64 : b->constIndexCap;
+    while ((u64)(b->constCount + 1) * 2 > cap) {
+        cap *= 2;
+    }
+    u32 *slots = PCalloc(cap, sizeof(u32));
+    if (slots == NULL) {
+        return false;
+    }
+    PFree(b->constIndex);
+    b->constIndex = slots;
+    b->constIndexCap = cap;
+    for (u32 i = 0; i < b->constCount; i++) {
+        // skip free kept u16 indexes
+        if (i < b->constShortNext || i > UINT16_MAX) {
+            constIndexPut(b, i);
         }
     }
+    return true;
+}
+
+u32 AddConstantToPool(PBytecode *b, PValue value, bool wide) {
+    if (!constIndexReserve(b)) {
+        return UINT32_MAX;
+    }
 
-    if (index >= MAX_CONST_COUNT) {
-        return UINT16_MAX;
+    u32 mask = b->constIndexCap - 1;
+    u32 slot = (u32)constHash(value) & mask;
+    while (b->constIndex[slot] != 0) {
+        u32 i = b->constIndex[slot] - 1;
+        if ((wide || i <= UINT16_MAX) && IsValueEqual(b->constPool[i], value)) {
+            return i;
+        }
+        slot = (slot + 1) & mask;
     }
 
-    arrput(b->constPool, value);
-    b->constCount++;
+    u32 index = b->constCount;
+    if (!wide && index > UINT16_MAX) {
+        if (b->constShortNext > UINT16_MAX) {
+            return UINT32_MAX;
+        }
+        index = b->constShortNext++;
+        b->constPool[index] = value;
+    } else {
+        if (wide && index >= CONST_SHORT_RESERVED && index <= UINT16_MAX) {
+            // keep the rest of u16 indexes
+            b->constShortNext = index;
+            for (; index <= UINT16_MAX; index++) {
+                arrput(b->constPool, MakeNil());
+            }
+        }
+        if (index >= MAX_CONST_COUNT) {
+            return UINT32_MAX;
+        }
+        arrput(b->constPool, value);
+        b->constCount = index + 1;
+    }
+    b->constIndex[slot] = index + 1;
     return index;
 }
 
+void FreeConstIndex(PBytecode *b) {
+    if (b->constIndex != NULL) {
+        PFree(b->constIndex);
+        b->constIndex = NULL;
+        b->constIndexCap = 0;
+    }
+}
+
 u16 ReadU16(const PBytecode *b, u64 offset) {
     if (b == NULL || offset >= b->codeCount) {
         return 0;
@@ -377,6 +627,75 @@ u16 ReadU16(const PBytecode *b, u64 offset) {
     return (u16)((u16)(b->code[offset] << 8) | (u16)b->code[offset + 1]);
 }
 
+int OpStackEffect(PanOpCode op, u16 operand) {
+    switch (op) {
+        case OP_CONST:
+        case OP_CONST_LONG:
+        case OP_TRUE:
+        case OP_FALSE:
+        case OP_NIL:
+        case OP_GET_GLOBAL:
+        case OP_GET_LOCAL:
+        case OP_GET_UPVAL:
+        case OP_GET_OUTER:
+        case OP_CLOSURE: return 1;
+
+        case OP_NEGATE:
+        case OP_NOT:
+        case OP_SET_GLOBAL:
+        case OP_SET_LOCAL:
+        case OP_SET_UPVAL:
+        case OP_SET_OUTER:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP:
+        case OP_LOOP:
+        case OP_MODGET:
+        case OP_LEN:
+        case OP_SQRT: return 0;
+
+        case OP_DEBUG:
+        case OP_RETURN:
+        case OP_POP:
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL:
+        case OP_DIV:
+        case OP_EXPONENT:
+        case OP_MOD:
+        case OP_EQUAL:
+        case OP_NOTEQUAL:
+        case OP_GT:
+        case OP_GTE:
+        case OP_LT:
+        case OP_LTE:
+        case OP_DEFINE_GLOBAL:
+        case OP_POP_JUMP_IF_FALSE:
+        case OP_POP_JUMP_IF_TRUE:
+        case OP_CLS_UPVAL:
+        case OP_SUBSCRIPT:
+        case OP_IMPORT:
+        case OP_APPEND: return -1;
+
+        case OP_SUBS_ASSIGN: return -2;
+        // callee and arguments are replaced by the result
+        case OP_CALL:
+        case OP_TAIL_CALL: return -(int)operand;
+        case OP_ARRAY: return 1 - (int)operand;
+        case OP_MAP: return 1 - 2 * (int)operand;
+    }
+
+    return 0;
+}
+
 u16 ReadU16RawCode(const u8 *code, u64 offset) {
     return (u16)((u16)(code[offset] << 8) | (u16)code[offset + 1]);
 }
+
+u32 ReadU24(const PBytecode *b, u64 offset) {
+    if (b == NULL || offset + 2 >= b->codeCount) {
+        return 0;
+    }
+
+    return ((u32)b->code[offset] << 16) | ((u32)b->code[offset + 1] << 8) |
+           (u32)b->code[offset + 2];
+}
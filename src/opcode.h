@@ -16,13 +16,19 @@
 extern "C" {
 #endif
 
-// How many Constants can be in the Bytecode
-#define MAX_CONST_COUNT 65535
+// How many Constants can be in the Bytecode, `OP_CONST_LONG` reaches all of
+// them. Other opcodes naming a constant only reach the first `UINT16_MAX + 1`
+#define MAX_CONST_COUNT 0x1000000
+// Once there are this many constants, the rest of the u16 indexes are kept
+// for constants which need one, such as global names, see `AddConstantToPool`
+#define CONST_SHORT_RESERVED 0xf000
 
 // Pankti Opcodes
 typedef enum PanOpCode {
     // Make Constant
     OP_CONST = 0,
+    // Make Constant, with a u24 index for constants past `UINT16_MAX`
+    OP_CONST_LONG,
     // Temporary debug statement
     OP_DEBUG,
     OP_RETURN,
@@ -64,14 +70,29 @@ typedef enum PanOpCode {
     // Op Jump but Backwards
     OP_LOOP,
     OP_CALL,
+    // Call which replaces the current frame, used for `return f(...)`
+    OP_TAIL_CALL,
     OP_CLOSURE,
     OP_CLS_UPVAL,
+    // Get/Set local slot of enclosing function frame from a direct
+    // (non escaping) function
+    OP_GET_OUTER,
+    OP_SET_OUTER,
     // indexing or subscript
     OP_SUBSCRIPT,
     // Subscript/index assignment
     OP_SUBS_ASSIGN,
     OP_IMPORT,
     OP_MODGET,
+    // Intrinsics, calls of builtins and standard library functions the
+    // compiler turned into opcodes. The arguments on the stack are replaced by
+    // the result. Operand is constant index of the name of the global the
+    // function is called through, used to call it the normal way when the
+    // VM's `intrinsicsOff` is set or arguments are not the expected types
+    OP_LEN,
+    OP_APPEND,
+    // Second operand is constant index of the member name in the module
+    OP_SQRT,
 } PanOpCode;
 
 // OpCode definition
@@ -90,17 +111,36 @@ const char *OpCodeToStr(PanOpCode code);
 // Get definition of the opcocde
 POpDefinition GetOpDefinition(PanOpCode code);
 
-// Position, Line Information for Error handling in runtime
+// Position, Line Information for Error handling in runtime. Copied from the
+// token, as tokens are freed once the script is compiled
 typedef struct PBtPosInfo {
-    u64 startOffset;
-    u64 line;
-    u64 col;
-    u64 len;
-    u64 gcol;
-    u64 glen;
-    Token *token;
+    u32 startOffset;
+    u32 line;
+    u32 col;
+    u32 len;
 } PBtPosInfo;
 
+// Code of a function inlined into this one by the compiler. Stack traces show
+// it as a frame of its own, called from `call`
+typedef struct PBtInline {
+    // Bytecode range of the inlined code, `end` is exclusive
+    u64 start;
+    u64 end;
+    // Constant index of the inlined function's name
+    u16 name;
+    // Position of the inlined call
+    PBtPosInfo call;
+} PBtInline;
+
+// Last member an `OP_MODGET` of one member name found
+typedef struct PModCache {
+    // `OModule.nameHash` of the module it was found in
+    u64 nameHash;
+    // `PVm.modStamp` when it was found, it is stale once they differ
+    u64 stamp;
+    PValue value;
+} PModCache;
+
 // Bytecode Object
 typedef struct PBytecode {
     // Raw bytes
@@ -110,10 +150,48 @@ typedef struct PBytecode {
     // Constants list
     PValue *constPool;
     // How many Constants are there
-    u16 constCount;
-    PBtPosInfo *posTable;
+    u32 constCount;
+    // Hash index of `constPool` used to find duplicates while compiling,
+    // open addressing slots holding constant index + 1, 0 if empty. Freed
+    // with `FreeConstIndex` once the function is compiled
+    u32 *constIndex;
+    u32 constIndexCap;
+    // Next free one of the u16 indexes kept by `CONST_SHORT_RESERVED`, the
+    // free ones are nil until used. `UINT16_MAX + 1` if there are none
+    u32 constShortNext;
+    // Positions of instructions, a byte stream of entries, see
+    // `BytecodeFindPos`. An entry is added when the position changes
+    u8 *posTable;
+    // Last entry of `posTable`, entries are encoded as a delta from it
+    PBtPosInfo posLast;
+    // Inlined code ranges, ordered by `start`. Ranges of calls inlined into
+    // inlined code are inside the range they were inlined into
+    PBtInline *inlines;
+    // Maximum stack slots the code needs, including callee and local slots.
+    // Computed by compiler, checked once when a frame is pushed
+    u32 maxStack;
+    // Module member lookups, indexed by constant index of the member name.
+    // NULL until the code runs its first `OP_MODGET`
+    PModCache *modCaches;
+    // Register bytecode for the register engine, translated on first call.
+    // See regcode.h
+    struct PRegCode *reg;
+    // Loop back edges run by the stack engine, which moves frames with hot
+    // loops to the register engine to trace them. See trace.h
+    u32 loopHits;
+#if defined(PANKTI_JIT)
+    // Native code compiled from `reg`, NULL until function is hot. See jit.h
+    struct PJitCode *jit;
+    // Calls and loop back edges so far
+    u32 hotCount;
+#endif
 } PBytecode;
 
+// Flag of `OP_CLOSURE` upvalue descriptor byte, set if the upvalue captures
+// a local slot of enclosing function instead of one of its upvalues.
+// Each descriptor is two bytes, flags and index
+#define CLOSURE_UPVAL_LOCAL 0x01
+
 // Create a new Bytecode Object
 PBytecode *NewBytecode(void);
 
@@ -126,6 +204,12 @@ void DebugBytecode(const PBytecode *bt, u64 offset);
 u64 EmitRawU16(PBytecode *b, u16 a);
 u64 EmitRawU8(PBytecode *b, u8 a);
 
+// Find position of instruction at `offset` of `b`. Position table entries
+// are deltas from the entry before, mostly two bytes : a byte with offset
+// delta, line delta and length, then column as a varint. It is only decoded
+// when an error is printed. Returns false if no position was recorded
+bool BytecodeFindPos(const PBytecode *b, u64 offset, PBtPosInfo *pos);
+
 // Emit and Write a Opcode
 u64 EmitBytecode(PBytecode *b, Token *tok, PanOpCode op);
 
@@ -137,8 +221,27 @@ u64 EmitBytecodeWithTwoArgs(
     PBytecode *b, Token *tok, PanOpCode op, u8 one, u8 two
 );
 
-// Add New Constant to Constant pool and return its index
-u16 AddConstantToPool(PBytecode *b, PValue value);
+// Start an inlined code range at the current end of code, for the function
+// named by constant `name` called at `call`. Returns index of the range
+u64 BeginInlineRange(PBytecode *b, u16 name, Token *call);
+// End inlined code range `index` at the current end of code
+void EndInlineRange(PBytecode *b, u64 index);
+
+// Add New Constant to Constant pool and return its index. Returns the index
+// of the existing one if an equal constant is already there, `UINT32_MAX` if
+// the pool is full.
+// `wide` is true if the constant is used by `OP_CONST`, which can be
+// `OP_CONST_LONG` for any index, else the index fits in a u16. Past
+// `CONST_SHORT_RESERVED` wide constants go after `UINT16_MAX`, so the other
+// ones still have indexes left
+u32 AddConstantToPool(PBytecode *b, PValue value, bool wide);
+// Free the hash index `AddConstantToPool` keeps. It is built again if more
+// constants are added
+void FreeConstIndex(PBytecode *b);
+
+// How much the stack grows (or shrinks if negative) after running opcode `op`
+// with its first operand `operand`, on the fall through path
+int OpStackEffect(PanOpCode op, u16 operand);
 
 // Read a u16 operand from Bytecode
 u16 ReadU16(const PBytecode *b, u64 offset);
@@ -146,6 +249,9 @@ u16 ReadU16(const PBytecode *b, u64 offset);
 // Read a u16 operands from raw code bytes
 u16 ReadU16RawCode(const u8 *code, u64 offset);
 
+// Read the u24 operand of `OP_CONST_LONG` from Bytecode
+u32 ReadU24(const PBytecode *b, u64 offset);
+
 #ifdef __cplusplus
 }
 #endif
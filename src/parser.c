@@ -8,6 +8,7 @@
 
 #include "parser.h"
 #include "alloc.h"
+#include "arena.h"
 #include "ast.h"
 #include "diagonctx.h"
 #include "external/stb/stb_ds.h"
@@ -49,7 +50,18 @@ static PExpr *rExpression(Parser *p);
 // Check if parser has reached end
 static bool atEnd(const Parser *p);
 
-Parser *NewParser(Pgc *gc, Lexer *lexer) {
+// Move stb_ds array `list` of `count` pointers to the arena, where the AST
+// keeps it. `list` is freed. Returns NULL for empty lists
+static void *listToArena(Parser *p, void *list, u64 count) {
+    if (list == NULL) {
+        return NULL;
+    }
+    void *result = ArenaCopy(p->arena, list, count * sizeof(void *));
+    arrfree(list);
+    return result;
+}
+
+Parser *NewParser(PArena *arena, Lexer *lexer) {
     Parser *parser = PCreate(Parser);
     if (parser == NULL) {
         return NULL;
@@ -57,7 +69,7 @@ Parser *NewParser(Pgc *gc, Lexer *lexer) {
     // ERROR HANDLE
     parser->lx = lexer;
     parser->tokens = lexer->tokens;
-    parser->gc = gc;
+    parser->arena = arena;
     parser->pos = 0;
     parser->stmts = NULL;
     parser->hasError = false;
@@ -79,6 +91,10 @@ PStmt **ParseParser(Parser *parser) {
     return parser->stmts;
 }
 
+PStmt *ParseStatement(Parser *parser) { return rLet(parser); }
+
+bool ParserAtEnd(const Parser *parser) { return atEnd(parser); }
+
 static Token *peek(const Parser *p) { return p->tokens[p->pos]; }
 
 static bool atEnd(const Parser *p) { return peek(p)->type == T_EOF; }
@@ -91,7 +107,10 @@ static bool check(const Parser *p, PTokenType t) {
     return peek(p)->type == t;
 }
 
-static Token *previous(const Parser *p) { return p->tokens[p->pos - 1]; }
+// At the first token there is none before it, the first token is used
+static Token *previous(const Parser *p) {
+    return p->tokens[p->pos > 0 ? p->pos - 1 : 0];
+}
 
 static Token *advance(Parser *p) {
     if (!atEnd(p)) {
@@ -145,7 +164,7 @@ static PExpr *rAnd(Parser *p) {
     while (matchOne(p, T_AND)) {
         Token *op = previous(p);
         PExpr *right = rEquality(p);
-        expr = NewLogical(p->gc, expr, op, right);
+        expr = NewLogical(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_LOGICAL_EXPR);
             return NULL;
@@ -159,7 +178,7 @@ static PExpr *rOr(Parser *p) {
     while (matchOne(p, T_OR)) {
         Token *op = previous(p);
         PExpr *right = rAnd(p);
-        expr = NewLogical(p->gc, expr, op, right);
+        expr = NewLogical(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_LOGICAL_EXPR);
             return NULL;
@@ -173,9 +192,13 @@ static PExpr *rAssignment(Parser *p) {
     if (matchOne(p, T_EQ)) {
         Token *op = previous(p);
         PExpr *value = rAssignment(p);
+        // error of the target is reported already
+        if (expr == NULL) {
+            return NULL;
+        }
 
         if (expr->type == EXPR_VARIABLE || expr->type == EXPR_SUBSCRIPT) {
-            PExpr *assignExpr = NewAssignment(p->gc, op, expr, value);
+            PExpr *assignExpr = NewAssignment(p->arena, op, expr, value);
             if (assignExpr == NULL) {
                 error(p, op, PARSER_IME_ASSIGN_EXPR);
                 return NULL;
@@ -196,7 +219,7 @@ static PExpr *rEquality(Parser *p) {
         Token *op = previous(p);
         PExpr *right = rComparison(p);
 
-        expr = NewBinaryExpr(p->gc, expr, op, right);
+        expr = NewBinaryExpr(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_BINARY_EXPR);
             return NULL;
@@ -211,7 +234,7 @@ static PExpr *rComparison(Parser *p) {
     while (matchMany(p, (PTokenType[]){T_GT, T_GTE, T_LT, T_LTE}, 4)) {
         Token *op = previous(p);
         PExpr *right = rTerm(p);
-        expr = NewBinaryExpr(p->gc, expr, op, right);
+        expr = NewBinaryExpr(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_BINARY_EXPR);
             return NULL;
@@ -226,7 +249,7 @@ static PExpr *rTerm(Parser *p) {
     while (matchMany(p, (PTokenType[]){T_MINUS, T_PLUS}, 2)) {
         Token *op = previous(p);
         PExpr *right = rFactor(p);
-        expr = NewBinaryExpr(p->gc, expr, op, right);
+        expr = NewBinaryExpr(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_BINARY_EXPR);
             return NULL;
@@ -244,7 +267,7 @@ static PExpr *rFactor(Parser *p) {
         if (right == NULL) {
             error(p, NULL, PARSER_INVALID_MULDIV_RIGHT);
         }
-        expr = NewBinaryExpr(p->gc, expr, op, right);
+        expr = NewBinaryExpr(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_BINARY_EXPR);
             return NULL;
@@ -257,7 +280,7 @@ static PExpr *rUnary(Parser *p) {
     if (matchMany(p, (PTokenType[]){T_BANG, T_MINUS}, 2)) {
         Token *op = previous(p);
         PExpr *right = rUnary(p);
-        PExpr *unaryExpr = NewUnary(p->gc, op, right);
+        PExpr *unaryExpr = NewUnary(p->arena, op, right);
         if (unaryExpr == NULL) {
             error(p, op, PARSER_IME_UNARY_EXPR);
             return NULL;
@@ -279,7 +302,7 @@ static PExpr *rExponent(Parser *p) {
         if (right == NULL) {
             error(p, NULL, PARSER_INVALID_EXPO_RIGHT);
         }
-        expr = NewBinaryExpr(p->gc, expr, op, right);
+        expr = NewBinaryExpr(p->arena, expr, op, right);
         if (expr == NULL) {
             error(p, op, PARSER_IME_BINARY_EXPR);
             return NULL;
@@ -302,7 +325,8 @@ static PExpr *finishCallExpr(Parser *p, PExpr *expr) {
     }
 
     Token *rparen = eat(p, T_RIGHT_PAREN, PARSER_EXPECT_CALL_RPAREN);
-    PExpr *callExpr = NewCallExpr(p->gc, rparen, expr, args, count);
+    args = listToArena(p, args, count);
+    PExpr *callExpr = NewCallExpr(p->arena, rparen, expr, args, count);
     if (callExpr == NULL) {
         error(p, rparen, PARSER_IME_CALL_EXPR);
         return NULL;
@@ -318,7 +342,7 @@ static PExpr *rSubscript(Parser *p, PExpr *expr) {
         return NULL;
     }
     eat(p, T_RS_BRACKET, PARSER_EXPECT_RBRACKET_SUBEXPR);
-    PExpr *subExpr = NewSubscriptExpr(p->gc, op, expr, indexExpr);
+    PExpr *subExpr = NewSubscriptExpr(p->arena, op, expr, indexExpr);
     if (subExpr == NULL) {
         error(p, op, PARSER_IME_SUBSCRIPT_EXPR);
         return NULL;
@@ -331,7 +355,7 @@ static PExpr *rSubscript(Parser *p, PExpr *expr) {
 static PExpr *rModget(Parser *p, PExpr *expr) {
     Token *op = previous(p);
     Token *childTok = eat(p, T_IDENT, PARSER_EXPECT_MOD_CHILD);
-    PExpr *modGetExpr = NewModgetExpr(p->gc, op, expr, childTok);
+    PExpr *modGetExpr = NewModgetExpr(p->arena, op, expr, childTok);
     if (modGetExpr == NULL) {
         error(
             p, op, PARSER_IME_MOD_CHILD
@@ -374,7 +398,8 @@ static PExpr *rArrayExpr(Parser *p) {
     }
     Token *rbrace = eat(p, T_RS_BRACKET, PARSER_EXPECT_RBRACKET_ARRAY);
     u64 itemCount = (u64)arrlen(items);
-    return NewArrayExpr(p->gc, rbrace, items, itemCount);
+    items = listToArena(p, items, itemCount);
+    return NewArrayExpr(p->arena, rbrace, items, itemCount);
 }
 
 static PExpr *rMapExpr(Parser *p) {
@@ -382,22 +407,28 @@ static PExpr *rMapExpr(Parser *p) {
     Token *lbrace = previous(p);
     while (!check(p, T_RIGHT_BRACE)) {
         arrput(etable, rExpression(p));
-        eat(p, T_COLON, PARSER_EXPECT_COLON_MAPKEY);
+        if (eat(p, T_COLON, PARSER_EXPECT_COLON_MAPKEY) == NULL) {
+            arrput(etable, NULL);
+            break;
+        }
         arrput(etable, rExpression(p));
         if (check(p, T_RIGHT_BRACE)) {
             break;
         }
-        eat(p, T_COMMA, PARSER_EXPECT_COMMA_MAPPAIR);
+        if (eat(p, T_COMMA, PARSER_EXPECT_COMMA_MAPPAIR) == NULL) {
+            break;
+        }
     }
     eat(p, T_RIGHT_BRACE, PARSER_EXPECT_RBRACE_MAP);
     u64 itemCount = (u64)(arrlen(etable));
-    return NewMapExpr(p->gc, lbrace, etable, itemCount);
+    etable = listToArena(p, etable, itemCount);
+    return NewMapExpr(p->arena, lbrace, etable, itemCount);
 }
 
 static PExpr *rPrimary(Parser *p) {
     if (matchOne(p, T_TRUE)) {
         Token *op = previous(p);
-        PExpr *e = NewLiteral(p->gc, previous(p), EXP_LIT_BOOL);
+        PExpr *e = NewLiteral(p->arena, previous(p), EXP_LIT_BOOL);
         if (e == NULL) {
             error(p, op, PARSER_IME_BOOL_EXPR);
             return NULL;
@@ -408,7 +439,7 @@ static PExpr *rPrimary(Parser *p) {
 
     if (matchOne(p, T_FALSE)) {
         Token *op = previous(p);
-        PExpr *e = NewLiteral(p->gc, op, EXP_LIT_BOOL);
+        PExpr *e = NewLiteral(p->arena, op, EXP_LIT_BOOL);
         if (e == NULL) {
             error(p, op, PARSER_IME_BOOL_EXPR);
             return NULL;
@@ -419,7 +450,7 @@ static PExpr *rPrimary(Parser *p) {
 
     if (matchOne(p, T_NIL)) {
         Token *op = previous(p);
-        PExpr *e = NewLiteral(p->gc, op, EXP_LIT_NIL);
+        PExpr *e = NewLiteral(p->arena, op, EXP_LIT_NIL);
         if (e == NULL) {
             error(p, op, PARSER_IME_NIL_EXPR);
         }
@@ -437,7 +468,7 @@ static PExpr *rPrimary(Parser *p) {
             return NULL;
         }
 
-        PExpr *e = NewLiteral(p->gc, opTok, EXP_LIT_NUM);
+        PExpr *e = NewLiteral(p->arena, opTok, EXP_LIT_NUM);
         if (e == NULL) {
             error(p, opTok, PARSER_IME_NUM_EXPR);
             return NULL;
@@ -448,7 +479,7 @@ static PExpr *rPrimary(Parser *p) {
 
     if (matchOne(p, T_STR)) {
         Token *opTok = previous(p);
-        PExpr *e = NewLiteral(p->gc, opTok, EXP_LIT_STR);
+        PExpr *e = NewLiteral(p->arena, opTok, EXP_LIT_STR);
         if (e == NULL) {
             error(p, opTok, PARSER_IME_STR_EXPR);
             return NULL;
@@ -459,7 +490,7 @@ static PExpr *rPrimary(Parser *p) {
 
     if (matchOne(p, T_IDENT)) {
         Token *op = previous(p);
-        PExpr *e = NewVarExpr(p->gc, op);
+        PExpr *e = NewVarExpr(p->arena, op);
         if (e == NULL) {
             error(p, op, PARSER_IME_IDENT_EXPR);
             return NULL;
@@ -471,7 +502,7 @@ static PExpr *rPrimary(Parser *p) {
         Token *op = previous(p);
         PExpr *e = rExpression(p);
         eat(p, T_RIGHT_PAREN, PARSER_EXPECT_RPAREN_GROUP);
-        PExpr *grpExpr = NewGrouping(p->gc, op, e);
+        PExpr *grpExpr = NewGrouping(p->arena, op, e);
         if (grpExpr == NULL) {
             error(p, op, PARSER_IME_GROUP_EXPR);
             return NULL;
@@ -528,7 +559,7 @@ static void syncParser(Parser *p) {
 static PStmt *rExprStmt(Parser *p) {
     PExpr *value = rExpression(p);
     Token *op = previous(p);
-    PStmt *exprStmt = NewExprStmt(p->gc, op, value);
+    PStmt *exprStmt = NewExprStmt(p->arena, op, value);
 
     if (exprStmt == NULL) {
         error(p, op, PARSER_IME_EXPR_STMT);
@@ -541,7 +572,7 @@ static PStmt *rExprStmt(Parser *p) {
 static PStmt *rDebugStmt(Parser *p) {
     PExpr *value = rExpression(p);
     Token *op = previous(p);
-    PStmt *debugStmt = NewDebugStmt(p->gc, op, value);
+    PStmt *debugStmt = NewDebugStmt(p->arena, op, value);
     if (debugStmt == NULL) {
         error(p, op, PARSER_IME_DEBUG_STMT);
         return NULL;
@@ -554,7 +585,7 @@ static PStmt *rLetStmt(Parser *p) {
     Token *name = eat(p, T_IDENT, PARSER_EXPECT_LET_IDENT);
     eat(p, T_EQ, PARSER_EXPECT_EQ_LET_IDENT);
     PExpr *value = rExpression(p);
-    PStmt *letStmt = NewLetStmt(p->gc, name, value);
+    PStmt *letStmt = NewLetStmt(p->arena, name, value);
     if (letStmt == NULL) {
         error(p, name, PARSER_IME_LET_STMT);
         return NULL;
@@ -571,7 +602,9 @@ static PStmt *rBlockStmt(Parser *p) {
     }
 
     eat(p, T_RIGHT_BRACE, PARSER_EXPECT_RBRACE_BLOCK);
-    PStmt *block = NewBlockStmt(p->gc, curTok, stmtList);
+    u64 count = (u64)arrlen(stmtList);
+    stmtList = listToArena(p, stmtList, count);
+    PStmt *block = NewBlockStmt(p->arena, curTok, stmtList, count);
     if (block == NULL) {
         error(p, curTok, PARSER_IME_BLOCK_STMT);
         return NULL;
@@ -587,7 +620,9 @@ static PStmt *rToEndBlockStmt(Parser *p) {
 
     eat(p, T_END, PARSER_EXPECT_END_BLOCK);
     Token *endTok = previous(p);
-    PStmt *block = NewBlockStmt(p->gc, previous(p), stmtList);
+    u64 count = (u64)arrlen(stmtList);
+    stmtList = listToArena(p, stmtList, count);
+    PStmt *block = NewBlockStmt(p->arena, endTok, stmtList, count);
     if (block == NULL) {
         error(p, endTok, PARSER_IME_BLOCK_STMT);
         return NULL;
@@ -612,7 +647,9 @@ static PStmt *rToEndOrElseBlockStmt(Parser *p, bool *hasElse) {
 
     Token *op = previous(p);
 
-    PStmt *block = NewBlockStmt(p->gc, op, stmtList);
+    u64 count = (u64)arrlen(stmtList);
+    stmtList = listToArena(p, stmtList, count);
+    PStmt *block = NewBlockStmt(p->arena, op, stmtList, count);
     if (block == NULL) {
         error(p, op, PARSER_IME_BLOCK_STMT);
         return NULL;
@@ -635,7 +672,7 @@ static PStmt *rIfStmt(Parser *p) {
         }
     }
 
-    PStmt *ifStmt = NewIfStmt(p->gc, op, cond, thenBranch, elseBranch);
+    PStmt *ifStmt = NewIfStmt(p->arena, op, cond, thenBranch, elseBranch);
     if (ifStmt == NULL) {
         error(p, op, PARSER_IME_IF_STMT);
         return NULL;
@@ -649,7 +686,7 @@ static PStmt *rWhileStmt(Parser *p) {
     PExpr *cond = rExpression(p);
     eat(p, T_DO, PARSER_EXPECT_DO_WHILECOND);
     PStmt *body = rToEndBlockStmt(p);
-    PStmt *whileStmt = NewWhileStmt(p->gc, op, cond, body);
+    PStmt *whileStmt = NewWhileStmt(p->arena, op, cond, body);
 
     if (whileStmt == NULL) {
         error(p, op, PARSER_IME_WHILE_STMT);
@@ -672,7 +709,7 @@ static PStmt *rReturnStmt(Parser *p) {
         eat(p, T_SEMICOLON, PARSER_EXPECT_SEMICOLON_NILRETURN);
     }
 
-    PStmt *retStmt = NewReturnStmt(p->gc, op, value);
+    PStmt *retStmt = NewReturnStmt(p->arena, op, value);
     if (retStmt == NULL) {
         error(p, op, PARSER_IME_RETURN_STMT);
         return NULL;
@@ -687,7 +724,7 @@ static PStmt *rBreakStmt(Parser *p) {
         eat(p, T_SEMICOLON, PARSER_EXPECT_SEMICOLON);
     }
 
-    PStmt *breakStmt = NewBreakStmt(p->gc, op);
+    PStmt *breakStmt = NewBreakStmt(p->arena, op);
 
     if (breakStmt == NULL) {
         error(p, op, PARSER_IME_BREAK_STMT);
@@ -703,7 +740,7 @@ static PStmt *rContinueStmt(Parser *p) {
         eat(p, T_SEMICOLON, PARSER_EXPECT_SEMICOLON);
     }
 
-    PStmt *contStmt = NewContinueStmt(p->gc, op);
+    PStmt *contStmt = NewContinueStmt(p->arena, op);
     if (contStmt == NULL) {
         error(p, op, PARSER_IME_CONTINUE_STMT);
         return NULL;
@@ -726,8 +763,9 @@ static PStmt *rFuncStmt(Parser *p) {
     }
     eat(p, T_RIGHT_PAREN, PARSER_EXPECT_FUNC_RPAREN);
     PStmt *body = rToEndBlockStmt(p);
+    params = listToArena(p, params, paramCount);
 
-    PStmt *funcStmt = NewFuncStmt(p->gc, name, params, body, paramCount);
+    PStmt *funcStmt = NewFuncStmt(p->arena, name, params, body, paramCount);
     if (funcStmt == NULL) {
         error(p, name, PARSER_IME_FUNC_STMT);
         return NULL;
@@ -745,7 +783,7 @@ static PStmt *rImportStmt(Parser *p) {
             PARSER_EXPECT_SEMICOLON); // Error should never occur
     }
 
-    PStmt *importStmt = NewImportStmt(p->gc, op, name, pathExpr);
+    PStmt *importStmt = NewImportStmt(p->arena, op, name, pathExpr);
     if (importStmt == NULL) {
         error(p, op, PARSER_IME_IMPORT_STMT);
         return NULL;
@@ -9,6 +9,7 @@
 #ifndef PANKTI_PARSER_H
 #define PANKTI_PARSER_H
 
+#include "arena.h"
 #include "diagonctx.h"
 #include "gc.h"
 #ifdef __cplusplus
@@ -26,8 +27,8 @@ typedef struct Parser {
     // Array of Tokens, referenced from lexer's token array
     Token **tokens;
     PDiagonCtx errCtx;
-    // Reference to GC
-    Pgc *gc;
+    // Arena the AST is allocated from
+    PArena *arena;
     // Reading Position of token from token array
     int pos;
 
@@ -38,12 +39,17 @@ typedef struct Parser {
 } Parser;
 
 // Create New Parser Object
+// `arena` = AST nodes are allocated from here
 // `lexer` = The lexer object. The lexer must have already scanned the source
-Parser *NewParser(Pgc *gc, Lexer *lexer);
+Parser *NewParser(PArena *arena, Lexer *lexer);
 // Free the Parser object
 void FreeParser(Parser *parser);
 // Run the parser. Return reference to internal statements array
 PStmt **ParseParser(Parser *parser);
+// Parse one top level statement at `pos`, it isn't added to `stmts`
+PStmt *ParseStatement(Parser *parser);
+// Are all tokens parsed?
+bool ParserAtEnd(const Parser *parser);
 
 #ifdef __cplusplus
 }
@@ -8,6 +8,7 @@
 
 #include "pstdlib.h"
 #include "gc.h"
+#include "strpool.h"
 #include "vm.h"
 #include <stdbool.h>
 #include <stdio.h>
@@ -33,24 +34,27 @@ void PushStdlib(PVm *vm, SymbolTable *table, const char *name, StdlibMod mod) {
     }
 }
 
+bool StdlibIntrinsic(StdlibMod mod, const char *name, u64 argc, PanOpCode *op) {
+    switch (mod) {
+        case STDLIB_MATH: return StdlibMathIntrinsic(name, argc, op);
+        default: return false;
+    }
+}
+
 void PushStdlibEntries(
-    PVm *vm,
-    SymbolTable *table,
-    const char *module,
-    StdlibEntry *entries,
-    u64 count
+    PVm *vm, SymbolTable *table, StdlibEntry *entries, u64 count
 ) {
+    // Grown once for all of them, instead of doubling on the way
+    SymbolTableReserve(table, SymbolTableGetCount(table) + count);
+    PStringPool *strings = vm->gc->strings;
+    if (strings != NULL) {
+        StringPoolReserve(strings, strings->count + count);
+    }
     for (u64 i = 0; i < count; i++) {
-        const StdlibEntry *entry = &entries[i];
-        PObj *stdNameObj = NewStrObject(vm->gc, NULL, entry->name, false);
+        StdlibEntry *entry = &entries[i];
+        PObj *stdNameObj = NewStrObject(vm->gc, entry->name, false);
         VmPush(vm, MakeObject(stdNameObj));
-        const char *entryName = StrFormat(
-            "<%s>.%s", module != NULL ? module : "unknown", entry->name
-        );
-        PObj *stdFnObj =
-            NewNativeFnObject(vm->gc, entryName, entry->fn, entry->arity);
-        VmPush(vm, MakeObject(stdFnObj));
-        SymbolTableSet(table, stdNameObj, VmPop(vm));
+        SymbolTableSet(table, stdNameObj, MakeObject(&entry->native));
         VmPop(vm);
     }
 }
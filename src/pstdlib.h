@@ -10,6 +10,7 @@
 #define PANKTI_PSTDLIB_H
 
 #include "object.h"
+#include "opcode.h"
 #include "symtable.h"
 #include "utils.h"
 #include <stdbool.h>
@@ -37,17 +38,33 @@ typedef enum StdlibMod {
     STDLIB_FILE,
 } StdlibMod;
 
+// Native function of a stdlib module or of the builtins.
+//
+// The function object is built at compile time with its full name, so
+// registering it costs only the symbol table insert of its name. It is
+// shared by every VM and import, and is not allocated or freed by any GC. It
+// starts marked, the GC never traces it, and natives don't reference other
+// objects.
 typedef struct StdlibEntry {
     char *name;
     u64 nlen;
-    NativeFn fn;
-    int arity;
+    PObj native;
 } StdlibEntry;
 
-#define MakeStdlibEntry(sname, nfn, ar)                                        \
-    ((StdlibEntry){                                                            \
-        .name = sname, .nlen = (u64)strlen(sname), .fn = nfn, .arity = ar      \
-    })
+// Entry of native function `nfn` with `ar` args, named `sname` in module
+// `smod`, both string literals. Only a constant expression, so tables of them
+// can be `static`
+#define MakeStdlibEntry(smod, sname, nfn, ar)                                  \
+    {                                                                          \
+        .name = sname, .nlen = sizeof(sname) - 1,                              \
+        .native = {                                                            \
+            .type = OT_NATIVE,                                                 \
+            .next = NULL,                                                      \
+            .marked = true,                                                    \
+            .v.ONative =                                                       \
+                {.fn = nfn, .arity = ar, .name = "<" smod ">." sname},         \
+        },                                                                     \
+    }
 
 typedef struct PVm PVm;
 
@@ -86,12 +103,15 @@ void PushStdlibGraphics(PVm *vm, SymbolTable *table);
 static inline void PushStdlibGraphics(PVm *vm, SymbolTable *table) { return; }
 #endif
 void PushStdlibFile(PVm *vm, SymbolTable *table);
+
+// Intrinsic opcode the compiler can emit for a call of member `name` of
+// module `mod` with `argc` arguments. Returns false if there is none
+bool StdlibIntrinsic(StdlibMod mod, const char *name, u64 argc, PanOpCode *op);
+bool StdlibMathIntrinsic(const char *name, u64 argc, PanOpCode *op);
+
+// Set members `entries` in `table`
 void PushStdlibEntries(
-    PVm *vm,
-    SymbolTable *table,
-    const char *module,
-    StdlibEntry *entries,
-    u64 count
+    PVm *vm, SymbolTable *table, StdlibEntry *entries, u64 count
 );
 
 #ifdef __cplusplus
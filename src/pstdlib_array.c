@@ -43,6 +43,8 @@ static PValue array_Exists(PVm *vm, PValue *args, u64 argc) {
     return MakeBool(found);
 }
 
+#define ARRAY_ADD_SIG "সংযোগ(তালিকার_নাম, সূচক, উপাদান)"
+
 static PValue array_Add(PVm *vm, PValue *args, u64 argc) {
     PValue rawArray = args[0];
     if (!IsValueObjType(rawArray, OT_ARR)) {
@@ -81,8 +83,10 @@ static PValue array_Add(PVm *vm, PValue *args, u64 argc) {
         return MakeNil();
     }
 
-    arrins(arr->items, arrIndex, val);
-    arr->count = arrlen(arr->items);
+    if (!ArrayObjInsValue(ValueAsObj(rawArray), arrIndex, val)) {
+        VmError(vm, RT_IME_STDARR_RESERVE, ARRAY_ADD_SIG, arr->count + 1);
+        return MakeNil();
+    }
     return MakeNumber((double)arr->count);
 }
 
@@ -138,9 +142,8 @@ static PValue array_Delete(PVm *vm, PValue *args, u64 argc) {
         return MakeNil();
     }
 
-    PValue result = arr->items[arrIndex];
-    arrdel(arr->items, arrIndex);
-    arr->count = arrlen(arr->items);
+    PValue result = MakeNil();
+    ArrayObjRemoveAt(ValueAsObj(rawArray), arrIndex, &result);
     return result;
 }
 
@@ -167,22 +170,691 @@ static PValue array_Trim(PVm *vm, PValue *args, u64 argc) {
     return popped;
 }
 
-#define ARRAY_STD_EXISTS "বর্তমান"
-#define ARRAY_STD_INDEX  "সূচক"
-#define ARRAY_STD_ADD    "সংযোগ"
-#define ARRAY_STD_DELETE "বিয়োগ"
-#define ARRAY_STD_TRIM   "শেষবাদ"
+// Signatures used in diagnostics of numeric array functions
+#define ARRNUM_SUM_SIG   "যোগফল(তালিকার_নাম)"
+#define ARRNUM_MIN_SIG   "ক্ষুদ্রতম(তালিকার_নাম)"
+#define ARRNUM_MAX_SIG   "বৃহত্তম(তালিকার_নাম)"
+#define ARRNUM_DOT_SIG   "ডট_গুণফল(ক, খ)"
+#define ARRNUM_SCALE_SIG "গুণিতক(তালিকার_নাম, গুণক)"
+#define ARRNUM_FILL_SIG  "ভরাট(তালিকার_নাম, মান)"
+#define ARRNUM_RANGE_SIG "পরিসর(শুরু, শেষ, ধাপ)"
+
+// Biggest array `পরিসর(...)` is allowed to create, and biggest capacity
+// `সংরক্ষণ(...)` reserves. 2 GB of items
+#define ARRNUM_RANGE_MAX ((u64)1 << 28)
+
+// Check that `raw` is an array of numbers, reporting error with function
+// signature `sig` if it is not. Returns the array object or NULL
+static PObj *getNumArray(PVm *vm, PValue raw, const char *sig) {
+    if (!IsValueObjType(raw, OT_ARR)) {
+        VmError(vm, RT_STDARR_FN_FIRST_ARR, sig, ValueTypeToStr(raw));
+        return NULL;
+    }
+
+    PObj *arr = ValueAsObj(raw);
+    u64 badIndex = 0;
+    if (!ArrayObjIsNumeric(arr, &badIndex)) {
+        VmError(
+            vm, RT_STDARR_NUM_NOT_NUMERIC, sig, badIndex,
+            ValueTypeToStr(arr->v.OArray.items[badIndex])
+        );
+        return NULL;
+    }
+
+    return arr;
+}
+
+// Create a new array of `count` uninitialized items
+static PObj *newSizedArray(PVm *vm, u64 count, const char *sig) {
+    PValue *items = NULL;
+    if (count > 0) {
+        if (!ArrayItemsReserve(&items, count)) {
+            VmError(vm, RT_IME_STDARR_NEW_ARR, sig);
+            return NULL;
+        }
+        arrsetlen(items, count);
+    }
+    PObj *arr = NewArrayObject(vm->gc, NULL, items, 0);
+    if (arr == NULL) {
+        arrfree(items);
+        VmError(vm, RT_IME_STDARR_NEW_ARR, sig);
+        return NULL;
+    }
+    arr->v.OArray.count = count;
+    return arr;
+}
+
+static PValue array_Sum(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getNumArray(vm, args[0], ARRNUM_SUM_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    return MakeNumber(ArrayNumSum(arr->v.OArray.items, arr->v.OArray.count));
+}
+
+static PValue array_Min(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getNumArray(vm, args[0], ARRNUM_MIN_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    if (arr->v.OArray.count == 0) {
+        VmError(vm, RT_STDARR_NUM_ARR_EMPTY, ARRNUM_MIN_SIG);
+        return MakeNil();
+    }
+
+    return MakeNumber(ArrayNumMin(arr->v.OArray.items, arr->v.OArray.count));
+}
+
+static PValue array_Max(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getNumArray(vm, args[0], ARRNUM_MAX_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    if (arr->v.OArray.count == 0) {
+        VmError(vm, RT_STDARR_NUM_ARR_EMPTY, ARRNUM_MAX_SIG);
+        return MakeNil();
+    }
+
+    return MakeNumber(ArrayNumMax(arr->v.OArray.items, arr->v.OArray.count));
+}
+
+static PValue array_Dot(PVm *vm, PValue *args, u64 argc) {
+    PObj *a = getNumArray(vm, args[0], ARRNUM_DOT_SIG);
+    if (a == NULL) {
+        return MakeNil();
+    }
+    PObj *b = getNumArray(vm, args[1], ARRNUM_DOT_SIG);
+    if (b == NULL) {
+        return MakeNil();
+    }
+
+    if (a->v.OArray.count != b->v.OArray.count) {
+        VmError(
+            vm, RT_STDARR_DOT_LEN_MISMATCH, a->v.OArray.count,
+            b->v.OArray.count
+        );
+        return MakeNil();
+    }
+
+    return MakeNumber(
+        ArrayNumDot(a->v.OArray.items, b->v.OArray.items, a->v.OArray.count)
+    );
+}
+
+static PValue array_Scale(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getNumArray(vm, args[0], ARRNUM_SCALE_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    PValue rawFactor = args[1];
+    if (!IsValueNum(rawFactor)) {
+        VmError(
+            vm, RT_STDARR_NUM_ARG_NOT_NUM, ARRNUM_SCALE_SIG, "গুণক",
+            ValueTypeToStr(rawFactor)
+        );
+        return MakeNil();
+    }
+
+    u64 count = arr->v.OArray.count;
+    PObj *result = newSizedArray(vm, count, ARRNUM_SCALE_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+
+    ArrayNumScale(
+        result->v.OArray.items, arr->v.OArray.items, count,
+        ValueAsNum(rawFactor)
+    );
+    result->v.OArray.kind = ARR_KIND_NUM;
+    return MakeObject(result);
+}
+
+static PValue array_Fill(PVm *vm, PValue *args, u64 argc) {
+    PValue rawArray = args[0];
+    if (!IsValueObjType(rawArray, OT_ARR)) {
+        VmError(
+            vm, RT_STDARR_FN_FIRST_ARR, ARRNUM_FILL_SIG,
+            ValueTypeToStr(rawArray)
+        );
+        return MakeNil();
+    }
+
+    struct OArray *arr = &ValueAsObj(rawArray)->v.OArray;
+    PValue value = ArrayItemValue(args[1]);
+    ArrayNumFill(arr->items, arr->count, value);
+    arr->kind = IsValueNum(value) ? ARR_KIND_NUM : ARR_KIND_ANY;
+    return rawArray;
+}
+
+static PValue array_Range(PVm *vm, PValue *args, u64 argc) {
+    const char *argNames[] = {"শুরু", "শেষ", "ধাপ"};
+    for (int i = 0; i < 3; i++) {
+        if (!IsValueNum(args[i])) {
+            VmError(
+                vm, RT_STDARR_NUM_ARG_NOT_NUM, ARRNUM_RANGE_SIG, argNames[i],
+                ValueTypeToStr(args[i])
+            );
+            return MakeNil();
+        }
+    }
+
+    double start = ValueAsNum(args[0]);
+    double end = ValueAsNum(args[1]);
+    double step = ValueAsNum(args[2]);
+
+    if (step == 0 || isinf(step) || isnan(step)) {
+        VmError(vm, RT_STDARR_RANGE_INVALID_STEP);
+        return MakeNil();
+    }
+
+    double span = ceil((end - start) / step);
+    u64 count = 0;
+    if (span > 0) {
+        if (span > (double)ARRNUM_RANGE_MAX) {
+            VmError(vm, RT_STDARR_RANGE_TOO_BIG, ARRNUM_RANGE_MAX);
+            return MakeNil();
+        }
+        count = (u64)span;
+    }
+
+    PObj *result = newSizedArray(vm, count, ARRNUM_RANGE_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+
+    ArrayNumRange(result->v.OArray.items, count, start, step);
+    result->v.OArray.kind = ARR_KIND_NUM;
+    return MakeObject(result);
+}
+
+// Signatures used in diagnostics of higher order array functions
+#define ARRFN_MAP_SIG     "রূপান্তর(তালিকার_নাম, কাজ)"
+#define ARRFN_FILTER_SIG  "ছাঁকো(তালিকার_নাম, কাজ)"
+#define ARRFN_REDUCE_SIG  "ভাঁজ(তালিকার_নাম, কাজ, শুরুর_মান)"
+#define ARRFN_FOREACH_SIG "প্রতিটি(তালিকার_নাম, কাজ)"
+#define ARRFN_SORT_SIG    "সাজাও(তালিকার_নাম)"
+#define ARRFN_SORTBY_SIG  "তুলনায়_সাজাও(তালিকার_নাম, কাজ)"
+
+// Get array object from `raw`, reporting error with function signature `sig`
+// if it is not an array
+static PObj *getArray(PVm *vm, PValue raw, const char *sig) {
+    if (!IsValueObjType(raw, OT_ARR)) {
+        VmError(vm, RT_STDARR_FN_FIRST_ARR, sig, ValueTypeToStr(raw));
+        return NULL;
+    }
+    return ValueAsObj(raw);
+}
+
+// Check if `fn` can be called with `VmCallClosure`
+static bool checkCallback(PVm *vm, PValue fn, const char *sig) {
+    if (!IsValueObjType(fn, OT_CLOSURE) && !IsValueObjType(fn, OT_NATIVE)) {
+        VmError(vm, RT_STDARR_CALLBACK_NOT_FN, sig, "কাজ", ValueTypeToStr(fn));
+        return false;
+    }
+    return true;
+}
+
+static PValue array_Map(PVm *vm, PValue *args, u64 argc) {
+    PObj *src = getArray(vm, args[0], ARRFN_MAP_SIG);
+    PValue fn = args[1];
+    if (src == NULL || !checkCallback(vm, fn, ARRFN_MAP_SIG)) {
+        return MakeNil();
+    }
+
+    u64 count = src->v.OArray.count;
+    PObj *result = newSizedArray(vm, count, ARRFN_MAP_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+    struct OArray *res = &result->v.OArray;
+    ArrayNumFill(res->items, count, MakeNil());
+    res->kind = ARR_KIND_NUM;
+    // keep the result reachable while callbacks run
+    VmPush(vm, MakeObject(result));
+
+    u64 i = 0;
+    // callback can modify the source array, so count is checked every time
+    for (; i < count && i < src->v.OArray.count; i++) {
+        PValue value =
+            ArrayItemValue(VmCallClosure(vm, fn, &src->v.OArray.items[i], 1));
+        res->items[i] = value;
+        ArrayObjTrackKind(res, value);
+    }
+
+    if (i < count) {
+        arrsetlen(res->items, i);
+        res->count = i;
+    }
+
+    VmPop(vm);
+    return MakeObject(result);
+}
+
+static PValue array_Filter(PVm *vm, PValue *args, u64 argc) {
+    PObj *src = getArray(vm, args[0], ARRFN_FILTER_SIG);
+    PValue fn = args[1];
+    if (src == NULL || !checkCallback(vm, fn, ARRFN_FILTER_SIG)) {
+        return MakeNil();
+    }
+
+    PObj *result = newSizedArray(vm, 0, ARRFN_FILTER_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+    if (!ArrayObjReserve(result, src->v.OArray.count)) {
+        VmError(vm, RT_IME_STDARR_NEW_ARR, ARRFN_FILTER_SIG);
+        return MakeNil();
+    }
+    VmPush(vm, MakeObject(result));
+
+    for (u64 i = 0; i < src->v.OArray.count; i++) {
+        PValue item = src->v.OArray.items[i];
+        if (IsValueTruthy(VmCallClosure(vm, fn, &item, 1)) &&
+            !ArrayObjPushValue(result, item)) {
+            VmError(
+                vm, RT_IME_STDARR_RESERVE, ARRFN_FILTER_SIG,
+                result->v.OArray.count + 1
+            );
+            return MakeNil();
+        }
+    }
+
+    VmPop(vm);
+    return MakeObject(result);
+}
+
+static PValue array_Reduce(PVm *vm, PValue *args, u64 argc) {
+    PObj *src = getArray(vm, args[0], ARRFN_REDUCE_SIG);
+    PValue fn = args[1];
+    if (src == NULL || !checkCallback(vm, fn, ARRFN_REDUCE_SIG)) {
+        return MakeNil();
+    }
+
+    PValue callArgs[2] = {args[2], MakeNil()};
+    for (u64 i = 0; i < src->v.OArray.count; i++) {
+        callArgs[1] = src->v.OArray.items[i];
+        callArgs[0] = VmCallClosure(vm, fn, callArgs, 2);
+    }
+
+    return callArgs[0];
+}
+
+static PValue array_ForEach(PVm *vm, PValue *args, u64 argc) {
+    PObj *src = getArray(vm, args[0], ARRFN_FOREACH_SIG);
+    PValue fn = args[1];
+    if (src == NULL || !checkCallback(vm, fn, ARRFN_FOREACH_SIG)) {
+        return MakeNil();
+    }
+
+    for (u64 i = 0; i < src->v.OArray.count; i++) {
+        VmCallClosure(vm, fn, &src->v.OArray.items[i], 1);
+    }
+
+    return MakeNil();
+}
+
+static bool lessNumber(PValue a, PValue b, void *ctx) {
+    return ValueAsNum(a) < ValueAsNum(b);
+}
+
+static bool lessString(PValue a, PValue b, void *ctx) {
+    const char *left = ValueAsObj(a)->v.OString.value;
+    const char *right = ValueAsObj(b)->v.OString.value;
+    return strcmp(left, right) < 0;
+}
+
+typedef struct ArrSortCallback {
+    PVm *vm;
+    PValue fn;
+} ArrSortCallback;
+
+static bool lessCallback(PValue a, PValue b, void *ctx) {
+    ArrSortCallback *cb = (ArrSortCallback *)ctx;
+    PValue pair[2] = {a, b};
+    return IsValueTruthy(VmCallClosure(cb->vm, cb->fn, pair, 2));
+}
+
+static PValue array_Sort(PVm *vm, PValue *args, u64 argc) {
+    PObj *arrObj = getArray(vm, args[0], ARRFN_SORT_SIG);
+    if (arrObj == NULL) {
+        return MakeNil();
+    }
+
+    struct OArray *arr = &arrObj->v.OArray;
+    if (arr->count < 2) {
+        return args[0];
+    }
+
+    PValueLessFn less = lessNumber;
+    if (!ArrayObjIsNumeric(arrObj, NULL)) {
+        less = lessString;
+        for (u64 i = 0; i < arr->count; i++) {
+            if (!IsValueObjType(arr->items[i], OT_STR)) {
+                VmError(
+                    vm, RT_STDARR_SORT_MIXED, i, ValueTypeToStr(arr->items[i])
+                );
+                return MakeNil();
+            }
+        }
+    }
+
+    ArraySortValues(arr->items, arr->count, less, NULL);
+    return args[0];
+}
+
+static PValue array_SortBy(PVm *vm, PValue *args, u64 argc) {
+    PObj *arrObj = getArray(vm, args[0], ARRFN_SORTBY_SIG);
+    PValue fn = args[1];
+    if (arrObj == NULL || !checkCallback(vm, fn, ARRFN_SORTBY_SIG)) {
+        return MakeNil();
+    }
+
+    u64 count = arrObj->v.OArray.count;
+    if (count < 2) {
+        return args[0];
+    }
+
+    // Sort happens in two temporary arrays, which stay on the stack, so that
+    // every item is reachable and the comparator can't observe a half sorted
+    // array
+    PObj *work = newSizedArray(vm, count, ARRFN_SORTBY_SIG);
+    if (work == NULL) {
+        return MakeNil();
+    }
+    memcpy(
+        work->v.OArray.items, arrObj->v.OArray.items, sizeof(PValue) * count
+    );
+    VmPush(vm, MakeObject(work));
+
+    PObj *scratch = newSizedArray(vm, count, ARRFN_SORTBY_SIG);
+    if (scratch == NULL) {
+        return MakeNil();
+    }
+    memcpy(
+        scratch->v.OArray.items, arrObj->v.OArray.items, sizeof(PValue) * count
+    );
+    VmPush(vm, MakeObject(scratch));
+
+    ArrSortCallback cb = {.vm = vm, .fn = fn};
+    ArrayStableSortValues(
+        work->v.OArray.items, scratch->v.OArray.items, count, lessCallback, &cb
+    );
+
+    // the comparator added or removed items, sorted ones can't be put back
+    struct OArray *arr = &arrObj->v.OArray;
+    if (arr->count != count) {
+        VmError(
+            vm, RT_STDARR_SORTBY_MODIFIED, ARRFN_SORTBY_SIG, count, arr->count
+        );
+        return MakeNil();
+    }
+    memcpy(arr->items, work->v.OArray.items, sizeof(PValue) * count);
+    arr->kind = ArrayItemsKind(arr->items, count);
+
+    VmPop(vm); // scratch
+    VmPop(vm); // work
+    return args[0];
+}
+
+// Signatures used in diagnostics of array slicing functions
+#define ARRSEQ_SLICE_SIG   "টুকরো(তালিকার_নাম, শুরু, শেষ)"
+#define ARRSEQ_CONCAT_SIG  "জোড়া(ক, খ)"
+#define ARRSEQ_EXTEND_SIG  "বিস্তার(তালিকার_নাম, নতুন_তালিকা)"
+#define ARRSEQ_SPLICE_SIG  "বদল(তালিকার_নাম, শুরু, বাদ_সংখ্যা, নতুন_তালিকা)"
+#define ARRSEQ_RESERVE_SIG "সংরক্ষণ(তালিকার_নাম, ধারণক্ষমতা)"
+#define ARRSEQ_CLEAR_SIG   "খালি_করো(তালিকার_নাম)"
+
+// Get array object from argument `argName` of function `sig`
+static PObj *getArrayArg(
+    PVm *vm, PValue raw, const char *sig, const char *argName
+) {
+    if (!IsValueObjType(raw, OT_ARR)) {
+        VmError(
+            vm, RT_STDARR_FN_ARG_NOT_ARR, sig, argName, ValueTypeToStr(raw)
+        );
+        return NULL;
+    }
+    return ValueAsObj(raw);
+}
+
+// Read argument `argName` of function `sig` as an index between 0 and `limit`
+// (inclusive). Returns false if it is not
+static bool getIndexArg(
+    PVm *vm, PValue raw, const char *sig, const char *argName, u64 limit,
+    u64 *index
+) {
+    if (!IsValueNum(raw)) {
+        VmError(
+            vm, RT_STDARR_NUM_ARG_NOT_NUM, sig, argName, ValueTypeToStr(raw)
+        );
+        return false;
+    }
+
+    double dblIndex = ValueAsNum(raw);
+    if (dblIndex < 0 || !IsDoubleInt(dblIndex)) {
+        VmError(vm, RT_STDARR_FN_INVALID_NUMIDX, sig, argName, dblIndex);
+        return false;
+    }
+
+    if (dblIndex > (double)limit) {
+        VmError(vm, RT_STDARR_FN_INDEX_OUT_RANGE, sig, argName, limit);
+        return false;
+    }
+
+    *index = (u64)dblIndex;
+    return true;
+}
+
+static PValue array_Slice(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getArray(vm, args[0], ARRSEQ_SLICE_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    u64 count = arr->v.OArray.count;
+    u64 start = 0;
+    u64 end = 0;
+    if (!getIndexArg(vm, args[1], ARRSEQ_SLICE_SIG, "শুরু", count, &start) ||
+        !getIndexArg(vm, args[2], ARRSEQ_SLICE_SIG, "শেষ", count, &end)) {
+        return MakeNil();
+    }
+
+    if (start > end) {
+        VmError(vm, RT_STDARR_SLICE_BAD_RANGE, start, end);
+        return MakeNil();
+    }
+
+    PObj *result = newSizedArray(vm, 0, ARRSEQ_SLICE_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+    if (!ArrayObjAppendItems(
+            result, arr->v.OArray.items + start, end - start
+        )) {
+        VmError(vm, RT_IME_STDARR_NEW_ARR, ARRSEQ_SLICE_SIG);
+        return MakeNil();
+    }
+    return MakeObject(result);
+}
+
+static PValue array_Concat(PVm *vm, PValue *args, u64 argc) {
+    PObj *a = getArrayArg(vm, args[0], ARRSEQ_CONCAT_SIG, "ক");
+    PObj *b = getArrayArg(vm, args[1], ARRSEQ_CONCAT_SIG, "খ");
+    if (a == NULL || b == NULL) {
+        return MakeNil();
+    }
+
+    PObj *result = newSizedArray(vm, 0, ARRSEQ_CONCAT_SIG);
+    if (result == NULL) {
+        return MakeNil();
+    }
+    if (!ArrayObjReserve(result, a->v.OArray.count + b->v.OArray.count)) {
+        VmError(vm, RT_IME_STDARR_NEW_ARR, ARRSEQ_CONCAT_SIG);
+        return MakeNil();
+    }
+    ArrayObjAppendItems(result, a->v.OArray.items, a->v.OArray.count);
+    ArrayObjAppendItems(result, b->v.OArray.items, b->v.OArray.count);
+    return MakeObject(result);
+}
+
+static PValue array_Extend(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getArray(vm, args[0], ARRSEQ_EXTEND_SIG);
+    PObj *other = getArrayArg(vm, args[1], ARRSEQ_EXTEND_SIG, "নতুন_তালিকা");
+    if (arr == NULL || other == NULL) {
+        return MakeNil();
+    }
+
+    u64 count = arr->v.OArray.count + other->v.OArray.count;
+    if (!ArrayObjAppendItems(
+            arr, other->v.OArray.items, other->v.OArray.count
+        )) {
+        VmError(vm, RT_IME_STDARR_RESERVE, ARRSEQ_EXTEND_SIG, count);
+        return MakeNil();
+    }
+    return MakeNumber((double)arr->v.OArray.count);
+}
+
+static PValue array_Splice(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getArray(vm, args[0], ARRSEQ_SPLICE_SIG);
+    PObj *other = getArrayArg(vm, args[3], ARRSEQ_SPLICE_SIG, "নতুন_তালিকা");
+    if (arr == NULL || other == NULL) {
+        return MakeNil();
+    }
+
+    u64 count = arr->v.OArray.count;
+    u64 start = 0;
+    u64 deleteCount = 0;
+    if (!getIndexArg(vm, args[1], ARRSEQ_SPLICE_SIG, "শুরু", count, &start) ||
+        !getIndexArg(
+            vm, args[2], ARRSEQ_SPLICE_SIG, "বাদ_সংখ্যা", count - start,
+            &deleteCount
+        )) {
+        return MakeNil();
+    }
+
+    // removed items are returned as a new array
+    PObj *removed = newSizedArray(vm, 0, ARRSEQ_SPLICE_SIG);
+    if (removed == NULL) {
+        return MakeNil();
+    }
+    if (!ArrayObjAppendItems(
+            removed, arr->v.OArray.items + start, deleteCount
+        )) {
+        VmError(vm, RT_IME_STDARR_NEW_ARR, ARRSEQ_SPLICE_SIG);
+        return MakeNil();
+    }
+
+    const PValue *items = other->v.OArray.items;
+    u64 itemCount = other->v.OArray.count;
+    PValue *copy = NULL;
+    if (other == arr && itemCount > 0) {
+        // splicing an array into itself, insert from a copy
+        arrsetlen(copy, itemCount);
+        memcpy(copy, items, sizeof(PValue) * itemCount);
+        items = copy;
+    }
+
+    bool spliced = ArrayObjSplice(arr, start, deleteCount, items, itemCount);
+    arrfree(copy);
+    if (!spliced) {
+        VmError(
+            vm, RT_IME_STDARR_RESERVE, ARRSEQ_SPLICE_SIG,
+            count - deleteCount + itemCount
+        );
+        return MakeNil();
+    }
+    return MakeObject(removed);
+}
+
+static PValue array_Reserve(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getArray(vm, args[0], ARRSEQ_RESERVE_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    u64 capacity = 0;
+    if (!getIndexArg(
+            vm, args[1], ARRSEQ_RESERVE_SIG, "ধারণক্ষমতা", ARRNUM_RANGE_MAX,
+            &capacity
+        )) {
+        return MakeNil();
+    }
+
+    if (!ArrayObjReserve(arr, capacity)) {
+        VmError(vm, RT_IME_STDARR_RESERVE, ARRSEQ_RESERVE_SIG, capacity);
+        return MakeNil();
+    }
+    return args[0];
+}
+
+static PValue array_Clear(PVm *vm, PValue *args, u64 argc) {
+    PObj *arr = getArray(vm, args[0], ARRSEQ_CLEAR_SIG);
+    if (arr == NULL) {
+        return MakeNil();
+    }
+
+    ArrayObjClear(arr);
+    return args[0];
+}
+
+#define ARRAY_STD_EXISTS  "বর্তমান"
+#define ARRAY_STD_INDEX   "সূচক"
+#define ARRAY_STD_ADD     "সংযোগ"
+#define ARRAY_STD_DELETE  "বিয়োগ"
+#define ARRAY_STD_TRIM    "শেষবাদ"
+#define ARRAY_STD_SUM     "যোগফল"
+#define ARRAY_STD_MIN     "ক্ষুদ্রতম"
+#define ARRAY_STD_MAX     "বৃহত্তম"
+#define ARRAY_STD_DOT     "ডট_গুণফল"
+#define ARRAY_STD_SCALE   "গুণিতক"
+#define ARRAY_STD_FILL    "ভরাট"
+#define ARRAY_STD_RANGE   "পরিসর"
+#define ARRAY_STD_MAP     "রূপান্তর"
+#define ARRAY_STD_FILTER  "ছাঁকো"
+#define ARRAY_STD_REDUCE  "ভাঁজ"
+#define ARRAY_STD_FOREACH "প্রতিটি"
+#define ARRAY_STD_SORT    "সাজাও"
+#define ARRAY_STD_SORT_BY "তুলনায়_সাজাও"
+#define ARRAY_STD_SLICE   "টুকরো"
+#define ARRAY_STD_CONCAT  "জোড়া"
+#define ARRAY_STD_EXTEND  "বিস্তার"
+#define ARRAY_STD_SPLICE  "বদল"
+#define ARRAY_STD_RESERVE "সংরক্ষণ"
+#define ARRAY_STD_CLEAR   "খালি_করো"
 
 void PushStdlibArray(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(ARRAY_STD_EXISTS, array_Exists, 2),
-        MakeStdlibEntry(ARRAY_STD_INDEX, array_Index, 2),
-        MakeStdlibEntry(ARRAY_STD_ADD, array_Add, 3),
-        MakeStdlibEntry(ARRAY_STD_DELETE, array_Delete, 2),
-        MakeStdlibEntry(ARRAY_STD_TRIM, array_Trim, 1),
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_EXISTS, array_Exists, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_INDEX, array_Index, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_ADD, array_Add, 3),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_DELETE, array_Delete, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_TRIM, array_Trim, 1),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SUM, array_Sum, 1),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_MIN, array_Min, 1),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_MAX, array_Max, 1),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_DOT, array_Dot, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SCALE, array_Scale, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_FILL, array_Fill, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_RANGE, array_Range, 3),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_MAP, array_Map, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_FILTER, array_Filter, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_REDUCE, array_Reduce, 3),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_FOREACH, array_ForEach, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SORT, array_Sort, 1),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SORT_BY, array_SortBy, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SLICE, array_Slice, 3),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_CONCAT, array_Concat, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_EXTEND, array_Extend, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_SPLICE, array_Splice, 4),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_RESERVE, array_Reserve, 2),
+        MakeStdlibEntry(ARRAY_STDLIB_NAME, ARRAY_STD_CLEAR, array_Clear, 1),
     };
 
     int count = ArrCount(entries);
 
-    PushStdlibEntries(vm, table, ARRAY_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
@@ -49,7 +49,7 @@ static PValue file_ReadAsString(PVm *vm, PValue *args, u64 argc) {
         return MakeNil();
     }
 
-    PObj *strObj = NewStrObject(vm->gc, NULL, fileStr, true);
+    PObj *strObj = NewStrObject(vm->gc, fileStr, true);
     if (strObj == NULL) {
         VmError(vm, RT_IME_STDFILE_READ_STR);
         return MakeNil();
@@ -132,14 +132,20 @@ static PValue file_CreateDir(PVm *vm, PValue *args, u64 argc) {
 #define FILE_STD_CREATE_DIR  "নতুন_ফোল্ডার"
 
 void PushStdlibFile(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(FILE_STD_EXISTS, file_Exists, 1),
-        MakeStdlibEntry(FILE_STD_READ, file_ReadAsString, 1),
-        MakeStdlibEntry(FILE_STD_WRITE, file_WriteStringToFile, 2),
-        MakeStdlibEntry(FILE_STD_CREATE_FILE, file_CreateFile, 1),
-        MakeStdlibEntry(FILE_STD_CREATE_DIR, file_CreateDir, 1),
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(MAP_STDLIB_NAME, FILE_STD_EXISTS, file_Exists, 1),
+        MakeStdlibEntry(MAP_STDLIB_NAME, FILE_STD_READ, file_ReadAsString, 1),
+        MakeStdlibEntry(
+            MAP_STDLIB_NAME, FILE_STD_WRITE, file_WriteStringToFile, 2
+        ),
+        MakeStdlibEntry(
+            MAP_STDLIB_NAME, FILE_STD_CREATE_FILE, file_CreateFile, 1
+        ),
+        MakeStdlibEntry(
+            MAP_STDLIB_NAME, FILE_STD_CREATE_DIR, file_CreateDir, 1
+        ),
     };
     int count = ArrCount(entries);
 
-    PushStdlibEntries(vm, table, MAP_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
@@ -533,7 +533,7 @@ static PValue gfx_LoadImage(PVm *vm, PValue *args, u64 argc) {
         VmError(vm, RT_IME_STDGFX_LOADIMG_FAILED_FETCH_IMAGE);
         return MakeNil();
     }
-    PObj *obj = NewStrObject(vm->gc, NULL, str, true);
+    PObj *obj = NewStrObject(vm->gc, str, true);
 
     if (obj == NULL) {
         VmError(vm, RT_IME_STDGFX_LOADIMG_FAILED_IMAGE_STR);
@@ -931,39 +931,58 @@ static PValue gfx_GetDelta(PVm *vm, PValue *args, u64 argc) {
 #define GFX_STD_DELTA               "ডেল্টা"
 
 void PushStdlibGraphics(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(GFX_STD_NEW, gfx_New, 3),
-        MakeStdlibEntry(GFX_STD_STOP, gfx_Stop, 0),
-        MakeStdlibEntry(GFX_STD_RUNNING, gfx_Running, 0),
-        MakeStdlibEntry(GFX_STD_DRAWSTART, gfx_DrawStart, 0),
-        MakeStdlibEntry(GFX_STD_DRAWFINISH, gfx_DrawFinish, 0),
-        MakeStdlibEntry(GFX_STD_LINE, gfx_DrawLine, 5),
-        MakeStdlibEntry(GFX_STD_PIXEL, gfx_DrawPixel, 3),
-        MakeStdlibEntry(GFX_STD_RECT, gfx_DrawRectangle, 5),
-        MakeStdlibEntry(GFX_STD_RECT_LINE, gfx_DrawRectangleLines, 6),
-        MakeStdlibEntry(GFX_STD_CIRCLE, gfx_DrawCircle, 4),
-        MakeStdlibEntry(GFX_STD_CIRCLE_LINE, gfx_DrawCircleLines, 5),
-        MakeStdlibEntry(GFX_STD_CLEAR, gfx_Clear, 0),
-        MakeStdlibEntry(GFX_STD_TEXT, gfx_DrawText, 5),
-        MakeStdlibEntry(GFX_STD_PRESSED, gfx_KeyPress, 1),
-        MakeStdlibEntry(GFX_STD_DOWN, gfx_KeyDown, 1),
-        MakeStdlibEntry(GFX_STD_RELEASED, gfx_KeyReleased, 1),
-        MakeStdlibEntry(GFX_STD_UP, gfx_KeyUp, 1),
-        MakeStdlibEntry(GFX_STD_LOAD_IMAGE, gfx_LoadImage, 1),
-        MakeStdlibEntry(GFX_STD_DRAW_IMAGE, gfx_DrawImage, 3),
-        MakeStdlibEntry(GFX_STD_MOUSE, gfx_GetMousePos, 0),
-        MakeStdlibEntry(GFX_STD_MOUSE_PRESSED, gfx_IsMouseButtonPressed, 1),
-        MakeStdlibEntry(GFX_STD_MOUSE_DOWN, gfx_IsMouseButtonDown, 1),
-        MakeStdlibEntry(GFX_STD_MOUSE_RELEASED, gfx_IsMouseButtonReleased, 1),
-        MakeStdlibEntry(GFX_STD_MOUSE_UP, gfx_IsMouseButtonUp, 1),
-        MakeStdlibEntry(GFX_STD_COLLIDE_RECT, gfx_Is2RectCollision, 8),
-        MakeStdlibEntry(GFX_STD_COLLIDE_POINTRECT, gfx_IsPointRectCollision, 6),
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_NEW, gfx_New, 3),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_STOP, gfx_Stop, 0),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_RUNNING, gfx_Running, 0),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_DRAWSTART, gfx_DrawStart, 0),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_DRAWFINISH, gfx_DrawFinish, 0),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_LINE, gfx_DrawLine, 5),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_PIXEL, gfx_DrawPixel, 3),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_RECT, gfx_DrawRectangle, 5),
         MakeStdlibEntry(
-            GFX_STD_COLLIDE_CIRCLE_RECT, gfx_IsCircleRectCollision, 7
+            GFX_STDLIB_NAME, GFX_STD_RECT_LINE, gfx_DrawRectangleLines, 6
         ),
-        MakeStdlibEntry(GFX_STD_DELTA, gfx_GetDelta, 0)
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_CIRCLE, gfx_DrawCircle, 4),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_CIRCLE_LINE, gfx_DrawCircleLines, 5
+        ),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_CLEAR, gfx_Clear, 0),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_TEXT, gfx_DrawText, 5),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_PRESSED, gfx_KeyPress, 1),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_DOWN, gfx_KeyDown, 1),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_RELEASED, gfx_KeyReleased, 1),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_UP, gfx_KeyUp, 1),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_LOAD_IMAGE, gfx_LoadImage, 1),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_DRAW_IMAGE, gfx_DrawImage, 3),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_MOUSE, gfx_GetMousePos, 0),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_MOUSE_PRESSED, gfx_IsMouseButtonPressed, 1
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_MOUSE_DOWN, gfx_IsMouseButtonDown, 1
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_MOUSE_RELEASED, gfx_IsMouseButtonReleased,
+            1
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_MOUSE_UP, gfx_IsMouseButtonUp, 1
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_COLLIDE_RECT, gfx_Is2RectCollision, 8
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_COLLIDE_POINTRECT,
+            gfx_IsPointRectCollision, 6
+        ),
+        MakeStdlibEntry(
+            GFX_STDLIB_NAME, GFX_STD_COLLIDE_CIRCLE_RECT,
+            gfx_IsCircleRectCollision, 7
+        ),
+        MakeStdlibEntry(GFX_STDLIB_NAME, GFX_STD_DELTA, gfx_GetDelta, 0)
     };
     int count = ArrCount(entries);
 
-    PushStdlibEntries(vm, table, GFX_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
@@ -114,13 +114,13 @@ static PValue map_Delete(PVm *vm, PValue *args, u64 argc) {
 #define MAP_STD_DELETE "বিয়োগ"
 
 void PushStdlibMap(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(MAP_STD_EXISTS, map_Exists, 2),
-        MakeStdlibEntry(MAP_STD_KEYS, map_Keys, 1),
-        MakeStdlibEntry(MAP_STD_VALUES, map_Values, 1),
-        MakeStdlibEntry(MAP_STD_DELETE, map_Delete, 2),
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(MAP_STDLIB_NAME, MAP_STD_EXISTS, map_Exists, 2),
+        MakeStdlibEntry(MAP_STDLIB_NAME, MAP_STD_KEYS, map_Keys, 1),
+        MakeStdlibEntry(MAP_STDLIB_NAME, MAP_STD_VALUES, map_Values, 1),
+        MakeStdlibEntry(MAP_STDLIB_NAME, MAP_STD_DELETE, map_Delete, 2),
     };
     int count = ArrCount(entries);
 
-    PushStdlibEntries(vm, table, MAP_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
@@ -271,37 +271,45 @@ static PValue math_Random(PVm *vm, PValue *args, u64 argc) {
 #define MATH_STD_E       "ই"
 #define MATH_STD_RANDOM  "এলোমেলো"
 
+bool StdlibMathIntrinsic(const char *name, u64 argc, PanOpCode *op) {
+    if (argc == 1 && StrEqual(name, MATH_STD_SQRT)) {
+        *op = OP_SQRT;
+        return true;
+    }
+    return false;
+}
+
 void PushStdlibMath(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(MATH_STD_SQRT, math_Sqrt, 1),
-        MakeStdlibEntry(MATH_STD_LOGTEN, math_Log10, 1),
-        MakeStdlibEntry(MATH_STD_LOG, math_Log, 1),
-        MakeStdlibEntry(MATH_STD_LOGBASE, math_LogBase, 2),
-        MakeStdlibEntry(MATH_STD_GCD, math_GCD, 2),
-        MakeStdlibEntry(MATH_STD_LCM, math_LCM, 2),
-        MakeStdlibEntry(MATH_STD_SINE, math_Sine, 1),
-        MakeStdlibEntry(MATH_STD_COSINE, math_Cosine, 1),
-        MakeStdlibEntry(MATH_STD_TANGENT, math_Tangent, 1),
-        MakeStdlibEntry(MATH_STD_DEGREE, math_Degree, 1),
-        MakeStdlibEntry(MATH_STD_RADIANS, math_Radians, 1),
-        MakeStdlibEntry(MATH_STD_NUM, math_Number, 1),
-        MakeStdlibEntry(MATH_STD_ABS, math_Abs, 1),
-        MakeStdlibEntry(MATH_STD_ROUND, math_Round, 1),
-        MakeStdlibEntry(MATH_STD_FLOOR, math_Floor, 1),
-        MakeStdlibEntry(MATH_STD_CEIL, math_Ceil, 1),
-        MakeStdlibEntry(MATH_STD_RANDOM, math_Random, 2)
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_SQRT, math_Sqrt, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_LOGTEN, math_Log10, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_LOG, math_Log, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_LOGBASE, math_LogBase, 2),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_GCD, math_GCD, 2),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_LCM, math_LCM, 2),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_SINE, math_Sine, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_COSINE, math_Cosine, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_TANGENT, math_Tangent, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_DEGREE, math_Degree, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_RADIANS, math_Radians, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_NUM, math_Number, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_ABS, math_Abs, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_ROUND, math_Round, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_FLOOR, math_Floor, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_CEIL, math_Ceil, 1),
+        MakeStdlibEntry(MATH_STDLIB_NAME, MATH_STD_RANDOM, math_Random, 2)
 
     };
     int count = ArrCount(entries);
 
-    PushStdlibEntries(vm, table, MATH_STDLIB_NAME, entries, count);
-    PObj *piNameObj = NewStrObject(vm->gc, NULL, MATH_STD_PI, false);
+    PushStdlibEntries(vm, table, entries, count);
+    PObj *piNameObj = NewStrObject(vm->gc, MATH_STD_PI, false);
     if (piNameObj == NULL) {
         VmError(vm, RT_IME_STDMATH_PI_STR);
         return;
     }
     VmPush(vm, MakeObject(piNameObj));
-    PObj *eNameObj = NewStrObject(vm->gc, NULL, MATH_STD_E, false);
+    PObj *eNameObj = NewStrObject(vm->gc, MATH_STD_E, false);
     if (eNameObj == NULL) {
         VmError(vm, RT_IME_STDMATH_E_STR);
         return;
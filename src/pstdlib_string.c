@@ -60,7 +60,7 @@ static PValue str_Index(PVm *vm, PValue *args, u64 argc) {
                 return MakeNil();
             }
 
-            PObj *obj = NewStrObject(vm->gc, NULL, emptyStr, true);
+            PObj *obj = NewStrObject(vm->gc, emptyStr, true);
             if (obj == NULL) {
                 VmError(vm, RT_IME_STDSTR_INDEX_RESULT_STR);
                 return MakeNil();
@@ -68,7 +68,7 @@ static PValue str_Index(PVm *vm, PValue *args, u64 argc) {
             return MakeObject(obj);
         }; // empty string
         case GR_ERR_OK: {
-            PObj *obj = NewStrObject(vm->gc, NULL, result, true);
+            PObj *obj = NewStrObject(vm->gc, result, true);
             if (obj == NULL) {
                 VmError(vm, RT_IME_STDSTR_INDEX_RESULT_STR);
                 return MakeNil();
@@ -105,7 +105,7 @@ static PValue str_Split(PVm *vm, PValue *args, u64 argc) {
 
     PValue *items = NULL;
     for (u64 i = 0; i < count; i++) {
-        PObj *tempStr = NewStrObject(vm->gc, NULL, result[i], true);
+        PObj *tempStr = NewStrObject(vm->gc, result[i], true);
         if (tempStr == NULL) {
             // we need to free the result and its substrings which were after
             // this specific substring
@@ -140,7 +140,7 @@ static PValue str_String(PVm *vm, PValue *args, u64 argc) {
         return MakeNil(); // error
     }
 
-    PObj *strObj = NewStrObject(vm->gc, NULL, str, true);
+    PObj *strObj = NewStrObject(vm->gc, str, true);
     if (strObj == NULL) {
         VmError(vm, RT_IME_STDSTR_STR_RESULT, ValueTypeToStr(target));
         return MakeNil();
@@ -153,12 +153,12 @@ static PValue str_String(PVm *vm, PValue *args, u64 argc) {
 #define STR_STD_STRING "পরিবর্তন"
 
 void PushStdlibString(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(STR_STD_INDEX, str_Index, 2),
-        MakeStdlibEntry(STR_STD_SPLIT, str_Split, 2),
-        MakeStdlibEntry(STR_STD_STRING, str_String, 1)
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(STRING_STDLIB_NAME, STR_STD_INDEX, str_Index, 2),
+        MakeStdlibEntry(STRING_STDLIB_NAME, STR_STD_SPLIT, str_Split, 2),
+        MakeStdlibEntry(STRING_STDLIB_NAME, STR_STD_STRING, str_String, 1)
     };
 
     int count = ArrCount(entries);
-    PushStdlibEntries(vm, table, STRING_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
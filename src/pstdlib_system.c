@@ -36,7 +36,7 @@ static PValue os_Name(PVm *vm, PValue *args, u64 argc) {
 #else
     char *name = SYS_UNKNOWN;
 #endif
-    PObj *nameStrObj = NewStrObject(vm->gc, NULL, name, false);
+    PObj *nameStrObj = NewStrObject(vm->gc, name, false);
     if (nameStrObj == NULL) {
         VmError(vm, RT_IME_STDSYS_NAME_STR);
         return MakeNil();
@@ -55,7 +55,7 @@ static PValue os_Arch(PVm *vm, PValue *args, u64 argc) {
 #else
     char *arch = SYS_UNKNOWN;
 #endif
-    PObj *archStrObj = NewStrObject(vm->gc, NULL, arch, false);
+    PObj *archStrObj = NewStrObject(vm->gc, arch, false);
     if (archStrObj == NULL) {
         VmError(vm, RT_IME_STDSYS_ARCH_STR);
         return MakeNil();
@@ -69,14 +69,14 @@ static PValue os_Username(PVm *vm, PValue *args, u64 argc) {
     char *username = GetOsUsername();
 #endif
     if (username != NULL) {
-        PObj *usernameStrObj = NewStrObject(vm->gc, NULL, username, false);
+        PObj *usernameStrObj = NewStrObject(vm->gc, username, false);
         if (usernameStrObj == NULL) {
             VmError(vm, RT_IME_STDSYS_USERNAME_STR);
             return MakeNil();
         }
         return MakeObject(usernameStrObj);
     }
-    PObj *unknownUserStrObj = NewStrObject(vm->gc, NULL, SYS_UNKNOWN, false);
+    PObj *unknownUserStrObj = NewStrObject(vm->gc, SYS_UNKNOWN, false);
     if (unknownUserStrObj == NULL) {
         VmError(vm, RT_IME_STDSYS_USERNAME_STR);
         return MakeNil();
@@ -90,14 +90,14 @@ static PValue os_HomeDir(PVm *vm, PValue *args, u64 argc) {
     char *homedir = GetHomeDir();
 #endif
     if (homedir != NULL) {
-        PObj *homeStrObj = NewStrObject(vm->gc, NULL, homedir, false);
+        PObj *homeStrObj = NewStrObject(vm->gc, homedir, false);
         if (homeStrObj == NULL) {
             VmError(vm, RT_IME_STDSYS_HOMEDIR_STR);
             return MakeNil();
         }
         return MakeObject(homeStrObj);
     }
-    PObj *unknownStrObj = NewStrObject(vm->gc, NULL, SYS_UNKNOWN, false);
+    PObj *unknownStrObj = NewStrObject(vm->gc, SYS_UNKNOWN, false);
     if (unknownStrObj == NULL) {
         VmError(vm, RT_IME_STDSYS_HOMEDIR_STR);
         return MakeNil();
@@ -111,7 +111,7 @@ static PValue os_CurDir(PVm *vm, PValue *args, u64 argc) {
     char *curdir = GetCurDir();
 #endif
     if (curdir != NULL) {
-        PObj *curDirStrObj = NewStrObject(vm->gc, NULL, curdir, false);
+        PObj *curDirStrObj = NewStrObject(vm->gc, curdir, false);
         PFree(curdir);
         if (curDirStrObj == NULL) {
             VmError(vm, RT_IME_STDSYS_CURDIR_STR);
@@ -119,7 +119,7 @@ static PValue os_CurDir(PVm *vm, PValue *args, u64 argc) {
         }
         return MakeObject(curDirStrObj);
     }
-    PObj *unknownStrObj = NewStrObject(vm->gc, NULL, SYS_UNKNOWN, false);
+    PObj *unknownStrObj = NewStrObject(vm->gc, SYS_UNKNOWN, false);
     if (unknownStrObj == NULL) {
         VmError(vm, RT_IME_STDSYS_CURDIR_STR);
         return MakeNil();
@@ -134,14 +134,14 @@ static PValue os_CurDir(PVm *vm, PValue *args, u64 argc) {
 #define OS_STD_CURDIR   "অবস্থান"
 
 void PushStdlibSystem(PVm *vm, SymbolTable *table) {
-    StdlibEntry entries[] = {
-        MakeStdlibEntry(OS_STD_NAME, os_Name, 0),
-        MakeStdlibEntry(OS_STD_ARCH, os_Arch, 0),
-        MakeStdlibEntry(OS_STD_USERNAME, os_Username, 0),
-        MakeStdlibEntry(OS_STD_HOMEDIR, os_HomeDir, 0),
-        MakeStdlibEntry(OS_STD_CURDIR, os_CurDir, 0),
+    static StdlibEntry entries[] = {
+        MakeStdlibEntry(SYSTEM_STDLIB_NAME, OS_STD_NAME, os_Name, 0),
+        MakeStdlibEntry(SYSTEM_STDLIB_NAME, OS_STD_ARCH, os_Arch, 0),
+        MakeStdlibEntry(SYSTEM_STDLIB_NAME, OS_STD_USERNAME, os_Username, 0),
+        MakeStdlibEntry(SYSTEM_STDLIB_NAME, OS_STD_HOMEDIR, os_HomeDir, 0),
+        MakeStdlibEntry(SYSTEM_STDLIB_NAME, OS_STD_CURDIR, os_CurDir, 0),
     };
 
     int count = ArrCount(entries);
-    PushStdlibEntries(vm, table, SYSTEM_STDLIB_NAME, entries, count);
+    PushStdlibEntries(vm, table, entries, count);
 }
@@ -0,0 +1,898 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Stack bytecode to register bytecode translator.
+//
+// The stack bytecode is walked once while keeping a model of the stack. Stack
+// item `n` lives in register `n`, but an item pushed by `OP_GET_LOCAL` or
+// `OP_CONST` is not copied to its register right away, it is remembered as
+// "same as register r" or "constant k" and used directly as an operand by the
+// instruction which consumes it. So `a + b` becomes a single `RG_ADD`, and a
+// following `OP_SET_LOCAL c` changes the destination of that `RG_ADD` to `c`.
+//
+// Items are copied to their own registers (materialized) when their register
+// has to hold the value : before jumps and jump targets, calls, array and map
+// literals, and when the register they refer to is about to be written.
+
+#include "regcode.h"
+#include "alloc.h"
+#include "external/stb/stb_ds.h"
+#include "object.h"
+#include "opcode.h"
+#include "printer.h"
+#include "ptypes.h"
+#include "terminal.h"
+#include "trace.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Where the value of a stack item is, while translating
+typedef enum RegItemKind {
+    // In its own register
+    RI_SLOT,
+    // Same as register `index`, copy is not made yet
+    RI_REG,
+    // Constant `index`, not loaded yet
+    RI_CONST,
+} RegItemKind;
+
+typedef struct RegItem {
+    RegItemKind kind;
+    u16 index;
+} RegItem;
+
+// Forward jump waiting for its target to be translated
+typedef struct RegJumpFix {
+    u32 pc;
+    u64 target;
+} RegJumpFix;
+
+typedef struct RegTranslator {
+    const PBytecode *bt;
+    PRegIns *code;
+    u64 *origin;
+    // Model of the stack
+    RegItem *items;
+    int depth;
+    // Instructions which are jump targets
+    bool *leader;
+    // Stack depth at jump targets, -1 if unknown
+    int *targetDepth;
+    // Register instruction index of stack instruction offsets
+    u32 *pcAt;
+    RegJumpFix *fixes;
+    // Backward jumps emitted so far
+    u32 loopCount;
+    // Stack instruction being translated
+    u64 offset;
+    // Last emitted instruction, if its destination can still be changed.
+    // -1 otherwise
+    i64 lastValue;
+    // False after unconditional jumps and returns, until next jump target
+    bool reachable;
+    bool failed;
+} RegTranslator;
+
+static u64 stackInsLength(const PBytecode *bt, u64 offset) {
+    PanOpCode op = (PanOpCode)bt->code[offset];
+    POpDefinition def = GetOpDefinition(op);
+    u64 len = 1;
+    for (u8 i = 0; i < def.operands; i++) {
+        len += def.operandWidths[i];
+    }
+
+    if (op == OP_CLOSURE) {
+        PObj *fn = ValueAsObj(bt->constPool[ReadU16(bt, offset + 1)]);
+        len += 2 * (u64)fn->v.OComFunction.upvalCount;
+    }
+
+    return len;
+}
+
+static void findLeaders(RegTranslator *t) {
+    const PBytecode *bt = t->bt;
+    u64 offset = 0;
+    while (offset < bt->codeCount) {
+        PanOpCode op = (PanOpCode)bt->code[offset];
+        u64 target = UINT64_MAX;
+        switch (op) {
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP:
+            case OP_POP_JUMP_IF_FALSE:
+            case OP_POP_JUMP_IF_TRUE:
+                target = offset + 3 + ReadU16(bt, offset + 1);
+                break;
+            case OP_LOOP: target = offset + 3 - ReadU16(bt, offset + 1); break;
+            default: break;
+        }
+
+        if (target != UINT64_MAX) {
+            if (target >= bt->codeCount) {
+                t->failed = true;
+                return;
+            }
+            t->leader[target] = true;
+        }
+        offset += stackInsLength(bt, offset);
+    }
+}
+
+static u32 emit(RegTranslator *t, PRegOp op, u16 a, u16 b, u16 c) {
+    arrput(t->code, ((PRegIns){.op = (u16)op, .a = a, .b = b, .c = c}));
+    arrput(t->origin, t->offset);
+    t->lastValue = -1;
+    return (u32)(arrlen(t->code) - 1);
+}
+
+// Emit an instruction which writes its result to register `a`, the
+// destination may later be changed by `OP_SET_LOCAL`
+static void emitValue(RegTranslator *t, PRegOp op, u16 a, u16 b, u16 c) {
+    t->lastValue = emit(t, op, a, b, c);
+}
+
+static void push(RegTranslator *t, RegItemKind kind, u16 index) {
+    if (t->depth >= (int)t->bt->maxStack) {
+        t->failed = true;
+        return;
+    }
+    t->items[t->depth++] = (RegItem){.kind = kind, .index = index};
+}
+
+// Copy stack item `i` to its own register
+static void materialize(RegTranslator *t, int i) {
+    RegItem *item = &t->items[i];
+    if (item->kind == RI_REG) {
+        emit(t, RG_MOVE, (u16)i, item->index, 0);
+    } else if (item->kind == RI_CONST) {
+        emit(t, RG_LOADK, (u16)i, item->index, 0);
+    }
+    item->kind = RI_SLOT;
+}
+
+static void materializeRange(RegTranslator *t, int from, int to) {
+    for (int i = from; i < to; i++) {
+        if (t->items[i].kind != RI_SLOT) {
+            materialize(t, i);
+        }
+    }
+}
+
+static void materializeAll(RegTranslator *t) {
+    materializeRange(t, 0, t->depth);
+}
+
+// Copy items which refer to register `reg`, before it is overwritten
+static void materializeAliases(RegTranslator *t, u16 reg) {
+    for (int i = 0; i < t->depth; i++) {
+        if (t->items[i].kind == RI_REG && t->items[i].index == reg) {
+            materialize(t, i);
+        }
+    }
+}
+
+static bool hasAliases(const RegTranslator *t, u16 reg) {
+    for (int i = 0; i < t->depth; i++) {
+        if (t->items[i].kind == RI_REG && t->items[i].index == reg) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// `RK` operand for stack item `i`
+static u16 rk(const RegTranslator *t, int i) {
+    const RegItem *item = &t->items[i];
+    switch (item->kind) {
+        case RI_SLOT: return (u16)i;
+        case RI_REG: return item->index;
+        case RI_CONST: return item->index | REG_CONST_BIT;
+    }
+    return (u16)i;
+}
+
+// Item `i` was just written by the last emitted instruction, which can
+// write somewhere else instead
+static bool canRetarget(const RegTranslator *t, int i) {
+    return t->lastValue >= 0 && t->lastValue == arrlen(t->code) - 1 &&
+           t->code[t->lastValue].a == (u16)i && t->items[i].kind == RI_SLOT;
+}
+
+static void recordTarget(RegTranslator *t, u64 target, int depth) {
+    if (t->targetDepth[target] < 0) {
+        t->targetDepth[target] = depth;
+    } else if (t->targetDepth[target] != depth) {
+        t->failed = true;
+    }
+}
+
+static void emitJumpTo(
+    RegTranslator *t, PRegOp op, u16 b, u16 c, u64 target, int depth
+) {
+    u32 pc = emit(t, op, 0, b, c);
+    arrput(t->fixes, ((RegJumpFix){.pc = pc, .target = target}));
+    recordTarget(t, target, depth);
+}
+
+static bool setJumpOffset(RegTranslator *t, u32 pc, u64 target) {
+    if (t->pcAt[target] == REG_PC_UNSET) {
+        return false;
+    }
+    i64 rel = (i64)t->pcAt[target] - (i64)(pc + 1);
+    if (rel < INT16_MIN || rel > INT16_MAX) {
+        return false;
+    }
+    t->code[pc].a = (u16)(i16)rel;
+    return true;
+}
+
+static PRegOp regArithOp(PanOpCode op) {
+    switch (op) {
+        case OP_ADD: return RG_ADD;
+        case OP_SUB: return RG_SUB;
+        case OP_MUL: return RG_MUL;
+        case OP_DIV: return RG_DIV;
+        case OP_MOD: return RG_MOD;
+        case OP_EXPONENT: return RG_POW;
+        case OP_EQUAL: return RG_EQ;
+        case OP_NOTEQUAL: return RG_NE;
+        case OP_GT: return RG_GT;
+        case OP_GTE: return RG_GE;
+        case OP_LT: return RG_LT;
+        case OP_LTE: return RG_LE;
+        default: return RG_ADD;
+    }
+}
+
+// Try to fuse the comparison just emitted with `OP_JUMP_IF_FALSE` at
+// `offset`. Only done when both paths pop the condition right away, which is
+// how `if` and `while` use it, so the result is never needed in a register
+static bool fuseCompareJump(RegTranslator *t, u64 offset, u64 target) {
+    const PBytecode *bt = t->bt;
+    int top = t->depth - 1;
+    if (!canRetarget(t, top) || bt->code[target] != OP_POP ||
+        offset + 3 >= bt->codeCount || bt->code[offset + 3] != OP_POP) {
+        return false;
+    }
+
+    PRegIns *last = &t->code[t->lastValue];
+    switch (last->op) {
+        case RG_EQ: last->op = RG_JMPF_EQ; break;
+        case RG_NE: last->op = RG_JMPF_NE; break;
+        case RG_GT: last->op = RG_JMPF_GT; break;
+        case RG_GE: last->op = RG_JMPF_GE; break;
+        case RG_LT: last->op = RG_JMPF_LT; break;
+        case RG_LE: last->op = RG_JMPF_LE; break;
+        default: return false;
+    }
+
+    last->a = 0;
+    arrput(t->fixes, ((RegJumpFix){.pc = (u32)t->lastValue, .target = target})
+    );
+    recordTarget(t, target, t->depth);
+    t->lastValue = -1;
+    return true;
+}
+
+static void setLocal(RegTranslator *t, u16 reg) {
+    int top = t->depth - 1;
+    RegItem value = t->items[top];
+    if (value.kind == RI_REG && value.index == reg) {
+        return;
+    }
+
+    if (canRetarget(t, top) && !hasAliases(t, reg)) {
+        t->code[t->lastValue].a = reg;
+        t->lastValue = -1;
+        t->items[reg].kind = RI_SLOT;
+        t->items[top] = (RegItem){.kind = RI_REG, .index = reg};
+        return;
+    }
+
+    materializeAliases(t, reg);
+    switch (value.kind) {
+        case RI_SLOT: emit(t, RG_MOVE, reg, (u16)top, 0); break;
+        case RI_REG: emit(t, RG_MOVE, reg, value.index, 0); break;
+        case RI_CONST: emit(t, RG_LOADK, reg, value.index, 0); break;
+    }
+    t->items[reg].kind = RI_SLOT;
+}
+
+static void translateIns(RegTranslator *t, u64 offset) {
+    const PBytecode *bt = t->bt;
+    PanOpCode op = (PanOpCode)bt->code[offset];
+    u16 arg = 0;
+    if (GetOpDefinition(op).operands > 0) {
+        arg = ReadU16(bt, offset + 1);
+    }
+    int top = t->depth - 1;
+
+    switch (op) {
+        case OP_CONST: {
+            if (arg <= REG_RK_MAX) {
+                push(t, RI_CONST, arg);
+            } else {
+                emitValue(t, RG_LOADK, (u16)t->depth, arg, 0);
+                push(t, RI_SLOT, 0);
+            }
+            break;
+        }
+        case OP_CONST_LONG: {
+            u32 index = ReadU24(bt, offset + 1);
+            emitValue(
+                t, RG_LOADK, (u16)t->depth, (u16)index, (u16)(index >> 16)
+            );
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_TRUE:
+        case OP_FALSE:
+        case OP_NIL: {
+            PRegOp rop = op == OP_TRUE    ? RG_LOADTRUE
+                         : op == OP_FALSE ? RG_LOADFALSE
+                                          : RG_LOADNIL;
+            emitValue(t, rop, (u16)t->depth, 0, 0);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_POP: {
+            t->depth--;
+            break;
+        }
+        case OP_DEBUG: {
+            emit(t, RG_PRINT, rk(t, top), 0, 0);
+            t->depth--;
+            break;
+        }
+
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL:
+        case OP_DIV:
+        case OP_MOD:
+        case OP_EXPONENT:
+        case OP_EQUAL:
+        case OP_NOTEQUAL:
+        case OP_GT:
+        case OP_GTE:
+        case OP_LT:
+        case OP_LTE: {
+            u16 b = rk(t, top - 1);
+            u16 c = rk(t, top);
+            t->depth -= 2;
+            emitValue(t, regArithOp(op), (u16)t->depth, b, c);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+
+        case OP_NEGATE:
+        case OP_NOT: {
+            u16 b = rk(t, top);
+            t->depth--;
+            emitValue(
+                t, op == OP_NEGATE ? RG_NEG : RG_NOT, (u16)t->depth, b, 0
+            );
+            push(t, RI_SLOT, 0);
+            break;
+        }
+
+        case OP_DEFINE_GLOBAL: {
+            emit(t, RG_DEFGLOBAL, rk(t, top), arg, 0);
+            t->depth--;
+            break;
+        }
+        case OP_GET_GLOBAL: {
+            emitValue(t, RG_GETGLOBAL, (u16)t->depth, arg, 0);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_SET_GLOBAL: {
+            emit(t, RG_SETGLOBAL, rk(t, top), arg, 0);
+            break;
+        }
+
+        case OP_GET_LOCAL: {
+            if (arg >= t->depth) {
+                t->failed = true;
+                return;
+            }
+            if (t->items[arg].kind != RI_SLOT) {
+                materialize(t, arg);
+            }
+            push(t, RI_REG, arg);
+            break;
+        }
+        case OP_SET_LOCAL: {
+            if (arg >= top) {
+                t->failed = true;
+                return;
+            }
+            setLocal(t, arg);
+            break;
+        }
+
+        case OP_GET_UPVAL: {
+            emitValue(t, RG_GETUPVAL, (u16)t->depth, arg, 0);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_SET_UPVAL: {
+            emit(t, RG_SETUPVAL, arg, rk(t, top), 0);
+            break;
+        }
+        case OP_GET_OUTER: {
+            emitValue(t, RG_GETOUTER, (u16)t->depth, arg, 0);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_SET_OUTER: {
+            emit(t, RG_SETOUTER, arg, rk(t, top), 0);
+            break;
+        }
+
+        case OP_JUMP_IF_FALSE: {
+            u64 target = offset + 3 + arg;
+            materializeRange(t, 0, top);
+            if (!fuseCompareJump(t, offset, target)) {
+                materialize(t, top);
+                emitJumpTo(t, RG_JMPF, (u16)top, 0, target, t->depth);
+            }
+            break;
+        }
+        case OP_POP_JUMP_IF_FALSE:
+        case OP_POP_JUMP_IF_TRUE: {
+            u64 target = offset + 3 + arg;
+            materializeAll(t);
+            emitJumpTo(
+                t, op == OP_POP_JUMP_IF_FALSE ? RG_JMPF : RG_JMPT, (u16)top,
+                0, target, t->depth
+            );
+            t->depth--;
+            break;
+        }
+        case OP_JUMP: {
+            materializeAll(t);
+            emitJumpTo(t, RG_JMP, 0, 0, offset + 3 + arg, t->depth);
+            t->reachable = false;
+            break;
+        }
+        case OP_LOOP: {
+            u64 target = offset + 3 - arg;
+            materializeAll(t);
+            if (t->loopCount >= UINT16_MAX) {
+                t->failed = true;
+                break;
+            }
+            u32 pc = emit(t, RG_JMP, 0, 0, (u16)t->loopCount++);
+            if (t->targetDepth[target] != t->depth ||
+                !setJumpOffset(t, pc, target)) {
+                t->failed = true;
+            }
+            t->reachable = false;
+            break;
+        }
+
+        case OP_CALL:
+        case OP_TAIL_CALL: {
+            materializeAll(t);
+            int base = t->depth - arg - 1;
+            emit(t, op == OP_CALL ? RG_CALL : RG_TAILCALL, (u16)base, arg, 0);
+            t->depth = base;
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_RETURN: {
+            emit(t, RG_RETURN, rk(t, top), 0, 0);
+            t->depth--;
+            t->reachable = false;
+            break;
+        }
+
+        case OP_CLOSURE: {
+            PObj *fn = ValueAsObj(bt->constPool[arg]);
+            i16 upvalCount = fn->v.OComFunction.upvalCount;
+            const u8 *desc = bt->code + offset + 3;
+            for (i16 i = 0; i < upvalCount; i++) {
+                if ((desc[i * 2] & CLOSURE_UPVAL_LOCAL) &&
+                    t->items[desc[i * 2 + 1]].kind != RI_SLOT) {
+                    materialize(t, desc[i * 2 + 1]);
+                }
+            }
+            emit(t, RG_CLOSURE, (u16)t->depth, arg, 0);
+            for (i16 i = 0; i < upvalCount; i++) {
+                emit(t, RG_UPVAL_DESC, desc[i * 2], desc[i * 2 + 1], 0);
+            }
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_CLS_UPVAL: {
+            if (t->items[top].kind != RI_SLOT) {
+                materialize(t, top);
+            }
+            emit(t, RG_CLOSE, (u16)top, 0, 0);
+            t->depth--;
+            break;
+        }
+
+        case OP_ARRAY:
+        case OP_MAP: {
+            int itemCount = op == OP_ARRAY ? arg : arg * 2;
+            int first = t->depth - itemCount;
+            materializeRange(t, first, t->depth);
+            emit(t, op == OP_ARRAY ? RG_NEWARRAY : RG_NEWMAP, (u16)first, arg, 0);
+            t->depth = first;
+            push(t, RI_SLOT, 0);
+            break;
+        }
+
+        case OP_SUBSCRIPT: {
+            u16 b = rk(t, top - 1);
+            u16 c = rk(t, top);
+            t->depth -= 2;
+            emitValue(t, RG_INDEX, (u16)t->depth, b, c);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+        case OP_SUBS_ASSIGN: {
+            emit(t, RG_SETINDEX, rk(t, top - 2), rk(t, top - 1), rk(t, top));
+            RegItem value = t->items[top];
+            t->depth -= 3;
+            // Assigned value is the result of the expression
+            bool popped = offset + 1 < bt->codeCount &&
+                          bt->code[offset + 1] == OP_POP &&
+                          !t->leader[offset + 1];
+            if (value.kind == RI_SLOT && !popped) {
+                emit(t, RG_MOVE, (u16)t->depth, (u16)top, 0);
+            } else if (value.kind == RI_REG && value.index >= t->depth) {
+                emit(t, RG_MOVE, (u16)t->depth, value.index, 0);
+                value.kind = RI_SLOT;
+            }
+            if (value.kind == RI_SLOT) {
+                push(t, RI_SLOT, 0);
+            } else {
+                push(t, value.kind, value.index);
+            }
+            break;
+        }
+
+        case OP_IMPORT: {
+            emit(t, RG_IMPORT, rk(t, top), arg, 0);
+            t->depth--;
+            break;
+        }
+        case OP_MODGET: {
+            u16 b = rk(t, top);
+            t->depth--;
+            emitValue(t, RG_MODGET, (u16)t->depth, b, arg);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+
+        case OP_LEN:
+        case OP_APPEND:
+        case OP_SQRT: {
+            int argc = op == OP_APPEND ? 2 : 1;
+            int base = t->depth - argc;
+            if (base < 0) {
+                t->failed = true;
+                return;
+            }
+            // The function may be called, which can change locals
+            for (int i = 0; i < base; i++) {
+                if (t->items[i].kind == RI_REG) {
+                    materialize(t, i);
+                }
+            }
+            u16 b = rk(t, base);
+            u16 c = argc == 2 ? rk(t, base + 1) : 0;
+            PRegOp rop = op == OP_LEN      ? RG_LEN
+                         : op == OP_APPEND ? RG_APPEND
+                                           : RG_SQRT;
+            t->depth = base;
+            emit(t, rop, (u16)base, b, c);
+            push(t, RI_SLOT, 0);
+            break;
+        }
+    }
+
+    if (t->depth < 0) {
+        t->failed = true;
+    }
+}
+
+static void freeTranslator(RegTranslator *t) {
+    PFree(t->items);
+    PFree(t->leader);
+    PFree(t->targetDepth);
+    PFree(t->pcAt);
+    arrfree(t->fixes);
+}
+
+PRegCode *RegTranslate(const PBytecode *bt, u64 paramCount) {
+    if (bt == NULL || bt->maxStack > REG_RK_MAX || bt->codeCount == 0 ||
+        paramCount + 1 > bt->maxStack) {
+        return NULL;
+    }
+
+    RegTranslator t = {0};
+    t.bt = bt;
+    t.items = PCreateArray(RegItem, bt->maxStack);
+    t.leader = PCalloc(bt->codeCount, sizeof(bool));
+    t.targetDepth = PCreateArray(int, bt->codeCount);
+    t.pcAt = PCreateArray(u32, bt->codeCount);
+    if (t.items == NULL || t.leader == NULL || t.targetDepth == NULL ||
+        t.pcAt == NULL) {
+        freeTranslator(&t);
+        return NULL;
+    }
+
+    for (u64 i = 0; i < bt->codeCount; i++) {
+        t.targetDepth[i] = -1;
+        t.pcAt[i] = REG_PC_UNSET;
+    }
+
+    // function itself and its parameters
+    t.depth = (int)paramCount + 1;
+    for (int i = 0; i < t.depth; i++) {
+        t.items[i] = (RegItem){.kind = RI_SLOT, .index = 0};
+    }
+    t.lastValue = -1;
+    t.reachable = true;
+    findLeaders(&t);
+
+    u64 offset = 0;
+    while (offset < bt->codeCount && !t.failed) {
+        u64 len = stackInsLength(bt, offset);
+        if (t.leader[offset]) {
+            t.offset = offset;
+            if (t.reachable) {
+                materializeAll(&t);
+                recordTarget(&t, offset, t.depth);
+            } else if (t.targetDepth[offset] >= 0) {
+                t.depth = t.targetDepth[offset];
+                for (int i = 0; i < t.depth; i++) {
+                    t.items[i].kind = RI_SLOT;
+                }
+                t.reachable = true;
+            }
+            t.lastValue = -1;
+        }
+
+        // Nothing jumps here, code after a jump or return is never run
+        if (!t.reachable) {
+            offset += len;
+            continue;
+        }
+
+        t.pcAt[offset] = (u32)arrlen(t.code);
+        t.offset = offset;
+        translateIns(&t, offset);
+        offset += len;
+    }
+
+    for (i64 i = 0; i < arrlen(t.fixes) && !t.failed; i++) {
+        if (!setJumpOffset(&t, t.fixes[i].pc, t.fixes[i].target)) {
+            t.failed = true;
+        }
+    }
+
+    PRegCode *rc = NULL;
+    PTraceLoop *loops = NULL;
+    if (!t.failed) {
+        rc = PCreate(PRegCode);
+        loops = PCalloc(t.loopCount + 1, sizeof(PTraceLoop));
+    }
+
+    if (rc == NULL || loops == NULL) {
+        PFree(rc);
+        PFree(loops);
+        arrfree(t.code);
+        arrfree(t.origin);
+        freeTranslator(&t);
+        return NULL;
+    }
+
+    rc->code = t.code;
+    rc->count = (u32)arrlen(t.code);
+    rc->origin = t.origin;
+    // Only jump targets have every stack value in its register, other
+    // instructions can't be entered from stack bytecode
+    for (u64 i = 0; i < bt->codeCount; i++) {
+        if (!t.leader[i]) {
+            t.pcAt[i] = REG_PC_UNSET;
+        }
+    }
+    rc->entry = t.pcAt;
+    t.pcAt = NULL;
+    rc->loopCount = t.loopCount;
+    rc->loops = loops;
+    freeTranslator(&t);
+    return rc;
+}
+
+void FreeRegCode(PRegCode *rc) {
+    if (rc == NULL) {
+        return;
+    }
+    arrfree(rc->code);
+    arrfree(rc->origin);
+    PFree(rc->entry);
+    for (u32 i = 0; i < rc->loopCount; i++) {
+        FreeTrace(rc->loops[i].trace);
+    }
+    PFree(rc->loops);
+    PFree(rc);
+}
+
+static const char *regOpNames[] = {
+    [RG_MOVE] = "Move",
+    [RG_LOADK] = "LoadK",
+    [RG_LOADNIL] = "LoadNil",
+    [RG_LOADTRUE] = "LoadTrue",
+    [RG_LOADFALSE] = "LoadFalse",
+    [RG_ADD] = "Add",
+    [RG_SUB] = "Sub",
+    [RG_MUL] = "Mul",
+    [RG_DIV] = "Div",
+    [RG_MOD] = "Mod",
+    [RG_POW] = "Pow",
+    [RG_EQ] = "Eq",
+    [RG_NE] = "Ne",
+    [RG_GT] = "Gt",
+    [RG_GE] = "Ge",
+    [RG_LT] = "Lt",
+    [RG_LE] = "Le",
+    [RG_NEG] = "Neg",
+    [RG_NOT] = "Not",
+    [RG_PRINT] = "Print",
+    [RG_DEFGLOBAL] = "DefGlobal",
+    [RG_GETGLOBAL] = "GetGlobal",
+    [RG_SETGLOBAL] = "SetGlobal",
+    [RG_GETUPVAL] = "GetUpval",
+    [RG_SETUPVAL] = "SetUpval",
+    [RG_GETOUTER] = "GetOuter",
+    [RG_SETOUTER] = "SetOuter",
+    [RG_JMP] = "Jmp",
+    [RG_JMPF] = "JmpF",
+    [RG_JMPT] = "JmpT",
+    [RG_JMPF_EQ] = "JmpFEq",
+    [RG_JMPF_NE] = "JmpFNe",
+    [RG_JMPF_GT] = "JmpFGt",
+    [RG_JMPF_GE] = "JmpFGe",
+    [RG_JMPF_LT] = "JmpFLt",
+    [RG_JMPF_LE] = "JmpFLe",
+    [RG_CALL] = "Call",
+    [RG_TAILCALL] = "TailCall",
+    [RG_RETURN] = "Return",
+    [RG_CLOSURE] = "Closure",
+    [RG_UPVAL_DESC] = "UpvalDesc",
+    [RG_CLOSE] = "Close",
+    [RG_NEWARRAY] = "NewArray",
+    [RG_NEWMAP] = "NewMap",
+    [RG_INDEX] = "Index",
+    [RG_SETINDEX] = "SetIndex",
+    [RG_IMPORT] = "Import",
+    [RG_MODGET] = "ModGet",
+    [RG_LEN] = "Len",
+    [RG_APPEND] = "Append",
+    [RG_SQRT] = "Sqrt",
+};
+
+static void printRK(u16 operand) {
+    if (operand & REG_CONST_BIT) {
+        PanPrint(" k%d", operand & REG_RK_MAX);
+    } else {
+        PanPrint(" r%d", operand);
+    }
+}
+
+void DebugRegCode(const PRegCode *rc, const PBytecode *bt) {
+    PanPrint("==== DEBUG REGISTER CODE ====\n");
+    for (u32 pc = 0; pc < rc->count; pc++) {
+        const PRegIns *ins = &rc->code[pc];
+        PanPrint("%s%05u %s", TermBlue(), pc, TermReset());
+        PanPrint("%s%s%s", TermGreen(), regOpNames[ins->op], TermReset());
+        switch ((PRegOp)ins->op) {
+            case RG_ADD:
+            case RG_SUB:
+            case RG_MUL:
+            case RG_DIV:
+            case RG_MOD:
+            case RG_POW:
+            case RG_EQ:
+            case RG_NE:
+            case RG_GT:
+            case RG_GE:
+            case RG_LT:
+            case RG_LE:
+            case RG_INDEX: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                printRK(ins->c);
+                break;
+            }
+            case RG_NEG:
+            case RG_NOT:
+            case RG_LEN:
+            case RG_SQRT: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                break;
+            }
+            case RG_APPEND: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                printRK(ins->c);
+                break;
+            }
+            case RG_SETUPVAL:
+            case RG_SETOUTER: {
+                PanPrint(" %d", ins->a);
+                printRK(ins->b);
+                break;
+            }
+            case RG_LOADNIL:
+            case RG_LOADTRUE:
+            case RG_LOADFALSE:
+            case RG_CLOSE: PanPrint(" r%d", ins->a); break;
+            case RG_PRINT:
+            case RG_RETURN: printRK(ins->a); break;
+            case RG_DEFGLOBAL:
+            case RG_SETGLOBAL:
+            case RG_IMPORT: {
+                printRK(ins->a);
+                PanPrint(" k%d", ins->b);
+                break;
+            }
+            case RG_SETINDEX: {
+                printRK(ins->a);
+                printRK(ins->b);
+                printRK(ins->c);
+                break;
+            }
+            case RG_MODGET: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                PanPrint(" k%d", ins->c);
+                break;
+            }
+            case RG_JMP:
+            case RG_JMPF:
+            case RG_JMPT:
+            case RG_JMPF_EQ:
+            case RG_JMPF_NE:
+            case RG_JMPF_GT:
+            case RG_JMPF_GE:
+            case RG_JMPF_LT:
+            case RG_JMPF_LE: {
+                PanPrint(" -> %05d", (int)pc + 1 + (i16)ins->a);
+                if (ins->op == RG_JMPF || ins->op == RG_JMPT) {
+                    PanPrint(" r%d", ins->b);
+                } else if (ins->op != RG_JMP) {
+                    printRK(ins->b);
+                    printRK(ins->c);
+                }
+                break;
+            }
+            case RG_LOADK: {
+                u32 index = ins->b | (u32)ins->c << 16;
+                PanPrint(" r%d k%u : ", ins->a, index);
+                PrintValue(bt->constPool[index]);
+                break;
+            }
+            case RG_GETGLOBAL:
+            case RG_CLOSURE: {
+                PanPrint(" r%d k%d : ", ins->a, ins->b);
+                PrintValue(bt->constPool[ins->b]);
+                break;
+            }
+            default: PanPrint(" %d %d %d", ins->a, ins->b, ins->c); break;
+        }
+        PanPrint("\n");
+    }
+    PanPrint("==== END REGISTER CODE ====\n");
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_REGCODE_H
+#define PANKTI_REGCODE_H
+
+#include "opcode.h"
+#include "ptypes.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Register bytecode, used by the register engine (`--engine register`).
+//
+// It is translated from the stack bytecode of a function when the function is
+// first called. A register is a slot of the function's frame, so register `n`
+// is the slot the stack bytecode would use at stack depth `n`. Locals are the
+// registers they are declared in, temporaries use the registers above them.
+//
+// Every instruction is three address : `a` is usually the destination, `b` and
+// `c` the sources. Source operands marked `RK` are either a register or, with
+// `REG_CONST_BIT` set, an index into the constant pool.
+
+// Set on an `RK` operand if it is a constant index
+#define REG_CONST_BIT 0x8000
+// Registers and constants which fit in an `RK` operand
+#define REG_RK_MAX 0x7fff
+// Stack bytecode offset with no register instruction
+#define REG_PC_UNSET UINT32_MAX
+
+typedef enum PRegOp {
+    // R(a) = R(b)
+    RG_MOVE = 0,
+    // R(a) = K(b | c << 16), `c` is 0 unless the constant index is past
+    // `UINT16_MAX`
+    RG_LOADK,
+    // R(a) = nil / true / false
+    RG_LOADNIL,
+    RG_LOADTRUE,
+    RG_LOADFALSE,
+    // R(a) = RK(b) op RK(c)
+    RG_ADD,
+    RG_SUB,
+    RG_MUL,
+    RG_DIV,
+    RG_MOD,
+    RG_POW,
+    RG_EQ,
+    RG_NE,
+    RG_GT,
+    RG_GE,
+    RG_LT,
+    RG_LE,
+    // R(a) = op RK(b)
+    RG_NEG,
+    RG_NOT,
+    // Print RK(a)
+    RG_PRINT,
+    // Define global with name K(b) as RK(a)
+    RG_DEFGLOBAL,
+    // R(a) = global with name K(b)
+    RG_GETGLOBAL,
+    // Global with name K(b) = RK(a)
+    RG_SETGLOBAL,
+    // R(a) = upvalue b
+    RG_GETUPVAL,
+    // Upvalue a = RK(b)
+    RG_SETUPVAL,
+    // R(a) = slot b of enclosing frame
+    RG_GETOUTER,
+    // Slot a of enclosing frame = RK(b)
+    RG_SETOUTER,
+    // Jump by signed offset a, relative to next instruction. `c` of backward
+    // jumps (loop back edges) is the loop number
+    RG_JMP,
+    // Jump by a if R(b) is falsy / truthy
+    RG_JMPF,
+    RG_JMPT,
+    // Jump by a unless RK(b) op RK(c). Comparison fused with the following
+    // conditional jump of `if` and `while`
+    RG_JMPF_EQ,
+    RG_JMPF_NE,
+    RG_JMPF_GT,
+    RG_JMPF_GE,
+    RG_JMPF_LT,
+    RG_JMPF_LE,
+    // Call R(a) with b arguments in R(a+1)..R(a+b), result goes to R(a)
+    RG_CALL,
+    // Same as `RG_CALL` but replaces current frame
+    RG_TAILCALL,
+    // Return RK(a)
+    RG_RETURN,
+    // R(a) = closure of function K(b). Followed by one `RG_UPVAL_DESC` for
+    // each upvalue of the function
+    RG_CLOSURE,
+    // Upvalue descriptor of previous `RG_CLOSURE`, `a` is the
+    // `CLOSURE_UPVAL_*` flags and `b` the index. Does nothing when run
+    RG_UPVAL_DESC,
+    // Close upvalues of R(a) and registers above it
+    RG_CLOSE,
+    // R(a) = array of b items in R(a)..R(a+b-1)
+    RG_NEWARRAY,
+    // R(a) = map of b key value pairs in R(a)..R(a+2b-1)
+    RG_NEWMAP,
+    // R(a) = RK(b)[RK(c)]
+    RG_INDEX,
+    // RK(a)[RK(b)] = RK(c)
+    RG_SETINDEX,
+    // Import module from path RK(a) with name K(b)
+    RG_IMPORT,
+    // R(a) = member K(c) of module RK(b)
+    RG_MODGET,
+    // R(a) = intrinsic of RK(b), or of RK(b) and RK(c). See `OP_LEN`. The
+    // function is called with the callee in R(a) and arguments after it when
+    // the intrinsic can't run, so `a` is never changed to another register
+    RG_LEN,
+    RG_APPEND,
+    RG_SQRT,
+} PRegOp;
+
+typedef struct PRegIns {
+    u16 op;
+    u16 a;
+    u16 b;
+    u16 c;
+} PRegIns;
+
+// Register bytecode of a function
+typedef struct PRegCode {
+    PRegIns *code;
+    u32 count;
+    // Offset of the stack bytecode instruction each register instruction was
+    // translated from, used to find position information for errors
+    u64 *origin;
+    // Register instruction of each stack bytecode offset which is a jump
+    // target, or `REG_PC_UNSET`. Stack bytecode at a loop head can continue
+    // from here, as all of its stack values are in their registers
+    u32 *entry;
+    // Loops, one for each back edge. See trace.h
+    u32 loopCount;
+    struct PTraceLoop *loops;
+} PRegCode;
+
+// Translate stack bytecode `bt` of a function with `paramCount` parameters to
+// register bytecode. Returns NULL if the function can't be translated (too
+// many registers or too long jumps)
+PRegCode *RegTranslate(const PBytecode *bt, u64 paramCount);
+// Free register bytecode
+void FreeRegCode(PRegCode *rc);
+// Print register bytecode
+void DebugRegCode(const PRegCode *rc, const PBytecode *bt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
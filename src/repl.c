@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "repl.h"
+#include "arena.h"
+#include "core.h"
+#include "diagonctx.h"
+#include "external/stb/stb_ds.h"
+#include "lexer.h"
+#include "parser.h"
+#include "printer.h"
+#include "ptypes.h"
+#include "terminal.h"
+#include "token.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Lines are read in pieces of this many bytes
+#define REPL_READ_SIZE 4096
+
+#define REPL_PROMPT      "> "
+#define REPL_MORE_PROMPT ".. "
+
+// First error of a chunk, see `ReplChunkComplete`
+typedef struct ReplCheck {
+    Parser *parser;
+    // Position of the end of file token
+    i64 eof;
+    bool hasError;
+    // The first error is at the end of the chunk, or was found looking for
+    // more tokens after its last one
+    bool atEnd;
+} ReplCheck;
+
+static void checkDiag(void *ctx, Token *tok, PanDiagCode code, va_list args) {
+    (void)code;
+    (void)args;
+    ReplCheck *rc = (ReplCheck *)ctx;
+    if (rc->hasError) {
+        return;
+    }
+    rc->hasError = true;
+    if (rc->parser != NULL) {
+        rc->atEnd = rc->parser->pos >= rc->eof ||
+                    (tok != NULL && tok == rc->parser->tokens[rc->eof]);
+    }
+}
+
+bool ReplChunkComplete(const char *text) {
+    PArena *arena = NewArena();
+    if (arena == NULL) {
+        return true;
+    }
+    // Raw lexer doesn't write to or free the text
+    Lexer *lx = NewLexer((char *)text, arena);
+    if (lx == NULL) {
+        FreeArena(arena);
+        return true;
+    }
+    MakeLexerRaw(lx, true);
+
+    ReplCheck rc = {0};
+    lx->errCtx = (PDiagonCtx){.report = checkDiag, .ctx = &rc};
+    ScanTokens(lx);
+
+    bool complete = true;
+    if (lx->openString) {
+        complete = false;
+    } else if (!rc.hasError) {
+        Parser *parser = NewParser(arena, lx);
+        if (parser != NULL) {
+            rc.parser = parser;
+            rc.eof = (i64)arrlen(lx->tokens) - 1;
+            parser->errCtx = (PDiagonCtx){.report = checkDiag, .ctx = &rc};
+            ParseParser(parser);
+            complete = !rc.atEnd;
+            FreeParser(parser);
+        }
+    }
+
+    FreeLexer(lx);
+    FreeArena(arena);
+    return complete;
+}
+
+// Append the next line of stdin to stb_ds array `chunk`, false at the end of
+// input
+static bool readLine(char **chunk) {
+    char buf[REPL_READ_SIZE];
+    bool read = false;
+    while (fgets(buf, sizeof(buf), stdin) != NULL) {
+        read = true;
+        u64 n = (u64)strlen(buf);
+        memcpy(arraddnptr(*chunk, n), buf, (size_t)n);
+        if (n > 0 && buf[n - 1] == '\n') {
+            break;
+        }
+    }
+
+    return read;
+}
+
+// Is line `line` of `len` bytes only spaces and a newline
+static bool isBlankLine(const char *line, u64 len) {
+    for (u64 i = 0; i < len; i++) {
+        if (line[i] != ' ' && line[i] != '\t' && line[i] != '\r' &&
+            line[i] != '\n') {
+            return false;
+        }
+    }
+    return true;
+}
+
+int RunRepl(bool regEngine) {
+    PanktiCore *core = NewSessionCore();
+    if (core == NULL) {
+        PanPrint("Error: Failed to initialize Pankti Runtime\n");
+        return EXIT_FAILURE;
+    }
+    core->regEngine = regEngine;
+
+    bool interactive = TermStdinIsTty();
+    char *chunk = NULL;
+    while (true) {
+        u64 lineStart = (u64)arrlen(chunk);
+        if (interactive) {
+            PanPrint("%s", lineStart == 0 ? REPL_PROMPT : REPL_MORE_PROMPT);
+            PanFlushStdout();
+        }
+        if (!readLine(&chunk)) {
+            break;
+        }
+
+        u64 len = (u64)arrlen(chunk);
+        bool forced = interactive && lineStart > 0 &&
+                      isBlankLine(chunk + lineStart, len - lineStart);
+        arrput(chunk, '\0');
+        if (!forced && !ReplChunkComplete(chunk)) {
+            arrsetlen(chunk, len);
+            continue;
+        }
+
+        RunCoreChunk(core, chunk, len);
+        arrsetlen(chunk, 0);
+    }
+
+    // What is left at the end of input is run for its errors
+    if (arrlen(chunk) > 0) {
+        RunCoreChunk(core, chunk, (u64)arrlen(chunk));
+    }
+    if (interactive) {
+        PanPrint("\n");
+    }
+
+    PanFlushStdout();
+    arrfree(chunk);
+    FreeCore(core);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_REPL_H
+#define PANKTI_REPL_H
+
+#include "ptypes.h"
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// REPL and batch evaluation.
+//
+// Code is read from stdin in chunks, each compiled and run in one session
+// core, see `NewSessionCore`, so a chunk sees globals, functions and imported
+// modules of the chunks before it. Builtins are registered and the GC is
+// created once for the whole session.
+//
+// A chunk is read line by line until it is complete, lines are added while
+// the parser stops at the end of them, such as in a function without its
+// `শেষ`, or while a string is left open. Errors of a chunk are printed and
+// the session goes on. Prompts are printed only if stdin is a terminal, where
+// an empty line also runs a chunk which is not complete, to show its errors.
+// Output is flushed after every chunk, so frontends can pipe code through it.
+
+// Is NUL terminated chunk `text` complete. A chunk which has errors other
+// than ending too early is complete, running it prints the errors
+bool ReplChunkComplete(const char *text);
+
+// Read and run chunks from stdin until end of input
+int RunRepl(bool regEngine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,16 +4,19 @@
 # file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 set(PANKTI_SRC_FILES
+  "${CMAKE_CURRENT_LIST_DIR}/arena.c"
   "${CMAKE_CURRENT_LIST_DIR}/argparse.c"
   "${CMAKE_CURRENT_LIST_DIR}/ast.c"
   "${CMAKE_CURRENT_LIST_DIR}/bengali.c"
   "${CMAKE_CURRENT_LIST_DIR}/builtins.c"
+  "${CMAKE_CURRENT_LIST_DIR}/check.c"
   "${CMAKE_CURRENT_LIST_DIR}/core.c"
   "${CMAKE_CURRENT_LIST_DIR}/diagonctx.c"
   "${CMAKE_CURRENT_LIST_DIR}/flags.c"
   "${CMAKE_CURRENT_LIST_DIR}/lexer.c"
   "${CMAKE_CURRENT_LIST_DIR}/parser.c"
   "${CMAKE_CURRENT_LIST_DIR}/printer.c"
+  "${CMAKE_CURRENT_LIST_DIR}/repl.c"
   "${CMAKE_CURRENT_LIST_DIR}/strescape.c"
   "${CMAKE_CURRENT_LIST_DIR}/strpool.c"
   "${CMAKE_CURRENT_LIST_DIR}/terminal.c"
@@ -25,14 +28,20 @@ set(PANKTI_SRC_FILES
   # Compiler Stuff
 
   "${CMAKE_CURRENT_LIST_DIR}/opcode.c"
+  "${CMAKE_CURRENT_LIST_DIR}/regcode.c"
   "${CMAKE_CURRENT_LIST_DIR}/compiler.c"
   "${CMAKE_CURRENT_LIST_DIR}/symtable.c"
   "${CMAKE_CURRENT_LIST_DIR}/vm.c"
+  "${CMAKE_CURRENT_LIST_DIR}/vm_stack.c"
+  "${CMAKE_CURRENT_LIST_DIR}/jit.c"
+  "${CMAKE_CURRENT_LIST_DIR}/trace.c"
 
   # Object
 
   "${CMAKE_CURRENT_LIST_DIR}/object.c"
   "${CMAKE_CURRENT_LIST_DIR}/object_array.c"
+  "${CMAKE_CURRENT_LIST_DIR}/object_array_num.c"
+  "${CMAKE_CURRENT_LIST_DIR}/object_array_sort.c"
   "${CMAKE_CURRENT_LIST_DIR}/object_map.c"
   "${CMAKE_CURRENT_LIST_DIR}/object_print.c"
   "${CMAKE_CURRENT_LIST_DIR}/object_tostring.c"
@@ -70,7 +79,9 @@ set(PANKTI_SRC_FILES
 
 set(PANKTI_HEADER_FILES
   "${CMAKE_CURRENT_LIST_DIR}/alloc.h"
+  "${CMAKE_CURRENT_LIST_DIR}/arena.h"
   "${CMAKE_CURRENT_LIST_DIR}/bengali.h"
+  "${CMAKE_CURRENT_LIST_DIR}/check.h"
   "${CMAKE_CURRENT_LIST_DIR}/core.h"
   "${CMAKE_CURRENT_LIST_DIR}/defaults.h"
   "${CMAKE_CURRENT_LIST_DIR}/gc.h"
@@ -79,6 +90,7 @@ set(PANKTI_HEADER_FILES
   "${CMAKE_CURRENT_LIST_DIR}/object.h"
   "${CMAKE_CURRENT_LIST_DIR}/parser.h"
   "${CMAKE_CURRENT_LIST_DIR}/pstdlib.h"
+  "${CMAKE_CURRENT_LIST_DIR}/repl.h"
   "${CMAKE_CURRENT_LIST_DIR}/strescape.h"
   "${CMAKE_CURRENT_LIST_DIR}/strpool.h"
   "${CMAKE_CURRENT_LIST_DIR}/terminal.h"
@@ -103,7 +103,7 @@ StrEscapeErr ProcessStringEscape(
     u64 wi = 0;
     StrEscapeErr err = SESC_OK;
 
-    while (ri < inlen || input[ri] != '\0') {
+    while (ri < inlen && input[ri] != '\0') {
         if (wi >= outlen - 1) {
             // We must have space for 1 char and '\0' NULL terminator
             return SESC_BUFFER_NOT_ENOUGH; // Buffer size not enough
@@ -63,7 +63,6 @@ PObj *StringPoolFind(PStringPool *sp, const char *val, u64 hash) {
     temp.type = OT_STR;
     temp.v.OString.value = (char *)val;
     temp.v.OString.hash = hash;
-    temp.v.OString.name = NULL;
 
     SPoolSet_itr it = SPoolSet_get(&sp->table, &temp);
     if (!SPoolSet_is_end(it)) {
@@ -91,6 +90,14 @@ bool StringPoolInsert(PStringPool *sp, PObj *strObj) {
     stringPoolInsertValue(sp, strObj);
     return true;
 }
+bool StringPoolReserve(PStringPool *sp, u64 count) {
+    if (sp == NULL) {
+        return false;
+    }
+
+    return SPoolSet_reserve(&sp->table, (size_t)count);
+}
+
 bool StringPoolRemove(PStringPool *sp, PObj *strObj) {
     if (sp == NULL || strObj == NULL) {
         return false;
@@ -40,6 +40,8 @@ PObj *StringPoolFind(PStringPool *sp, const char *val, u64 hash);
 
 // Insert new String object to pool
 bool StringPoolInsert(PStringPool *sp, PObj *strObj);
+// Make room for `count` strings in all
+bool StringPoolReserve(PStringPool *sp, u64 count);
 // Remove String from pool
 bool StringPoolRemove(PStringPool *sp, PObj *strObj);
 // Remove Unmarked String objects from pool
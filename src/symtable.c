@@ -36,6 +36,7 @@ SymbolTable *NewSymbolTable(void) {
         return NULL;
     }
     table->count = 0;
+    table->version = 0;
     SymTable_init(&table->table);
     return table;
 }
@@ -66,6 +67,7 @@ static inline void symbolTableInsertValue(
     // NOLINENEXTLINE
     SymTable_insert(&table->table, obj, value);
     table->count = SymbolTableGetCount(table);
+    table->version++;
 }
 // NOLINTEND
 
@@ -127,6 +129,30 @@ bool SymbolTableSet(SymbolTable *table, PObj *str, PValue value) {
     }
 }
 
+bool SymbolTableReserve(SymbolTable *table, u64 count) {
+    if (table == NULL) {
+        return false;
+    }
+
+    if (!SymTable_reserve(&table->table, (size_t)count)) {
+        return false;
+    }
+    table->version++;
+    return true;
+}
+
+PValue *SymbolTableSlot(SymbolTable *table, PObj *str) {
+    if (table == NULL || str == NULL || str->type != OT_STR) {
+        return NULL;
+    }
+
+    SymTable_itr it = SymTable_get(&table->table, str);
+    if (SymTable_is_end(it)) {
+        return NULL;
+    }
+    return &it.data->val;
+}
+
 // NOLINTEND
 bool SymbolTableRemove(SymbolTable *table, PObj *str) {
     if (table == NULL || str == NULL) {
@@ -138,6 +164,7 @@ bool SymbolTableRemove(SymbolTable *table, PObj *str) {
     }
 
     SymTable_erase(&table->table, str);
+    table->version++;
     return true;
 }
 bool SymbolTableAddAll(SymbolTable *from, SymbolTable *to) {
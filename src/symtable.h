@@ -31,6 +31,9 @@ typedef struct Pgc Pgc;
 typedef struct SymbolTable {
     SymTable table;
     u64 count;
+    // Changes whenever entries may move (a key is added or removed). Value
+    // pointers from `SymbolTableSlot` stay valid while it is the same
+    u64 version;
 } SymbolTable;
 
 SymbolTable *NewSymbolTable(void);
@@ -39,6 +42,11 @@ u64 SymbolTableGetCount(const SymbolTable *table);
 bool SymbolTableHasKey(const SymbolTable *table, PObj *str);
 PValue SymbolTableFind(SymbolTable *table, PObj *str, bool *found);
 bool SymbolTableSet(SymbolTable *table, PObj *str, PValue value);
+// Make room for `count` keys in all, so adding up to that many doesn't grow
+// the table again
+bool SymbolTableReserve(SymbolTable *table, u64 count);
+// Where the value of `str` is stored, NULL if there is no such key
+PValue *SymbolTableSlot(SymbolTable *table, PObj *str);
 bool SymbolTableRemove(SymbolTable *table, PObj *str);
 bool SymbolTableAddAll(SymbolTable *from, SymbolTable *to);
 void DebugSymbolTable(SymbolTable *table);
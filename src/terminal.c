@@ -33,11 +33,13 @@
 #include <io.h>
 #include <windows.h>
 #define PAN_ISATTY(fd) _isatty(fd)
+#define PAN_STDIN_FD   0
 #define PAN_STDERR_FD  2
 #define PAN_STDOUT_FD  1
 #else
 #include <unistd.h>
 #define PAN_ISATTY(fd) isatty(fd)
+#define PAN_STDIN_FD   STDIN_FILENO
 #define PAN_STDERR_FD  STDERR_FILENO
 #define PAN_STDOUT_FD  STDOUT_FILENO
 #endif
@@ -105,6 +107,8 @@ void InitTermInfo(void) {
 
 PTermInfo GetTermInfo(void) { return pantermInfo; }
 
+bool TermStdinIsTty(void) { return PAN_ISATTY(PAN_STDIN_FD) != 0; }
+
 const char *TermColor(const char *color) {
     return pantermInfo.color ? color : "";
 }
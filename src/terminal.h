@@ -21,6 +21,8 @@ typedef struct PTermInfo {
 
 PTermInfo GetTermInfo(void);
 void InitTermInfo(void);
+// Is stdin a terminal, someone typing rather than a pipe or a file
+bool TermStdinIsTty(void);
 
 const char *TermColor(const char *color);
 
@@ -8,9 +8,11 @@
 
 #include "token.h"
 #include "alloc.h"
+#include "arena.h"
 #include "printer.h"
 #include "terminal.h"
 #include <stdbool.h>
+#include <string.h>
 
 char *TokTypeToStr(PTokenType type) {
     switch (type) {
@@ -79,14 +81,17 @@ Token *NewToken(PTokenType type) {
         return NULL;
     }
 
-    tok->lexeme = NULL;
-    tok->type = type;
-    tok->line = 0;
-    tok->hash = 0;
-    tok->gcol = 0;
-    tok->glen = 0;
-    tok->index = 0;
+    *tok = (Token){.type = type};
+    return tok;
+}
+
+Token *NewArenaToken(PArena *arena, PTokenType type) {
+    Token *tok = ArenaAlloc(arena, sizeof(Token));
+    if (tok == NULL) {
+        return NULL;
+    }
 
+    *tok = (Token){.type = type};
     return tok;
 }
 
@@ -146,28 +151,31 @@ static const char *getLexeme(const Token *t) {
     }
 }
 
+static int lexemeLen(const Token *t) {
+    return t->lexeme != NULL ? (int)t->len : (int)strlen(getLexeme(t));
+}
+
 void PrintToken(const Token *token) {
     PanPrint(
-        "%03llu | Token[ " // token index
-        "%s%llu:%llu%s | " // token line: token column (grapheme based)
+        "Token[ "          // token
+        "%s%llu:%llu%s | " // token line: token column (byte based)
         "%s%s%s : '"       // TokenType
-        "%s%s%s"           // Lexeme
-        "' (%s%ld%s) ]",   // Token Lexeme Length
-        (unsigned long long)token->index,
+        "%s%.*s%s"         // Lexeme
+        "' (%s%llu%s) ]",  // Token Lexeme Length
 
         TermBlue(), (unsigned long long)token->line,
-        (unsigned long long)token->gcol, // token line:col (clr: blue)
+        (unsigned long long)token->col, // token line:col (clr: blue)
         TermReset(),
 
         TermPurple(),
         TokTypeToStr(token->type), // token type (clr: purple)
         TermReset(),
 
-        TermGreen(),
+        TermGreen(), lexemeLen(token),
         getLexeme(token), // token lexeme (clr: green)
         TermReset(),
 
-        TermBlue(), token->glen, TermReset()
+        TermBlue(), (unsigned long long)token->len, TermReset()
     );
 }
 
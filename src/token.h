@@ -131,37 +131,35 @@ void PrintTokType(PTokenType type);
 bool IsDoubleTok(PTokenType type);
 
 // Token Object
+// 24 bytes, a script has a lot of them
 typedef struct Token {
-    // Token Type
-    PTokenType type;
-    // Optional Lexeme : Referenced from source directly using string indexing.
-    // Only used for Keywords, identifiers, strings, numbers.
+    // Optional Lexeme : Slice of the source, `len` bytes long and not NUL
+    // terminated. Only used for Keywords, identifiers, strings, numbers.
     // Can be NULL
     char *lexeme;
+    // Token Type
+    PTokenType type;
     // Line number
-    u64 line;
-    // Column number. Distance from first character of the line
-    u64 col;
+    u32 line;
+    // Column number. Distance from first character of the line in bytes, 1
+    // based. Grapheme based columns are found from it when an error is
+    // printed, see `LineIndexGraphemeCol`
+    u32 col;
     // length of the token lexeme, if lexeme is optional depends of how many
     // characters the token contains need. For example, T_EQ is 1, T_EQEQ is 2
-    u64 len;
-    // Grapheme based column number
-    u64 gcol;
-    // Grapheme based length
-    u64 glen;
-    // Hash for the token lexeme. expect for Keywords, identifiers, strings,
-    // numbers it will be 0 (zero)
-    u64 hash;
-    // This token <index>th token in the script
-    u64 index;
+    u32 len;
 } Token;
 
+typedef struct PArena PArena;
+
 // Create an empty token.
 // `type` = Token type
 Token *NewToken(PTokenType type);
-// Free the token object
+// Create an empty token in `arena`, it is freed with the arena
+Token *NewArenaToken(PArena *arena, PTokenType type);
+// Free the token object. Only for tokens created with `NewToken`
 void FreeToken(Token *token);
-// Set token lexeme. Calculate and set hash.
+// Set token lexeme.
 bool SetTokenLexeme(Token *token, char *str);
 // Print Token
 void PrintToken(const Token *token);
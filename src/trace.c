@@ -0,0 +1,732 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Loop trace recorder and trace interpreter, see trace.h.
+//
+// The recorder runs one iteration instruction by instruction, calling into
+// the VM for everything but jumps. Before each instruction it looks at the
+// values of its operands : arithmetic and comparisons on numbers, globals
+// which exist and indexing arrays with numbers get specialized trace
+// instructions, anything else is run the normal way by `TR_STEP`. Conditional
+// jumps become guards for the direction they took.
+//
+// Which registers hold numbers is tracked through the iteration, so each
+// register is checked once before its first use, and not at all after an
+// instruction which made it a number. Every iteration starts knowing nothing,
+// same as the recording did.
+
+#include "trace.h"
+#include "alloc.h"
+#include "external/stb/stb_ds.h"
+#include "object.h"
+#include "printer.h"
+#include "ptypes.h"
+#include "symtable.h"
+#include "terminal.h"
+#include "utils.h"
+#include "vm.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct TraceRecorder {
+    PVm *vm;
+    PTraceIns *code;
+    // Registers known to hold a number at this point of the iteration
+    bool *isNum;
+    u32 regCount;
+    const PValue *regs;
+    const PValue *consts;
+} TraceRecorder;
+
+static void emit(TraceRecorder *r, PTraceIns ins) { arrput(r->code, ins); }
+
+static PValue recRK(const TraceRecorder *r, u16 x) {
+    return (x & REG_CONST_BIT) ? r->consts[x & REG_RK_MAX] : r->regs[x];
+}
+
+static bool recIsNum(const TraceRecorder *r, u16 x) {
+    return IsValueNum(recRK(r, x));
+}
+
+static void setNum(TraceRecorder *r, u16 reg, bool isNum) {
+    if (reg < r->regCount) {
+        r->isNum[reg] = isNum;
+    }
+}
+
+static void forgetAll(TraceRecorder *r) {
+    for (u32 i = 0; i < r->regCount; i++) {
+        r->isNum[i] = false;
+    }
+}
+
+// Number operand `x` of instruction `pc`. Registers not known to be numbers
+// are guarded
+static void guardNum(TraceRecorder *r, u16 x, u32 pc) {
+    if ((x & REG_CONST_BIT) || (x < r->regCount && r->isNum[x])) {
+        return;
+    }
+    emit(r, (PTraceIns){.op = TR_GUARD_NUM, .a = x, .exit = pc});
+    setNum(r, x, true);
+}
+
+// Record value instruction `ins` at `pc`, before it is run
+static void recordValueIns(TraceRecorder *r, const PRegIns *ins, u32 pc) {
+    PRegOp op = (PRegOp)ins->op;
+    switch (op) {
+        case RG_MOVE: {
+            emit(r, (PTraceIns){.op = TR_MOVE, .a = ins->a, .b = ins->b});
+            setNum(r, ins->a, ins->b < r->regCount && r->isNum[ins->b]);
+            return;
+        }
+        case RG_LOADK:
+        case RG_LOADNIL:
+        case RG_LOADTRUE:
+        case RG_LOADFALSE: {
+            u32 index = ins->b | (u32)ins->c << 16;
+            PValue k = op == RG_LOADK      ? r->consts[index]
+                       : op == RG_LOADNIL  ? MakeNil()
+                       : op == RG_LOADTRUE ? MakeBool(true)
+                                           : MakeBool(false);
+            emit(r, (PTraceIns){.op = TR_LOADK, .a = ins->a, .as.k = k});
+            setNum(r, ins->a, IsValueNum(k));
+            return;
+        }
+        case RG_ADD:
+        case RG_SUB:
+        case RG_MUL:
+        case RG_DIV:
+        case RG_MOD:
+        case RG_EQ:
+        case RG_NE:
+        case RG_GT:
+        case RG_GE:
+        case RG_LT:
+        case RG_LE: {
+            if (!recIsNum(r, ins->b) || !recIsNum(r, ins->c)) {
+                break;
+            }
+            guardNum(r, ins->b, pc);
+            guardNum(r, ins->c, pc);
+            u8 trOp = op <= RG_MOD ? (u8)(TR_ADD + (op - RG_ADD))
+                                   : (u8)(TR_EQ + (op - RG_EQ));
+            emit(
+                r, (PTraceIns){.op = trOp,
+                               .a = ins->a,
+                               .b = ins->b,
+                               .c = ins->c,
+                               .exit = pc}
+            );
+            setNum(r, ins->a, op <= RG_MOD);
+            return;
+        }
+        case RG_NEG: {
+            if (!recIsNum(r, ins->b)) {
+                break;
+            }
+            guardNum(r, ins->b, pc);
+            emit(r, (PTraceIns){.op = TR_NEG, .a = ins->a, .b = ins->b});
+            setNum(r, ins->a, true);
+            return;
+        }
+        case RG_GETGLOBAL:
+        case RG_SETGLOBAL: {
+            // Writing it turns intrinsics off, which `TR_SETGLOBAL` doesn't
+            if (op == RG_SETGLOBAL &&
+                ValueAsObj(r->consts[ins->b])->v.OString.intrinsic) {
+                break;
+            }
+            PValue *slot =
+                SymbolTableSlot(r->vm->globals, ValueAsObj(r->consts[ins->b]));
+            // Undefined, let it report the error
+            if (slot == NULL) {
+                break;
+            }
+            emit(
+                r, (PTraceIns){.op = op == RG_GETGLOBAL ? TR_GETGLOBAL
+                                                        : TR_SETGLOBAL,
+                               .a = ins->a,
+                               .exit = pc,
+                               .as.slot = slot}
+            );
+            if (op == RG_GETGLOBAL) {
+                setNum(r, ins->a, false);
+            }
+            return;
+        }
+        case RG_INDEX: {
+            if (!IsValueObjType(recRK(r, ins->b), OT_ARR) ||
+                !recIsNum(r, ins->c)) {
+                break;
+            }
+            guardNum(r, ins->c, pc);
+            emit(
+                r, (PTraceIns){.op = TR_INDEX,
+                               .a = ins->a,
+                               .b = ins->b,
+                               .c = ins->c,
+                               .exit = pc}
+            );
+            setNum(r, ins->a, false);
+            return;
+        }
+        case RG_LEN:
+        case RG_APPEND:
+        case RG_SQRT: {
+            // Calls the function, see below
+            if (r->vm->intrinsicsOff) {
+                break;
+            }
+            emit(
+                r, (PTraceIns){.op = TR_INTRINSIC,
+                               .a = ins->a,
+                               .b = ins->b,
+                               .c = ins->c,
+                               .exit = pc,
+                               .as.ins = ins}
+            );
+            setNum(r, ins->a, true);
+            return;
+        }
+        default: break;
+    }
+
+    emit(r, (PTraceIns){.op = TR_STEP, .as.ins = ins});
+    switch (op) {
+        // Callee may change any register, through upvalues or as an outer
+        // frame of a direct function
+        case RG_CALL:
+        case RG_LEN:
+        case RG_APPEND:
+        case RG_SQRT:
+        case RG_SETUPVAL: forgetAll(r); break;
+        // No register written
+        case RG_PRINT:
+        case RG_DEFGLOBAL:
+        case RG_SETGLOBAL:
+        case RG_SETOUTER:
+        case RG_CLOSE:
+        case RG_SETINDEX:
+        case RG_IMPORT: break;
+        default: setNum(r, ins->a, false); break;
+    }
+}
+
+static bool numCompare(PRegOp op, double b, double c) {
+    switch (op) {
+        case RG_JMPF_EQ: return b == c;
+        case RG_JMPF_NE: return b != c;
+        case RG_JMPF_GT: return b > c;
+        case RG_JMPF_GE: return b >= c;
+        case RG_JMPF_LT: return b < c;
+        case RG_JMPF_LE: return b <= c;
+        default: return false;
+    }
+}
+
+// Record conditional jump `ins` at `pc`, and find out if it jumps. Returns
+// false if an error was reported
+static bool recordBranch(
+    TraceRecorder *r, const PRegIns *ins, u32 pc, bool *jump
+) {
+    PRegOp op = (PRegOp)ins->op;
+    if (op == RG_JMPF || op == RG_JMPT) {
+        bool truthy = IsValueTruthy(r->regs[ins->b]);
+        emit(
+            r, (PTraceIns){.op = TR_GUARD_TRUTHY,
+                           .expect = truthy,
+                           .a = ins->b,
+                           .exit = pc}
+        );
+        *jump = truthy == (op == RG_JMPT);
+        return true;
+    }
+
+    if (recIsNum(r, ins->b) && recIsNum(r, ins->c)) {
+        guardNum(r, ins->b, pc);
+        guardNum(r, ins->c, pc);
+        bool result = numCompare(
+            op, ValueAsNum(recRK(r, ins->b)), ValueAsNum(recRK(r, ins->c))
+        );
+        emit(
+            r, (PTraceIns){.op = (u8)(TR_GUARD_EQ + (op - RG_JMPF_EQ)),
+                           .expect = result,
+                           .b = ins->b,
+                           .c = ins->c,
+                           .exit = pc}
+        );
+        *jump = !result;
+        return true;
+    }
+
+    if (!VmRegBranch(r->vm, ins, jump)) {
+        return false;
+    }
+    emit(
+        r, (PTraceIns){.op = TR_GUARD_BRANCH,
+                       .expect = *jump,
+                       .exit = pc,
+                       .as.ins = ins}
+    );
+    return true;
+}
+
+bool TraceRecord(PVm *vm, PTraceLoop *loop, u32 head, u32 back) {
+    int frameIndex = vm->frameCount - 1;
+    PCallFrame *frame = &vm->frames[frameIndex];
+    const PBytecode *bt = frame->fn->v.OComFunction.code;
+    const PRegIns *code = bt->reg->code;
+    u64 globalsVersion = vm->globals->version;
+
+    TraceRecorder r = {
+        .vm = vm,
+        .code = NULL,
+        .isNum = PCalloc(bt->maxStack, sizeof(bool)),
+        .regCount = bt->maxStack,
+        .regs = frame->slots,
+        .consts = bt->constPool,
+    };
+    if (r.isNum == NULL) {
+        loop->hits = TRACE_NEVER;
+        return true;
+    }
+
+    u32 pc = head;
+    bool done = false;
+    bool ok = true;
+    while (!done && arrlen(r.code) < TRACE_MAX_LENGTH) {
+        const PRegIns *ins = &code[pc];
+        u32 next = pc + 1;
+#if defined(PANKTI_BUILD_DEBUG)
+        vm->insCount++;
+#endif
+        switch ((PRegOp)ins->op) {
+            case RG_JMP: {
+                if (pc == back) {
+                    emit(&r, (PTraceIns){.op = TR_LOOP});
+                    next = head;
+                    done = true;
+                } else if ((i16)ins->a < 0) {
+                    // Inner loops are not unrolled
+                    next = pc;
+                } else {
+                    next = pc + 1 + (u32)(i16)ins->a;
+                }
+                break;
+            }
+            case RG_JMPF:
+            case RG_JMPT:
+            case RG_JMPF_EQ:
+            case RG_JMPF_NE:
+            case RG_JMPF_GT:
+            case RG_JMPF_GE:
+            case RG_JMPF_LT:
+            case RG_JMPF_LE: {
+                bool jump = false;
+                if (!recordBranch(&r, ins, pc, &jump)) {
+                    ok = false;
+                    break;
+                }
+                if (jump) {
+                    next = (u32)((i64)pc + 1 + (i16)ins->a);
+                }
+                break;
+            }
+            // Leave the loop
+            case RG_TAILCALL:
+            case RG_RETURN: next = pc; break;
+            default: {
+                recordValueIns(&r, ins, pc);
+                if (!VmRegStep(vm, ins)) {
+                    ok = false;
+                    break;
+                }
+                if (ins->op == RG_CLOSURE) {
+                    next += ValueAsObj(r.consts[ins->b])
+                                ->v.OComFunction.upvalCount;
+                }
+                break;
+            }
+        }
+
+        // Stopped at `pc`, or left the loop. The frame continues from there
+        if (!ok || next == pc || next < head || next > back) {
+            break;
+        }
+        pc = next;
+    }
+
+    PFree(r.isNum);
+    if (!ok) {
+        arrfree(r.code);
+        return false;
+    }
+
+    frame = &vm->frames[frameIndex];
+    // Globals moved while recording, slots recorded before that are stale
+    if (done && vm->globals->version != globalsVersion) {
+        done = false;
+        pc = head;
+    }
+    if (!done) {
+        arrfree(r.code);
+        frame->rip = code + pc;
+        loop->hits = ++loop->aborts >= TRACE_MAX_ABORTS ? TRACE_NEVER : 0;
+        return true;
+    }
+
+    PTrace *trace = PCreate(PTrace);
+    if (trace == NULL) {
+        arrfree(r.code);
+        loop->hits = TRACE_NEVER;
+        frame->rip = code + head;
+        return true;
+    }
+    trace->code = r.code;
+    trace->count = (u32)arrlen(r.code);
+    trace->head = head;
+    trace->globalsVersion = globalsVersion;
+    loop->trace = trace;
+    frame->rip = code + head;
+    return true;
+}
+
+#define TRACE_RK(x)                                                            \
+    (((x) & REG_CONST_BIT) ? consts[(x) & REG_RK_MAX] : regs[(x)])
+
+#define TRACE_NUM(x) ValueAsNum(TRACE_RK(x))
+
+// Int fast path `fn` of arithmetic instruction, see `IntAdd`
+#define TRACE_INT_ARITH(fn)                                                    \
+    (IsValueInt(TRACE_RK(ins->b)) && IsValueInt(TRACE_RK(ins->c)) &&           \
+     fn(ValueAsInt(TRACE_RK(ins->b)), ValueAsInt(TRACE_RK(ins->c)),            \
+        &regs[ins->a]))
+
+// Leave trace at exit of `ins`
+#define TRACE_EXIT()                                                           \
+    do {                                                                       \
+        vm->frames[frameIndex].rip = code + ins->exit;                         \
+        return true;                                                           \
+    } while (0)
+
+bool TraceRun(PVm *vm, const PTrace *trace) {
+    int frameIndex = vm->frameCount - 1;
+    PCallFrame *frame = &vm->frames[frameIndex];
+    const PBytecode *bt = frame->fn->v.OComFunction.code;
+    const PRegIns *code = bt->reg->code;
+    const PValue *consts = bt->constPool;
+    PValue *regs = frame->slots;
+    const PTraceIns *ins = trace->code;
+
+    while (true) {
+#if defined(PANKTI_BUILD_DEBUG)
+        vm->insCount++;
+#endif
+        switch ((PTraceOp)ins->op) {
+            case TR_GUARD_NUM: {
+                if (!IsValueNum(regs[ins->a])) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_TRUTHY: {
+                if (IsValueTruthy(regs[ins->a]) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_EQ: {
+                if ((TRACE_NUM(ins->b) == TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_NE: {
+                if ((TRACE_NUM(ins->b) != TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_GT: {
+                if ((TRACE_NUM(ins->b) > TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_GE: {
+                if ((TRACE_NUM(ins->b) >= TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_LT: {
+                if ((TRACE_NUM(ins->b) < TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_LE: {
+                if ((TRACE_NUM(ins->b) <= TRACE_NUM(ins->c)) != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+            case TR_GUARD_BRANCH: {
+                bool jump = false;
+                if (!VmRegBranch(vm, ins->as.ins, &jump)) {
+                    return false;
+                }
+                if (jump != ins->expect) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+
+            case TR_MOVE: regs[ins->a] = regs[ins->b]; break;
+            case TR_LOADK: regs[ins->a] = ins->as.k; break;
+
+            case TR_ADD: {
+                if (TRACE_INT_ARITH(IntAdd)) {
+                    break;
+                }
+                regs[ins->a] = MakeNumber(TRACE_NUM(ins->b) + TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_SUB: {
+                if (TRACE_INT_ARITH(IntSub)) {
+                    break;
+                }
+                regs[ins->a] = MakeNumber(TRACE_NUM(ins->b) - TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_MUL: {
+                if (TRACE_INT_ARITH(IntMul)) {
+                    break;
+                }
+                regs[ins->a] = MakeNumber(TRACE_NUM(ins->b) * TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_DIV: {
+                double divisor = TRACE_NUM(ins->c);
+                if (divisor == 0.0) {
+                    TRACE_EXIT();
+                }
+                regs[ins->a] = MakeNumber(TRACE_NUM(ins->b) / divisor);
+                break;
+            }
+            case TR_MOD: {
+                double divisor = TRACE_NUM(ins->c);
+                if (divisor == 0.0) {
+                    TRACE_EXIT();
+                }
+                if (TRACE_INT_ARITH(IntMod)) {
+                    break;
+                }
+                regs[ins->a] = MakeNumber(fmod(TRACE_NUM(ins->b), divisor));
+                break;
+            }
+            case TR_EQ: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) == TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_NE: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) != TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_GT: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) > TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_GE: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) >= TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_LT: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) < TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_LE: {
+                regs[ins->a] = MakeBool(TRACE_NUM(ins->b) <= TRACE_NUM(ins->c));
+                break;
+            }
+            case TR_NEG: regs[ins->a] = MakeNumber(-TRACE_NUM(ins->b)); break;
+
+            case TR_GETGLOBAL: {
+                if (vm->globals->version != trace->globalsVersion) {
+                    TRACE_EXIT();
+                }
+                regs[ins->a] = *ins->as.slot;
+                break;
+            }
+            case TR_SETGLOBAL: {
+                if (vm->globals->version != trace->globalsVersion) {
+                    TRACE_EXIT();
+                }
+                *ins->as.slot = TRACE_RK(ins->a);
+                break;
+            }
+            case TR_INDEX: {
+                PValue target = TRACE_RK(ins->b);
+                if (!IsValueObjType(target, OT_ARR)) {
+                    TRACE_EXIT();
+                }
+                const struct OArray *arr = &ValueAsObj(target)->v.OArray;
+                PValue indexVal = TRACE_RK(ins->c);
+                if (IsValueInt(indexVal) && ValueAsInt(indexVal) >= 0 &&
+                    (u64)ValueAsInt(indexVal) < arr->count) {
+                    regs[ins->a] = arr->items[ValueAsInt(indexVal)];
+                    break;
+                }
+                double index = ValueAsNum(indexVal);
+                if (index < 0 || index >= (double)arr->count ||
+                    !IsDoubleInt(index)) {
+                    TRACE_EXIT();
+                }
+                regs[ins->a] = arr->items[(u64)index];
+                break;
+            }
+
+            case TR_INTRINSIC: {
+                PValue args[2] = {TRACE_RK(ins->b), TRACE_RK(ins->c)};
+                PanOpCode op = (PanOpCode)(OP_LEN + (ins->as.ins->op - RG_LEN));
+                if (!VmIntrinsic(vm, op, args, &regs[ins->a])) {
+                    TRACE_EXIT();
+                }
+                break;
+            }
+
+            case TR_STEP: {
+                if (!VmRegStep(vm, ins->as.ins)) {
+                    return false;
+                }
+                break;
+            }
+            case TR_LOOP: ins = trace->code; continue;
+        }
+        ins++;
+    }
+}
+
+#undef TRACE_EXIT
+#undef TRACE_INT_ARITH
+#undef TRACE_NUM
+#undef TRACE_RK
+
+void FreeTrace(PTrace *trace) {
+    if (trace == NULL) {
+        return;
+    }
+    arrfree(trace->code);
+    PFree(trace);
+}
+
+static const char *traceOpNames[] = {
+    [TR_GUARD_NUM] = "GuardNum",
+    [TR_GUARD_TRUTHY] = "GuardTruthy",
+    [TR_GUARD_EQ] = "GuardEq",
+    [TR_GUARD_NE] = "GuardNe",
+    [TR_GUARD_GT] = "GuardGt",
+    [TR_GUARD_GE] = "GuardGe",
+    [TR_GUARD_LT] = "GuardLt",
+    [TR_GUARD_LE] = "GuardLe",
+    [TR_GUARD_BRANCH] = "GuardBranch",
+    [TR_MOVE] = "Move",
+    [TR_LOADK] = "LoadK",
+    [TR_ADD] = "Add",
+    [TR_SUB] = "Sub",
+    [TR_MUL] = "Mul",
+    [TR_DIV] = "Div",
+    [TR_MOD] = "Mod",
+    [TR_EQ] = "Eq",
+    [TR_NE] = "Ne",
+    [TR_GT] = "Gt",
+    [TR_GE] = "Ge",
+    [TR_LT] = "Lt",
+    [TR_LE] = "Le",
+    [TR_NEG] = "Neg",
+    [TR_GETGLOBAL] = "GetGlobal",
+    [TR_SETGLOBAL] = "SetGlobal",
+    [TR_INDEX] = "Index",
+    [TR_INTRINSIC] = "Intrinsic",
+    [TR_STEP] = "Step",
+    [TR_LOOP] = "Loop",
+};
+
+static void printRK(u16 operand) {
+    if (operand & REG_CONST_BIT) {
+        PanPrint(" k%d", operand & REG_RK_MAX);
+    } else {
+        PanPrint(" r%d", operand);
+    }
+}
+
+void DebugTrace(const PTrace *trace) {
+    PanPrint("==== DEBUG TRACE (loop at %05u) ====\n", trace->head);
+    for (u32 i = 0; i < trace->count; i++) {
+        const PTraceIns *ins = &trace->code[i];
+        PanPrint("%s%04u %s", TermBlue(), i, TermReset());
+        PanPrint("%s%s%s", TermGreen(), traceOpNames[ins->op], TermReset());
+        switch ((PTraceOp)ins->op) {
+            case TR_GUARD_NUM:
+            case TR_GUARD_TRUTHY: PanPrint(" r%d", ins->a); break;
+            case TR_GUARD_EQ:
+            case TR_GUARD_NE:
+            case TR_GUARD_GT:
+            case TR_GUARD_GE:
+            case TR_GUARD_LT:
+            case TR_GUARD_LE: {
+                printRK(ins->b);
+                printRK(ins->c);
+                break;
+            }
+            case TR_MOVE: PanPrint(" r%d r%d", ins->a, ins->b); break;
+            case TR_LOADK: {
+                PanPrint(" r%d ", ins->a);
+                PrintValue(ins->as.k);
+                break;
+            }
+            case TR_ADD:
+            case TR_SUB:
+            case TR_MUL:
+            case TR_DIV:
+            case TR_MOD:
+            case TR_EQ:
+            case TR_NE:
+            case TR_GT:
+            case TR_GE:
+            case TR_LT:
+            case TR_LE:
+            case TR_INDEX:
+            case TR_INTRINSIC: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                printRK(ins->c);
+                break;
+            }
+            case TR_NEG: {
+                PanPrint(" r%d", ins->a);
+                printRK(ins->b);
+                break;
+            }
+            case TR_GETGLOBAL: PanPrint(" r%d", ins->a); break;
+            case TR_SETGLOBAL: printRK(ins->a); break;
+            case TR_GUARD_BRANCH:
+            case TR_STEP: {
+                PanPrint(" op %d", ins->as.ins->op);
+                break;
+            }
+            case TR_LOOP: break;
+        }
+        if (ins->op <= TR_GUARD_BRANCH) {
+            PanPrint(" %s-> exit %05u", ins->expect ? "(true) " : "", ins->exit);
+        }
+        PanPrint("\n");
+    }
+    PanPrint("==== END TRACE ====\n");
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PANKTI_TRACE_H
+#define PANKTI_TRACE_H
+
+#include "object.h"
+#include "ptypes.h"
+#include "regcode.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Loop traces.
+//
+// Each loop back edge of the register bytecode (a backward `RG_JMP`) counts
+// how often it is taken. Once a loop is hot, one iteration of it is recorded
+// while it runs : the instructions on the path it took, and the types of the
+// values it saw. The recording becomes a trace, a linear list of instructions
+// specialized for those types, with guards checking the types and branch
+// directions still hold. Following iterations run the trace instead of the
+// register bytecode.
+//
+// When a guard fails the trace exits to the register instruction the guard
+// was checking, which runs it the normal way. Registers are the frame's stack
+// slots in both, so an exit only has to set the frame's instruction pointer.
+//
+// Only loops of functions without native code are traced, the JIT (jit.h)
+// compiles the whole function when it is available.
+//
+// `PANKTI_TRACE` environment variable : `off` disables traces, `always`
+// records a loop on its first back edge.
+
+// Back edges of a loop before it is recorded
+#define TRACE_HOT_THRESHOLD 50
+// `hits` of loops which are never recorded
+#define TRACE_NEVER UINT32_MAX
+// Recordings of a loop which can stop before giving up on it
+#define TRACE_MAX_ABORTS 4
+// Longest trace
+#define TRACE_MAX_LENGTH 512
+// Max nested traces, deeper loops run in the register engine so C stack
+// doesn't overflow before the VM call stack does
+#define TRACE_MAX_DEPTH 512
+
+typedef enum PTraceOp {
+    // Exit unless R(a) is a number
+    TR_GUARD_NUM = 0,
+    // Exit unless truthiness of R(a) is `expect`
+    TR_GUARD_TRUTHY,
+    // Exit unless RK(b) op RK(c) is `expect`, both are numbers
+    TR_GUARD_EQ,
+    TR_GUARD_NE,
+    TR_GUARD_GT,
+    TR_GUARD_GE,
+    TR_GUARD_LT,
+    TR_GUARD_LE,
+    // Exit unless conditional jump `ins` jumps (`expect` is true) or not
+    TR_GUARD_BRANCH,
+    // R(a) = R(b)
+    TR_MOVE,
+    // R(a) = k
+    TR_LOADK,
+    // R(a) = RK(b) op RK(c), both are numbers
+    TR_ADD,
+    TR_SUB,
+    TR_MUL,
+    // Exit if RK(c) is 0
+    TR_DIV,
+    TR_MOD,
+    TR_EQ,
+    TR_NE,
+    TR_GT,
+    TR_GE,
+    TR_LT,
+    TR_LE,
+    // R(a) = -RK(b), a number
+    TR_NEG,
+    // R(a) = *slot, value of a global. Exit if globals have moved
+    TR_GETGLOBAL,
+    // *slot = RK(a)
+    TR_SETGLOBAL,
+    // R(a) = RK(b)[RK(c)], RK(c) is a number. Exit unless RK(b) is an array
+    // and RK(c) a valid index of it
+    TR_INDEX,
+    // R(a) = intrinsic register instruction `ins` of RK(b), or of RK(b) and
+    // RK(c). Exit if it has to call the function, see `VmIntrinsic`
+    TR_INTRINSIC,
+    // Run register instruction `ins` the normal way
+    TR_STEP,
+    // Back to the start of the trace
+    TR_LOOP,
+} PTraceOp;
+
+typedef struct PTraceIns {
+    u8 op;
+    // Expected result of guards
+    bool expect;
+    u16 a;
+    u16 b;
+    u16 c;
+    // Register instruction to exit to when guard fails
+    u32 exit;
+    union {
+        PValue k;
+        PValue *slot;
+        const PRegIns *ins;
+    } as;
+} PTraceIns;
+
+typedef struct PTrace {
+    PTraceIns *code;
+    u32 count;
+    // Register instruction the trace starts at, the loop head
+    u32 head;
+    // `version` of globals table `TR_GETGLOBAL` and `TR_SETGLOBAL` slots
+    // belong to
+    u64 globalsVersion;
+} PTrace;
+
+// State of a loop, the `c` operand of its back edge is its index in
+// `PRegCode.loops`
+typedef struct PTraceLoop {
+    // Back edges taken so far, `TRACE_NEVER` if it won't be recorded
+    u32 hits;
+    // Recordings which were stopped
+    u32 aborts;
+    PTrace *trace;
+} PTraceLoop;
+
+// Record one iteration of the loop of top frame, whose head is register
+// instruction `head` and back edge `back`, while running it. The frame must
+// be at `head`. Sets `loop->trace` if the iteration could be recorded, else
+// the frame is left at the instruction recording stopped at. Returns false if
+// an error was reported
+bool TraceRecord(PVm *vm, PTraceLoop *loop, u32 head, u32 back);
+// Run `trace` on top frame until a guard fails, the frame is then left at the
+// exit instruction. Returns false if an error was reported
+bool TraceRun(PVm *vm, const PTrace *trace);
+// Free a trace
+void FreeTrace(PTrace *trace);
+// Print a trace
+void DebugTrace(const PTrace *trace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,6 +35,42 @@ u64 GetGraphemeCount(const char *str, u64 len) {
 
     return count;
 }
+
+static void findLineStarts(PLineIndex *index) {
+    arrput(index->starts, 0);
+    for (const char *c = index->source; *c != '\0'; c++) {
+        if (*c == '\n') {
+            arrput(index->starts, (u64)(c - index->source) + 1);
+        }
+    }
+}
+
+u64 LineIndexGraphemeCol(PLineIndex *index, u64 line, u64 col) {
+    if (index == NULL || index->source == NULL || line == 0 || col == 0) {
+        return col;
+    }
+    if (index->starts == NULL) {
+        findLineStarts(index);
+    }
+    if (line > (u64)arrlen(index->starts)) {
+        return col;
+    }
+    const char *lineStart = index->source + index->starts[line - 1];
+    u64 len = 0;
+    while (len < col - 1 && lineStart[len] != '\0' && lineStart[len] != '\n') {
+        len++;
+    }
+    return GetGraphemeCount(lineStart, len) + 1;
+}
+
+void FreeLineIndex(PLineIndex *index) {
+    if (index == NULL || index->starts == NULL) {
+        return;
+    }
+    arrfree(index->starts);
+    index->starts = NULL;
+}
+
 char *GetGraphemeAt(const char *str, u64 len, u64 index, GraphemeError *err) {
     if (str == NULL || len == 0) {
         if (err != NULL) *err = GR_ERR_EMPTY;
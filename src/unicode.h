@@ -31,6 +31,19 @@ u64 GetGraphemeCount(const char *str, u64 len);
 char *GetGraphemeAt(const char *str, u64 len, u64 index, GraphemeError *err);
 char **GetGraphemeArray(const char *str, u64 len, GraphemeError *err);
 
+// Line starts of a source, to find grapheme based columns of positions only
+// when they are printed. Tokens only know byte columns
+typedef struct PLineIndex {
+    const char *source;
+    // Byte offset each line starts at, found on first use
+    u64 *starts;
+} PLineIndex;
+
+// Grapheme based column of byte column `col` of line `line`, both 1 based
+u64 LineIndexGraphemeCol(PLineIndex *index, u64 line, u64 col);
+// Free line starts of `index`
+void FreeLineIndex(PLineIndex *index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,7 +15,7 @@
 #include "ptypes.h"
 #include "ustring.h"
 
-static u32 uiterGetACp(const char *str, u64 len, u64 *ate) {
+u32 UDecodeCp(const char *str, u64 len, u64 *ate) {
     if (len == 0) {
         *ate = 0;
         return 0;
@@ -93,7 +93,7 @@ static void uiterFillPeekBuffer(UIter *it) {
             break;
         }
         u64 ate = 0;
-        u32 cp = uiterGetACp(it->str + curpos, it->len - curpos, &ate);
+        u32 cp = UDecodeCp(it->str + curpos, it->len - curpos, &ate);
         if (ate > 0) {
             it->peekBuf[i] = cp;
             it->peekCount++;
@@ -141,7 +141,7 @@ void UIterAdvance(UIter *iter) {
 
     // how much first item in peek buffer ate?
     u64 ate = 0;
-    uiterGetACp(iter->str + iter->pos, iter->len - iter->pos, &ate);
+    UDecodeCp(iter->str + iter->pos, iter->len - iter->pos, &ate);
     if (ate > 0) {
         iter->pos += ate;
     } else {
@@ -60,6 +60,11 @@ void UIterAdvance(UIter *iter);
 // Advance the iterator and return the just passed codepoint
 u32 UIterNext(UIter *it);
 
+// Decode the UTF-8 encoded codepoint at the start of `str`, which has `len`
+// bytes. `ate` is set to how many bytes it took, 1 for invalid bytes which
+// decode as `UITER_INVALID_CODEPOINT`. Returns 0 if `len` is 0
+u32 UDecodeCp(const char *str, u64 len, u64 *ate);
+
 // Convert the UTF-32 encoded codepoint to UTF-8 encoded character array
 // `value` = UTF-32 encoded codepoint
 // `result` = buffer to write the UTF-8 encoded bytes
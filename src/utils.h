@@ -42,6 +42,25 @@ char *PanReadLine(const char *msg, int *len);
 // `path` = Path to the file
 char *PanReadFile(const char *path);
 
+// Source of a script. Regular files are mapped read only where possible, so
+// the text is not copied, other files such as pipes are read to their end
+typedef struct PanSource {
+    // Text without the BOM, followed by a NUL byte. Must not be written
+    char *text;
+    // Length of `text`
+    u64 len;
+    // Mapping `text` is in, NULL if it was read
+    void *map;
+    u64 mapLen;
+    // Path can be loaded again to get the same text, false for pipes
+    bool reloadable;
+} PanSource;
+
+// Load script at `path` to `src`, false if it can't be read
+bool PanLoadSource(const char *path, PanSource *src);
+// Unmap or free text of `src`
+void PanFreeSource(PanSource *src);
+
 // Check if file exists
 // `path` = Path to the file
 bool DoesFileExists(const char *filepath);
@@ -10,6 +10,7 @@
 #include "external/gb/gb_string.h"
 #include "printer.h"
 #include "ptypes.h"
+#include "system.h"
 #include "utils.h"
 #include <stdbool.h>
 #include <stdio.h>
@@ -41,43 +42,159 @@
 #define PAN_MKDIR(f, mode) mkdir(f, mode)
 #endif
 
-// Potential bug: handling of non-seekable file
-char *PanReadFile(const char *path) {
-    char *text = NULL;
-
-    if (path != NULL) {
-        FILE *file = fopen(path, "rt");
-        if (file != NULL) {
-            fseek(file, 0, SEEK_END);
-            long size = ftell(file);
-            fseek(file, 0, SEEK_SET);
-
-            if (size >= 0) {
-                text = (char *)PCalloc(size + 1, sizeof(char));
-                if (text == NULL) {
-                    fclose(file);
-                    return NULL;
-                }
-
-                fread(text, (size_t)size, 1, file);
-                text[size] = '\0';
-
-                // Check and Remove BOM from file
-                if (size >= 3 && (uchar)text[0] == UTF8_BOM_0 &&
-                    (uchar)text[1] == UTF8_BOM_1 &&
-                    (uchar)text[2] == UTF8_BOM_2) {
-                    memmove(text, text + 3, size - 3);
-                    text[size - 3] = '\0';
-                }
-            }
+#if defined(PANKTI_OS_LINUX) || defined(PANKTI_OS_MAC)
+#define PANKTI_MMAP_SOURCE
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+// Read `file` to its end into a NUL terminated string, growing it as it goes
+// so pipes and text mode newline conversion read what is there. `hint` is the
+// expected size, 0 if unknown
+static char *readStream(FILE *file, u64 hint, u64 *outLen) {
+    u64 cap = hint + 1 > 4096 ? hint + 1 : 4096;
+    u64 len = 0;
+    char *text = PMalloc(cap);
+    if (text == NULL) {
+        return NULL;
+    }
 
-            fclose(file);
+    while (true) {
+        if (len + 1 == cap) {
+            char *grown = PRealloc(text, cap * 2);
+            if (grown == NULL) {
+                PFree(text);
+                return NULL;
+            }
+            text = grown;
+            cap *= 2;
+        }
+        u64 got = (u64)fread(text + len, 1, (size_t)(cap - len - 1), file);
+        len += got;
+        if (got == 0) {
+            break;
         }
     }
 
+    if (ferror(file)) {
+        PFree(text);
+        return NULL;
+    }
+
+    text[len] = '\0';
+    *outLen = len;
     return text;
 }
 
+static bool hasBom(const char *text, u64 len) {
+    return len >= 3 && (uchar)text[0] == UTF8_BOM_0 &&
+           (uchar)text[1] == UTF8_BOM_1 && (uchar)text[2] == UTF8_BOM_2;
+}
+
+char *PanReadFile(const char *path) {
+    if (path == NULL) {
+        return NULL;
+    }
+    FILE *file = fopen(path, "rt");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    PAN_STAT_STRUCT buf = {0};
+    u64 hint = 0;
+    if (PAN_STAT(path, &buf) == 0 && S_ISREG(buf.st_mode)) {
+        hint = (u64)buf.st_size;
+    }
+
+    u64 len = 0;
+    char *text = readStream(file, hint, &len);
+    fclose(file);
+
+    // Check and Remove BOM from file
+    if (text != NULL && hasBom(text, len)) {
+        memmove(text, text + 3, len - 3);
+        text[len - 3] = '\0';
+    }
+
+    return text;
+}
+
+#if defined(PANKTI_MMAP_SOURCE)
+// Map regular file `path` read only. Bytes past the end of a file up to the
+// end of its last page are zero, which terminates the text. Files which fill
+// their last page have no such byte and are read instead
+static bool mapSource(const char *path, PanSource *src) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat buf = {0};
+    long page = sysconf(_SC_PAGESIZE);
+    if (fstat(fd, &buf) != 0 || !S_ISREG(buf.st_mode) || buf.st_size <= 0 ||
+        page <= 0 || buf.st_size % page == 0) {
+        close(fd);
+        return false;
+    }
+
+    u64 size = (u64)buf.st_size;
+    void *map = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+#if defined(MADV_SEQUENTIAL)
+    madvise(map, (size_t)size, MADV_SEQUENTIAL);
+#endif
+
+    char *text = (char *)map;
+    u64 bom = hasBom(text, size) ? 3 : 0;
+    src->text = text + bom;
+    src->len = size - bom;
+    src->map = map;
+    src->mapLen = size;
+    src->reloadable = true;
+    return true;
+}
+#endif
+
+bool PanLoadSource(const char *path, PanSource *src) {
+    *src = (PanSource){0};
+    if (path == NULL) {
+        return false;
+    }
+
+#if defined(PANKTI_MMAP_SOURCE)
+    if (mapSource(path, src)) {
+        return true;
+    }
+#endif
+
+    char *text = PanReadFile(path);
+    if (text == NULL) {
+        return false;
+    }
+    src->text = text;
+    src->len = (u64)strlen(text);
+    src->reloadable = PanIsPathFile(path);
+    return true;
+}
+
+void PanFreeSource(PanSource *src) {
+    if (src == NULL || src->text == NULL) {
+        return;
+    }
+#if defined(PANKTI_MMAP_SOURCE)
+    if (src->map != NULL) {
+        munmap(src->map, (size_t)src->mapLen);
+        *src = (PanSource){0};
+        return;
+    }
+#endif
+    PFree(src->text);
+    *src = (PanSource){0};
+}
+
 bool PanWriteFile(const char *filepath, const char *str) {
     if (filepath == NULL || str == NULL) {
         return false;
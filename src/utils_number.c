@@ -67,11 +67,16 @@ double NumberFromStr(const char *lexeme, u64 len, bool *ok) {
         return -1;
     }
 
-    UIter *iter = NewUIterator(lexeme);
+    // `lexeme` may be a slice of the source, only `len` bytes are read
+    u64 pos = 0;
     int index = 0;
-
-    while (!UIterIsEnd(iter)) {
-        char32 ch = UIterNext(iter);
+    while (pos < len) {
+        u64 ate = 0;
+        char32 ch = UDecodeCp(lexeme + pos, len - pos, &ate);
+        if (ate == 0) {
+            break;
+        }
+        pos += ate;
         if (ch == '.') {
             buf[index++] = '.';
             continue;
@@ -81,7 +86,6 @@ double NumberFromStr(const char *lexeme, u64 len, bool *ok) {
 
     double value = atof(buf);
     *ok = true;
-    FreeUIterator(iter);
     PFree(buf);
     return value;
 }
@@ -11,34 +11,101 @@
 #include "builtins.h"
 #include "compiler.h"
 #include "diagonctx.h"
+#include "flags.h"
 #include "external/stb/stb_ds.h"
 #include "gc.h"
 #include "gen/diagon.h"
+#include "jit.h"
 #include "object.h"
 #include "opcode.h"
 #include "printer.h"
 #include "pstdlib.h"
 #include "ptypes.h"
 #include "symtable.h"
+#include "trace.h"
 #include "utils.h"
 #include <math.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// Unchecked stack operations used by the dispatch loop. Room for a frame's
+// `maxStack` slots is made when it is pushed (see `vmEnsureStack`), so
+// running bytecode can't overflow the stack. Natives use checked `VmPush`
+static finline void vmPush(PVm *vm, PValue val) { *vm->sp++ = val; }
+
+static finline PValue vmPop(PVm *vm) { return *--vm->sp; }
+
+// Make sure a frame with slots starting at `slots` has room for `maxStack`
+// slots
+static finline bool vmEnsureStack(PVm *vm, PValue *slots, u32 maxStack) {
+    if (slots + maxStack <= vm->stackEnd) {
+        return true;
+    }
+    return VmStackGrow(vm, (u64)(slots + maxStack - vm->sp));
+}
+
+// Register engine, see below `vmRunLoop`
+static bool vmRegTranslate(PVm *vm, PObj *fnObj);
+static void vmRegSetTop(PVm *vm, PCallFrame *frame, PValue *written);
+static bool vmRegEnterFrame(PVm *vm, PCallFrame *frame);
+static bool vmTraceLoop(PVm *vm, PCallFrame *frame, const PRegIns *ins);
+
+#if defined(PANKTI_JIT)
+static bool vmJitCompile(PObj *fnObj);
+static bool vmJitEnterFrame(PVm *vm, PCallFrame *frame, u32 pc);
+
+// Count a call or loop back edge of function `fnObj`, and compile it once it
+// is hot. Returns true if it has native code which can be run now
+static finline bool vmJitHot(PVm *vm, PObj *fnObj) {
+    PBytecode *code = fnObj->v.OComFunction.code;
+    if (vm->jitDepth >= JIT_MAX_DEPTH) {
+        return false;
+    }
+    if (code->jit != NULL) {
+        return true;
+    }
+    if (vm->jitThreshold == 0 || code->hotCount == JIT_NEVER ||
+        ++code->hotCount < vm->jitThreshold) {
+        return false;
+    }
+    return vmJitCompile(fnObj);
+}
+#endif
+
+// Whether loops of `code` may be traced now. Functions use native code
+// instead when the JIT is on
+static finline bool vmTraceAllowed(const PVm *vm, const PBytecode *code) {
+    if (vm->traceThreshold == 0 || vm->traceDepth >= TRACE_MAX_DEPTH) {
+        return false;
+    }
+#if defined(PANKTI_JIT)
+    return vm->jitThreshold == 0 || code->hotCount == JIT_NEVER;
+#else
+    (void)code;
+    return true;
+#endif
+}
 
 PVm *NewVm(Pgc *gc, PDiagonCtx errCtx) {
     PVm *vm = PCreate(PVm);
     if (vm == NULL) {
         return NULL;
     }
-    vm->sp = vm->stack;
     vm->gc = gc;
-    vm->frameCount = 0;
+    vm->stack = NULL;
+    vm->frames = NULL;
+    if (!VmStackInit(vm)) {
+        PFree(vm);
+        return NULL;
+    }
 
     SymbolTable *globalsTable = NewSymbolTable();
 
     if (globalsTable == NULL) {
+        VmStackFree(vm);
         PFree(vm);
         return NULL;
     }
@@ -47,40 +114,103 @@ PVm *NewVm(Pgc *gc, PDiagonCtx errCtx) {
     vm->modules = NULL;
     vm->modProxiesCount = 0;
     vm->modProxies = NULL;
-    vm->sp = vm->stack;
     vm->openUpvals = NULL;
     vm->scriptPath = NULL;
     vm->scriptArgs = NULL;
     vm->scriptArgCount = 0;
     vm->errCtx = errCtx;
+    vm->regEngine = false;
+    vm->intrinsicsOff = false;
+    vm->modStamp = 1;
+    vm->traceThreshold = TRACE_HOT_THRESHOLD;
+    vm->traceDepth = 0;
+    const char *traceMode = getenv("PANKTI_TRACE");
+    if (traceMode != NULL && strcmp(traceMode, "off") == 0) {
+        vm->traceThreshold = 0;
+    } else if (traceMode != NULL && strcmp(traceMode, "always") == 0) {
+        vm->traceThreshold = 1;
+    }
+#if defined(PANKTI_JIT)
+    vm->jitThreshold = JIT_HOT_THRESHOLD;
+    vm->jitDepth = 0;
+    const char *jitMode = getenv("PANKTI_JIT");
+    if (jitMode != NULL && strcmp(jitMode, "off") == 0) {
+        vm->jitThreshold = 0;
+    } else if (jitMode != NULL && strcmp(jitMode, "always") == 0) {
+        vm->jitThreshold = 1;
+    }
+#endif
+#if defined(PANKTI_BUILD_DEBUG)
+    vm->insCount = 0;
+#endif
     return vm;
 }
 
-void SetupVm(
-    PVm *vm, PObj *func, const char *scriptPath, int sArgc, char **sArgs
-) {
-    vm->scriptPath = scriptPath;
-    vm->scriptArgCount = sArgc;
-    vm->scriptArgs = sArgs;
+// Push closure of top level function `func` as the first frame
+static bool vmLoadScript(PVm *vm, PObj *func) {
     VmPush(vm, MakeObject(func));
     PObj *clsObj = NewClosureObject(vm->gc, func);
     if (clsObj == NULL) {
         // Directly call to core runtime error
         // we cannot provide any stack trace yet
-        ReportDiag(
-            &vm->errCtx, func->v.OComFunction.rawName, RT_IME_PRIMARY_SETUP
-        );
-        return;
+        ReportDiag(&vm->errCtx, NULL, RT_IME_PRIMARY_SETUP);
+        return false;
     }
     VmPop(vm);
     VmPush(vm, MakeObject(clsObj));
     PCallFrame *frame = &vm->frames[vm->frameCount++];
     frame->cls = clsObj;
-    frame->ip = clsObj->v.OClosure.function->v.OComFunction.code->code;
+    frame->fn = clsObj->v.OClosure.function;
+    frame->ip = frame->fn->v.OComFunction.code->code;
     frame->slots = vm->stack;
+    frame->outer = NULL;
+    frame->capturesLocals = true;
+    if (!vmEnsureStack(
+            vm, frame->slots, frame->fn->v.OComFunction.code->maxStack
+        )) {
+        // stack overflow is reported already, script is not run
+        vm->frameCount--;
+        return false;
+    }
+    frame->rip = NULL;
+    if (vm->regEngine) {
+        frame->top = vm->sp;
+        if (vmRegTranslate(vm, frame->fn)) {
+            frame->rip = frame->fn->v.OComFunction.code->reg->code;
+            vmRegSetTop(vm, frame, frame->slots + 1);
+        }
+    }
+    return true;
+}
+
+bool SetupVm(
+    PVm *vm, PObj *func, const char *scriptPath, int sArgc, char **sArgs
+) {
+    vm->scriptPath = scriptPath;
+    vm->scriptArgCount = sArgc;
+    vm->scriptArgs = sArgs;
+    if (!vmLoadScript(vm, func)) {
+        return false;
+    }
+    RegisterBuiltins(vm);
+    return true;
+}
+
+void SetupVmSession(
+    PVm *vm, const char *scriptPath, int sArgc, char **sArgs
+) {
+    vm->scriptPath = scriptPath;
+    vm->scriptArgCount = sArgc;
+    vm->scriptArgs = sArgs;
     RegisterBuiltins(vm);
 }
 
+void VmRunChunk(PVm *vm, PObj *func) {
+    if (vmLoadScript(vm, func)) {
+        VmRun(vm);
+    }
+}
+
 void FreeVm(PVm *vm) {
     if (vm == NULL) {
         return;
@@ -103,6 +233,7 @@ void FreeVm(PVm *vm) {
         arrfree(vm->modules);
     }
 
+    VmStackFree(vm);
     PFree(vm);
 }
 
@@ -115,6 +246,7 @@ void markVmStack(PVm *vm) {
 void markVmFrames(PVm *vm) {
     for (int i = 0; i < vm->frameCount; i++) {
         GcMarkObject(vm->gc, vm->frames[i].cls);
+        GcMarkObject(vm->gc, vm->frames[i].fn);
     }
 }
 
@@ -146,71 +278,100 @@ typedef struct VmPosInfo {
     u64 line;
     u64 col;
     u64 len;
-    u64 gcol;
-    u64 glen;
-    Token *token;
 } VmPosInfo;
 
-static VmPosInfo vmGetPosInfo(const PVm *vm, const PCallFrame *frame) {
-    if (vm == NULL || frame == NULL) {
+// Offset of stack bytecode instruction `frame` is running
+static u64 vmFrameOffset(const PCallFrame *frame) {
+    PBytecode *bt = frame->fn->v.OComFunction.code;
+    if (frame->rip != NULL) {
+        // register instruction is mapped back to stack bytecode
+        u64 pc = (u64)(frame->rip - bt->reg->code);
+        return bt->reg->origin[pc > 0 ? pc - 1 : 0];
+    }
+    return (u64)(frame->ip - bt->code) - 1;
+}
+
+static VmPosInfo vmMakePosInfo(const PBtPosInfo *pos) {
+    return (VmPosInfo){
+        .found = true,
+        .line = pos->line,
+        .col = pos->col,
+        .len = pos->len,
+    };
+}
+
+// Position of instruction at `errOffset` of bytecode `bt`
+static VmPosInfo vmGetOffsetPosInfo(const PBytecode *bt, u64 errOffset) {
+    PBtPosInfo pos;
+    if (!BytecodeFindPos(bt, errOffset, &pos)) {
         return (VmPosInfo){.found = false};
     }
-    PBytecode *bt = frame->cls->v.OClosure.function->v.OComFunction.code;
-    u64 errOffset = (frame->ip - bt->code) - 1;
-    u64 posCount = (u64)arrlen(bt->posTable);
-    if (posCount == 0) {
+    return vmMakePosInfo(&pos);
+}
+
+static VmPosInfo vmGetPosInfo(const PVm *vm, const PCallFrame *frame) {
+    if (vm == NULL || frame == NULL) {
         return (VmPosInfo){.found = false};
     }
+    return vmGetOffsetPosInfo(
+        frame->fn->v.OComFunction.code, vmFrameOffset(frame)
+    );
+}
 
-    // Binary search : largest startOffset <= errOffset
-    i64 lo = 0;
-    i64 hi = (i64)posCount - 1;
-    i64 best = 0;
+static void vmPrintTraceLine(
+    const PVm *vm, PLineIndex *lines, PObj *name, VmPosInfo posInfo
+) {
+    PanFPrint(stderr, "in ");
+    if (name != NULL) {
+        PanFPrint(stderr, "%s(...)", name->v.OString.value);
+    } else {
+        PanFPrint(
+            stderr, "<script> (%s)",
+            vm->scriptPath != NULL ? vm->scriptPath : "unknown"
+        );
+    }
+    if (posInfo.found) {
+        u64 gcol = LineIndexGraphemeCol(lines, posInfo.line, posInfo.col);
+        PanFPrint(stderr, " at %llu:%llu\n", posInfo.line, gcol);
+    }
+}
 
-    while (lo <= hi) {
-        i64 mid = (lo + hi) / 2;
-        if (bt->posTable[mid].startOffset <= errOffset) {
-            best = mid;
-            lo = mid + 1;
-        } else {
-            hi = mid - 1;
+// Print stack trace lines of `frame`, functions inlined into it are printed
+// as frames of their own, innermost first
+static void vmPrintFrameTrace(
+    const PVm *vm, PLineIndex *lines, const PCallFrame *frame
+) {
+    struct OComFunction *fn = &frame->fn->v.OComFunction;
+    PBytecode *bt = fn->code;
+    u64 offset = vmFrameOffset(frame);
+    VmPosInfo posInfo = vmGetOffsetPosInfo(bt, offset);
+
+    for (i64 i = (i64)arrlen(bt->inlines) - 1; i >= 0; i--) {
+        const PBtInline *inl = &bt->inlines[i];
+        if (inl->start <= offset && offset < inl->end) {
+            PObj *name = ValueAsObj(bt->constPool[inl->name]);
+            vmPrintTraceLine(vm, lines, name, posInfo);
+            posInfo = vmMakePosInfo(&inl->call);
         }
     }
 
-    PBtPosInfo *bestPos = &bt->posTable[best];
-
-    return (VmPosInfo){
-        .found = true,
-        .line = bestPos->line,
-        .col = bestPos->col,
-        .len = bestPos->len,
-        .gcol = bestPos->gcol,
-        .glen = bestPos->glen,
-        .token = bestPos->token,
-
-    };
+    vmPrintTraceLine(vm, lines, fn->strName, posInfo);
 }
 
-void VmPrintStackTrace(const PVm *vm) {
+// With deep recursion, only this many innermost and outermost frames are
+// printed in stack trace
+#define STACK_TRACE_EDGE 16
+
+void VmPrintStackTrace(const PVm *vm, PLineIndex *lines) {
     for (int i = vm->frameCount - 1; i >= 0; i--) {
-        const PCallFrame *frame = &vm->frames[i];
-        VmPosInfo posInfo = vmGetPosInfo(vm, frame);
-        struct OClosure *cls = &frame->cls->v.OClosure;
-        struct OComFunction *fn = &cls->function->v.OComFunction;
-
-        PanFPrint(stderr, "in ");
-        if (fn->strName != NULL) {
-            struct OString *name = &fn->strName->v.OString;
-            PanFPrint(stderr, "%s(...)", name->value);
-        } else {
-            PanFPrint(
-                stderr, "<script> (%s)",
-                vm->scriptPath != NULL ? vm->scriptPath : "unknown"
-            );
-        }
-        if (posInfo.found) {
-            PanFPrint(stderr, " at %llu:%llu\n", posInfo.line, posInfo.gcol);
+        if (vm->frameCount > STACK_TRACE_EDGE * 2 &&
+            i == vm->frameCount - 1 - STACK_TRACE_EDGE) {
+            int skipped = vm->frameCount - STACK_TRACE_EDGE * 2;
+            PanFPrint(stderr, "... %d more ...\n", skipped);
+            i = STACK_TRACE_EDGE;
+            continue;
         }
+        vmPrintFrameTrace(vm, lines, &vm->frames[i]);
     }
 }
 
@@ -233,10 +394,17 @@ void VmError(PVm *vm, PanDiagCode code) {
 void VmError(PVm *vm, PanDiagCode code, ...) {
     PCallFrame *frame = &vm->frames[vm->frameCount - 1];
     VmPosInfo posInfo = vmGetPosInfo(vm, frame);
-    Token *tok = posInfo.found ? posInfo.token : NULL;
+    // Tokens are freed once the script is compiled, errors get a stand-in
+    // with the position
+    Token tok = {
+        .type = T_EOF,
+        .line = (u32)posInfo.line,
+        .col = (u32)posInfo.col,
+        .len = (u32)posInfo.len,
+    };
     va_list args;
     va_start(args, code);
-    ReportDiagV(&vm->errCtx, tok, code, args);
+    ReportDiagV(&vm->errCtx, posInfo.found ? &tok : NULL, code, args);
     va_end(args);
 }
 
@@ -258,6 +426,16 @@ static void PushModule(PVm *vm, PModule *mod) {
     vm->modCount = (u64)arrlen(vm->modules);
 }
 
+// Module imported before from `path`, NULL if there is none
+static PModule *vmFindModule(PVm *vm, const char *path) {
+    for (u64 i = 0; i < vm->modCount; i++) {
+        if (StrEqual(vm->modules[i]->pathname, path)) {
+            return vm->modules[i];
+        }
+    }
+    return NULL;
+}
+
 static void PushProxy(PVm *vm, u64 key, char *name, PModule *mod) {
     if (mod == NULL) {
         return; // error check
@@ -283,8 +461,7 @@ void DebugVMStack(PVm *vm) {
 PValue VmGetLastPopped(const PVm *vm) { return MakeNil(); }
 
 bool VmPush(PVm *vm, PValue val) {
-    if (vm->sp >= vm->stack + PVM_STACK_SIZE) {
-        VmError(vm, RT_STACK_OVERFLOW);
+    if (vm->sp >= vm->stackEnd && !VmStackGrow(vm, 1)) {
         return false;
     }
     *vm->sp = val;
@@ -307,7 +484,9 @@ PValue VmPeek(const PVm *vm, int index) {
     return val;
 }
 
-static bool vmBinaryOpNumber(PVm *vm, PanOpCode op, PValue left, PValue right) {
+static bool vmBinaryOpNumber(
+    PVm *vm, PanOpCode op, PValue left, PValue right, PValue *out
+) {
     double leftVal = ValueAsNum(left);
     double rightVal = ValueAsNum(right);
     double result = 0.0;
@@ -334,12 +513,42 @@ static bool vmBinaryOpNumber(PVm *vm, PanOpCode op, PValue left, PValue right) {
         case OP_EXPONENT: result = pow(leftVal, rightVal); break;
         default: return false;
     }
-    VmPop(vm);
-    VmPop(vm);
-    return VmPush(vm, MakeNumber(result));
+    *out = MakeNumber(result);
+    return true;
+}
+
+// Int fast path of `left op right`, returns false if it must be done with
+// `double`s
+static finline bool vmIntArith(PanOpCode op, i32 left, i32 right, PValue *out) {
+    switch (op) {
+        case OP_ADD: return IntAdd(left, right, out);
+        case OP_SUB: return IntSub(left, right, out);
+        case OP_MUL: return IntMul(left, right, out);
+        case OP_MOD: return IntMod(left, right, out);
+        default: return false;
+    }
+}
+
+// `-value` of a number
+static finline PValue vmNegNumber(PValue value) {
+    if (IsValueInt(value) && ValueAsInt(value) != 0 &&
+        ValueAsInt(value) != INT32_MIN) {
+        return MakeInt(-ValueAsInt(value));
+    }
+    return MakeNumber(-ValueAsNum(value));
 }
 
-static bool vmBinaryOpString(PVm *vm, PanOpCode op, PValue left, PValue right) {
+// Check if numbers or other values `a` and `b` are equal
+static finline bool vmEqual(PValue a, PValue b) {
+    if (IsValueInt(a) && IsValueInt(b)) {
+        return ValueAsInt(a) == ValueAsInt(b);
+    }
+    return IsValueEqual(a, b);
+}
+
+static bool vmBinaryOpString(
+    PVm *vm, PanOpCode op, PValue left, PValue right, PValue *out
+) {
     struct OString *ls = &ValueAsObj(left)->v.OString;
     u64 lsLen = (u64)strlen(ls->value);
     struct OString *rs = &ValueAsObj(right)->v.OString;
@@ -350,25 +559,28 @@ static bool vmBinaryOpString(PVm *vm, PanOpCode op, PValue left, PValue right) {
         return false;
     }
 
-    PObj *nsObj = NewStrObject(vm->gc, NULL, newStr, true); // fetch the token
-    VmPop(vm);
-    VmPop(vm);
-
-    return VmPush(vm, MakeObject(nsObj));
+    PObj *nsObj = NewStrObject(vm->gc, newStr, true); // fetch the token
+    *out = MakeObject(nsObj);
+    return true;
 }
 
-static bool vmBinaryOp(PVm *vm, PanOpCode op) {
-    PValue right = VmPeek(vm, 0);
-    PValue left = VmPeek(vm, 1);
-
+// Calculate `left op right` for arithmetic operator `op` into `out`. Reports
+// error and returns false for invalid operands
+static bool vmArith(
+    PVm *vm, PanOpCode op, PValue left, PValue right, PValue *out
+) {
+    if (IsValueInt(left) && IsValueInt(right) &&
+        vmIntArith(op, ValueAsInt(left), ValueAsInt(right), out)) {
+        return true;
+    }
     if (IsValueNum(left) && IsValueNum(right)) {
-        bool isok = vmBinaryOpNumber(vm, op, left, right);
+        bool isok = vmBinaryOpNumber(vm, op, left, right, out);
         if (!isok) {
             VmError(vm, RT_BINARY_OP);
             return false;
         }
     } else if (IsValueObjType(left, OT_STR) && IsValueObjType(right, OT_STR)) {
-        bool isok = vmBinaryOpString(vm, op, left, right);
+        bool isok = vmBinaryOpString(vm, op, left, right, out);
         if (!isok) {
             VmError(vm, RT_STR_BINARY_OP);
             return false;
@@ -381,30 +593,63 @@ static bool vmBinaryOp(PVm *vm, PanOpCode op) {
     return true;
 }
 
-static bool vmCompareOp(PVm *vm, PanOpCode op) {
-    PValue rightVal = VmPeek(vm, 0);
-    PValue leftVal = VmPeek(vm, 1);
-
-    if (IsValueNum(leftVal) && IsValueNum(rightVal)) {
-        double left = ValueAsNum(leftVal);
-        double right = ValueAsNum(rightVal);
-        bool result = false;
-        switch (op) {
-            case OP_GT: result = left > right; break;
-            case OP_GTE: result = left >= right; break;
-            case OP_LT: result = left < right; break;
-            case OP_LTE: result = left <= right; break;
-            default: break; // should never reach here
-        }
+static bool vmBinaryOp(PVm *vm, PanOpCode op) {
+    PValue result;
+    if (!vmArith(vm, op, VmPeek(vm, 1), VmPeek(vm, 0), &result)) {
+        return false;
+    }
+    vmPop(vm);
+    vmPop(vm);
+    vmPush(vm, result);
+    return true;
+}
+
+static finline bool vmIntCompare(PanOpCode op, i32 left, i32 right) {
+    switch (op) {
+        case OP_GT: return left > right;
+        case OP_GTE: return left >= right;
+        case OP_LT: return left < right;
+        case OP_LTE: return left <= right;
+        default: return false; // should never reach here
+    }
+}
+
+static finline bool vmNumCompare(PanOpCode op, double left, double right) {
+    switch (op) {
+        case OP_GT: return left > right;
+        case OP_GTE: return left >= right;
+        case OP_LT: return left < right;
+        case OP_LTE: return left <= right;
+        default: return false; // should never reach here
+    }
+}
 
-        VmPop(vm);
-        VmPop(vm);
-        VmPush(vm, MakeBool(result));
+// Compare `left` and `right` with comparison operator `op`
+static finline bool vmCompare(
+    PVm *vm, PanOpCode op, PValue left, PValue right, bool *out
+) {
+    if (IsValueInt(left) && IsValueInt(right)) {
+        *out = vmIntCompare(op, ValueAsInt(left), ValueAsInt(right));
         return true;
-    } else {
-        VmError(vm, RT_INVALID_COMP_OP);
+    }
+    if (IsValueNum(left) && IsValueNum(right)) {
+        *out = vmNumCompare(op, ValueAsNum(left), ValueAsNum(right));
+        return true;
+    }
+    VmError(vm, RT_INVALID_COMP_OP);
+    return false;
+}
+
+static bool vmCompareOp(PVm *vm, PanOpCode op) {
+    bool result = false;
+    if (!vmCompare(vm, op, VmPeek(vm, 1), VmPeek(vm, 0), &result)) {
         return false;
     }
+
+    vmPop(vm);
+    vmPop(vm);
+    vmPush(vm, MakeBool(result));
+    return true;
 }
 
 static bool vmCallFunction(PVm *vm, PObj *clsObj, int argCount) {
@@ -419,12 +664,58 @@ static bool vmCallFunction(PVm *vm, PObj *clsObj, int argCount) {
     }
     PCallFrame *frame = &vm->frames[vm->frameCount++];
     frame->cls = clsObj;
+    frame->fn = cls->function;
     frame->ip = cls->function->v.OComFunction.code->code;
+    frame->rip = NULL;
     frame->slots = vm->sp - argCount - 1;
+    frame->outer = NULL;
+    frame->capturesLocals = cls->function->v.OComFunction.capturesLocals;
+    if (!vmEnsureStack(
+            vm, frame->slots, cls->function->v.OComFunction.code->maxStack
+        )) {
+        return false;
+    }
+#if defined(PANKTI_JIT)
+    if (vmJitHot(vm, frame->fn)) {
+        return vmJitEnterFrame(vm, frame, 0);
+    }
+#endif
     return true;
 }
 
-static bool vmCallNative(PVm *vm, PObj *funcObj, int argc) {
+// Call a direct (non escaping) function. The compiler only lets them be
+// called from the frame of the function they were declared in, which is the
+// current frame
+static bool vmCallDirect(PVm *vm, PObj *fnObj, int argCount) {
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    if (fn->paramCount != (u64)argCount) {
+        VmError(vm, RT_ARG_PARAM_NOTEQ, fn->paramCount, (u64)argCount);
+        return false;
+    }
+    PValue *outer = vm->frames[vm->frameCount - 1].slots;
+    PCallFrame *frame = &vm->frames[vm->frameCount++];
+    frame->cls = NULL;
+    frame->fn = fnObj;
+    frame->ip = fn->code->code;
+    frame->rip = NULL;
+    frame->slots = vm->sp - argCount - 1;
+    frame->outer = outer;
+    frame->capturesLocals = fn->capturesLocals;
+    if (!vmEnsureStack(vm, frame->slots, fn->code->maxStack)) {
+        return false;
+    }
+#if defined(PANKTI_JIT)
+    if (vmJitHot(vm, fnObj)) {
+        return vmJitEnterFrame(vm, frame, 0);
+    }
+#endif
+    return true;
+}
+
+// Run native function `funcObj` with `argc` arguments from `args`
+static bool vmNativeCall(
+    PVm *vm, PObj *funcObj, PValue *args, int argc, PValue *out
+) {
     struct ONative *native = &funcObj->v.ONative;
     if (native->arity != -1 && native->arity != argc) {
         // PanPrint("%d != %d", argc, native->arity);
@@ -436,9 +727,17 @@ static bool vmCallNative(PVm *vm, PObj *funcObj, int argc) {
         return false;
     }
 
-    PValue result = native->fn(vm, vm->sp - argc, argc);
+    *out = native->fn(vm, args, argc);
+    return true;
+}
+
+static bool vmCallNative(PVm *vm, PObj *funcObj, int argc) {
+    PValue result;
+    if (!vmNativeCall(vm, funcObj, vm->sp - argc, argc, &result)) {
+        return false;
+    }
     vm->sp -= argc + 1;
-    VmPush(vm, result);
+    vmPush(vm, result);
     return true;
 }
 
@@ -447,23 +746,22 @@ static bool vmCallValue(PVm *vm, PValue callee, int argCount) {
         return vmCallFunction(vm, ValueAsObj(callee), argCount);
     } else if (IsValueObjType(callee, OT_NATIVE)) {
         return vmCallNative(vm, ValueAsObj(callee), argCount);
+    } else if (IsValueObjType(callee, OT_COMFNC)) {
+        return vmCallDirect(vm, ValueAsObj(callee), argCount);
     }
 
     return false;
 }
 
-static finline PValue vmGetSubIndex(PVm *vm, bool assign) {
-    if (assign) {
-        return VmPeek(vm, 1);
-    } else {
-        return VmPeek(vm, 0);
+// Check `indexVal` is a valid index of array `arrObj`
+static bool vmArrayIndex(
+    PVm *vm, PValue indexVal, const struct OArray *arrObj, u64 *out
+) {
+    if (IsValueInt(indexVal) && ValueAsInt(indexVal) >= 0 &&
+        (u64)ValueAsInt(indexVal) < arrObj->count) {
+        *out = (u64)ValueAsInt(indexVal);
+        return true;
     }
-}
-
-static bool vmArraySubscript(PVm *vm, PValue target, bool assign) {
-
-    PValue indexVal = vmGetSubIndex(vm, assign);
-
     if (!IsValueNum(indexVal)) {
         VmError(vm, RT_INVALID_ARR_INDEX_NOTNUM, ValueTypeToStr(indexVal));
         return false;
@@ -476,93 +774,106 @@ static bool vmArraySubscript(PVm *vm, PValue target, bool assign) {
     }
     u64 index = (u64)floor(dblIndex);
 
-    struct OArray *arrObj = &ValueAsObj(target)->v.OArray;
-
     if (index >= arrObj->count) {
         u64 maxIndex = arrObj->count == 0 ? 0 : arrObj->count - 1;
         VmError(vm, RT_ARR_INDEX_OUT_RANGE, maxIndex, index);
         return false;
     }
 
-    PValue result = MakeNil();
-
-    if (assign) {
-        result = VmPeek(vm, 0);
-        arrObj->items[index] = result;
-        VmPop(vm); // new value
-        VmPop(vm); // index
-        VmPop(vm); // target
-    } else {
-        result = arrObj->items[index];
-        VmPop(vm); // index
-        VmPop(vm); // target
-    }
-
-    VmPush(vm, result);
+    *out = index;
     return true;
 }
 
-static bool vmMapSubscript(PVm *vm, PValue target, bool assign) {
-    PValue keyVal = vmGetSubIndex(vm, assign);
-
-    if (!CanValueBeKey(keyVal)) {
-        VmError(vm, RT_INVALID_MAP_KEY, ValueTypeToStr(keyVal));
-        return false;
-    }
+// `target[indexVal]` of an array or map
+static bool vmIndexGet(PVm *vm, PValue target, PValue indexVal, PValue *out) {
+    if (IsValueObjType(target, OT_ARR)) {
+        struct OArray *arrObj = &ValueAsObj(target)->v.OArray;
+        u64 index = 0;
+        if (!vmArrayIndex(vm, indexVal, arrObj, &index)) {
+            return false;
+        }
+        *out = arrObj->items[index];
+        return true;
+    } else if (IsValueObjType(target, OT_MAP)) {
+        if (!CanValueBeKey(indexVal)) {
+            VmError(vm, RT_INVALID_MAP_KEY, ValueTypeToStr(indexVal));
+            return false;
+        }
 
-    u64 keyHash = GetValueHash(keyVal, vm->gc->timestamp);
-    PObj *mapObj = ValueAsObj(target);
-    PValue result;
-    if (assign) {
-        PValue newValue = VmPeek(vm, 0);
-        MapObjSetValue(mapObj, keyVal, keyHash, newValue);
-        VmPop(vm); // new value
-        VmPop(vm); // key
-        VmPop(vm); // target : map
-        result = newValue;
-    } else {
+        u64 keyHash = GetValueHash(indexVal, vm->gc->timestamp);
         bool found = false;
-        result = MapObjGetValue(ValueAsObj(target), keyVal, keyHash, &found);
+        *out = MapObjGetValue(ValueAsObj(target), indexVal, keyHash, &found);
         if (!found) {
             VmError(vm, RT_MAP_KEY_NOT_FOUND);
             return false;
         }
-        VmPop(vm); // key
-        VmPop(vm); // target
+        return true;
     }
 
-    VmPush(vm, result);
-    return true;
+    VmError(vm, RT_INVALID_SUBS_TARGET, ValueTypeToStr(target));
+    return false;
 }
 
-static bool vmSubscript(PVm *vm) {
-    PValue targetVal = VmPeek(vm, 1);
+// `target[indexVal] = value` of an array or map
+static bool vmIndexSet(PVm *vm, PValue target, PValue indexVal, PValue value) {
+    if (IsValueObjType(target, OT_ARR)) {
+        struct OArray *arrObj = &ValueAsObj(target)->v.OArray;
+        u64 index = 0;
+        if (!vmArrayIndex(vm, indexVal, arrObj, &index)) {
+            return false;
+        }
+        value = ArrayItemValue(value);
+        arrObj->items[index] = value;
+        ArrayObjTrackKind(arrObj, value);
+        return true;
+    } else if (IsValueObjType(target, OT_MAP)) {
+        if (!CanValueBeKey(indexVal)) {
+            VmError(vm, RT_INVALID_MAP_KEY, ValueTypeToStr(indexVal));
+            return false;
+        }
 
-    if (IsValueObjType(targetVal, OT_ARR)) {
-        return vmArraySubscript(vm, targetVal, false);
-    } else if (IsValueObjType(targetVal, OT_MAP)) {
-        return vmMapSubscript(vm, targetVal, false);
-    } else {
-        VmError(vm, RT_INVALID_SUBS_TARGET, ValueTypeToStr(targetVal));
+        u64 keyHash = GetValueHash(indexVal, vm->gc->timestamp);
+        MapObjSetValue(ValueAsObj(target), indexVal, keyHash, value);
+        return true;
+    }
+
+    VmError(vm, RT_INVALID_SUBASSIGN, ValueTypeToStr(target));
+    return false;
+}
+
+static bool vmSubscript(PVm *vm) {
+    PValue result;
+    if (!vmIndexGet(vm, VmPeek(vm, 1), VmPeek(vm, 0), &result)) {
         return false;
     }
+    vmPop(vm); // index
+    vmPop(vm); // target
+    vmPush(vm, result);
+    return true;
 }
 
 static bool vmSubscriptAssign(PVm *vm) {
-    PValue targetVal = VmPeek(vm, 2);
-
-    if (IsValueObjType(targetVal, OT_ARR)) {
-        return vmArraySubscript(vm, targetVal, true);
-    } else if (IsValueObjType(targetVal, OT_MAP)) {
-        return vmMapSubscript(vm, targetVal, true);
-    } else {
-        VmError(vm, RT_INVALID_SUBASSIGN, ValueTypeToStr(targetVal));
+    PValue newValue = VmPeek(vm, 0);
+    if (!vmIndexSet(vm, VmPeek(vm, 2), VmPeek(vm, 1), newValue)) {
         return false;
     }
+    vmPop(vm); // new value
+    vmPop(vm); // index
+    vmPop(vm); // target
+    vmPush(vm, newValue);
+    return true;
+}
+
+// Writing global `nameObj`, intrinsics are turned off if any stands for it.
+// See `OP_LEN`
+static finline void vmWriteGlobal(PVm *vm, PObj *nameObj) {
+    if (nameObj->v.OString.intrinsic) {
+        vm->intrinsicsOff = true;
+    }
 }
 
-static bool vmImportModule(PVm *vm, PValue name) {
-    PValue importPath = VmPeek(vm, 0);
+// Import module from `importPath` as global `name`
+static bool vmImportModule(PVm *vm, PValue name, PValue importPath) {
     if (!IsValueObjType(importPath, OT_STR)) {
         VmError(vm, RT_INVALID_IMPORT_PATH, ValueTypeToStr(importPath));
         return false;
@@ -577,54 +888,219 @@ static bool vmImportModule(PVm *vm, PValue name) {
         return false;
     }
 
-    PModule *mod = NewModule(vm, pathStr);
-
-    if (mod == NULL) {
-        VmError(vm, RT_IME_MODULE);
-        return false;
+    // Members of a module don't change once it is imported, importing it
+    // again shares its table
+    PModule *mod = vmFindModule(vm, pathStr);
+    bool loaded = mod != NULL;
+    if (!loaded) {
+        mod = NewModule(vm, pathStr);
+        if (mod == NULL) {
+            VmError(vm, RT_IME_MODULE);
+            return false;
+        }
+        PushModule(vm, mod);
     }
 
-    PushModule(vm, mod);
     PObj *nameObj = ValueAsObj(name);
+    // Importing a module for the first time is what intrinsics expect
+    if (SymbolTableHasKey(vm->globals, nameObj)) {
+        vmWriteGlobal(vm, nameObj);
+    }
     u64 key = nameObj->v.OString.hash;
-    PushProxy(vm, key, nameObj->v.OString.name->lexeme, mod);
+    PushProxy(vm, key, nameObj->v.OString.value, mod);
+    vm->modStamp++;
 
-    PushStdlib(vm, mod->table, mod->pathname, stdmod);
+    if (!loaded) {
+        PushStdlib(vm, mod->table, mod->pathname, stdmod);
+    }
 
     PObj *modObject =
         NewModuleObject(vm->gc, nameObj->v.OString.value, pathStr);
     SymbolTableSet(vm->globals, nameObj, MakeObject(modObject));
-    VmPop(vm); // remove the importPath
 
     return true;
 }
 
-static PObj *vmCaptureUpval(PVm *vm, PValue *local) {
-
-    PObj *prevUpval = NULL;
-    PObj *upval = vm->openUpvals;
-
-    while (upval != NULL && upval->v.OUpval.location > local) {
-        prevUpval = upval;
-        upval = upval->v.OUpval.next;
+// Member `child` of module `moduleVal`
+static bool vmModGet(PVm *vm, PValue moduleVal, PValue child, PValue *out) {
+    if (!IsValueObjType(moduleVal, OT_MODULE)) {
+        VmError(vm, RT_ONLY_MOD_CHILD, ValueTypeToStr(moduleVal));
+        return false;
     }
-
-    if (upval != NULL && upval->v.OUpval.location == local) {
-        return upval;
+    if (!IsValueObjType(child, OT_STR)) {
+        VmError(vm, RT_INVALID_MOD_CHILD, ValueTypeToStr(child));
+        return false;
+    }
+    PObj *childObj = ValueAsObj(child);
+    PObj *modObj = ValueAsObj(moduleVal);
+    u64 nameHash = modObj->v.OModule.nameHash;
+    if (hmgeti(vm->modProxies, nameHash) < 0) {
+        VmError(vm, RT_UNKNOWN_MOD, modObj->v.OModule.path);
     }
 
-    PObj *newUpval = NewUpvalueObject(vm->gc, local);
+    ModProxyEntry proxy = hmgets(vm->modProxies, nameHash);
 
-    if (newUpval == NULL) {
-        VmError(vm, RT_IME_CLOSURE);
-        return NULL;
+    PModule *module = proxy.mod;
+    bool found = false;
+    *out = SymbolTableFind(module->table, childObj, &found);
+    if (!found) {
+        PrintObject(childObj);
+        VmError(vm, RT_UNKNOWN_CHILD);
+        return false;
     }
+    return true;
+}
 
-    newUpval->v.OUpval.next = upval;
-    if (prevUpval == NULL) {
-        vm->openUpvals = newUpval;
-    } else {
-        prevUpval->v.OUpval.next = newUpval;
+// Member with constant name `child` of module `moduleVal`, for `OP_MODGET`
+// of bytecode `bt`. Members found are cached, a module's members don't change
+// once it is imported
+static finline bool vmModGetCached(
+    PVm *vm, PBytecode *bt, PValue moduleVal, u16 child, PValue *out
+) {
+    if (bt->modCaches == NULL) {
+        bt->modCaches = PCalloc(bt->constCount, sizeof(PModCache));
+    }
+    PModCache *cache = bt->modCaches == NULL ? NULL : &bt->modCaches[child];
+    if (cache != NULL && IsValueObjType(moduleVal, OT_MODULE) &&
+        cache->stamp == vm->modStamp &&
+        cache->nameHash == ValueAsObj(moduleVal)->v.OModule.nameHash) {
+        *out = cache->value;
+        return true;
+    }
+    if (!vmModGet(vm, moduleVal, bt->constPool[child], out)) {
+        return false;
+    }
+    if (cache != NULL) {
+        cache->nameHash = ValueAsObj(moduleVal)->v.OModule.nameHash;
+        cache->stamp = vm->modStamp;
+        cache->value = *out;
+    }
+    return true;
+}
+
+// Intrinsics, see `OP_LEN`.
+
+// Number of arguments of intrinsic `op`
+static finline int vmIntrinsicArgc(PanOpCode op) {
+    return op == OP_APPEND ? 2 : 1;
+}
+
+// Run intrinsic `op` on arguments `args` without calling the function.
+// Returns false if it can't, when intrinsics are off or the arguments need
+// the checks and errors of the function
+static finline bool vmIntrinsic(
+    PVm *vm, PanOpCode op, const PValue *args, PValue *out
+) {
+    if (vm->intrinsicsOff) {
+        return false;
+    }
+    switch (op) {
+        case OP_LEN: {
+            if (!IsValueObj(args[0]) || !ObjectHasLen(ValueAsObj(args[0]))) {
+                return false;
+            }
+            *out = MakeIntOrNumber(GetObjectLength(ValueAsObj(args[0])));
+            return true;
+        }
+        case OP_APPEND: {
+            if (!IsValueObjType(args[0], OT_ARR) ||
+                !ArrayObjPushValue(ValueAsObj(args[0]), args[1])) {
+                return false;
+            }
+            u64 count = ValueAsObj(args[0])->v.OArray.count;
+            *out = MakeIntOrNumber((double)count);
+            return true;
+        }
+        case OP_SQRT: {
+            if (!IsValueNum(args[0])) {
+                return false;
+            }
+            *out = MakeNumber(sqrt(ValueAsNum(args[0])));
+            return true;
+        }
+        default: return false;
+    }
+}
+
+// Function which intrinsic at `offset` of stack bytecode `bt` stands for
+static bool vmIntrinsicCallee(
+    PVm *vm, const PBytecode *bt, u64 offset, PValue *out
+) {
+    PObj *nameObj = ValueAsObj(bt->constPool[ReadU16(bt, offset + 1)]);
+    bool found = false;
+    PValue callee = SymbolTableFind(vm->globals, nameObj, &found);
+    if (!found) {
+        VmError(vm, RT_UNDEF_GET_VAR, nameObj->v.OString.value);
+        return false;
+    }
+    if (bt->code[offset] == OP_SQRT) {
+        return vmModGet(
+            vm, callee, bt->constPool[ReadU16(bt, offset + 3)], out
+        );
+    }
+    *out = callee;
+    return true;
+}
+
+// Call the function which intrinsic `op` of `frame` stands for, the way
+// `OP_CALL` does. Its `argc` arguments are on the stack, the compiler left
+// room to put the callee below them
+static bool vmIntrinsicCall(
+    PVm *vm, PCallFrame *frame, PanOpCode op, int argc
+) {
+    PBytecode *code = frame->fn->v.OComFunction.code;
+    u64 offset = (u64)(frame->ip - code->code) - 1;
+    frame->ip += op == OP_SQRT ? 4 : 2;
+    PValue callee;
+    if (!vmIntrinsicCallee(vm, code, offset, &callee)) {
+        return false;
+    }
+    if (!IsValueObjType(callee, OT_CLOSURE) &&
+        !IsValueObjType(callee, OT_NATIVE) &&
+        !IsValueObjType(callee, OT_COMFNC)) {
+        VmError(vm, RT_INVALID_CALLEE, ValueTypeToStr(callee));
+        return false;
+    }
+
+    memmove(vm->sp - argc + 1, vm->sp - argc, sizeof(PValue) * (u64)argc);
+    vm->sp[-argc] = callee;
+    vm->sp++;
+    if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+        return false;
+    }
+    if (!vmCallValue(vm, callee, argc)) {
+        VmError(vm, RT_CALL_FAIL);
+        return false;
+    }
+    return true;
+}
+
+static PObj *vmCaptureUpval(PVm *vm, PValue *local) {
+
+    PObj *prevUpval = NULL;
+    PObj *upval = vm->openUpvals;
+
+    while (upval != NULL && upval->v.OUpval.location > local) {
+        prevUpval = upval;
+        upval = upval->v.OUpval.next;
+    }
+
+    if (upval != NULL && upval->v.OUpval.location == local) {
+        return upval;
+    }
+
+    PObj *newUpval = NewUpvalueObject(vm->gc, local);
+
+    if (newUpval == NULL) {
+        VmError(vm, RT_IME_CLOSURE);
+        return NULL;
+    }
+
+    newUpval->v.OUpval.next = upval;
+    if (prevUpval == NULL) {
+        vm->openUpvals = newUpval;
+    } else {
+        prevUpval->v.OUpval.next = newUpval;
     }
     return newUpval;
 }
@@ -699,6 +1175,46 @@ static void closeUpvals(PVm *vm, PValue *last) {
     }
 }
 
+void VmReset(PVm *vm) {
+    closeUpvals(vm, vm->stack);
+    vm->sp = vm->stack;
+    vm->frameCount = 0;
+    vm->traceDepth = 0;
+#if defined(PANKTI_JIT)
+    vm->jitDepth = 0;
+#endif
+}
+
+// Replace current frame `frame` with a call to closure `clsObj`, used by
+// `OP_TAIL_CALL`. The callee and arguments on top of the stack are moved down
+// to the slots of the current frame
+static bool vmTailCallFunction(
+    PVm *vm, PCallFrame *frame, PObj *clsObj, int argCount
+) {
+    struct OClosure *cls = &clsObj->v.OClosure;
+    struct OComFunction *fn = &cls->function->v.OComFunction;
+    if (fn->paramCount != (u64)argCount) {
+        VmError(vm, RT_ARG_PARAM_NOTEQ, fn->paramCount, (u64)argCount);
+        return false;
+    }
+
+    // locals of current frame are going away
+    if (frame->capturesLocals) {
+        closeUpvals(vm, frame->slots);
+    }
+
+    PValue *callee = vm->sp - argCount - 1;
+    memmove(frame->slots, callee, sizeof(PValue) * (u64)(argCount + 1));
+    vm->sp = frame->slots + argCount + 1;
+
+    frame->cls = clsObj;
+    frame->fn = cls->function;
+    frame->ip = fn->code->code;
+    frame->outer = NULL;
+    frame->capturesLocals = fn->capturesLocals;
+    return vmEnsureStack(vm, frame->slots, fn->code->maxStack);
+}
+
 static finline u8 vmReadByte(PVm *vm, PCallFrame *frame) {
     return *frame->ip++;
 }
@@ -708,9 +1224,14 @@ static finline u16 vmReadU16(PVm *vm, PCallFrame *frame) {
     return ((u16)(frame->ip[-2] << 8) | (u16)(frame->ip[-1]));
 }
 
+static finline u32 vmReadU24(PVm *vm, PCallFrame *frame) {
+    frame->ip += 3;
+    return ((u32)frame->ip[-3] << 16) | ((u32)frame->ip[-2] << 8) |
+           (u32)frame->ip[-1];
+}
+
 static finline PValue vmReadConst(PVm *vm, PCallFrame *frame) {
-    return frame->cls->v.OClosure.function->v.OComFunction.code
-        ->constPool[vmReadU16(vm, frame)];
+    return frame->fn->v.OComFunction.code->constPool[vmReadU16(vm, frame)];
     // return frame->f->v.OComFunction.code->constPool[vmReadU16(vm, frame)];
 }
 
@@ -721,57 +1242,66 @@ static finline PObj *vmReadObjConst(PVm *vm, PCallFrame *frame) {
     );
 }
 
-void VmRun(PVm *vm) {
-    if (vm->errCtx.report == NULL) {
-        PanPrint(
-            "Fatal Internal Error : VM Started Running Before Error Context "
-            "Was Set\n"
-        );
-        exit(EXIT_FAILURE);
-    }
+// Run the dispatch loop until the frame at `baseFrame` returns. The returned
+// value is left on top of the stack.
+// When `baseFrame` is 0, the loop runs the whole script.
+static void vmRunLoop(PVm *vm, int baseFrame) {
     PCallFrame *frame = &vm->frames[vm->frameCount - 1];
     while (true) {
         u8 ins;
+#if defined(PANKTI_BUILD_DEBUG)
+        vm->insCount++;
+#endif
 
         switch (ins = vmReadByte(vm, frame)) {
             case OP_RETURN: {
-                PValue result = VmPop(vm);
-                closeUpvals(vm, frame->slots);
+                PValue result = vmPop(vm);
+                if (frame->capturesLocals) {
+                    closeUpvals(vm, frame->slots);
+                }
                 vm->frameCount--;
                 if (vm->frameCount == 0) {
-                    VmPop(vm);
+                    vmPop(vm);
                     return;
                 }
                 vm->sp = frame->slots;
-                VmPush(vm, result);
+                vmPush(vm, result);
+                if (vm->frameCount == baseFrame) {
+                    return;
+                }
                 frame = &vm->frames[vm->frameCount - 1];
                 break;
             }
             case OP_DEBUG: {
-                PrintValue(VmPop(vm));
+                PrintValue(vmPop(vm));
                 PanPrint("\n");
                 break;
             }
 
             case OP_CONST: {
                 PValue val = vmReadConst(vm, frame);
-                VmPush(vm, val);
+                vmPush(vm, val);
+                break;
+            }
+            case OP_CONST_LONG: {
+                const PBytecode *bt = frame->fn->v.OComFunction.code;
+                vmPush(vm, bt->constPool[vmReadU24(vm, frame)]);
                 break;
             }
             case OP_POP: {
-                VmPop(vm);
+                vmPop(vm);
                 break;
             }
             case OP_TRUE: {
-                VmPush(vm, MakeBool(true));
+                vmPush(vm, MakeBool(true));
                 break;
             }
             case OP_FALSE: {
-                VmPush(vm, MakeBool(false));
+                vmPush(vm, MakeBool(false));
                 break;
             }
             case OP_NIL: {
-                VmPush(vm, MakeNil());
+                vmPush(vm, MakeNil());
                 break;
             }
 
@@ -789,13 +1319,13 @@ void VmRun(PVm *vm) {
             case OP_NOTEQUAL: {
                 PValue b = VmPeek(vm, 0);
                 PValue a = VmPeek(vm, 1);
-                bool result = IsValueEqual(a, b);
+                bool result = vmEqual(a, b);
                 if (ins == OP_NOTEQUAL) {
                     result = !result;
                 }
-                VmPop(vm);
-                VmPop(vm);
-                VmPush(vm, MakeBool(result));
+                vmPop(vm);
+                vmPop(vm);
+                vmPush(vm, MakeBool(result));
                 break;
             }
             case OP_GT:
@@ -811,12 +1341,12 @@ void VmRun(PVm *vm) {
                     break;
                 }
 
-                VmPush(vm, MakeNumber(-ValueAsNum(VmPop(vm))));
+                vmPush(vm, vmNegNumber(vmPop(vm)));
                 break;
             }
 
             case OP_NOT: {
-                VmPush(vm, MakeBool(!IsValueTruthy(VmPop(vm))));
+                vmPush(vm, MakeBool(!IsValueTruthy(vmPop(vm))));
                 break;
             }
             case OP_DEFINE_GLOBAL: {
@@ -829,9 +1359,10 @@ void VmRun(PVm *vm) {
                     break;
                 }
 
+                vmWriteGlobal(vm, nameObj);
                 SymbolTableSet(vm->globals, nameObj, VmPeek(vm, 0));
 
-                VmPop(vm);
+                vmPop(vm);
                 break;
             }
             case OP_GET_GLOBAL: {
@@ -843,7 +1374,7 @@ void VmRun(PVm *vm) {
                     return;
                 }
 
-                VmPush(vm, val);
+                vmPush(vm, val);
                 break;
             }
 
@@ -851,6 +1382,7 @@ void VmRun(PVm *vm) {
                 PObj *nameObj = vmReadObjConst(vm, frame);
                 bool found = SymbolTableHasKey(vm->globals, nameObj);
                 if (found) {
+                    vmWriteGlobal(vm, nameObj);
                     SymbolTableSet(vm->globals, nameObj, VmPeek(vm, 0));
                     break;
                 } else {
@@ -862,7 +1394,7 @@ void VmRun(PVm *vm) {
 
             case OP_GET_LOCAL: {
                 u16 localStackIndex = vmReadU16(vm, frame);
-                VmPush(vm, frame->slots[localStackIndex]);
+                vmPush(vm, frame->slots[localStackIndex]);
                 break;
             }
             case OP_SET_LOCAL: {
@@ -889,7 +1421,7 @@ void VmRun(PVm *vm) {
                 if (!IsValueTruthy(VmPeek(vm, 0))) {
                     frame->ip += offset;
                 } else {
-                    VmPop(vm);
+                    vmPop(vm);
                 }
                 break;
             }
@@ -899,7 +1431,7 @@ void VmRun(PVm *vm) {
                 if (IsValueTruthy(VmPeek(vm, 0))) {
                     frame->ip += offset;
                 } else {
-                    VmPop(vm);
+                    vmPop(vm);
                 }
                 break;
             }
@@ -907,20 +1439,48 @@ void VmRun(PVm *vm) {
             case OP_LOOP: {
                 u16 offset = vmReadU16(vm, frame);
                 frame->ip -= offset;
+#if defined(PANKTI_JIT)
+                if (vmJitHot(vm, frame->fn)) {
+                    PBytecode *code = frame->fn->v.OComFunction.code;
+                    u32 pc = code->reg->entry[frame->ip - code->code];
+                    if (pc == REG_PC_UNSET) {
+                        break;
+                    }
+                    // Rest of the frame runs as native code
+                    if (!vmJitEnterFrame(vm, frame, pc)) {
+                        return;
+                    }
+                    if (vm->frameCount == 0 || vm->frameCount == baseFrame) {
+                        return;
+                    }
+                    frame = &vm->frames[vm->frameCount - 1];
+                    break;
+                }
+#endif
+                PBytecode *code = frame->fn->v.OComFunction.code;
+                if (code->loopHits != TRACE_NEVER &&
+                    vmTraceAllowed(vm, code) &&
+                    ++code->loopHits >= vm->traceThreshold &&
+                    vmRegEnterFrame(vm, frame)) {
+                    if (vm->frameCount == 0 || vm->frameCount == baseFrame) {
+                        return;
+                    }
+                    frame = &vm->frames[vm->frameCount - 1];
+                }
                 break;
             }
             case OP_CALL: {
                 u16 argCount = vmReadU16(vm, frame);
                 PValue callee = VmPeek(vm, argCount);
                 if (!IsValueObjType(callee, OT_CLOSURE) &&
-                    !IsValueObjType(callee, OT_NATIVE)) {
+                    !IsValueObjType(callee, OT_NATIVE) &&
+                    !IsValueObjType(callee, OT_COMFNC)) {
                     // VmError(vm, "Can only call functions");
                     VmError(vm, RT_INVALID_CALLEE, ValueTypeToStr(callee));
                     return;
                 }
 
-                if (vm->frameCount >= PVM_FRAMESTACK_SIZE) {
-                    VmError(vm, RT_CALLSTACK_OVERFLOW);
+                if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
                     return;
                 }
 
@@ -934,6 +1494,41 @@ void VmRun(PVm *vm) {
                 break;
             }
 
+            case OP_TAIL_CALL: {
+                u16 argCount = vmReadU16(vm, frame);
+                PValue callee = VmPeek(vm, argCount);
+                if (IsValueObjType(callee, OT_CLOSURE)) {
+                    if (!vmTailCallFunction(
+                            vm, frame, ValueAsObj(callee), argCount
+                        )) {
+                        VmError(vm, RT_CALL_FAIL);
+                        return;
+                    }
+                    break;
+                }
+
+                // Natives don't have frames, and direct functions need the
+                // current frame as their outer frame. Call them normally,
+                // the following `OP_RETURN` returns the result
+                if (!IsValueObjType(callee, OT_NATIVE) &&
+                    !IsValueObjType(callee, OT_COMFNC)) {
+                    VmError(vm, RT_INVALID_CALLEE, ValueTypeToStr(callee));
+                    return;
+                }
+
+                if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+                    return;
+                }
+
+                if (!vmCallValue(vm, callee, argCount)) {
+                    VmError(vm, RT_CALL_FAIL);
+                    return;
+                }
+
+                frame = &vm->frames[vm->frameCount - 1];
+                break;
+            }
+
             case OP_CLOSURE: {
                 PValue funcVal = vmReadConst(vm, frame);
                 if (!IsValueObjType(funcVal, OT_COMFNC)) {
@@ -949,22 +1544,22 @@ void VmRun(PVm *vm) {
                 struct OClosure *cls = &objClosure->v.OClosure;
 
                 for (i16 i = 0; i < cls->upvalCount; i++) {
-                    u16 isLocal = vmReadU16(vm, frame);
-                    u16 index = vmReadU16(vm, frame);
-                    if (isLocal) {
+                    u8 flags = vmReadByte(vm, frame);
+                    u8 index = vmReadByte(vm, frame);
+                    if (flags & CLOSURE_UPVAL_LOCAL) {
                         cls->upvals[i] =
                             vmCaptureUpval(vm, frame->slots + index);
                     } else {
                         cls->upvals[i] = frame->cls->v.OClosure.upvals[index];
                     }
                 }
-                VmPush(vm, MakeObject(objClosure));
+                vmPush(vm, MakeObject(objClosure));
                 break;
             }
 
             case OP_GET_UPVAL: {
                 u16 slot = vmReadU16(vm, frame);
-                VmPush(
+                vmPush(
                     vm, *frame->cls->v.OClosure.upvals[slot]->v.OUpval.location
                 );
                 break;
@@ -977,9 +1572,21 @@ void VmRun(PVm *vm) {
                 break;
             }
 
+            case OP_GET_OUTER: {
+                u16 slot = vmReadU16(vm, frame);
+                vmPush(vm, frame->outer[slot]);
+                break;
+            }
+
+            case OP_SET_OUTER: {
+                u16 slot = vmReadU16(vm, frame);
+                frame->outer[slot] = VmPeek(vm, 0);
+                break;
+            }
+
             case OP_CLS_UPVAL: {
                 closeUpvals(vm, vm->sp - 1);
-                VmPop(vm);
+                vmPop(vm);
                 break;
             }
 
@@ -987,10 +1594,12 @@ void VmRun(PVm *vm) {
                 u16 itemCount = vmReadU16(vm, frame);
                 PValue *items = NULL;
                 if (itemCount > 0) {
+                    // items are already in order on top of stack
                     arrsetlen(items, itemCount);
-                }
-                for (u16 i = itemCount; i > 0; i--) {
-                    items[i - 1] = VmPop(vm);
+                    memcpy(
+                        items, vm->sp - itemCount, sizeof(PValue) * itemCount
+                    );
+                    vm->sp -= itemCount;
                 }
                 PObj *arrObj = NewArrayObject(vm->gc, NULL, items, itemCount);
                 if (arrObj == NULL) {
@@ -998,7 +1607,7 @@ void VmRun(PVm *vm) {
                     VmError(vm, RT_IME_ARRAY);
                     return;
                 }
-                VmPush(vm, MakeObject(arrObj));
+                vmPush(vm, MakeObject(arrObj));
                 break;
             }
 
@@ -1029,7 +1638,7 @@ void VmRun(PVm *vm) {
                 }
                 mapObj->v.OMap.count = pairCount;
                 mapObj->v.OMap.table = entries;
-                VmPush(vm, MakeObject(mapObj));
+                vmPush(vm, MakeObject(mapObj));
                 break;
             }
             case OP_SUBSCRIPT: {
@@ -1042,45 +1651,995 @@ void VmRun(PVm *vm) {
             }
             case OP_IMPORT: {
                 PValue name = vmReadConst(vm, frame);
-                vmImportModule(vm, name);
+                if (vmImportModule(vm, name, VmPeek(vm, 0))) {
+                    vmPop(vm); // remove the importPath
+                }
                 break;
             }
             case OP_MODGET: {
-                PValue child = vmReadConst(vm, frame);
-                PValue moduleVal = VmPeek(vm, 0);
-                if (!IsValueObjType(moduleVal, OT_MODULE)) {
-                    VmError(vm, RT_ONLY_MOD_CHILD, ValueTypeToStr(moduleVal));
-                    return;
-                }
-                if (!IsValueObjType(child, OT_STR)) {
-                    VmError(vm, RT_INVALID_MOD_CHILD, ValueTypeToStr(child));
+                u16 child = vmReadU16(vm, frame);
+                PValue childResult;
+                if (!vmModGetCached(
+                        vm, frame->fn->v.OComFunction.code, VmPeek(vm, 0),
+                        child, &childResult
+                    )) {
                     return;
                 }
-                PObj *childObj = ValueAsObj(child);
-                PObj *modObj = ValueAsObj(moduleVal);
-                u64 nameHash = modObj->v.OModule.nameHash;
-                if (hmgeti(vm->modProxies, nameHash) < 0) {
-                    VmError(vm, RT_UNKNOWN_MOD, modObj->v.OModule.path);
-                }
+                vmPop(vm);
 
-                ModProxyEntry proxy = hmgets(vm->modProxies, nameHash);
+                vmPush(vm, childResult);
 
-                PModule *module = proxy.mod;
-                bool found = false;
-                PValue childResult =
-                    SymbolTableFind(module->table, childObj, &found);
-                if (!found) {
-                    PrintObject(childObj);
-                    VmError(vm, RT_UNKNOWN_CHILD);
+                break;
+            }
+            case OP_LEN:
+            case OP_APPEND:
+            case OP_SQRT: {
+                PanOpCode op = (PanOpCode)ins;
+                int argc = vmIntrinsicArgc(op);
+                PValue result;
+                if (vmIntrinsic(vm, op, vm->sp - argc, &result)) {
+                    frame->ip += op == OP_SQRT ? 4 : 2;
+                    vm->sp -= argc;
+                    vmPush(vm, result);
                     break;
                 }
-                VmPop(vm);
-
-                VmPush(vm, childResult);
-
+                if (!vmIntrinsicCall(vm, frame, op, argc)) {
+                    return;
+                }
+                frame = &vm->frames[vm->frameCount - 1];
                 break;
             }
         } // switch
         CollectGarbage(vm->gc);
     } // while true
 }
+
+// ============ Register Engine ============
+//
+// Runs register bytecode (see regcode.h). A frame's registers are its stack
+// slots, and `vm->sp` is kept at the frame's `top` so garbage collector marks
+// every register. Calls pass the callee and arguments in consecutive
+// registers, which become slot 0 and parameters of the new frame, same as the
+// stack engine.
+
+// Translate function `fnObj` to register bytecode, if not already done
+static bool vmRegTranslate(PVm *vm, PObj *fnObj) {
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    if (fn->code->reg != NULL) {
+        return true;
+    }
+
+    fn->code->reg = RegTranslate(fn->code, fn->paramCount);
+    if (fn->code->reg == NULL) {
+        VmError(vm, RT_IME_REG_TRANSLATE);
+        return false;
+    }
+#if defined(PANKTI_BUILD_DEBUG)
+    if (FLAG_DEBUG_BYTECODE) {
+        DebugRegCode(fn->code->reg, fn->code);
+    }
+#endif
+    return true;
+}
+
+// Set stack top of register frame `frame`. Registers from `written` up to
+// the new top which are above the current stack pointer may hold stale
+// values, which garbage collector hasn't been marking, so they are cleared
+static void vmRegSetTop(PVm *vm, PCallFrame *frame, PValue *written) {
+    PValue *top = frame->slots + frame->fn->v.OComFunction.code->maxStack;
+    if (top < vm->sp) {
+        top = vm->sp;
+    }
+    for (PValue *slot = written > vm->sp ? written : vm->sp; slot < top;
+         slot++) {
+        *slot = MakeNil();
+    }
+    frame->top = top;
+    vm->sp = top;
+}
+
+// Push frame for function `fnObj` whose callee and arguments are in `slots`.
+// `clsObj` is NULL for direct functions
+static bool vmRegPushFrame(
+    PVm *vm, PObj *clsObj, PObj *fnObj, PValue *slots, int argCount,
+    PValue *outer
+) {
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    if (fn->paramCount != (u64)argCount) {
+        VmError(vm, RT_ARG_PARAM_NOTEQ, fn->paramCount, (u64)argCount);
+        return false;
+    }
+    if (!vmRegTranslate(vm, fnObj) ||
+        !vmEnsureStack(vm, slots, fn->code->maxStack)) {
+        return false;
+    }
+
+    PCallFrame *frame = &vm->frames[vm->frameCount++];
+    frame->cls = clsObj;
+    frame->fn = fnObj;
+    frame->rip = fn->code->reg->code;
+    frame->slots = slots;
+    frame->outer = outer;
+    frame->capturesLocals = fn->capturesLocals;
+#if defined(PANKTI_JIT)
+    PValue *callerSp = vm->sp;
+    vmRegSetTop(vm, frame, slots + argCount + 1);
+    if (vmJitHot(vm, fnObj)) {
+        // Runs to completion, same as a native function
+        bool ok = vmJitEnterFrame(vm, frame, 0);
+        vm->sp = callerSp;
+        return ok;
+    }
+#else
+    vmRegSetTop(vm, frame, slots + argCount + 1);
+#endif
+    return true;
+}
+
+// Call the callee in `slots[0]` with `argCount` arguments after it. Functions
+// get a new frame, natives are run right away and their result is stored in
+// `slots[0]`
+static bool vmRegCall(PVm *vm, PValue *slots, int argCount) {
+    PValue callee = slots[0];
+    if (IsValueObjType(callee, OT_CLOSURE)) {
+        PObj *clsObj = ValueAsObj(callee);
+        return vmRegPushFrame(
+            vm, clsObj, clsObj->v.OClosure.function, slots, argCount, NULL
+        );
+    } else if (IsValueObjType(callee, OT_NATIVE)) {
+        return vmNativeCall(
+            vm, ValueAsObj(callee), slots + 1, argCount, &slots[0]
+        );
+    } else if (IsValueObjType(callee, OT_COMFNC)) {
+        PValue *outer = vm->frames[vm->frameCount - 1].slots;
+        return vmRegPushFrame(
+            vm, NULL, ValueAsObj(callee), slots, argCount, outer
+        );
+    }
+
+    VmError(vm, RT_INVALID_CALLEE, ValueTypeToStr(callee));
+    return false;
+}
+
+// Replace `frame` with a call to closure `clsObj`, whose callee and
+// arguments are in `callee`
+static bool vmRegTailCall(
+    PVm *vm, PCallFrame *frame, PObj *clsObj, PValue *callee, int argCount
+) {
+    PObj *fnObj = clsObj->v.OClosure.function;
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    if (fn->paramCount != (u64)argCount) {
+        VmError(vm, RT_ARG_PARAM_NOTEQ, fn->paramCount, (u64)argCount);
+        return false;
+    }
+    if (!vmRegTranslate(vm, fnObj) ||
+        !vmEnsureStack(vm, frame->slots, fn->code->maxStack)) {
+        return false;
+    }
+
+    // locals of current frame are going away
+    if (frame->capturesLocals) {
+        closeUpvals(vm, frame->slots);
+    }
+    memmove(frame->slots, callee, sizeof(PValue) * (u64)(argCount + 1));
+
+    frame->cls = clsObj;
+    frame->fn = fnObj;
+    frame->rip = fn->code->reg->code;
+    frame->outer = NULL;
+    frame->capturesLocals = fn->capturesLocals;
+    vmRegSetTop(vm, frame, frame->slots + argCount + 1);
+    return true;
+}
+
+static finline PValue vmRegRK(const PValue *regs, const PValue *consts, u16 x) {
+    return (x & REG_CONST_BIT) ? consts[x & REG_RK_MAX] : regs[x];
+}
+
+#define REG_RK(x) vmRegRK(regs, consts, (x))
+
+// Run intrinsic `ins` of register frame `frame`. If the function it stands
+// for has to be called instead, sets `callArgc` to its argument count and
+// puts the callee in R(a) and the arguments after it, ready for
+// `vmRegCall`, else sets it to 0. Returns false if an error was reported
+static finline bool vmRegIntrinsic(
+    PVm *vm, PCallFrame *frame, PValue *regs, const PValue *consts,
+    const PRegIns *ins, int *callArgc
+) {
+    PanOpCode op = (PanOpCode)(OP_LEN + (ins->op - RG_LEN));
+    int argc = vmIntrinsicArgc(op);
+    PValue args[2] = {REG_RK(ins->b), argc == 2 ? REG_RK(ins->c) : MakeNil()};
+    *callArgc = 0;
+    if (vmIntrinsic(vm, op, args, &regs[ins->a])) {
+        return true;
+    }
+
+    const PBytecode *code = frame->fn->v.OComFunction.code;
+    u64 offset = code->reg->origin[ins - code->reg->code];
+    PValue callee;
+    if (!vmIntrinsicCallee(vm, code, offset, &callee)) {
+        return false;
+    }
+    regs[ins->a] = callee;
+    for (int i = 0; i < argc; i++) {
+        regs[ins->a + 1 + i] = args[i];
+    }
+    *callArgc = argc;
+    return true;
+}
+
+// Run register instruction `ins` of `frame`, other than jumps, calls and
+// returns, which change the running frame or instruction
+static finline bool vmRegExec(
+    PVm *vm, PCallFrame *frame, PValue *regs, const PValue *consts,
+    const PRegIns *ins
+) {
+    switch ((PRegOp)ins->op) {
+        case RG_MOVE: regs[ins->a] = regs[ins->b]; break;
+        case RG_LOADK:
+            regs[ins->a] = consts[ins->b | (u32)ins->c << 16];
+            break;
+        case RG_LOADNIL: regs[ins->a] = MakeNil(); break;
+        case RG_LOADTRUE: regs[ins->a] = MakeBool(true); break;
+        case RG_LOADFALSE: regs[ins->a] = MakeBool(false); break;
+
+        case RG_ADD: {
+            PValue b = REG_RK(ins->b);
+            PValue c = REG_RK(ins->c);
+            if (IsValueInt(b) && IsValueInt(c) &&
+                IntAdd(ValueAsInt(b), ValueAsInt(c), &regs[ins->a])) {
+                break;
+            }
+            if (IsValueNum(b) && IsValueNum(c)) {
+                regs[ins->a] = MakeNumber(ValueAsNum(b) + ValueAsNum(c));
+            } else if (!vmArith(vm, OP_ADD, b, c, &regs[ins->a])) {
+                return false;
+            }
+            break;
+        }
+        case RG_SUB: {
+            PValue b = REG_RK(ins->b);
+            PValue c = REG_RK(ins->c);
+            if (IsValueInt(b) && IsValueInt(c) &&
+                IntSub(ValueAsInt(b), ValueAsInt(c), &regs[ins->a])) {
+                break;
+            }
+            if (IsValueNum(b) && IsValueNum(c)) {
+                regs[ins->a] = MakeNumber(ValueAsNum(b) - ValueAsNum(c));
+            } else if (!vmArith(vm, OP_SUB, b, c, &regs[ins->a])) {
+                return false;
+            }
+            break;
+        }
+        case RG_MUL: {
+            PValue b = REG_RK(ins->b);
+            PValue c = REG_RK(ins->c);
+            if (IsValueInt(b) && IsValueInt(c) &&
+                IntMul(ValueAsInt(b), ValueAsInt(c), &regs[ins->a])) {
+                break;
+            }
+            if (IsValueNum(b) && IsValueNum(c)) {
+                regs[ins->a] = MakeNumber(ValueAsNum(b) * ValueAsNum(c));
+            } else if (!vmArith(vm, OP_MUL, b, c, &regs[ins->a])) {
+                return false;
+            }
+            break;
+        }
+        case RG_DIV:
+        case RG_MOD:
+        case RG_POW: {
+            PanOpCode op = ins->op == RG_DIV   ? OP_DIV
+                           : ins->op == RG_MOD ? OP_MOD
+                                               : OP_EXPONENT;
+            if (!vmArith(
+                    vm, op, REG_RK(ins->b), REG_RK(ins->c), &regs[ins->a]
+                )) {
+                return false;
+            }
+            break;
+        }
+
+        case RG_EQ:
+        case RG_NE: {
+            bool result = vmEqual(REG_RK(ins->b), REG_RK(ins->c));
+            regs[ins->a] = MakeBool(ins->op == RG_EQ ? result : !result);
+            break;
+        }
+        case RG_GT:
+        case RG_GE:
+        case RG_LT:
+        case RG_LE: {
+            PanOpCode op = (PanOpCode)(OP_GT + (ins->op - RG_GT));
+            bool result = false;
+            if (!vmCompare(
+                    vm, op, REG_RK(ins->b), REG_RK(ins->c), &result
+                )) {
+                return false;
+            }
+            regs[ins->a] = MakeBool(result);
+            break;
+        }
+
+        case RG_NEG: {
+            PValue b = REG_RK(ins->b);
+            regs[ins->a] = IsValueNum(b) ? vmNegNumber(b) : b;
+            break;
+        }
+        case RG_NOT: {
+            regs[ins->a] = MakeBool(!IsValueTruthy(REG_RK(ins->b)));
+            break;
+        }
+        case RG_PRINT: {
+            PrintValue(REG_RK(ins->a));
+            PanPrint("\n");
+            break;
+        }
+
+        case RG_DEFGLOBAL: {
+            PObj *nameObj = ValueAsObj(consts[ins->b]);
+            if (nameObj->type != OT_STR) {
+                VmError(
+                    vm, RT_INVALID_VAR_DECLARE,
+                    ObjTypeToString(nameObj->type)
+                );
+                break;
+            }
+            vmWriteGlobal(vm, nameObj);
+            SymbolTableSet(vm->globals, nameObj, REG_RK(ins->a));
+            break;
+        }
+        case RG_GETGLOBAL: {
+            PObj *nameObj = ValueAsObj(consts[ins->b]);
+            bool found = false;
+            PValue val = SymbolTableFind(vm->globals, nameObj, &found);
+            if (!found) {
+                VmError(vm, RT_UNDEF_GET_VAR, nameObj->v.OString.value);
+                return false;
+            }
+            regs[ins->a] = val;
+            break;
+        }
+        case RG_SETGLOBAL: {
+            PObj *nameObj = ValueAsObj(consts[ins->b]);
+            if (!SymbolTableHasKey(vm->globals, nameObj)) {
+                VmError(vm, RT_UNDEF_SET_VAR, nameObj->v.OString.value);
+                return false;
+            }
+            vmWriteGlobal(vm, nameObj);
+            SymbolTableSet(vm->globals, nameObj, REG_RK(ins->a));
+            break;
+        }
+
+        case RG_GETUPVAL: {
+            regs[ins->a] =
+                *frame->cls->v.OClosure.upvals[ins->b]->v.OUpval.location;
+            break;
+        }
+        case RG_SETUPVAL: {
+            *frame->cls->v.OClosure.upvals[ins->a]->v.OUpval.location =
+                REG_RK(ins->b);
+            break;
+        }
+        case RG_GETOUTER: regs[ins->a] = frame->outer[ins->b]; break;
+        case RG_SETOUTER: frame->outer[ins->a] = REG_RK(ins->b); break;
+
+        case RG_CLOSURE: {
+            PObj *objClosure =
+                NewClosureObject(vm->gc, ValueAsObj(consts[ins->b]));
+            if (objClosure == NULL) {
+                VmError(vm, RT_IME_CLOSURE);
+                return false;
+            }
+            struct OClosure *cls = &objClosure->v.OClosure;
+
+            for (i16 i = 0; i < cls->upvalCount; i++) {
+                const PRegIns *desc = &ins[1 + i];
+                if (desc->a & CLOSURE_UPVAL_LOCAL) {
+                    cls->upvals[i] = vmCaptureUpval(vm, regs + desc->b);
+                } else {
+                    cls->upvals[i] = frame->cls->v.OClosure.upvals[desc->b];
+                }
+            }
+            regs[ins->a] = MakeObject(objClosure);
+            break;
+        }
+        case RG_CLOSE: closeUpvals(vm, regs + ins->a); break;
+
+        case RG_NEWARRAY: {
+            u16 itemCount = ins->b;
+            PValue *items = NULL;
+            if (itemCount > 0) {
+                arrsetlen(items, itemCount);
+                memcpy(
+                    items, regs + ins->a, sizeof(PValue) * itemCount
+                );
+            }
+            PObj *arrObj = NewArrayObject(vm->gc, NULL, items, itemCount);
+            if (arrObj == NULL) {
+                arrfree(items);
+                VmError(vm, RT_IME_ARRAY);
+                return false;
+            }
+            regs[ins->a] = MakeObject(arrObj);
+            break;
+        }
+        case RG_NEWMAP: {
+            u16 pairCount = ins->b;
+            MapEntry *entries = NULL;
+            for (u16 i = 0; i < pairCount; i++) {
+                PValue key = regs[ins->a + i * 2];
+                PValue val = regs[ins->a + i * 2 + 1];
+
+                if (!CanValueBeKey(key)) {
+                    hmfree(entries);
+                    VmError(vm, RT_INVALID_MAP_KEY, ValueTypeToStr(key));
+                    return false;
+                }
+
+                u64 keyHash = GetValueHash(key, vm->gc->timestamp);
+                hmputs(entries, ((MapEntry){keyHash, key, val}));
+            }
+
+            PObj *mapObj = NewMapObject(vm->gc, NULL);
+            if (mapObj == NULL) {
+                hmfree(entries);
+                VmError(vm, RT_IME_MAP);
+                return false;
+            }
+            mapObj->v.OMap.count = pairCount;
+            mapObj->v.OMap.table = entries;
+            regs[ins->a] = MakeObject(mapObj);
+            break;
+        }
+
+        case RG_INDEX: {
+            if (!vmIndexGet(
+                    vm, REG_RK(ins->b), REG_RK(ins->c), &regs[ins->a]
+                )) {
+                return false;
+            }
+            break;
+        }
+        case RG_SETINDEX: {
+            if (!vmIndexSet(
+                    vm, REG_RK(ins->a), REG_RK(ins->b), REG_RK(ins->c)
+                )) {
+                return false;
+            }
+            break;
+        }
+        case RG_IMPORT: {
+            if (!vmImportModule(vm, consts[ins->b], REG_RK(ins->a))) {
+                return false;
+            }
+            break;
+        }
+        case RG_MODGET: {
+            if (!vmModGetCached(
+                    vm, frame->fn->v.OComFunction.code, REG_RK(ins->b),
+                    ins->c, &regs[ins->a]
+                )) {
+                return false;
+            }
+            break;
+        }
+        // Read by `RG_CLOSURE`, nothing to do
+        case RG_UPVAL_DESC: break;
+        default: break;
+    }
+    return true;
+}
+
+// Register engine version of `vmRunLoop`
+static void vmRunRegLoop(PVm *vm, int baseFrame) {
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    PValue *regs = frame->slots;
+    const PValue *consts = frame->fn->v.OComFunction.code->constPool;
+    while (true) {
+        const PRegIns *ins = frame->rip++;
+#if defined(PANKTI_BUILD_DEBUG)
+        vm->insCount++;
+#endif
+
+        switch ((PRegOp)ins->op) {
+            case RG_JMP: {
+                frame->rip += (i16)ins->a;
+                if ((i16)ins->a >= 0) {
+                    break;
+                }
+#if defined(PANKTI_JIT)
+                if (vmJitHot(vm, frame->fn)) {
+                    PBytecode *code = frame->fn->v.OComFunction.code;
+                    // Rest of the frame runs as native code
+                    if (!vmJitEnterFrame(
+                            vm, frame, (u32)(frame->rip - code->reg->code)
+                        )) {
+                        return;
+                    }
+                    if (vm->frameCount == 0 || vm->frameCount == baseFrame) {
+                        return;
+                    }
+                    frame = &vm->frames[vm->frameCount - 1];
+                    vm->sp = frame->top;
+                    regs = frame->slots;
+                    consts = frame->fn->v.OComFunction.code->constPool;
+                    break;
+                }
+#endif
+                if (vmTraceAllowed(vm, frame->fn->v.OComFunction.code)) {
+                    if (!vmTraceLoop(vm, frame, ins)) {
+                        return;
+                    }
+                    frame = &vm->frames[vm->frameCount - 1];
+                }
+                break;
+            }
+            case RG_JMPF: {
+                if (!IsValueTruthy(regs[ins->b])) {
+                    frame->rip += (i16)ins->a;
+                }
+                break;
+            }
+            case RG_JMPT: {
+                if (IsValueTruthy(regs[ins->b])) {
+                    frame->rip += (i16)ins->a;
+                }
+                break;
+            }
+            case RG_JMPF_EQ:
+            case RG_JMPF_NE: {
+                bool result = vmEqual(REG_RK(ins->b), REG_RK(ins->c));
+                if (result != (ins->op == RG_JMPF_EQ)) {
+                    frame->rip += (i16)ins->a;
+                }
+                break;
+            }
+            case RG_JMPF_LT: {
+                PValue b = REG_RK(ins->b);
+                PValue c = REG_RK(ins->c);
+                if (IsValueInt(b) && IsValueInt(c)) {
+                    if (!(ValueAsInt(b) < ValueAsInt(c))) {
+                        frame->rip += (i16)ins->a;
+                    }
+                    break;
+                }
+                if (IsValueNum(b) && IsValueNum(c)) {
+                    if (!(ValueAsNum(b) < ValueAsNum(c))) {
+                        frame->rip += (i16)ins->a;
+                    }
+                    break;
+                }
+                VmError(vm, RT_INVALID_COMP_OP);
+                return;
+            }
+            case RG_JMPF_GT:
+            case RG_JMPF_GE:
+            case RG_JMPF_LE: {
+                PanOpCode op = (PanOpCode)(OP_GT + (ins->op - RG_JMPF_GT));
+                bool result = false;
+                if (!vmCompare(
+                        vm, op, REG_RK(ins->b), REG_RK(ins->c), &result
+                    )) {
+                    return;
+                }
+                if (!result) {
+                    frame->rip += (i16)ins->a;
+                }
+                break;
+            }
+
+            case RG_CALL: {
+                if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+                    return;
+                }
+                if (!vmRegCall(vm, regs + ins->a, ins->b)) {
+                    VmError(vm, RT_CALL_FAIL);
+                    return;
+                }
+                frame = &vm->frames[vm->frameCount - 1];
+                regs = frame->slots;
+                consts = frame->fn->v.OComFunction.code->constPool;
+                break;
+            }
+            case RG_LEN:
+            case RG_APPEND:
+            case RG_SQRT: {
+                int argc = 0;
+                if (!vmRegIntrinsic(vm, frame, regs, consts, ins, &argc)) {
+                    return;
+                }
+                if (argc == 0) {
+                    break;
+                }
+                if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+                    return;
+                }
+                if (!vmRegCall(vm, regs + ins->a, argc)) {
+                    VmError(vm, RT_CALL_FAIL);
+                    return;
+                }
+                frame = &vm->frames[vm->frameCount - 1];
+                regs = frame->slots;
+                consts = frame->fn->v.OComFunction.code->constPool;
+                break;
+            }
+            case RG_TAILCALL: {
+                PValue callee = regs[ins->a];
+                if (IsValueObjType(callee, OT_CLOSURE)) {
+                    if (!vmRegTailCall(
+                            vm, frame, ValueAsObj(callee), regs + ins->a,
+                            ins->b
+                        )) {
+                        VmError(vm, RT_CALL_FAIL);
+                        return;
+                    }
+                    consts = frame->fn->v.OComFunction.code->constPool;
+                    break;
+                }
+
+                // Natives and direct functions are called normally, the
+                // following `RG_RETURN` returns the result
+                if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+                    return;
+                }
+                if (!vmRegCall(vm, regs + ins->a, ins->b)) {
+                    VmError(vm, RT_CALL_FAIL);
+                    return;
+                }
+                frame = &vm->frames[vm->frameCount - 1];
+                regs = frame->slots;
+                consts = frame->fn->v.OComFunction.code->constPool;
+                break;
+            }
+            case RG_RETURN: {
+                PValue result = REG_RK(ins->a);
+                if (frame->capturesLocals) {
+                    closeUpvals(vm, frame->slots);
+                }
+                vm->frameCount--;
+                if (vm->frameCount == 0) {
+                    vm->sp = vm->stack;
+                    return;
+                }
+                frame->slots[0] = result;
+                if (vm->frameCount == baseFrame) {
+                    vm->sp = frame->slots + 1;
+                    return;
+                }
+                frame = &vm->frames[vm->frameCount - 1];
+                vm->sp = frame->top;
+                regs = frame->slots;
+                consts = frame->fn->v.OComFunction.code->constPool;
+                break;
+            }
+
+            default: {
+                if (!vmRegExec(vm, frame, regs, consts, ins)) {
+                    return;
+                }
+                break;
+            }
+        } // switch
+        CollectGarbage(vm->gc);
+    } // while true
+}
+
+#undef REG_RK
+
+// Run top frame, a stack engine frame at a loop head, in the register engine
+// until it returns. Returns false, and the frame stays in the stack engine,
+// if it can't be translated
+static bool vmRegEnterFrame(PVm *vm, PCallFrame *frame) {
+    struct OComFunction *fn = &frame->fn->v.OComFunction;
+    PBytecode *code = fn->code;
+    if (code->reg == NULL) {
+        code->reg = RegTranslate(code, fn->paramCount);
+    }
+    u32 pc = code->reg == NULL ? REG_PC_UNSET
+                               : code->reg->entry[frame->ip - code->code];
+    if (pc == REG_PC_UNSET) {
+        code->loopHits = TRACE_NEVER;
+        return false;
+    }
+
+    frame->rip = code->reg->code + pc;
+    vmRegSetTop(vm, frame, vm->sp);
+    vmRunRegLoop(vm, vm->frameCount - 1);
+    return true;
+}
+
+// ============ Loop Traces ============
+//
+// See trace.h. Register frames count their loop back edges here, record hot
+// loops and run their traces. Frames go back to `vmRunRegLoop` when a trace
+// exits.
+
+// Back edge `ins` of top frame `frame` was taken. Returns false if an error
+// was reported
+static bool vmTraceLoop(PVm *vm, PCallFrame *frame, const PRegIns *ins) {
+    PRegCode *reg = frame->fn->v.OComFunction.code->reg;
+    PTraceLoop *loop = &reg->loops[ins->c];
+    bool ok = true;
+    vm->traceDepth++;
+    if (loop->trace == NULL) {
+        if (loop->hits != TRACE_NEVER &&
+            ++loop->hits >= vm->traceThreshold) {
+            ok = TraceRecord(
+                vm, loop, (u32)(frame->rip - reg->code),
+                (u32)(ins - reg->code)
+            );
+#if defined(PANKTI_BUILD_DEBUG)
+            if (ok && loop->trace != NULL && FLAG_DEBUG_BYTECODE) {
+                DebugTrace(loop->trace);
+            }
+#endif
+        }
+    }
+    if (ok && loop->trace != NULL) {
+        ok = TraceRun(vm, loop->trace);
+    }
+    vm->traceDepth--;
+    return ok;
+}
+
+// Run call `ins` of top frame, with callee in R(a) and `argCount`
+// arguments after it, until the callee returns
+static bool vmRegStepCall(PVm *vm, const PRegIns *ins, int argCount) {
+    int baseFrame = vm->frameCount;
+    vm->frames[baseFrame - 1].rip = ins + 1;
+    if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+        return false;
+    }
+    PCallFrame *frame = &vm->frames[baseFrame - 1];
+    if (!vmRegCall(vm, frame->slots + ins->a, argCount)) {
+        VmError(vm, RT_CALL_FAIL);
+        return false;
+    }
+    // Callee without native code
+    if (vm->frameCount > baseFrame) {
+        vmRunRegLoop(vm, baseFrame);
+        vm->sp = vm->frames[baseFrame - 1].top;
+    }
+    CollectGarbage(vm->gc);
+    return true;
+}
+
+bool VmRegStep(PVm *vm, const PRegIns *ins) {
+    if (ins->op == RG_CALL) {
+        return vmRegStepCall(vm, ins, ins->b);
+    }
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    frame->rip = ins + 1;
+    if (ins->op == RG_LEN || ins->op == RG_APPEND || ins->op == RG_SQRT) {
+        int argc = 0;
+        if (!vmRegIntrinsic(
+                vm, frame, frame->slots,
+                frame->fn->v.OComFunction.code->constPool, ins, &argc
+            )) {
+            return false;
+        }
+        if (argc != 0) {
+            return vmRegStepCall(vm, ins, argc);
+        }
+        CollectGarbage(vm->gc);
+        return true;
+    }
+    bool ok = vmRegExec(
+        vm, frame, frame->slots, frame->fn->v.OComFunction.code->constPool, ins
+    );
+    CollectGarbage(vm->gc);
+    return ok;
+}
+
+bool VmIntrinsic(PVm *vm, PanOpCode op, const PValue *args, PValue *out) {
+    return vmIntrinsic(vm, op, args, out);
+}
+
+bool VmRegBranch(PVm *vm, const PRegIns *ins, bool *jump) {
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    frame->rip = ins + 1;
+    const PValue *regs = frame->slots;
+    const PValue *consts = frame->fn->v.OComFunction.code->constPool;
+    if (ins->op == RG_JMPF || ins->op == RG_JMPT) {
+        *jump = IsValueTruthy(regs[ins->b]) == (ins->op == RG_JMPT);
+        return true;
+    }
+
+    PValue b = vmRegRK(regs, consts, ins->b);
+    PValue c = vmRegRK(regs, consts, ins->c);
+    bool result = false;
+    if (ins->op == RG_JMPF_EQ || ins->op == RG_JMPF_NE) {
+        result = vmEqual(b, c) == (ins->op == RG_JMPF_EQ);
+    } else {
+        PanOpCode op = (PanOpCode)(OP_GT + (ins->op - RG_JMPF_GT));
+        if (!vmCompare(vm, op, b, c, &result)) {
+            return false;
+        }
+    }
+    *jump = !result;
+    return true;
+}
+
+#if defined(PANKTI_JIT)
+
+// ============ Baseline JIT ============
+//
+// Native code runs register frames (see jit.h). A frame is switched to native
+// code when it is pushed, or at a loop head while it is running, and then
+// runs until it returns. Calls from native code go through the register
+// engine, which runs native code of the callee if it has some.
+
+// Compile function `fnObj`. Functions which can't be compiled are never tried
+// again
+static bool vmJitCompile(PObj *fnObj) {
+    struct OComFunction *fn = &fnObj->v.OComFunction;
+    PBytecode *code = fn->code;
+    if (code->reg == NULL) {
+        code->reg = RegTranslate(code, fn->paramCount);
+    }
+    if (code->reg != NULL) {
+        code->jit = JitCompile(code);
+    }
+    if (code->jit == NULL) {
+        code->hotCount = JIT_NEVER;
+        return false;
+    }
+    return true;
+}
+
+// Run top frame as native code from register instruction `pc` until it
+// returns. Its stack values must be in their slots up to `vm->sp`
+static bool vmJitEnterFrame(PVm *vm, PCallFrame *frame, u32 pc) {
+    int baseFrame = vm->frameCount - 1;
+    PBytecode *code = frame->fn->v.OComFunction.code;
+    frame->rip = code->reg->code + pc;
+    vmRegSetTop(vm, frame, vm->sp);
+
+    while (true) {
+        frame = &vm->frames[vm->frameCount - 1];
+        code = frame->fn->v.OComFunction.code;
+        vm->jitDepth++;
+        PJitStatus status = JitRun(code->jit, vm, frame->slots, pc);
+        vm->jitDepth--;
+        if (status != JIT_TAILCALL) {
+            return status == JIT_DONE;
+        }
+
+        // Frame was replaced by the callee
+        frame = &vm->frames[vm->frameCount - 1];
+        pc = 0;
+        if (!vmJitHot(vm, frame->fn)) {
+            vmRunRegLoop(vm, baseFrame);
+            return true;
+        }
+    }
+}
+
+#define FRAME_RK(frame, x)                                                     \
+    vmRegRK(                                                                   \
+        (frame)->slots, (frame)->fn->v.OComFunction.code->constPool, (x)       \
+    )
+
+PJitStatus VmJitExec(PVm *vm, const PRegIns *ins) {
+    return VmRegStep(vm, ins) ? JIT_NEXT : JIT_ERROR;
+}
+
+PJitStatus VmJitCompare(PVm *vm, const PRegIns *ins) {
+    bool jump = false;
+    if (!VmRegBranch(vm, ins, &jump)) {
+        return JIT_ERROR;
+    }
+    return jump ? JIT_JUMP : JIT_NEXT;
+}
+
+PJitStatus VmJitCall(PVm *vm, const PRegIns *ins) {
+    return vmRegStepCall(vm, ins, ins->b) ? JIT_NEXT : JIT_ERROR;
+}
+
+PJitStatus VmJitTailCall(PVm *vm, const PRegIns *ins) {
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    frame->rip = ins + 1;
+    PValue callee = frame->slots[ins->a];
+    if (!IsValueObjType(callee, OT_CLOSURE)) {
+        // Natives and direct functions are called normally, the following
+        // `RG_RETURN` returns the result
+        return VmJitCall(vm, ins);
+    }
+
+    if (!vmRegTailCall(
+            vm, frame, ValueAsObj(callee), frame->slots + ins->a, ins->b
+        )) {
+        VmError(vm, RT_CALL_FAIL);
+        return JIT_ERROR;
+    }
+    return JIT_TAILCALL;
+}
+
+PJitStatus VmJitReturn(PVm *vm, const PRegIns *ins) {
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    frame->rip = ins + 1;
+    PValue result = FRAME_RK(frame, ins->a);
+    if (frame->capturesLocals) {
+        closeUpvals(vm, frame->slots);
+    }
+    vm->frameCount--;
+    if (vm->frameCount == 0) {
+        vm->sp = vm->stack;
+        return JIT_DONE;
+    }
+    frame->slots[0] = result;
+    vm->sp = frame->slots + 1;
+    return JIT_DONE;
+}
+
+#undef FRAME_RK
+
+#endif
+
+void VmRun(PVm *vm) {
+    if (vm->errCtx.report == NULL) {
+        PanPrint(
+            "Fatal Internal Error : VM Started Running Before Error Context "
+            "Was Set\n"
+        );
+        exit(EXIT_FAILURE);
+    }
+
+#if defined(PANKTI_JIT)
+    PCallFrame *frame = &vm->frames[vm->frameCount - 1];
+    if (vmJitHot(vm, frame->fn)) {
+        vmJitEnterFrame(vm, frame, 0);
+        return;
+    }
+#endif
+
+    if (vm->regEngine) {
+        vmRunRegLoop(vm, 0);
+    } else {
+        vmRunLoop(vm, 0);
+    }
+}
+
+PValue VmCallClosure(PVm *vm, PValue callee, const PValue *args, int argc) {
+    if (!IsValueObjType(callee, OT_CLOSURE) &&
+        !IsValueObjType(callee, OT_NATIVE)) {
+        VmError(vm, RT_INVALID_CALLEE, ValueTypeToStr(callee));
+        return MakeNil();
+    }
+
+    if (vm->frameCount >= vm->frameCap && !VmFramesGrow(vm)) {
+        return MakeNil();
+    }
+
+    VmPush(vm, callee);
+    for (int i = 0; i < argc; i++) {
+        VmPush(vm, args[i]);
+    }
+
+    int baseFrame = vm->frameCount;
+    if (vm->regEngine) {
+        PValue *slots = vm->sp - argc - 1;
+        if (!vmRegCall(vm, slots, argc)) {
+            VmError(vm, RT_CALL_FAIL);
+            return MakeNil();
+        }
+        if (vm->frameCount > baseFrame) {
+            vmRunRegLoop(vm, baseFrame);
+        } else {
+            vm->sp = slots + 1;
+        }
+        return VmPop(vm);
+    }
+
+    if (!vmCallValue(vm, callee, argc)) {
+        VmError(vm, RT_CALL_FAIL);
+        return MakeNil();
+    }
+
+    // natives are already done, closures need their own dispatch loop
+    if (vm->frameCount > baseFrame) {
+        vmRunLoop(vm, baseFrame);
+    }
+
+    return VmPop(vm);
+}
@@ -12,7 +12,9 @@
 #include "diagonctx.h"
 #include "object.h"
 #include "ptypes.h"
+#include "regcode.h"
 #include "symtable.h"
+#include "unicode.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,13 +24,24 @@ extern "C" {
 #define PVM_PERFRAME_STACK_SIZE 256
 #endif
 
-// VM Call stack size
+// VM Call stack initial size, it grows as needed
 #ifndef PVM_FRAMESTACK_SIZE
 #define PVM_FRAMESTACK_SIZE 64
 #endif
 
-#ifndef PVM_STACK_SIZE
-#define PVM_STACK_SIZE PVM_PERFRAME_STACK_SIZE *PVM_FRAMESTACK_SIZE
+// VM Call stack limit (can be modified at compile time)
+#ifndef PVM_FRAMESTACK_MAX
+#if defined(PANKTI_OS_WEB)
+#define PVM_FRAMESTACK_MAX 1024
+#else
+#define PVM_FRAMESTACK_MAX 8192
+#endif
+#endif
+
+// VM Stack limit in slots (can be modified at compile time).
+// Only the address range is reserved, memory is used as the stack grows
+#ifndef PVM_STACK_MAX
+#define PVM_STACK_MAX (PVM_PERFRAME_STACK_SIZE * PVM_FRAMESTACK_MAX)
 #endif
 
 // Forward declaration of GC
@@ -52,26 +65,51 @@ typedef struct ModProxyEntry {
 } ModProxyEntry;
 
 typedef struct PCallFrame {
+    // Closure being run, NULL for direct functions
     PObj *cls;
+    // Compiled function being run
+    PObj *fn;
     u8 *ip;
+    // Instruction pointer of register engine
+    const PRegIns *rip;
     PValue *slots;
+    // Slots of enclosing function frame, only used by direct functions
+    PValue *outer;
+    // Copied from the function on call. If false, nothing captured this
+    // frame's slots and returning can skip closing upvalues
+    bool capturesLocals;
+    // Stack pointer while this frame runs in the register engine. Covers all
+    // registers of the frame, so GC sees them
+    PValue *top;
 } PCallFrame;
 
 // Pankti Virtual Machine Object
 typedef struct PVm {
-    PCallFrame frames[PVM_FRAMESTACK_SIZE];
+    // Call frames, grows up to `PVM_FRAMESTACK_MAX`
+    PCallFrame *frames;
     int frameCount;
+    // Allocated call frames
+    int frameCap;
 
-    // The Stack
-    PValue stack[PVM_STACK_SIZE];
+    // The Stack, its address never changes. See vm_stack.c
+    PValue *stack;
+    // End of the usable (committed) part of the stack
+    PValue *stackEnd;
     // Stack pointer
     PValue *sp;
+    // Bytes reserved for the stack
+    u64 stackReserved;
+    // Bytes the stack grows at once
+    u64 stackChunk;
 
     PModule **modules;
     u64 modCount;
 
     ModProxyEntry *modProxies;
     u64 modProxiesCount;
+    // Changes on every import, as a module name may then stand for another
+    // module. See `PModCache`
+    u64 modStamp;
 
     // Garbage Collector
     Pgc *gc;
@@ -83,6 +121,26 @@ typedef struct PVm {
     // Error context
     PDiagonCtx errCtx;
 
+    // Run register bytecode instead of stack bytecode. See regcode.h
+    bool regEngine;
+    // Set once a global which intrinsic opcodes stand for is written, they
+    // then call the function the normal way. See `OP_LEN`
+    bool intrinsicsOff;
+    // Loop back edges before a loop is traced, 0 if traces are off
+    u32 traceThreshold;
+    // Nested frames running traces
+    int traceDepth;
+#if defined(PANKTI_JIT)
+    // Calls and back edges before a function is compiled, 0 if JIT is off
+    u32 jitThreshold;
+    // Nested frames running native code
+    int jitDepth;
+#endif
+#if defined(PANKTI_BUILD_DEBUG)
+    // Instructions executed so far
+    u64 insCount;
+#endif
+
     // Path to the script path which is running
     const char *scriptPath;
     // Arguments to scripts
@@ -93,21 +151,64 @@ typedef struct PVm {
 
 // Create an empty VM Object
 PVm *NewVm(Pgc *gc, PDiagonCtx errCtx);
-// Setup VM with bytecode, constants, gc etc.
-void SetupVm(
+// Setup VM with bytecode, constants, gc etc. Return false, after reporting
+// the error, if the script can't be loaded
+bool SetupVm(
     PVm *vm, PObj *func, const char *scriptPath, int sArgc, char **sArgs
 );
+// Setup VM for a session, which runs top level functions of chunks one after
+// another with `VmRunChunk`. Builtins are registered here once
+void SetupVmSession(
+    PVm *vm, const char *scriptPath, int sArgc, char **sArgs
+);
+// Run top level function `func` of a chunk on VM set up by `SetupVmSession`
+void VmRunChunk(PVm *vm, PObj *func);
+// Drop frames and stack of a chunk which stopped at an error, closing its
+// open upvalues so closures it left behind can still be called
+void VmReset(PVm *vm);
 // Free the VM
 void FreeVm(PVm *vm);
 
+// Reserve the VM stack and allocate call frames
+bool VmStackInit(PVm *vm);
+// Free the VM stack and call frames
+void VmStackFree(PVm *vm);
+// Make sure there is room for `needed` more slots above stack pointer.
+// Reports stack overflow if stack can't grow
+bool VmStackGrow(PVm *vm, u64 needed);
+// Grow call frames. Reports call stack overflow if already at the limit
+bool VmFramesGrow(PVm *vm);
+
 void VmMarkRoots(Pgc *gc, void *ctx);
 
 // Debug VM Stack
 void DebugVMStack(PVm *vm);
-// Print Call Stack Trace
-void VmPrintStackTrace(const PVm *vm);
+// Print Call Stack Trace. Columns are found through `lines`, which is the
+// index of the script source
+void VmPrintStackTrace(const PVm *vm, PLineIndex *lines);
 // Run the VM
 void VmRun(PVm *vm);
+// Call `callee` (a closure or a native function) with `argc` arguments from
+// `args` and return the result. Closures are run to completion in a nested
+// dispatch loop, so native functions can use it to call back into user code.
+// Objects the caller holds only in C variables must be kept reachable (for
+// example by pushing them on the stack) as garbage collector can run during
+// the call
+PValue VmCallClosure(PVm *vm, PValue callee, const PValue *args, int argc);
+
+// Run register instruction `ins` of top frame, for code running register
+// bytecode outside the register engine loop. Jumps, tail calls and returns
+// are not handled, calls are run until they return. Returns false if an error
+// was reported
+bool VmRegStep(PVm *vm, const PRegIns *ins);
+// Find out if conditional jump `ins` of top frame jumps. Returns false if an
+// error was reported
+bool VmRegBranch(PVm *vm, const PRegIns *ins, bool *jump);
+
+// Run intrinsic `op` (see `OP_LEN`) on `args` without calling the function
+// it stands for. Returns false if it can't, the instruction must then be run
+// the normal way
+bool VmIntrinsic(PVm *vm, PanOpCode op, const PValue *args, PValue *out);
 
 // Throw VM Runtime Error
 // void VmError(PVm *vm, PanDiagCode code);
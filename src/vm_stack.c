@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// VM value stack and call frame stack.
+//
+// The value stack can't move once the VM is running, as open upvalues and
+// call frames point into it. So address range for the whole `PVM_STACK_MAX`
+// slots is reserved up front, which costs no memory, and is committed in
+// chunks as the stack grows. Targets without virtual memory reservation
+// allocate the whole stack at once.
+//
+// Call frames are always accessed by index, so they are simply reallocated.
+
+#include "alloc.h"
+#include "gen/diagon.h"
+#include "ptypes.h"
+#include "system.h"
+#include "vm.h"
+#include <stdbool.h>
+
+#if defined(PANKTI_OS_WIN)
+#include <windows.h>
+#define PVM_STACK_VIRTUAL
+#elif defined(PANKTI_OS_LINUX) || defined(PANKTI_OS_MAC)
+#include <sys/mman.h>
+#include <unistd.h>
+#define PVM_STACK_VIRTUAL
+#endif
+
+// Stack is committed in chunks of this many slots (rounded up to page size)
+#define PVM_STACK_CHUNK (PVM_PERFRAME_STACK_SIZE * 16)
+
+static u64 pageSize(void) {
+#if defined(PANKTI_OS_WIN)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (u64)info.dwPageSize;
+#elif defined(PVM_STACK_VIRTUAL)
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (u64)size : 4096;
+#else
+    return sizeof(PValue);
+#endif
+}
+
+static u64 roundUp(u64 value, u64 multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+static void *reserveStack(u64 bytes) {
+#if defined(PANKTI_OS_WIN)
+    return VirtualAlloc(NULL, (SIZE_T)bytes, MEM_RESERVE, PAGE_NOACCESS);
+#elif defined(PVM_STACK_VIRTUAL)
+    void *addr = mmap(
+        NULL, (size_t)bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    return addr == MAP_FAILED ? NULL : addr;
+#else
+    return PMalloc(bytes);
+#endif
+}
+
+static bool commitStack(void *addr, u64 bytes) {
+#if defined(PANKTI_OS_WIN)
+    return VirtualAlloc(addr, (SIZE_T)bytes, MEM_COMMIT, PAGE_READWRITE) !=
+           NULL;
+#elif defined(PVM_STACK_VIRTUAL)
+    return mprotect(addr, (size_t)bytes, PROT_READ | PROT_WRITE) == 0;
+#else
+    (void)addr;
+    (void)bytes;
+    return true;
+#endif
+}
+
+static void releaseStack(void *addr, u64 bytes) {
+#if defined(PANKTI_OS_WIN)
+    (void)bytes;
+    VirtualFree(addr, 0, MEM_RELEASE);
+#elif defined(PVM_STACK_VIRTUAL)
+    munmap(addr, (size_t)bytes);
+#else
+    (void)bytes;
+    PFree(addr);
+#endif
+}
+
+bool VmStackInit(PVm *vm) {
+    vm->stackChunk = roundUp(sizeof(PValue) * PVM_STACK_CHUNK, pageSize());
+    vm->stackReserved = roundUp(sizeof(PValue) * PVM_STACK_MAX, pageSize());
+
+    PValue *stack = (PValue *)reserveStack(vm->stackReserved);
+    if (stack == NULL) {
+        return false;
+    }
+
+    u64 firstChunk = vm->stackChunk < vm->stackReserved ? vm->stackChunk
+                                                        : vm->stackReserved;
+    if (!commitStack(stack, firstChunk)) {
+        releaseStack(stack, vm->stackReserved);
+        return false;
+    }
+
+    PCallFrame *frames = PCreateArray(PCallFrame, PVM_FRAMESTACK_SIZE);
+    if (frames == NULL) {
+        releaseStack(stack, vm->stackReserved);
+        return false;
+    }
+
+    vm->stack = stack;
+    vm->stackEnd = (PValue *)((u8 *)stack + firstChunk);
+    vm->sp = stack;
+    vm->frames = frames;
+    vm->frameCap = PVM_FRAMESTACK_SIZE;
+    vm->frameCount = 0;
+    return true;
+}
+
+void VmStackFree(PVm *vm) {
+    if (vm->stack != NULL) {
+        releaseStack(vm->stack, vm->stackReserved);
+        vm->stack = NULL;
+        vm->stackEnd = NULL;
+        vm->sp = NULL;
+    }
+
+    if (vm->frames != NULL) {
+        PFree(vm->frames);
+        vm->frames = NULL;
+        vm->frameCap = 0;
+    }
+}
+
+bool VmStackGrow(PVm *vm, u64 needed) {
+    u64 committed = (u64)((u8 *)vm->stackEnd - (u8 *)vm->stack);
+    u64 wanted = sizeof(PValue) * ((u64)(vm->sp - vm->stack) + needed);
+    if (wanted <= committed) {
+        return true;
+    }
+
+    if (wanted > vm->stackReserved) {
+        VmError(vm, RT_STACK_OVERFLOW);
+        return false;
+    }
+
+    u64 newSize = roundUp(wanted, vm->stackChunk);
+    if (newSize > vm->stackReserved) {
+        newSize = vm->stackReserved;
+    }
+
+    if (!commitStack((u8 *)vm->stack + committed, newSize - committed)) {
+        VmError(vm, RT_STACK_OVERFLOW);
+        return false;
+    }
+
+    vm->stackEnd = (PValue *)((u8 *)vm->stack + newSize);
+    return true;
+}
+
+bool VmFramesGrow(PVm *vm) {
+    if (vm->frameCap >= PVM_FRAMESTACK_MAX) {
+        VmError(vm, RT_CALLSTACK_OVERFLOW);
+        return false;
+    }
+
+    int newCap = vm->frameCap * 2;
+    if (newCap > PVM_FRAMESTACK_MAX) {
+        newCap = PVM_FRAMESTACK_MAX;
+    }
+
+    PCallFrame *frames = (PCallFrame *)PRealloc(
+        vm->frames, sizeof(PCallFrame) * (u64)newCap
+    );
+    if (frames == NULL) {
+        VmError(vm, RT_CALLSTACK_OVERFLOW);
+        return false;
+    }
+
+    vm->frames = frames;
+    vm->frameCap = newCap;
+    return true;
+}
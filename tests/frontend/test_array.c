@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "../../src/external/stb/stb_ds.h"
+#include "../../src/object.h"
+#include "../include/utest.h"
+#include <stdint.h>
+
+UTEST(ArrayTest, ReserveTooBig) {
+    PValue *items = NULL;
+    arrput(items, MakeNumber(1));
+    arrput(items, MakeNumber(2));
+    PValue *old = items;
+    u64 cap = (u64)arrcap(items);
+
+    // Sizes which can't be allocated leave the items as they were
+    ASSERT_FALSE(ArrayItemsReserve(&items, UINT64_MAX));
+    ASSERT_FALSE(ArrayItemsReserve(&items, ARRAY_ITEMS_MAX + 1));
+    ASSERT_TRUE(items == old);
+    ASSERT_EQ((u64)arrcap(items), cap);
+    ASSERT_EQ((u64)arrlen(items), (u64)2);
+
+    ASSERT_TRUE(ArrayItemsReserve(&items, 100));
+    ASSERT_GE((u64)arrcap(items), (u64)100);
+    ASSERT_EQ((u64)arrlen(items), (u64)2);
+    ASSERT_EQ(items[1], MakeNumber(2));
+    arrfree(items);
+}
+
+UTEST(ArrayTest, ReserveEmpty) {
+    PValue *items = NULL;
+    ASSERT_FALSE(ArrayItemsReserve(&items, UINT64_MAX));
+    ASSERT_TRUE(items == NULL);
+    ASSERT_TRUE(ArrayItemsReserve(&items, 0));
+    ASSERT_TRUE(ArrayItemsReserve(&items, 8));
+    ASSERT_GE((u64)arrcap(items), (u64)8);
+    arrfree(items);
+}
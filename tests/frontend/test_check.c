@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "../../src/check.h"
+#include "../../src/external/stb/stb_ds.h"
+#include "../include/utest.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct CheckTest {
+    PCheckFile *file;
+};
+
+UTEST_F_SETUP(CheckTest) { utest_fixture->file = NULL; }
+
+UTEST_F_TEARDOWN(CheckTest) { FreeCheckFile(utest_fixture->file); }
+
+#define OpenFile(src)                                                          \
+    utest_fixture->file = NewCheckFile(src, strlen(src));                      \
+    ASSERT_NE(utest_fixture->file, NULL);
+
+#define EditFile(start, end, text)                                             \
+    ASSERT_TRUE(CheckFileEdit(                                                 \
+        utest_fixture->file, start, end, text, strlen(text)                    \
+    ));
+
+// Diagnostics of the edited file must be the ones of its text parsed afresh
+#define CheckSameAsFresh()                                                     \
+    {                                                                          \
+        u64 textLen = 0;                                                       \
+        char *text = CheckFileText(utest_fixture->file, &textLen);             \
+        PCheckFile *fresh = NewCheckFile(text, textLen);                       \
+        PCheckDiag *got = CheckFileDiags(utest_fixture->file);                 \
+        PCheckDiag *want = CheckFileDiags(fresh);                              \
+        ASSERT_EQ(arrlen(got), arrlen(want));                                  \
+        for (u64 i = 0; i < arrlen(got); i++) {                                \
+            ASSERT_EQ(got[i].line, want[i].line);                              \
+            ASSERT_EQ(got[i].col, want[i].col);                                \
+            ASSERT_EQ(got[i].code, want[i].code);                              \
+        }                                                                      \
+        ASSERT_EQ(utest_fixture->file->lineCount, fresh->lineCount);           \
+        arrfree(got);                                                          \
+        arrfree(want);                                                         \
+        FreeCheckFile(fresh);                                                  \
+        free(text);                                                            \
+    }
+
+UTEST_F(CheckTest, EditFixesError) {
+    OpenFile("dhori a = 1\nkaj f(x)\n  ferao x * \nsesh\ndekhao(f(a))\n");
+    PCheckDiag *diags = CheckFileDiags(utest_fixture->file);
+    ASSERT_EQ(arrlen(diags), 3);
+    ASSERT_EQ(diags[1].line, 3u);
+    ASSERT_EQ(diags[1].col, 11u);
+    ASSERT_EQ(diags[1].code, PARSER_EXPECT_EXPR);
+    arrfree(diags);
+
+    EditFile(3, 4, "  ferao x * 2\n");
+    diags = CheckFileDiags(utest_fixture->file);
+    ASSERT_EQ(arrlen(diags), 0);
+    arrfree(diags);
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, InsertMovesLines) {
+    OpenFile("dhori a = 1\n\ndhori = 2\n\ndhori c = 2\n");
+    EditFile(1, 1, "dekhao(a)\ndekhao(a)\n");
+    PCheckDiag *diags = CheckFileDiags(utest_fixture->file);
+    ASSERT_EQ(arrlen(diags), 1);
+    ASSERT_EQ(diags[0].line, 5u);
+    arrfree(diags);
+    ASSERT_EQ(utest_fixture->file->lineCount, 7u);
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, LexerError) {
+    OpenFile("dhori a = 1\ndhori b = 2\n");
+    EditFile(2, 3, "dhori b = 2 @\n");
+    PCheckDiag *diags = CheckFileDiags(utest_fixture->file);
+    ASSERT_GE(arrlen(diags), 1);
+    ASSERT_EQ(diags[0].line, 2u);
+    ASSERT_EQ(diags[0].col, 13u);
+    ASSERT_EQ(diags[0].code, LEXER_INVALID_CHAR);
+    arrfree(diags);
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, RemovedEndMergesUnits) {
+    OpenFile(
+        "kaj f(x)\n  ferao x\nsesh\n\ndekhao(1)\n\nkaj g(y)\n"
+        "  ferao y\nsesh\n"
+    );
+    u64 units = arrlen(utest_fixture->file->units);
+    ASSERT_GE(units, 3);
+
+    // Without `sesh` the function reads on to the end of the file
+    EditFile(3, 4, "\n");
+    ASSERT_LT(arrlen(utest_fixture->file->units), units);
+    CheckSameAsFresh();
+
+    EditFile(3, 4, "sesh\n");
+    ASSERT_EQ(arrlen(utest_fixture->file->units), units);
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, DeleteAndAppend) {
+    OpenFile("ferao\nsesh\n");
+    EditFile(1, 2, "");
+    CheckSameAsFresh();
+    EditFile(2, 2, "dekhao(1)");
+    CheckSameAsFresh();
+    EditFile(1, 3, "");
+    ASSERT_EQ(utest_fixture->file->lineCount, 0u);
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, ErrorAtEndOfFile) {
+    OpenFile("kaj f()\n  1\n\n");
+    PCheckDiag *diags = CheckFileDiags(utest_fixture->file);
+    ASSERT_EQ(arrlen(diags), 1);
+    ASSERT_EQ(diags[0].line, 4u);
+    ASSERT_EQ(diags[0].col, 1u);
+    arrfree(diags);
+    EditFile(2, 3, "  2\n");
+    CheckSameAsFresh();
+}
+
+UTEST_F(CheckTest, OutOfRange) {
+    OpenFile("dhori a = 1\n");
+    ASSERT_FALSE(CheckFileEdit(utest_fixture->file, 0, 1, "", 0));
+    ASSERT_FALSE(CheckFileEdit(utest_fixture->file, 2, 1, "", 0));
+    ASSERT_FALSE(CheckFileEdit(utest_fixture->file, 1, 3, "", 0));
+}
+
+UTEST(CheckServer, PayloadTooLarge) {
+    ASSERT_TRUE(CheckPayloadLenValid(0));
+    ASSERT_TRUE(CheckPayloadLenValid(CHECK_PAYLOAD_MAX));
+    ASSERT_FALSE(CheckPayloadLenValid(CHECK_PAYLOAD_MAX + 1));
+    ASSERT_FALSE(CheckPayloadLenValid(99999999999ull));
+    ASSERT_FALSE(CheckPayloadLenValid(UINT64_MAX));
+
+    // Text of a length over the limit is skipped, not run as commands. The
+    // input ends before all of it, so the `quit` in it isn't the one which
+    // stops the server
+    const char *huge = "open a.pn 18446744073709551615\nquit\nopen b.pn 3\nabc";
+    FILE *in = tmpfile();
+    ASSERT_NE(in, NULL);
+    fputs(huge, in);
+    rewind(in);
+    ASSERT_EQ(ServeCheckCommands(in), EXIT_SUCCESS);
+    ASSERT_EQ(ftell(in), (long)strlen(huge));
+    fclose(in);
+}
+
+UTEST(CheckServer, BadLength) {
+    // Where the text ends is unknown, so the server stops
+    const char *cmds[] = {"open d -5\n", "change d 1 1 x1\n", "open d\t12a\n"};
+    for (u64 i = 0; i < sizeof(cmds) / sizeof(cmds[0]); i++) {
+        FILE *in = tmpfile();
+        ASSERT_NE(in, NULL);
+        fputs(cmds[i], in);
+        fputs("open a.pn 12\ndhori a = 1\nquit\n", in);
+        rewind(in);
+        ASSERT_EQ(ServeCheckCommands(in), EXIT_SUCCESS);
+        ASSERT_EQ(ftell(in), (long)strlen(cmds[i]));
+        fclose(in);
+    }
+
+    // A bad line number still has its text read
+    const char *change = "open a.pn 0\nchange a.pn -1 1 12\ndhori a = 1\n";
+    FILE *in = tmpfile();
+    ASSERT_NE(in, NULL);
+    fputs(change, in);
+    fputs("quit\nclose a.pn\n", in);
+    rewind(in);
+    ASSERT_EQ(ServeCheckCommands(in), EXIT_SUCCESS);
+    ASSERT_EQ(ftell(in), (long)(strlen(change) + strlen("quit\n")));
+    fclose(in);
+}
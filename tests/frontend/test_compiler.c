@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "../../src/arena.h"
+#include "../../src/compiler.h"
+#include "../../src/core.h"
+#include "../../src/gc.h"
+#include "../../src/lexer.h"
+#include "../../src/object.h"
+#include "../../src/opcode.h"
+#include "../../src/parser.h"
+#include "../../src/symtable.h"
+#include "../../src/vm.h"
+#include "../include/utest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct CompilerTest {
+    PArena *arena;
+    Lexer *lx;
+    Parser *parser;
+    Pgc *gc;
+    PCompiler *comp;
+    int errors;
+};
+
+UTEST_F_SETUP(CompilerTest) {
+    utest_fixture->arena = NULL;
+    utest_fixture->lx = NULL;
+    utest_fixture->parser = NULL;
+    utest_fixture->gc = NULL;
+    utest_fixture->comp = NULL;
+    utest_fixture->errors = 0;
+}
+
+UTEST_F_TEARDOWN(CompilerTest) {
+    if (utest_fixture->comp != NULL) {
+        FreeCompiler(utest_fixture->comp);
+    }
+    if (utest_fixture->gc != NULL) {
+        FreeGc(utest_fixture->gc);
+    }
+    if (utest_fixture->parser != NULL) {
+        FreeParser(utest_fixture->parser);
+    }
+    if (utest_fixture->lx != NULL) {
+        FreeLexer(utest_fixture->lx);
+    }
+    if (utest_fixture->arena != NULL) {
+        FreeArena(utest_fixture->arena);
+    }
+}
+
+static void countError(void *ctx, Token *tok, PanDiagCode code, va_list args) {
+    (void)tok;
+    (void)code;
+    (void)args;
+    (*(int *)ctx)++;
+}
+
+// Compile `src` to the top level function `fn`, errors are counted in
+// `utest_fixture->errors`
+#define CompileSrc(src, fn)                                                    \
+    utest_fixture->arena = NewArena();                                         \
+    utest_fixture->lx = NewLexer(src, utest_fixture->arena);                   \
+    MakeLexerRaw(utest_fixture->lx, true);                                     \
+    ScanTokens(utest_fixture->lx);                                             \
+    utest_fixture->parser =                                                    \
+        NewParser(utest_fixture->arena, utest_fixture->lx);                    \
+    utest_fixture->parser->errCtx =                                            \
+        (PDiagonCtx){.report = countError, .ctx = &utest_fixture->errors};     \
+    PStmt **prog = ParseParser(utest_fixture->parser);                         \
+    ASSERT_EQ(utest_fixture->errors, 0);                                       \
+    utest_fixture->gc = NewGc();                                               \
+    utest_fixture->comp = NewCompiler(                                         \
+        utest_fixture->gc,                                                     \
+        (PDiagonCtx){.report = countError, .ctx = &utest_fixture->errors}      \
+    );                                                                         \
+    GcRegisterRootMarker(                                                      \
+        utest_fixture->gc, CompilerMarkRoots, utest_fixture->comp              \
+    );                                                                         \
+    ASSERT_TRUE(CompilerCompile(utest_fixture->comp, prog));                   \
+    ASSERT_EQ(utest_fixture->errors, 0);                                       \
+    PObj *fn = GetCompiledFunction(utest_fixture->comp);                       \
+    ASSERT_NE(fn, NULL);
+
+// Whether bytecode `bt` has an instruction `op`
+static bool hasOp(PBytecode *bt, PanOpCode op) {
+    u64 offset = 0;
+    while (offset < bt->codeCount) {
+        if (bt->code[offset] == op) {
+            return true;
+        }
+        POpDefinition def = GetOpDefinition((PanOpCode)bt->code[offset]);
+        offset++;
+        for (u8 i = 0; i < def.operands; i++) {
+            offset += def.operandWidths[i];
+        }
+    }
+    return false;
+}
+
+// Count of distinct literals in each function of `manyConstsSrc`, past the
+// 16-bit constant indexes
+#define MANY_CONSTS 70000
+
+// Script adding literals 1 to `MANY_CONSTS` in a function and at top level,
+// then defining a global whose name comes after all the literals
+static char *manyConstsSrc(void) {
+    u64 cap = (u64)MANY_CONSTS * 64 + 256;
+    char *src = malloc(cap);
+    if (src == NULL) {
+        return NULL;
+    }
+    u64 len = 0;
+    len += (u64)snprintf(src + len, cap - len, "kaj big()\n  dhori s = 0\n");
+    for (int i = 1; i <= MANY_CONSTS; i++) {
+        len += (u64)snprintf(src + len, cap - len, "  s = s + %d\n", i);
+    }
+    len += (u64)snprintf(
+        src + len, cap - len, "  ferao s\nsesh\ndhori s = 0\n"
+    );
+    for (int i = 1; i <= MANY_CONSTS; i++) {
+        len += (u64)snprintf(src + len, cap - len, "s = s + %d\n", i);
+    }
+    snprintf(
+        src + len, cap - len, "dhori total = big()\ndhori last = s + 0.5\n"
+    );
+    return src;
+}
+
+UTEST_F(CompilerTest, ManyConstantsUseLongIndex) {
+    char *src = manyConstsSrc();
+    ASSERT_NE(src, NULL);
+    CompileSrc(src, fn);
+    free(src);
+
+    PBytecode *bt = fn->v.OComFunction.code;
+    ASSERT_GT(bt->constCount, (u32)UINT16_MAX + 1);
+    ASSERT_TRUE(hasOp(bt, OP_CONST_LONG));
+
+    PObj *big = NULL;
+    for (u32 i = 0; i < bt->constCount; i++) {
+        PValue value = bt->constPool[i];
+        if (IsValueObjType(value, OT_COMFNC)) {
+            big = ValueAsObj(value);
+        }
+    }
+    ASSERT_NE(big, NULL);
+    ASSERT_GT(big->v.OComFunction.code->constCount, (u32)UINT16_MAX + 1);
+    ASSERT_TRUE(hasOp(big->v.OComFunction.code, OP_CONST_LONG));
+}
+
+// Number held by global `name` of session `core`
+#define AssertGlobalNum(core, name, num)                                       \
+    {                                                                          \
+        bool found = false;                                                    \
+        PObj *key = NewStrObject(core->gc, (char *)name, false);               \
+        PValue value = SymbolTableFind(core->vm->globals, key, &found);        \
+        ASSERT_TRUE(found);                                                    \
+        ASSERT_TRUE(IsValueNum(value));                                        \
+        ASSERT_EQ(ValueAsNum(value), num);                                     \
+    }
+
+UTEST(CompilerRun, ManyConstants) {
+    char *src = manyConstsSrc();
+    ASSERT_NE(src, NULL);
+    double sum = (double)MANY_CONSTS * (MANY_CONSTS + 1) / 2;
+
+    // Both engines read the literals past the 16-bit indexes
+    for (int reg = 0; reg < 2; reg++) {
+        PanktiCore *core = NewSessionCore();
+        ASSERT_NE(core, NULL);
+        core->regEngine = reg == 1;
+        ASSERT_EQ(RunCoreChunk(core, src, strlen(src)), PCERR_OK);
+        AssertGlobalNum(core, "s", sum);
+        AssertGlobalNum(core, "total", sum);
+        AssertGlobalNum(core, "last", sum + 0.5);
+        FreeCore(core);
+    }
+    free(src);
+}
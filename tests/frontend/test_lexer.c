@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include "../../src/arena.h"
 #include "../../src/external/stb/stb_ds.h"
 #include "../../src/lexer.h"
 #include "../../src/utils.h"
@@ -44,14 +45,19 @@
 
 struct LexerTest {
     Lexer *lx;
+    PArena *arena;
 };
 
 UTEST_F_SETUP(LexerTest) {
-    utest_fixture->lx = NewLexer("");
+    utest_fixture->arena = NewArena();
+    utest_fixture->lx = NewLexer("", utest_fixture->arena);
     MakeLexerRaw(utest_fixture->lx, true);
 }
 
-UTEST_F_TEARDOWN(LexerTest) { FreeLexer(utest_fixture->lx); }
+UTEST_F_TEARDOWN(LexerTest) {
+    FreeLexer(utest_fixture->lx);
+    FreeArena(utest_fixture->arena);
+}
 
 UTEST_F(LexerTest, Operator) {
     SetupLexer("1+2.0-3.5*4.999/5.1**6.01")
@@ -8,6 +8,7 @@
 
 #include "../../src/lexer.h"
 #include "../../src/parser.h"
+#include "../../src/arena.h"
 #include "../../src/gc.h"
 #include "../../src/external/stb/stb_ds.h"
 #include "../include/utest.h"
@@ -15,14 +16,14 @@
 struct ParserTest{
 	Lexer * lx;
 	Parser * parser;
-	Pgc * gc;
+	PArena * arena;
 	PStmt ** stmts;
 };
 
 UTEST_F_SETUP(ParserTest){
 	utest_fixture->lx = NULL;
 	utest_fixture->parser = NULL;
-	utest_fixture->gc = NULL;
+	utest_fixture->arena = NULL;
 	utest_fixture->stmts = NULL;
 }
 
@@ -35,17 +36,17 @@ UTEST_F_TEARDOWN(ParserTest){
 		FreeLexer(utest_fixture->lx);
 	}
 
-	if (utest_fixture->gc != NULL) {
-		FreeGc(utest_fixture->gc);
+	if (utest_fixture->arena != NULL) {
+		FreeArena(utest_fixture->arena);
 	}
 }
 
 #define SetupParser(src)\
-	utest_fixture->gc = NewGc();\
-	utest_fixture->lx = NewLexer(src);\
+	utest_fixture->arena = NewArena();\
+	utest_fixture->lx = NewLexer(src, utest_fixture->arena);\
     MakeLexerRaw(utest_fixture->lx, true);\
 	ScanTokens(utest_fixture->lx);\
-	utest_fixture->parser = NewParser(utest_fixture->gc, utest_fixture->lx);\
+	utest_fixture->parser = NewParser(utest_fixture->arena, utest_fixture->lx);\
 	utest_fixture->stmts = ParseParser(utest_fixture->parser);\
 
 
@@ -105,7 +106,8 @@ UTEST_F(ParserTest, Let){
 
 	ASSERT_EQ(stmt->type, STMT_LET);
 	struct SLet * let = &stmt->stmt.SLet;
-	ASSERT_STREQ(let->name->lexeme, "time");
+	ASSERT_EQ(let->name->len, 4u);
+	ASSERT_STRNEQ(let->name->lexeme, "time", 4);
 	ASSERT_EQ(let->expr->type, EXPR_LITERAL);
 }
 
@@ -115,19 +117,51 @@ UTEST_F(ParserTest, FuncDeclaration){
 	PStmt * stmt = utest_fixture->stmts[0];
 
 	ASSERT_EQ(stmt->type, STMT_FUNC);
-	ASSERT_STREQ(stmt->stmt.SFunc.name->lexeme, "jog");
+	ASSERT_EQ(stmt->stmt.SFunc.name->len, 3u);
+	ASSERT_STRNEQ(stmt->stmt.SFunc.name->lexeme, "jog", 3);
 
 	ASSERT_EQ(stmt->stmt.SFunc.paramCount, 2);
-	ASSERT_STREQ(stmt->stmt.SFunc.params[0]->lexeme, "a");
-	ASSERT_STREQ(stmt->stmt.SFunc.params[1]->lexeme, "b");
+	ASSERT_EQ(stmt->stmt.SFunc.params[0]->len, 1u);
+	ASSERT_STRNEQ(stmt->stmt.SFunc.params[0]->lexeme, "a", 1);
+	ASSERT_EQ(stmt->stmt.SFunc.params[1]->len, 1u);
+	ASSERT_STRNEQ(stmt->stmt.SFunc.params[1]->lexeme, "b", 1);
 
 	PStmt * fbody = stmt->stmt.SFunc.body;
 	ASSERT_EQ(fbody->type, STMT_BLOCK);
 
 	struct SBlock * block = &fbody->stmt.SBlock;
-	ASSERT_EQ(arrlen(block->stmts), 1);
+	ASSERT_EQ(block->count, 1);
 	ASSERT_EQ(block->stmts[0]->type, STMT_RETURN);
 
 	struct SReturn * ret = &block->stmts[0]->stmt.SReturn;
 	ASSERT_EQ(ret->value->type, EXPR_BINARY);
 }
+
+static void countError(void * ctx, Token * tok, PanDiagCode code, va_list args){
+	(*(int *)ctx)++;
+}
+
+// Parse `src` counting the errors reported in `errors`
+#define SetupParserErrors(src, errors)\
+	utest_fixture->arena = NewArena();\
+	utest_fixture->lx = NewLexer(src, utest_fixture->arena);\
+	MakeLexerRaw(utest_fixture->lx, true);\
+	ScanTokens(utest_fixture->lx);\
+	utest_fixture->parser = NewParser(utest_fixture->arena, utest_fixture->lx);\
+	utest_fixture->parser->errCtx = (PDiagonCtx){.report = countError, .ctx = &errors};\
+	utest_fixture->stmts = ParseParser(utest_fixture->parser);\
+
+UTEST_F(ParserTest, AssignWithoutTarget){
+	int errors = 0;
+	SetupParserErrors("=", errors);
+	ASSERT_TRUE(utest_fixture->parser->hasError);
+	ASSERT_GT(errors, 0);
+}
+
+UTEST_F(ParserTest, MapOpenAtEnd){
+	// Used to loop forever on the end of file token
+	int errors = 0;
+	SetupParserErrors("*{", errors);
+	ASSERT_TRUE(utest_fixture->parser->hasError);
+	ASSERT_GT(errors, 0);
+}
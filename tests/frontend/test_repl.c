@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "../../src/core.h"
+#include "../../src/object.h"
+#include "../../src/repl.h"
+#include "../../src/symtable.h"
+#include "../../src/vm.h"
+#include "../include/utest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ReplTest {
+    PanktiCore *core;
+};
+
+UTEST_F_SETUP(ReplTest) {
+    utest_fixture->core = NewSessionCore();
+    ASSERT_NE(utest_fixture->core, NULL);
+}
+
+UTEST_F_TEARDOWN(ReplTest) { FreeCore(utest_fixture->core); }
+
+#define RunChunk(src, result)                                                  \
+    ASSERT_EQ(                                                                 \
+        RunCoreChunk(utest_fixture->core, src, strlen(src)), result            \
+    );
+
+// Number held by global `name` of the session
+#define AssertGlobalNum(name, num)                                             \
+    {                                                                          \
+        bool found = false;                                                    \
+        PObj *key =                                                            \
+            NewStrObject(utest_fixture->core->gc, (char *)name, false);        \
+        PValue value =                                                         \
+            SymbolTableFind(utest_fixture->core->vm->globals, key, &found);    \
+        ASSERT_TRUE(found);                                                    \
+        ASSERT_TRUE(IsValueNum(value));                                        \
+        ASSERT_EQ(ValueAsNum(value), num);                                     \
+    }
+
+UTEST(ReplChunk, Complete) {
+    ASSERT_TRUE(ReplChunkComplete("dhori a = 1\n"));
+    ASSERT_TRUE(ReplChunkComplete("kaj f(x)\n  ferao x\nsesh\n"));
+    ASSERT_TRUE(ReplChunkComplete("\n"));
+    // errors before the end are reported, more lines won't fix them
+    ASSERT_TRUE(ReplChunkComplete("dhori = 1\n"));
+    ASSERT_TRUE(ReplChunkComplete("dhori a = 1 @\n"));
+}
+
+UTEST(ReplChunk, NotComplete) {
+    ASSERT_FALSE(ReplChunkComplete("kaj f(x)\n"));
+    ASSERT_FALSE(ReplChunkComplete("kaj f(x)\n  ferao x\n"));
+    ASSERT_FALSE(ReplChunkComplete("dhori a = \n"));
+    ASSERT_FALSE(ReplChunkComplete("dekhao(1,\n"));
+    ASSERT_FALSE(ReplChunkComplete("dhori a = \"first line\n"));
+}
+
+UTEST_F(ReplTest, GlobalsAcrossChunks) {
+    RunChunk("dhori a = 41\n", PCERR_OK);
+    RunChunk("kaj inc(x)\n  ferao x + 1\nsesh\n", PCERR_OK);
+    RunChunk("dhori b = inc(a)\n", PCERR_OK);
+    AssertGlobalNum("b", 42.0);
+
+    // calls compiled before `inc` changes see the new one
+    RunChunk("kaj twice(x)\n  ferao inc(inc(x))\nsesh\n", PCERR_OK);
+    RunChunk("kaj inc(x)\n  ferao x + 10\nsesh\n", PCERR_OK);
+    RunChunk("b = twice(0)\n", PCERR_OK);
+    AssertGlobalNum("b", 20.0);
+}
+
+UTEST_F(ReplTest, ImportAcrossChunks) {
+    RunChunk("import m \"গণিত\"\n", PCERR_OK);
+    RunChunk("dhori r = m.বর্গমূল(16)\n", PCERR_OK);
+    AssertGlobalNum("r", 4.0);
+}
+
+UTEST_F(ReplTest, ImportAgainSharesModule) {
+    RunChunk("import m \"গণিত\"\n", PCERR_OK);
+    RunChunk("import n \"গণিত\"\ndhori r = n.বর্গমূল(9)\n", PCERR_OK);
+    AssertGlobalNum("r", 3.0);
+    ASSERT_EQ(utest_fixture->core->vm->modCount, (u64)1);
+}
+
+UTEST_F(ReplTest, ErrorsKeepSession) {
+    RunChunk("dhori a = 1\n", PCERR_OK);
+    RunChunk("a = 2\ndekhao(missing)\na = 3\n", PCERR_RUNTIME);
+    AssertGlobalNum("a", 2.0);
+    RunChunk("ferao a\n", PCERR_COMPILER);
+    RunChunk("dhori = 1\n", PCERR_PARSER);
+    RunChunk("kaj f(n)\n  ferao f(n + 1) + 1\nsesh\n", PCERR_OK);
+    RunChunk("dhori b = f(0) + 1\n", PCERR_RUNTIME);
+    RunChunk("a = a + 1\n", PCERR_OK);
+    AssertGlobalNum("a", 3.0);
+}
+
+UTEST_F(ReplTest, ClosureLeftByError) {
+    RunChunk("dhori g = nil\n", PCERR_OK);
+    RunChunk(
+        "kaj mk()\n  dhori c = 0\n  kaj inc()\n    c = c + 1\n    ferao c\n"
+        "  sesh\n  g = inc\n  dekhao(missing)\nsesh\nmk()\n",
+        PCERR_RUNTIME
+    );
+    RunChunk("g()\ndhori n = g()\n", PCERR_OK);
+    AssertGlobalNum("n", 2.0);
+}
@@ -8,4 +8,8 @@ set(PANKTI_NATIVE_TEST_FILES
   "${CMAKE_CURRENT_LIST_DIR}/test_main.c"
   "${CMAKE_CURRENT_LIST_DIR}/test_lexer.c"
   "${CMAKE_CURRENT_LIST_DIR}/test_parser.c"
+  "${CMAKE_CURRENT_LIST_DIR}/test_check.c"
+  "${CMAKE_CURRENT_LIST_DIR}/test_compiler.c"
+  "${CMAKE_CURRENT_LIST_DIR}/test_array.c"
+  "${CMAKE_CURRENT_LIST_DIR}/test_repl.c"
 )
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2022 Palash Bauri
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RUNTIME_TEST_ERR_STDLIB_H
+#define RUNTIME_TEST_ERR_STDLIB_H
+
+#include "../tester.h"
+#include "../../include/utest.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+UTEST(RuntimeErrorTest, StdArrayTooBig){ ErrorTest("stdarray_too_big"); }
+UTEST(RuntimeErrorTest, StdArraySortByModified){ ErrorTest("stdarray_sortby_modified"); }
+UTEST(RuntimeErrorTest, StdMathIntrinsicPos){ ErrorTest("stdmath_intrinsic_pos"); }
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,12 @@ UTEST(RuntimeTest, SubscriptAssign){ GoldenTest("subscript_assign"); }
 UTEST(RuntimeTest, MixedSyntax){ GoldenTest("mixed_syntax"); }
 UTEST(RuntimeTest, Truthiness){ GoldenTest("truthiness"); }
 UTEST(RuntimeTest, FuncFirstClass){ GoldenTest("func_firstclass"); }
+UTEST(RuntimeTest, FuncTailCall){ GoldenTest("func_tailcall"); }
+UTEST(RuntimeTest, FuncDeepRecursion){ GoldenTest("func_deep_recursion"); }
+UTEST(RuntimeTest, FuncInline){ GoldenTest("func_inline"); }
+UTEST(RuntimeTest, ArithmeticInt){ GoldenTest("arithmetic_int"); }
+UTEST(RuntimeTest, Intrinsics){ GoldenTest("intrinsics"); }
+UTEST(RuntimeTest, ImportCache){ GoldenTest("import_cache"); }
 
 
 #ifdef __cplusplus
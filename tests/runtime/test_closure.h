@@ -18,6 +18,7 @@ extern "C" {
 UTEST(RuntimeTest, Nested_Closure){ GoldenTest("nested_closure"); }
 UTEST(RuntimeTest, Mutation_Closure){ GoldenTest("closure_mutation"); }
 UTEST(RuntimeTest, Shared_Closure){ GoldenTest("closure_shared"); }
+UTEST(RuntimeTest, Direct_Closure){ GoldenTest("closure_direct"); }
 
 #ifdef __cplusplus
 }
@@ -20,6 +20,7 @@
 
 // Error Tests
 #include "errors/test_parser.h"
+#include "errors/test_stdlib.h"
 
 // Test Benchmarks
 #include "test_bench.h"
@@ -19,6 +19,9 @@ UTEST(RuntimeTest, StdString){ GoldenTest("stdstring"); }
 UTEST(RuntimeTest, StdMath){ GoldenTest("stdmath"); }
 UTEST(RuntimeTest, StdMap){ GoldenTest("stdmap"); }
 UTEST(RuntimeTest, StdArray){ GoldenTest("stdarray"); }
+UTEST(RuntimeTest, StdArrayNum){ GoldenTest("stdarray_num"); }
+UTEST(RuntimeTest, StdArrayFn){ GoldenTest("stdarray_fn"); }
+UTEST(RuntimeTest, StdArraySeq){ GoldenTest("stdarray_seq"); }
 UTEST(RuntimeTest, StdFile){ GoldenTest("stdfile"); }
 UTEST(RuntimeTest, StdGraphics){ GoldenTest("stdgraphics"); }
 UTEST(RuntimeTest, StdSystem){ GoldenTest("stdsystem"); }
@@ -22,6 +22,8 @@ UTEST(RuntimeTest, WhileFizzBuzz){ GoldenTest("while_fizzbuzz"); }
 UTEST(RuntimeTest, WhileNested){ GoldenTest("while_nested"); }
 UTEST(RuntimeTest, WhileNestedBreak){ GoldenTest("while_nested_break"); }
 UTEST(RuntimeTest, WhileNestedContinue){ GoldenTest("while_nested_continue"); }
+UTEST(RuntimeTest, WhileBreakScope){ GoldenTest("while_break_scope"); }
+UTEST(RuntimeTest, WhileTypeChange){ GoldenTest("while_type_change"); }
 //UTEST(RuntimeTest, *){ GoldenTest("*"); }
 
 
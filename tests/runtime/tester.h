@@ -51,7 +51,21 @@ static inline char * trimSpaces(char * str){
     return ptr;
 }
 
-static bool matchLines(FILE * inputPtr, FILE * goldenPtr, bool debug, int * line){
+// Replace every `path` in `str` with `name`, which must not be longer
+static inline void replacePath(char * str, const char * path, const char * name){
+	size_t pathLen = strlen(path);
+	size_t nameLen = strlen(name);
+	char * found = strstr(str, path);
+	while (found != NULL) {
+		memcpy(found, name, nameLen);
+		memmove(found + nameLen, found + pathLen, strlen(found + pathLen) + 1);
+		found = strstr(found + nameLen, path);
+	}
+}
+
+// If `scriptPath` is not NULL, it is matched as `scriptName` in the input, so
+// goldens don't depend on where the samples are
+static bool matchLines(FILE * inputPtr, FILE * goldenPtr, bool debug, int * line, const char * scriptPath, const char * scriptName){
 	if (inputPtr == NULL || goldenPtr == NULL || line == NULL) {
 		return false;
 	}
@@ -63,6 +77,9 @@ static bool matchLines(FILE * inputPtr, FILE * goldenPtr, bool debug, int * line
 	bool hasGolden = fgets(goldenBuf, READ_BUFFER, goldenPtr) != NULL;
 
 	while(hasInput || hasGolden){
+		if (hasInput && scriptPath != NULL) {
+			replacePath(inputBuf, scriptPath, scriptName);
+		}
 		char * tempInput = hasInput ? trimSpaces(inputBuf) : "";
 		char * tempGolden = hasGolden ? trimSpaces(goldenBuf) : "";
 
@@ -85,7 +102,7 @@ static bool matchLines(FILE * inputPtr, FILE * goldenPtr, bool debug, int * line
 	return true;
 }
 
-static inline bool matchFiles(const char * inputFile, const char * goldenFile, bool debug){
+static inline bool matchFiles(const char * inputFile, const char * goldenFile, bool debug, const char * scriptPath, const char * scriptName){
 	FILE * inputFp = fopen(inputFile, "r");
 	if (inputFp == NULL) {
 		printf("Failed to read input file : %s\n", inputFile);
@@ -100,7 +117,7 @@ static inline bool matchFiles(const char * inputFile, const char * goldenFile, b
 	}
 
 	int line = 1;
-	bool match = matchLines(inputFp, goldFp, debug, &line);
+	bool match = matchLines(inputFp, goldFp, debug, &line, scriptPath, scriptName);
 	fclose(inputFp);
 	fclose(goldFp);
 	return match;
@@ -121,7 +138,7 @@ static inline bool matchOutput(const char * cmd, const char * golden, bool debug
     }
     int line = 1;
 
-	bool match = matchLines(cmdFp, gldFp, debug, &line);
+	bool match = matchLines(cmdFp, gldFp, debug, &line, NULL, NULL);
 	if (!match) {
 		fclose(gldFp);
 		pclose(cmdFp);
@@ -216,7 +233,9 @@ static inline bool RunErrorGolden(const char * script){
 	int ret = system(command);
 	(void)ret;
 
-	bool result = matchFiles(tmpPath, goldenPath, enableDebug);
+	char scriptName[COMMAND_BUFF_SIZE];
+	snprintf(scriptName, COMMAND_BUFF_SIZE, "%s.pn", script);
+	bool result = matchFiles(tmpPath, goldenPath, enableDebug, scriptPath, scriptName);
 
 	remove(tmpPath);
 